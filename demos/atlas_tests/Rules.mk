@@ -13,6 +13,12 @@ include $(dir)/Rules.mk
 dir := $(d)/glyph_test
 include $(dir)/Rules.mk
 
+dir := $(d)/interval_allocator_benchmark
+include $(dir)/Rules.mk
+
+dir := $(d)/glyph_texel_allocator_benchmark
+include $(dir)/Rules.mk
+
 # Begin standard footer
 d		:= $(dirstack_$(sp))
 sp		:= $(basename $(sp))
@@ -0,0 +1,18 @@
+# Begin standard header
+sp 		:= $(sp).x
+dirstack_$(sp)	:= $(d)
+d		:= $(dir)
+# End standard header
+
+# the rectangle allocators are private to the library, so
+# the benchmark compiles their sources directly
+DEMOS += glyph-texel-allocator-benchmark
+glyph-texel-allocator-benchmark_SOURCES := $(call filelist, main.cpp) \
+	src/fastuidraw/private/segregated_interval_allocator.cpp \
+	src/fastuidraw/text/private/rect_atlas.cpp \
+	src/fastuidraw/text/private/shelf_atlas.cpp
+
+# Begin standard footer
+d		:= $(dirstack_$(sp))
+sp		:= $(basename $(sp))
+# End standard footer
@@ -0,0 +1,213 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <fastuidraw/text/freetype_face.hpp>
+#include "generic_command_line.hpp"
+#include "simple_time.hpp"
+#include "text_helper.hpp"
+#include "../../../src/fastuidraw/text/private/rect_atlas.hpp"
+#include "../../../src/fastuidraw/text/private/shelf_atlas.hpp"
+
+/* Benchmark of the rectangle allocators that GlyphAtlas can use
+ * for texels: detail::RectAtlas (GlyphAtlas::tree_texel_allocator)
+ * and detail::ShelfAtlas (GlyphAtlas::shelf_texel_allocator).
+ * The sizes of the rectangles are the bitmap sizes of the glyphs
+ * of a font at a pixel size plus padding, as they would be for
+ * coverage glyphs. Both allocators see exactly the same sequence
+ * of requests: first glyphs are added until an allocation fails
+ * to measure packing efficiency (area of the glyphs over the area
+ * of the atlas), then each iteration of churn frees a random glyph
+ * and adds a random glyph to measure allocations per second as
+ * glyphs come and go from a GlyphCache.
+ */
+
+using namespace fastuidraw;
+
+class benchmark_params:public command_line_register
+{
+public:
+  benchmark_params(void):
+    m_font_file(default_font(), "font", "font from which to take glyph sizes", *this),
+    m_font_index(0, "font_index", "face index into font file", *this),
+    m_pixel_size(32, "pixel_size", "pixel size at which to take glyph sizes", *this),
+    m_padding(1, "padding", "padding added to each side of each glyph", *this),
+    m_width(1024, "width", "width of the atlas", *this),
+    m_height(1024, "height", "height of the atlas", *this),
+    m_churn_fill(0.9f, "churn_fill", "fraction of the glyphs that fit in the atlas "
+                 "to keep live during churn", *this),
+    m_iterations(1000000, "iterations", "number of free/allocate pairs", *this),
+    m_seed(101, "seed", "seed of the random number generator", *this)
+  {}
+
+  command_line_argument_value<std::string> m_font_file;
+  command_line_argument_value<int> m_font_index;
+  command_line_argument_value<int> m_pixel_size;
+  command_line_argument_value<int> m_padding;
+  command_line_argument_value<int> m_width;
+  command_line_argument_value<int> m_height;
+  command_line_argument_value<float> m_churn_fill;
+  command_line_argument_value<int> m_iterations;
+  command_line_argument_value<int> m_seed;
+};
+
+static
+void
+load_glyph_sizes(const benchmark_params &P, std::vector<ivec2> &sizes)
+{
+  reference_counted_ptr<FreeTypeFace::GeneratorFile> gen;
+  reference_counted_ptr<FreeTypeFace> face;
+
+  gen = FASTUIDRAWnew FreeTypeFace::GeneratorFile(P.m_font_file.value().c_str(),
+                                                  P.m_font_index.value());
+  face = gen->create_face();
+  if (face)
+    {
+      FT_Face f(face->face());
+
+      FT_Set_Pixel_Sizes(f, P.m_pixel_size.value(), P.m_pixel_size.value());
+      for (int g = 0; g < f->num_glyphs; ++g)
+        {
+          if (FT_Load_Glyph(f, g, FT_LOAD_DEFAULT) == 0)
+            {
+              /* metrics are in 26.6 fixed point */
+              int w(f->glyph->metrics.width), h(f->glyph->metrics.height);
+
+              w = (w + 63) / 64;
+              h = (h + 63) / 64;
+              if (w > 0 && h > 0)
+                {
+                  sizes.push_back(ivec2(w, h) + ivec2(2 * P.m_padding.value()));
+                }
+            }
+        }
+    }
+
+  if (sizes.empty())
+    {
+      std::mt19937 generator(P.m_seed.value());
+      std::normal_distribution<float> dist(0.6f * P.m_pixel_size.value(),
+                                           0.2f * P.m_pixel_size.value());
+
+      std::cout << "Unable to take glyph sizes from \"" << P.m_font_file.value()
+                << "\", using a normal distribution of sizes\n";
+      for (int i = 0; i < 4096; ++i)
+        {
+          int w, h;
+
+          w = std::max(1, static_cast<int>(dist(generator)));
+          h = std::max(1, static_cast<int>(dist(generator)));
+          sizes.push_back(ivec2(w, h) + ivec2(2 * P.m_padding.value()));
+        }
+    }
+}
+
+template<typename T>
+void
+run_benchmark(const char *label, const benchmark_params &P,
+              const std::vector<ivec2> &sizes)
+{
+  typedef const detail::RectAtlasBase::rectangle *rect_ptr;
+
+  std::mt19937 generator(P.m_seed.value());
+  std::uniform_int_distribution<int> pick(0, sizes.size() - 1);
+  std::vector<rect_ptr> live;
+  T atlas(ivec2(P.m_width.value(), P.m_height.value()));
+  int64_t fill_us, churn_us, area(0);
+  int churn_live, failed(0);
+  float efficiency;
+  simple_time timer;
+
+  /* fill until the first failure */
+  for (;;)
+    {
+      rect_ptr r;
+      ivec2 sz(sizes[pick(generator)]);
+
+      r = atlas.add_rectangle(sz, 0, 0, 0, 0);
+      if (r == nullptr)
+        {
+          break;
+        }
+      live.push_back(r);
+      area += sz.x() * sz.y();
+    }
+  fill_us = timer.restart_us();
+  efficiency = static_cast<float>(area) / static_cast<float>(P.m_width.value() * P.m_height.value());
+
+  std::cout << label << ":\n"
+            << "\tfill: " << live.size() << " glyphs in " << fill_us << " us ("
+            << static_cast<double>(live.size()) * 1e6 / static_cast<double>(std::max(fill_us, int64_t(1)))
+            << " allocations/sec)\n"
+            << "\tpacking efficiency at first failure: " << 100.0f * efficiency << "%\n";
+
+  /* churn with a fraction of the glyphs live */
+  churn_live = static_cast<int>(P.m_churn_fill.value() * static_cast<float>(live.size()));
+  std::shuffle(live.begin(), live.end(), generator);
+  while (static_cast<int>(live.size()) > churn_live)
+    {
+      detail::RectAtlasBase::delete_rectangle(live.back());
+      live.pop_back();
+    }
+
+  timer.restart_us();
+  for (int i = 0; i < P.m_iterations.value() && !live.empty(); ++i)
+    {
+      int idx;
+      rect_ptr r;
+
+      idx = std::uniform_int_distribution<int>(0, live.size() - 1)(generator);
+      detail::RectAtlasBase::delete_rectangle(live[idx]);
+
+      r = atlas.add_rectangle(sizes[pick(generator)], 0, 0, 0, 0);
+      if (r != nullptr)
+        {
+          live[idx] = r;
+        }
+      else
+        {
+          live[idx] = live.back();
+          live.pop_back();
+          ++failed;
+        }
+    }
+  churn_us = timer.restart_us();
+
+  std::cout << "\tchurn: " << churn_us << " us ("
+            << static_cast<double>(P.m_iterations.value()) * 1e6 / static_cast<double>(std::max(churn_us, int64_t(1)))
+            << " free/allocate pairs/sec)\n"
+            << "\tfailed allocations during churn: " << failed << "\n"
+            << "\tglyphs live at end: " << live.size() << "\n";
+}
+
+int
+main(int argc, char **argv)
+{
+  benchmark_params P;
+  std::vector<ivec2> sizes;
+  int64_t area(0);
+
+  if (argc == 2 && std::string(argv[1]) == "-help")
+    {
+      std::cout << "\n\nUsage: " << argv[0];
+      P.print_help(std::cout);
+      P.print_detailed_help(std::cout);
+      return 0;
+    }
+
+  P.parse_command_line(argc, argv);
+  std::cout << "\n\n";
+
+  load_glyph_sizes(P, sizes);
+  for (const ivec2 &sz : sizes)
+    {
+      area += sz.x() * sz.y();
+    }
+  std::cout << sizes.size() << " glyph sizes, average area "
+            << static_cast<double>(area) / static_cast<double>(sizes.size()) << "\n";
+
+  run_benchmark<detail::RectAtlas>("RectAtlas (tree_texel_allocator)", P, sizes);
+  run_benchmark<detail::ShelfAtlas>("ShelfAtlas (shelf_texel_allocator)", P, sizes);
+
+  return 0;
+}
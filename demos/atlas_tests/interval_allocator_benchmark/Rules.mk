@@ -0,0 +1,17 @@
+# Begin standard header
+sp 		:= $(sp).x
+dirstack_$(sp)	:= $(d)
+d		:= $(dir)
+# End standard header
+
+# the allocators are private to the library, so the
+# benchmark compiles their sources directly
+DEMOS += interval-allocator-benchmark
+interval-allocator-benchmark_SOURCES := $(call filelist, main.cpp) \
+	src/fastuidraw/private/interval_allocator.cpp \
+	src/fastuidraw/private/segregated_interval_allocator.cpp
+
+# Begin standard footer
+d		:= $(dirstack_$(sp))
+sp		:= $(basename $(sp))
+# End standard footer
@@ -0,0 +1,120 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <utility>
+#include "generic_command_line.hpp"
+#include "simple_time.hpp"
+#include "../../../src/fastuidraw/private/interval_allocator.hpp"
+#include "../../../src/fastuidraw/private/segregated_interval_allocator.hpp"
+
+/* Benchmark of allocate/free churn of interval_allocator
+ * against segregated_interval_allocator. Both allocators
+ * see exactly the same sequence of requests: the store is
+ * first filled to a target number of live intervals, then
+ * each iteration frees a random live interval and allocates
+ * a new one, which is the pattern of GlyphAtlas geometry
+ * data and ColorStopAtlas layers as glyphs and color stop
+ * sequences come and go.
+ */
+
+class benchmark_params:public command_line_register
+{
+public:
+  benchmark_params(void):
+    m_size(1 << 20, "size", "size of the range from which to allocate", *this),
+    m_live(4096, "live", "number of live intervals during churn", *this),
+    m_min_length(1, "min_length", "minimum length of an interval", *this),
+    m_max_length(256, "max_length", "maximum length of an interval", *this),
+    m_iterations(1000000, "iterations", "number of free/allocate pairs", *this),
+    m_seed(101, "seed", "seed of the random number generator", *this)
+  {}
+
+  command_line_argument_value<int> m_size;
+  command_line_argument_value<int> m_live;
+  command_line_argument_value<int> m_min_length;
+  command_line_argument_value<int> m_max_length;
+  command_line_argument_value<int> m_iterations;
+  command_line_argument_value<int> m_seed;
+};
+
+template<typename T>
+void
+run_benchmark(const char *label, const benchmark_params &P)
+{
+  std::mt19937 generator(P.m_seed.value());
+  std::uniform_int_distribution<int> length(P.m_min_length.value(), P.m_max_length.value());
+  std::vector<std::pair<int, int> > live;
+  T allocator(P.m_size.value());
+  int failed(0);
+  int64_t fill_us, churn_us;
+  simple_time timer;
+
+  live.reserve(P.m_live.value());
+  for (int i = 0; i < P.m_live.value(); ++i)
+    {
+      int len(length(generator)), loc;
+
+      loc = allocator.allocate_interval(len);
+      if (loc != -1)
+        {
+          live.push_back(std::make_pair(loc, len));
+        }
+      else
+        {
+          ++failed;
+        }
+    }
+  fill_us = timer.restart_us();
+
+  for (int i = 0; i < P.m_iterations.value() && !live.empty(); ++i)
+    {
+      int idx, len, loc;
+
+      idx = std::uniform_int_distribution<int>(0, live.size() - 1)(generator);
+      allocator.free_interval(live[idx].first, live[idx].second);
+
+      len = length(generator);
+      loc = allocator.allocate_interval(len);
+      if (loc != -1)
+        {
+          live[idx] = std::make_pair(loc, len);
+        }
+      else
+        {
+          live[idx] = live.back();
+          live.pop_back();
+          ++failed;
+        }
+    }
+  churn_us = timer.restart_us();
+
+  std::cout << label << ":\n"
+            << "\tfill: " << fill_us << " us\n"
+            << "\tchurn: " << churn_us << " us ("
+            << static_cast<double>(churn_us) * 1000.0 / static_cast<double>(P.m_iterations.value())
+            << " ns per free/allocate pair)\n"
+            << "\tfailed allocations: " << failed << "\n"
+            << "\tlargest free interval at end: " << allocator.largest_free_interval() << "\n";
+}
+
+int
+main(int argc, char **argv)
+{
+  benchmark_params P;
+
+  if (argc == 2 && std::string(argv[1]) == "-help")
+    {
+      std::cout << "\n\nUsage: " << argv[0];
+      P.print_help(std::cout);
+      P.print_detailed_help(std::cout);
+      return 0;
+    }
+
+  P.parse_command_line(argc, argv);
+  std::cout << "\n\n";
+
+  run_benchmark<fastuidraw::interval_allocator>("interval_allocator", P);
+  run_benchmark<fastuidraw::segregated_interval_allocator>("segregated_interval_allocator", P);
+
+  return 0;
+}
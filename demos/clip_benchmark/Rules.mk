@@ -0,0 +1,16 @@
+# Begin standard header
+sp 		:= $(sp).x
+dirstack_$(sp)	:= $(d)
+d		:= $(dir)
+# End standard header
+
+# the clipping routines are private to the library, so
+# the benchmark compiles their sources directly
+DEMOS += clip-benchmark
+clip-benchmark_SOURCES := $(call filelist, main.cpp) \
+	src/fastuidraw/private/clip.cpp
+
+# Begin standard footer
+d		:= $(dirstack_$(sp))
+sp		:= $(basename $(sp))
+# End standard footer
@@ -0,0 +1,166 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include "generic_command_line.hpp"
+#include "simple_time.hpp"
+#include "../../src/fastuidraw/private/clip.hpp"
+
+/* Benchmark of clipping convex polygons against clip equations
+ * with the std::vector based detail::clip_against_planes()
+ * against the batched detail::clip_against_planes() that uses
+ * detail::ClipWorkRoom. The clip equations are the four sides
+ * of the square [-1, 1]x[-1, 1], which is what Painter clips
+ * against, and the polygons are regular polygons placed so that
+ * some are unclipped, some are partially clipped and some are
+ * completely clipped. Both variants see exactly the same input
+ * and the outputs are compared.
+ */
+
+class benchmark_params:public command_line_register
+{
+public:
+  benchmark_params(void):
+    m_num_polygons(4096, "num_polygons", "number of polygons to clip per point count", *this),
+    m_iterations(256, "iterations", "number of times to clip each polygon", *this),
+    m_min_points(4, "min_points", "minimum number of points of a polygon", *this),
+    m_max_points(16, "max_points", "maximum number of points of a polygon", *this),
+    m_seed(101, "seed", "seed of the random number generator", *this)
+  {}
+
+  command_line_argument_value<int> m_num_polygons;
+  command_line_argument_value<int> m_iterations;
+  command_line_argument_value<int> m_min_points;
+  command_line_argument_value<int> m_max_points;
+  command_line_argument_value<int> m_seed;
+};
+
+void
+make_polygons(std::mt19937 &generator, unsigned int num_pts,
+              unsigned int num_polygons,
+              std::vector<fastuidraw::vec2> &dst)
+{
+  std::uniform_real_distribution<float> center(-2.0f, 2.0f);
+  std::uniform_real_distribution<float> radius(0.1f, 1.5f);
+  std::uniform_real_distribution<float> angle(0.0f, 2.0f * static_cast<float>(M_PI));
+
+  dst.clear();
+  for (unsigned int p = 0; p < num_polygons; ++p)
+    {
+      fastuidraw::vec2 c(center(generator), center(generator));
+      float r(radius(generator)), theta0(angle(generator));
+
+      for (unsigned int i = 0; i < num_pts; ++i)
+        {
+          float theta;
+
+          theta = theta0 + 2.0f * static_cast<float>(M_PI) * static_cast<float>(i) / static_cast<float>(num_pts);
+          dst.push_back(c + r * fastuidraw::vec2(std::cos(theta), std::sin(theta)));
+        }
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  using namespace fastuidraw;
+
+  benchmark_params P;
+
+  if (argc == 2 && std::string(argv[1]) == "-help")
+    {
+      std::cout << "\n\nUsage: " << argv[0];
+      P.print_help(std::cout);
+      P.print_detailed_help(std::cout);
+      return 0;
+    }
+
+  P.parse_command_line(argc, argv);
+  std::cout << "\n\n";
+
+  vecN<vec3, 4> clip_eqs;
+  std::mt19937 generator(P.m_seed.value());
+  std::vector<vec2> polygons, out_pts;
+  vecN<std::vector<vec2>, 2> scratch;
+  detail::ClipWorkRoom work_room;
+  unsigned int num_polygons(P.m_num_polygons.value());
+
+  clip_eqs[0] = vec3(1.0f, 0.0f, 1.0f);
+  clip_eqs[1] = vec3(-1.0f, 0.0f, 1.0f);
+  clip_eqs[2] = vec3(0.0f, 1.0f, 1.0f);
+  clip_eqs[3] = vec3(0.0f, -1.0f, 1.0f);
+
+  for (int num_pts = P.m_min_points.value(); num_pts <= P.m_max_points.value(); ++num_pts)
+    {
+      int64_t vector_us, batched_us;
+      unsigned int mismatches(0), vector_total(0), batched_total(0);
+      simple_time timer;
+
+      make_polygons(generator, num_pts, num_polygons, polygons);
+      c_array<const vec2> all_polygons(&polygons[0], polygons.size());
+
+      timer.restart_us();
+      for (int iter = 0; iter < P.m_iterations.value(); ++iter)
+        {
+          for (unsigned int p = 0; p < num_polygons; ++p)
+            {
+              c_array<const vec2> poly;
+
+              poly = all_polygons.sub_array(p * num_pts, num_pts);
+              detail::clip_against_planes(clip_eqs, poly, out_pts, scratch);
+              vector_total += out_pts.size();
+            }
+        }
+      vector_us = timer.restart_us();
+
+      for (int iter = 0; iter < P.m_iterations.value(); ++iter)
+        {
+          for (unsigned int p = 0; p < num_polygons; ++p)
+            {
+              c_array<const vec2> poly, clipped;
+
+              poly = all_polygons.sub_array(p * num_pts, num_pts);
+              detail::clip_against_planes(clip_eqs, poly, &clipped, work_room);
+              batched_total += clipped.size();
+            }
+        }
+      batched_us = timer.restart_us();
+
+      for (unsigned int p = 0; p < num_polygons; ++p)
+        {
+          c_array<const vec2> poly, clipped;
+          bool r0, r1;
+
+          poly = all_polygons.sub_array(p * num_pts, num_pts);
+          r0 = detail::clip_against_planes(clip_eqs, poly, out_pts, scratch);
+          r1 = detail::clip_against_planes(clip_eqs, poly, &clipped, work_room);
+          if (r0 != r1 || clipped.size() != out_pts.size())
+            {
+              ++mismatches;
+              continue;
+            }
+          for (unsigned int i = 0; i < clipped.size(); ++i)
+            {
+              if (clipped[i] != out_pts[i])
+                {
+                  ++mismatches;
+                  break;
+                }
+            }
+        }
+
+      std::cout << num_pts << " points:\n"
+                << "\tstd::vector: " << vector_us << " us ("
+                << static_cast<double>(vector_us) * 1000.0
+                / static_cast<double>(P.m_iterations.value() * num_polygons)
+                << " ns per polygon)\n"
+                << "\tbatched: " << batched_us << " us ("
+                << static_cast<double>(batched_us) * 1000.0
+                / static_cast<double>(P.m_iterations.value() * num_polygons)
+                << " ns per polygon)\n"
+                << "\toutput points: " << vector_total << " vs " << batched_total << "\n"
+                << "\tmismatched polygons: " << mismatches << "\n";
+    }
+
+  return 0;
+}
@@ -12,6 +12,8 @@
    ]] marks the end of a sequence of control points
    arc marks an arc edge, the next value is the angle in degres
    value0 value1 marks a coordinate (control point of edge point)
+
+   The parsing is done by fastuidraw::PathStreamReader.
  */
 void
 read_path(fastuidraw::Path &path, const std::string &source);
@@ -1,89 +1,11 @@
 #include <string>
 #include <algorithm>
-#include <mutex>
+#include <thread>
 #include <sstream>
-#include <dirent.h>
 #include "text_helper.hpp"
 
 namespace
 {
-  /* The purpose of the DaaBufferHolder is to -DELAY-
-   * the loading of data until the first time the data
-   * is requested.
-   */
-  class DataBufferLoader:public fastuidraw::reference_counted<DataBufferLoader>::default_base
-  {
-  public:
-    explicit
-    DataBufferLoader(const std::string &pfilename):
-      m_filename(pfilename)
-    {}
-
-    fastuidraw::reference_counted_ptr<fastuidraw::DataBufferBase>
-    buffer(void)
-    {
-      fastuidraw::reference_counted_ptr<fastuidraw::DataBufferBase> R;
-
-      m_mutex.lock();
-      if (!m_buffer)
-        {
-          m_buffer = FASTUIDRAWnew fastuidraw::DataBuffer(m_filename.c_str());
-        }
-      R = m_buffer;
-      m_mutex.unlock();
-
-      return R;
-    }
-
-  private:
-    std::string m_filename;
-    std::mutex m_mutex;
-    fastuidraw::reference_counted_ptr<fastuidraw::DataBufferBase> m_buffer;
-  };
-
-  class FreeTypeFontGenerator:public fastuidraw::GlyphSelector::FontGeneratorBase
-  {
-  public:
-    FreeTypeFontGenerator(fastuidraw::reference_counted_ptr<DataBufferLoader> buffer,
-                          fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> lib,
-                          fastuidraw::FontFreeType::RenderParams render_params,
-                          int face_index,
-                          const fastuidraw::FontProperties &props):
-      m_buffer(buffer),
-      m_lib(lib),
-      m_render_params(render_params),
-      m_face_index(face_index),
-      m_props(props)
-    {}
-
-    virtual
-    fastuidraw::reference_counted_ptr<const fastuidraw::FontBase>
-    generate_font(void) const
-    {
-      fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeFace::GeneratorBase> h;
-      fastuidraw::reference_counted_ptr<fastuidraw::DataBufferBase> buffer;
-      fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> font;
-      buffer = m_buffer->buffer();
-      h = FASTUIDRAWnew fastuidraw::FreeTypeFace::GeneratorMemory(buffer, m_face_index);
-      font = FASTUIDRAWnew fastuidraw::FontFreeType(h, m_props, m_render_params, m_lib);
-      return font;
-    }
-
-    virtual
-    const fastuidraw::FontProperties&
-    font_properties(void) const
-    {
-      return m_props;
-    }
-
-  private:
-    fastuidraw::reference_counted_ptr<DataBufferLoader> m_buffer;
-    fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> m_lib;
-    fastuidraw::FontFreeType::RenderParams m_render_params;
-    int m_face_index;
-    fastuidraw::FontProperties m_props;
-  };
-
   void
   preprocess_text(std::string &text)
   {
@@ -104,56 +26,6 @@ namespace
       }
     text.swap(v);
   }
-
-  void
-  add_fonts_from_file(const std::string &filename,
-                      fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> lib,
-                      fastuidraw::reference_counted_ptr<fastuidraw::GlyphSelector> glyph_selector,
-                      fastuidraw::FontFreeType::RenderParams render_params)
-  {
-    FT_Error error_code;
-    FT_Face face(nullptr);
-
-    lib->lock();
-    error_code = FT_New_Face(lib->lib(), filename.c_str(), 0, &face);
-    lib->unlock();
-
-    if (error_code == 0 && face != nullptr && (face->face_flags & FT_FACE_FLAG_SCALABLE) != 0)
-      {
-        fastuidraw::reference_counted_ptr<DataBufferLoader> buffer_loader;
-
-        buffer_loader = FASTUIDRAWnew DataBufferLoader(filename);
-        for(unsigned int i = 0, endi = face->num_faces; i < endi; ++i)
-          {
-            fastuidraw::reference_counted_ptr<fastuidraw::GlyphSelector::FontGeneratorBase> h;
-            std::ostringstream source_label;
-            fastuidraw::FontProperties props;
-            if (i != 0)
-              {
-                lib->lock();
-                FT_Done_Face(face);
-                FT_New_Face(lib->lib(), filename.c_str(), i, &face);
-                lib->unlock();
-              }
-            fastuidraw::FontFreeType::compute_font_properties_from_face(face, props);
-            source_label << filename << ":" << i;
-            props.source_label(source_label.str().c_str());
-
-            h = FASTUIDRAWnew FreeTypeFontGenerator(buffer_loader, lib, render_params, i, props);
-            glyph_selector->add_font_generator(h);
-
-            //std::cout << "add font: " << props << "\n";
-          }
-      }
-
-    lib->lock();
-    if (face != nullptr)
-      {
-        FT_Done_Face(face);
-      }
-    lib->unlock();
-  }
-
 }
 
 /////////////////////////////
@@ -385,31 +257,28 @@ create_formatted_text(std::istream &istr, fastuidraw::GlyphRender renderer,
 }
 
 void
-add_fonts_from_path(const std::string &filename,
+add_fonts_from_path(const std::string &path,
                     fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> lib,
                     fastuidraw::reference_counted_ptr<fastuidraw::GlyphSelector> glyph_selector,
-                    fastuidraw::FontFreeType::RenderParams render_params)
+                    fastuidraw::FontFreeType::RenderParams render_params,
+                    const std::string &cache_file)
 {
-  DIR *dir;
-  struct dirent *entry;
+  fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeFontRegistry> registry;
 
-  dir = opendir(filename.c_str());
-  if (!dir)
+  registry = FASTUIDRAWnew fastuidraw::FreeTypeFontRegistry(lib, render_params);
+  registry->number_threads(std::thread::hardware_concurrency());
+  if (!cache_file.empty())
     {
-      add_fonts_from_file(filename, lib, glyph_selector, render_params);
-      return;
+      registry->load_cache(cache_file.c_str());
     }
 
-  for(entry = readdir(dir); entry != nullptr; entry = readdir(dir))
+  registry->add_path(path.c_str());
+  registry->register_fonts(*glyph_selector);
+
+  if (!cache_file.empty())
     {
-      std::string file;
-      file = entry->d_name;
-      if (file != ".." && file != ".")
-        {
-          add_fonts_from_path(filename + "/" + file, lib, glyph_selector, render_params);
-        }
+      registry->save_cache(cache_file.c_str());
     }
-  closedir(dir);
 }
 
 fastuidraw::c_string
@@ -10,6 +10,7 @@
 #include <fastuidraw/util/vecN.hpp>
 #include <fastuidraw/text/glyph_selector.hpp>
 #include <fastuidraw/text/font_freetype.hpp>
+#include <fastuidraw/text/freetype_font_registry.hpp>
 #include <fastuidraw/painter/painter_enums.hpp>
 
 #include "cast_c_array.hpp"
@@ -87,7 +88,8 @@ void
 add_fonts_from_path(const std::string &path,
                     fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> lib,
                     fastuidraw::reference_counted_ptr<fastuidraw::GlyphSelector> glyph_selector,
-                    fastuidraw::FontFreeType::RenderParams render_params);
+                    fastuidraw::FontFreeType::RenderParams render_params,
+                    const std::string &cache_file = std::string());
 
 fastuidraw::c_string
 default_font(void);
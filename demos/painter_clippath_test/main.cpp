@@ -1,6 +1,7 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <cmath>
 
 #include "sdl_painter_demo.hpp"
 #include "simple_time.hpp"
@@ -51,6 +52,15 @@ private:
       number_zoomers
     };
 
+  enum
+    {
+      no_boolean_shape,
+      pentagram_shape,
+      double_wound_shape,
+
+      number_boolean_shapes
+    };
+
   void
   draw_element(const Path &path, unsigned int clip_mode, const vec4 &pen_color,
                const float3x3 &matrix);
@@ -61,16 +71,27 @@ private:
   void
   make_paths(void);
 
+  void
+  draw_boolean_shape(void);
+
   command_line_argument_value<std::string> m_path1_file;
   command_line_argument_value<std::string> m_path2_file;
 
   Path m_path1, m_path2;
 
+  /* odd-even regions of self-intersecting single contours,
+   * the centre of each must stay empty
+   */
+  Path m_pentagram, m_double_wound;
+  PathBoolean m_pentagram_boolean, m_double_wound_boolean;
+
   unsigned int m_path1_clip_mode, m_path2_clip_mode;
   unsigned int m_active_zoomer;
+  unsigned int m_boolean_shape;
   vecN<PanZoomTrackerSDLEvent, number_zoomers> m_zoomers;
   vecN<std::string, number_clip_modes> m_clip_labels;
   vecN<std::string, number_zoomers> m_zoomer_labels;
+  vecN<std::string, number_boolean_shapes> m_boolean_shape_labels;
 };
 
 painter_clip_test::
@@ -85,12 +106,14 @@ painter_clip_test():
                *this),
   m_path1_clip_mode(no_clip),
   m_path2_clip_mode(no_clip),
-  m_active_zoomer(view_zoomer)
+  m_active_zoomer(view_zoomer),
+  m_boolean_shape(no_boolean_shape)
 {
   std::cout << "Controls:\n"
             << "\t1: cycle through clip modes for path1\n"
             << "\t2: cycle through clip modes for path2\n"
-            << "\ts: cycle through active zoomer controls\n";
+            << "\ts: cycle through active zoomer controls\n"
+            << "\tp: cycle through drawing odd-even PathBoolean of a self-intersecting contour\n";
 
   m_clip_labels[clip_in] = "clip_in";
   m_clip_labels[clip_out] = "clip_out";
@@ -99,6 +122,10 @@ painter_clip_test():
   m_zoomer_labels[view_zoomer] = "view_zoomer";
   m_zoomer_labels[path1_zoomer] = "path1_zoomer";
   m_zoomer_labels[path2_zoomer] = "path2_zoomer";
+
+  m_boolean_shape_labels[no_boolean_shape] = "no_boolean_shape";
+  m_boolean_shape_labels[pentagram_shape] = "pentagram_shape";
+  m_boolean_shape_labels[double_wound_shape] = "double_wound_shape";
 }
 
 void
@@ -147,6 +174,10 @@ handle_event(const SDL_Event &ev)
           cycle_value(m_active_zoomer, ev.key.keysym.mod & (KMOD_SHIFT|KMOD_CTRL|KMOD_ALT), number_zoomers);
           std::cout << "Active zoomer set to: " << m_zoomer_labels[m_active_zoomer] << "\n";
           break;
+        case SDLK_p:
+          cycle_value(m_boolean_shape, ev.key.keysym.mod & (KMOD_SHIFT|KMOD_CTRL|KMOD_ALT), number_boolean_shapes);
+          std::cout << "Boolean shape set to: " << m_boolean_shape_labels[m_boolean_shape] << "\n";
+          break;
         }
       break;
     };
@@ -192,7 +223,34 @@ make_paths(void)
               << Path::contour_end();
     }
 
+  /* pentagram: a single contour through every other
+   * vertex of a regular pentagon
+   */
+  for (unsigned int i = 0; i < 5; ++i)
+    {
+      float t;
+
+      t = float(2 * i) * 2.0f * static_cast<float>(M_PI) / 5.0f;
+      m_pentagram << vec2(300.0f + 100.0f * std::sin(t), 300.0f - 100.0f * std::cos(t));
+    }
+  m_pentagram << Path::contour_end();
+  m_pentagram_boolean.set(m_pentagram, PainterEnums::odd_even_fill_rule);
+
+  /* a single contour winding twice around its first point; every
+   * triangle of the fan from that point has the same orientation,
+   * so the tessellator's fan shortcut would accept it
+   */
+  m_double_wound << vec2(300.0f, 300.0f);
+  for (unsigned int i = 0; i < 24; ++i)
+    {
+      float t, r;
 
+      t = 0.1f + float(i) * (4.0f * static_cast<float>(M_PI) - 0.2f) / 23.0f;
+      r = (i < 12) ? 100.0f : 60.0f;
+      m_double_wound << vec2(300.0f + r * std::cos(t), 300.0f + r * std::sin(t));
+    }
+  m_double_wound << Path::contour_end();
+  m_double_wound_boolean.set(m_double_wound, PainterEnums::odd_even_fill_rule);
 }
 
 
@@ -238,6 +296,33 @@ draw_element(const Path &path, unsigned int clip_mode, const vec4 &pen_color,
   m_painter->restore();
 }
 
+void
+painter_clip_test::
+draw_boolean_shape(void)
+{
+  const PathBoolean *boolean;
+  PainterBrush brush;
+
+  switch(m_boolean_shape)
+    {
+    default:
+      return;
+
+    case pentagram_shape:
+      boolean = &m_pentagram_boolean;
+      break;
+    case double_wound_shape:
+      boolean = &m_double_wound_boolean;
+      break;
+    }
+
+  m_painter->save();
+  brush.pen(0.0f, 0.0f, 1.0f, 1.0f);
+  m_painter->clipInPath(*boolean);
+  m_painter->draw_rect(PainterData(&brush), vec2(150.0f, 150.0f), vec2(300.0f, 300.0f));
+  m_painter->restore();
+}
+
 void
 painter_clip_test::
 draw_frame(void)
@@ -255,6 +340,8 @@ draw_frame(void)
   draw_element(m_path2, m_path2_clip_mode, vec4(0.0f, 1.0f, 0.0f, 1.0f),
                m_zoomers[path2_zoomer].transformation().matrix3());
 
+  draw_boolean_shape();
+
   m_painter->end();
   glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
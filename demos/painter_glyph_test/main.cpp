@@ -144,7 +144,7 @@ private:
   float
   update_cts_params(void);
 
-  command_line_argument_value<std::string> m_font_path;
+  command_line_argument_value<std::string> m_font_path, m_font_cache;
   command_line_argument_value<std::string> m_font_style, m_font_family;
   command_line_argument_value<bool> m_font_bold, m_font_italic;
   command_line_argument_value<std::string> m_font_file;
@@ -428,6 +428,10 @@ data(unsigned int I) const
 painter_glyph_test::
 painter_glyph_test(void):
   m_font_path(default_font_path(), "font_path", "Specifies path in which to search for fonts", *this),
+  m_font_cache("", "font_cache",
+               "If non-empty gives the name of a file in which to cache the properties "
+               "of the fonts found in font_path so that they are not opened on later runs",
+               *this),
   m_font_style("Book", "font_style", "Specifies the font style", *this),
   m_font_family("DejaVu Sans", "font_family", "Specifies the font family name", *this),
   m_font_bold(false, "font_bold", "if true select a bold font", *this),
@@ -524,7 +528,8 @@ create_and_add_font(void)
                       FontFreeType::RenderParams()
                       .distance_field_max_distance(m_max_distance.value())
                       .distance_field_pixel_size(m_distance_pixel_size.value())
-                      .curve_pair_pixel_size(m_curve_pair_pixel_size.value()));
+                      .curve_pair_pixel_size(m_curve_pair_pixel_size.value()),
+                      m_font_cache.value());
 
   if (!font)
     {
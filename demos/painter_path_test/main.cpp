@@ -222,6 +222,19 @@ private:
   void
   update_cts_params(void);
 
+  /* returns 0 if the scene fills the path with anti-aliasing
+   * drawn by fuzz, 1 if by analytic coverage and -1 if the
+   * scene does not fill with either.
+   */
+  int
+  aa_fill_mode(void);
+
+  /* returns true if the default fill shader has the shader
+   * to fill the current fill rule by analytic coverage.
+   */
+  bool
+  analytic_coverage_available(void);
+
   PanZoomTrackerSDLEvent&
   zoomer(void)
   {
@@ -438,8 +451,19 @@ private:
   bool m_stroke_width_in_pixels;
 
   bool m_fill_by_clipping;
+  bool m_fill_by_stencil_cover;
+  bool m_aa_fill_by_analytic_coverage;
   bool m_draw_grid;
 
+  /* total frame time in ms and number of frames drawn with
+   * the path filled with anti-aliasing by fuzz (index 0)
+   * and by analytic coverage (index 1), see aa_fill_mode();
+   * reset when a different path is selected.
+   */
+  vecN<float, 2> m_aa_fill_ms;
+  vecN<unsigned int, 2> m_aa_fill_frames;
+  int m_prev_aa_fill_mode;
+
   simple_time m_draw_timer, m_fps_timer;
   Path m_grid_path;
   bool m_grid_path_dirty;
@@ -581,7 +605,12 @@ painter_stroke_test(void):
   m_wire_frame(false),
   m_stroke_width_in_pixels(false),
   m_fill_by_clipping(false),
+  m_fill_by_stencil_cover(false),
+  m_aa_fill_by_analytic_coverage(false),
   m_draw_grid(false),
+  m_aa_fill_ms(0.0f, 0.0f),
+  m_aa_fill_frames(0u, 0u),
+  m_prev_aa_fill_mode(-1),
   m_grid_path_dirty(true),
   m_clip_window_path_dirty(true)
 {
@@ -609,6 +638,8 @@ painter_stroke_test(void):
             << "\tf: toggle drawing path fill\n"
             << "\tr: cycle through fill rules\n"
             << "\te: toggle fill by drawing clip rect\n"
+            << "\t8: toggle fill by stencil-then-cover\n"
+            << "\tctrl-u: toggle AA fill by analytic coverage instead of fuzz\n"
             << "\ti: cycle through image filter to apply to fill (no image, nearest, linear, cubic)\n"
             << "\tctrl-i: toggle mipmap filtering when applying an image\n"
             << "\ts: cycle through defined color stops for gradient\n"
@@ -664,6 +695,39 @@ painter_stroke_test(void):
 }
 
 
+int
+painter_stroke_test::
+aa_fill_mode(void)
+{
+  if (!m_draw_fill || !m_with_aa || m_aa_fill_by_stroking
+      || m_fill_by_clipping || m_fill_by_stencil_cover)
+    {
+      return -1;
+    }
+
+  if (m_aa_fill_by_analytic_coverage && analytic_coverage_available())
+    {
+      return 1;
+    }
+
+  return 0;
+}
+
+bool
+painter_stroke_test::
+analytic_coverage_available(void)
+{
+  enum PainterEnums::fill_rule_t r;
+
+  if (current_fill_rule() >= PainterEnums::fill_rule_data_count)
+    {
+      return false;
+    }
+
+  r = static_cast<PainterEnums::fill_rule_t>(current_fill_rule());
+  return m_painter->default_shaders().fill_shader().aa_analytic_shader(r);
+}
+
 void
 painter_stroke_test::
 update_cts_params(void)
@@ -1037,6 +1101,8 @@ handle_event(const SDL_Event &ev)
         case SDLK_k:
           cycle_value(m_selected_path, ev.key.keysym.mod & (KMOD_SHIFT|KMOD_CTRL|KMOD_ALT), m_paths.size());
           std::cout << "Path " << m_paths[m_selected_path].m_label << " selected\n";
+          m_aa_fill_ms = vecN<float, 2>(0.0f, 0.0f);
+          m_aa_fill_frames = vecN<unsigned int, 2>(0u, 0u);
           m_clip_window_path_dirty = true;
           break;
 
@@ -1259,6 +1325,22 @@ handle_event(const SDL_Event &ev)
             }
           break;
 
+        case SDLK_8:
+          if (m_draw_fill)
+            {
+              m_fill_by_stencil_cover = !m_fill_by_stencil_cover;
+              std::cout << "Set to ";
+              if (m_fill_by_stencil_cover)
+                {
+                  std::cout << "fill by stencil-then-cover\n";
+                }
+              else
+                {
+                  std::cout << "fill by drawing FilledPath\n";
+                }
+            }
+          break;
+
         case SDLK_f:
           m_draw_fill = !m_draw_fill;
           std::cout << "Set to ";
@@ -1270,7 +1352,26 @@ handle_event(const SDL_Event &ev)
           break;
 
         case SDLK_u:
-          if (m_draw_fill & m_with_aa)
+          if (m_draw_fill && m_with_aa && (ev.key.keysym.mod & (KMOD_CTRL|KMOD_ALT)))
+            {
+              m_aa_fill_by_analytic_coverage = !m_aa_fill_by_analytic_coverage;
+              std::cout << "Set to AA fill by ";
+              if (m_aa_fill_by_analytic_coverage)
+                {
+                  std::cout << "analytic coverage\n";
+                  if (!analytic_coverage_available())
+                    {
+                      std::cout << "\tNote: the default fill shader has no analytic coverage "
+                                << "shader for the fill rule, build with "
+                                << "FASTUIDRAW_ANALYTIC_FILL_AA to have them\n";
+                    }
+                }
+              else
+                {
+                  std::cout << "drawing fuzz\n";
+                }
+            }
+          else if (m_draw_fill & m_with_aa)
             {
               m_aa_fill_by_stroking = !m_aa_fill_by_stroking;
               std::cout << "Set to ";
@@ -1681,6 +1782,22 @@ draw_scene(bool drawing_wire_frame)
           m_painter->draw_rect(D, vec2(-1.0f, -1.0f), vec2(2.0f, 2.0f));
           m_painter->restore();
         }
+      else if (m_fill_by_stencil_cover && current_fill_rule() < PainterEnums::fill_rule_data_count)
+        {
+          enum PainterEnums::fill_rule_t r;
+          r = static_cast<PainterEnums::fill_rule_t>(current_fill_rule());
+          m_painter->fill_path_stencil_cover(D, path(), r);
+        }
+      else if (!m_aa_fill_by_analytic_coverage && analytic_coverage_available())
+        {
+          enum PainterEnums::fill_rule_t r;
+          PainterFillShader fill_shader(m_painter->default_shaders().fill_shader());
+
+          /* without the analytic shader, the fill draws the fuzz */
+          r = static_cast<PainterEnums::fill_rule_t>(current_fill_rule());
+          fill_shader.aa_analytic_shader(r, reference_counted_ptr<PainterItemShader>());
+          m_painter->fill_path(fill_shader, D, path(), r, m_with_aa && !m_aa_fill_by_stroking);
+        }
       else
         {
           m_painter->fill_path(D, path(), *fill_rule, m_with_aa && !m_aa_fill_by_stroking);
@@ -1820,6 +1937,14 @@ draw_frame(void)
 
   us = static_cast<float>(m_fps_timer.restart_us());
 
+  /* the time measured is of the previous frame */
+  if (m_prev_aa_fill_mode >= 0)
+    {
+      m_aa_fill_ms[m_prev_aa_fill_mode] += us / 1000.0f;
+      ++m_aa_fill_frames[m_prev_aa_fill_mode];
+    }
+  m_prev_aa_fill_mode = aa_fill_mode();
+
   update_cts_params();
   vwp.m_dimensions = wh;
 
@@ -1921,7 +2046,23 @@ draw_frame(void)
            << m_painter->query_stat(PainterPacker::num_indices)
            << "\nGenericData: "
            << m_painter->query_stat(PainterPacker::num_generic_datas)
-           << "\nPainter Z: " << m_painter->current_z()
+           << "\nPacked bytes: "
+           << m_painter->query_stat(PainterPacker::num_attributes) * sizeof(PainterAttribute)
+           + m_painter->query_stat(PainterPacker::num_indices) * sizeof(PainterIndex);
+      for (unsigned int i = 0; i < 2; ++i)
+        {
+          ostr << ((i == 0) ? "\nAA fill by fuzz ms: " : "\nAA fill by analytic ms: ");
+          if (m_aa_fill_frames[i] > 0)
+            {
+              ostr << m_aa_fill_ms[i] / static_cast<float>(m_aa_fill_frames[i])
+                   << " (" << m_aa_fill_frames[i] << " frames)";
+            }
+          else
+            {
+              ostr << "NAN";
+            }
+        }
+      ostr << "\nPainter Z: " << m_painter->current_z()
            << "\nMouse position:"
            << item_coordinates(mouse_position)
            << "\ncurveFlatness: " << m_curve_flatness
@@ -0,0 +1,141 @@
+/*!
+ * \file colorstop_atlas_cpu.hpp
+ * \brief file colorstop_atlas_cpu.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/colorstop_atlas.hpp>
+
+namespace fastuidraw
+{
+namespace cpu
+{
+/*!\addtogroup CPUBackend
+ * @{
+ */
+
+  /*!
+   * \brief
+   * A ColorStopAtlasCPU is the CPU backend implementation
+   * for \ref ColorStopAtlas. The backing store is an array
+   * in system memory.
+   */
+  class ColorStopAtlasCPU:public ColorStopAtlas
+  {
+  public:
+    /*!
+     * \brief
+     * Class to hold the construction parameters for creating
+     * a ColorStopAtlasCPU.
+     */
+    class params
+    {
+    public:
+      /*!
+       * Ctor.
+       */
+      params(void);
+
+      /*!
+       * Copy ctor.
+       * \param obj value from which to copy
+       */
+      params(const params &obj);
+
+      ~params();
+
+      /*!
+       * Assignment operator.
+       * \param rhs value from which to copy
+       */
+      params&
+      operator=(const params &rhs);
+
+      /*!
+       * Swap operation
+       * \param obj object with which to swap
+       */
+      void
+      swap(params &obj);
+
+      /*!
+       * width of the backing store, initial value is 1024
+       */
+      int
+      width(void) const;
+
+      /*!
+       * Set the value for width(void) const
+       */
+      params&
+      width(int v);
+
+      /*!
+       * number of layers of the backing store, initial
+       * value is 32
+       */
+      int
+      num_layers(void) const;
+
+      /*!
+       * Set the value for num_layers(void) const
+       */
+      params&
+      num_layers(int v);
+
+    private:
+      void *m_d;
+    };
+
+    /*!
+     * Ctor.
+     * \param P parameters of construction.
+     */
+    explicit
+    ColorStopAtlasCPU(const params &P);
+
+    ~ColorStopAtlasCPU();
+
+    /*!
+     * Returns the params value used to construct
+     * the ColorStopAtlasCPU.
+     */
+    const params&
+    param_values(void);
+
+    /*!
+     * Fetch a value from the backing store with linear
+     * filtering, the sample locations are clamped
+     * to the edge of the backing store. May be called
+     * from multiple threads provided the atlas is not
+     * being modified.
+     * \param x texel coordinate (i.e. texel centers are at
+     *          half-integers) of the fetch
+     * \param layer layer from which to fetch
+     */
+    vec4
+    fetch(float x, int layer) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+
+}
+
+}
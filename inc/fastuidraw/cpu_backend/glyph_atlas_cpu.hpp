@@ -0,0 +1,172 @@
+/*!
+ * \file glyph_atlas_cpu.hpp
+ * \brief file glyph_atlas_cpu.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/text/glyph_atlas.hpp>
+
+namespace fastuidraw
+{
+namespace cpu
+{
+/*!\addtogroup CPUBackend
+ * @{
+ */
+
+  /*!
+   * \brief
+   * A GlyphAtlasCPU is the CPU backend implementation
+   * for \ref GlyphAtlas. Both the texel and geometry
+   * stores are arrays in system memory.
+   */
+  class GlyphAtlasCPU:public GlyphAtlas
+  {
+  public:
+    /*!
+     * \brief
+     * Class to hold the construction parameters for creating
+     * a GlyphAtlasCPU.
+     */
+    class params
+    {
+    public:
+      /*!
+       * Ctor.
+       */
+      params(void);
+
+      /*!
+       * Copy ctor.
+       * \param obj value from which to copy
+       */
+      params(const params &obj);
+
+      ~params();
+
+      /*!
+       * Assignment operator.
+       * \param obj value from which to copy
+       */
+      params&
+      operator=(const params &obj);
+
+      /*!
+       * Swap operation
+       * \param obj object with which to swap
+       */
+      void
+      swap(params &obj);
+
+      /*!
+       * Dimensions of the texel store, initial
+       * value is (1024, 1024, 4).
+       */
+      ivec3
+      texel_store_dimensions(void) const;
+
+      /*!
+       * Set the value for texel_store_dimensions(void) const
+       */
+      params&
+      texel_store_dimensions(ivec3 v);
+
+      /*!
+       * Number of floats that the geometry store holds,
+       * initial value is 256 * 1024.
+       */
+      unsigned int
+      number_floats(void) const;
+
+      /*!
+       * Set the value for number_floats(void) const
+       */
+      params&
+      number_floats(unsigned int v);
+
+      /*!
+       * Alignment of the geometry store, initial value is 4.
+       */
+      unsigned int
+      alignment(void) const;
+
+      /*!
+       * Set the value for alignment(void) const
+       */
+      params&
+      alignment(unsigned int v);
+
+      /*!
+       * Specifies how rectangles of texels are allocated from
+       * the texel store, initial value is \ref
+       * GlyphAtlas::tree_texel_allocator.
+       */
+      enum GlyphAtlas::texel_allocator_t
+      texel_allocator(void) const;
+
+      /*!
+       * Set the value for texel_allocator(void) const
+       */
+      params&
+      texel_allocator(enum GlyphAtlas::texel_allocator_t v);
+
+    private:
+      void *m_d;
+    };
+
+    /*!
+     * Ctor.
+     * \param P parameters of construction.
+     */
+    explicit
+    GlyphAtlasCPU(const params &P);
+
+    ~GlyphAtlasCPU();
+
+    /*!
+     * Returns the params value used to construct
+     * the GlyphAtlasCPU.
+     */
+    const params&
+    param_values(void) const;
+
+    /*!
+     * Fetch a texel from the texel store, the fetch
+     * location is clamped to the dimensions of the
+     * store. May be called from multiple threads
+     * provided the atlas is not being modified.
+     * \param x x-coordinate of the texel
+     * \param y y-coordinate of the texel
+     * \param layer layer of the texel
+     */
+    uint8_t
+    texel(int x, int y, int layer) const;
+
+    /*!
+     * Returns the contents of the geometry store.
+     */
+    c_array<const generic_data>
+    geometry_data(void) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+
+} //namespace cpu
+} //namespace fastuidraw
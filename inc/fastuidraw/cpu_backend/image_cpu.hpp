@@ -0,0 +1,225 @@
+/*!
+ * \file image_cpu.hpp
+ * \brief file image_cpu.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/image.hpp>
+
+namespace fastuidraw
+{
+namespace cpu
+{
+/*!\addtogroup CPUBackend
+ * @{
+ */
+
+  /*!
+   * \brief
+   * An ImageAtlasCPU is the CPU backend implementation
+   * for \ref ImageAtlas.
+   *
+   * An ImageAtlasCPU on creation, creates an
+   * \ref AtlasColorBackingStoreBase and an \ref AtlasIndexBackingStoreBase
+   * itself that are backed by arrays in system memory.
+   */
+  class ImageAtlasCPU:public ImageAtlas
+  {
+  public:
+    /*!
+     * \brief
+     * Class to hold the construction parameters for creating
+     * a ImageAtlasCPU.
+     */
+    class params
+    {
+    public:
+      /*!
+       * Ctor.
+       */
+      params(void);
+
+      /*!
+       * Copy ctor.
+       * \param obj value from which to copy
+       */
+      params(const params &obj);
+
+      ~params();
+
+      /*!
+       * Assignment operator.
+       * \param obj value from which to copy
+       */
+      params&
+      operator=(const params &obj);
+
+      /*!
+       * Swap operation
+       * \param obj object with which to swap
+       */
+      void
+      swap(params &obj);
+
+      /*!
+       * The log2 of the width and height of the color tile
+       * size, initial value is 5
+       */
+      int
+      log2_color_tile_size(void) const;
+
+      /*!
+       * Set the value for log2_color_tile_size(void) const
+       */
+      params&
+      log2_color_tile_size(int v);
+
+      /*!
+       * The log2 of the number of color tiles across and
+       * down per layer, initial value is 4. Effective
+       * value is clamped to 8.
+       */
+      int
+      log2_num_color_tiles_per_row_per_col(void) const;
+
+      /*!
+       * Set the value for log2_num_color_tiles_per_row_per_col(void) const
+       */
+      params&
+      log2_num_color_tiles_per_row_per_col(int v);
+
+      /*!
+       * The number of layers within the color store,
+       * initial value is 1
+       */
+      int
+      num_color_layers(void) const;
+
+      /*!
+       * Set the value for num_color_layers(void) const
+       */
+      params&
+      num_color_layers(int v);
+
+      /*!
+       * The log2 of the width and height of the index tile
+       * size, initial value is 2.
+       */
+      int
+      log2_index_tile_size(void) const;
+
+      /*!
+       * Set the value for log2_index_tile_size(void) const
+       */
+      params&
+      log2_index_tile_size(int v);
+
+      /*!
+       * The log2 of the number of index tiles across and down
+       * per layer, initial value is 6. Effective value is
+       * clamped to 8.
+       */
+      int
+      log2_num_index_tiles_per_row_per_col(void) const;
+
+      /*!
+       * Set the value for log2_num_index_tiles_per_row_per_col(void) const
+       */
+      params&
+      log2_num_index_tiles_per_row_per_col(int v);
+
+      /*!
+       * The number of layers within the index store,
+       * initial value is 4.
+       */
+      int
+      num_index_layers(void) const;
+
+      /*!
+       * Set the value for num_index_layers(void) const
+       */
+      params&
+      num_index_layers(int v);
+
+      /*!
+       * Specifies how the color store holds its texels, initial
+       * value is \ref AtlasColorBackingStoreBase::uncompressed.
+       * A compressed color store only holds the base mipmap
+       * level (as does an uncompressed one) and requires that
+       * log2_color_tile_size() is at least 2.
+       */
+      enum AtlasColorBackingStoreBase::compression_t
+      color_compression(void) const;
+
+      /*!
+       * Set the value for color_compression(void) const
+       */
+      params&
+      color_compression(enum AtlasColorBackingStoreBase::compression_t v);
+
+    private:
+      void *m_d;
+    };
+
+    /*!
+     * Ctor.
+     * \param P parameters of construction.
+     */
+    explicit
+    ImageAtlasCPU(const params &P);
+
+    ~ImageAtlasCPU(void);
+
+    /*!
+     * Returns the params value used to construct
+     * the ImageAtlasCPU.
+     */
+    const params&
+    param_values(void) const;
+
+    /*!
+     * Fetch a texel from the color store, the fetch
+     * location is clamped to the dimensions of the
+     * store. May be called from multiple threads
+     * provided the atlas is not being modified.
+     * \param x x-coordinate of the texel
+     * \param y y-coordinate of the texel
+     * \param layer layer of the texel
+     */
+    u8vec4
+    color_texel(int x, int y, int layer) const;
+
+    /*!
+     * Fetch a texel from the index store, the fetch
+     * location is clamped to the dimensions of the
+     * store. May be called from multiple threads
+     * provided the atlas is not being modified.
+     * \param x x-coordinate of the texel
+     * \param y y-coordinate of the texel
+     * \param layer layer of the texel
+     */
+    u8vec4
+    index_texel(int x, int y, int layer) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+
+} //namespace cpu
+} //namespace fastuidraw
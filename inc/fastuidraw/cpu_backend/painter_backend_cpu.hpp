@@ -0,0 +1,382 @@
+/*!
+ * \file painter_backend_cpu.hpp
+ * \brief file painter_backend_cpu.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <fastuidraw/painter/packing/painter_backend.hpp>
+#include <fastuidraw/cpu_backend/image_cpu.hpp>
+#include <fastuidraw/cpu_backend/glyph_atlas_cpu.hpp>
+#include <fastuidraw/cpu_backend/colorstop_atlas_cpu.hpp>
+#include <fastuidraw/cpu_backend/painter_item_shader_cpu.hpp>
+#include <fastuidraw/cpu_backend/painter_blend_shader_cpu.hpp>
+
+namespace fastuidraw
+{
+  namespace cpu
+  {
+/*!\addtogroup CPUBackend
+ * @{
+ */
+    /*!
+     * \brief
+     * A PainterBackendCPU implements PainterBackend
+     * with a software rasterizer that runs entirely on
+     * the CPU across a pool of threads.
+     *
+     * Drawing proceeds as follows. The vertices of a draw are
+     * shaded in parallel. The triangles are then set up and binned
+     * (in order) to the screen space tiles they touch and the tiles
+     * are rasterized in parallel; because each tile is owned by
+     * exactly one thread and processes its triangles in submission
+     * order, the results are identical to a serial rasterization.
+     *
+     * The shaders of a PainterBackendCPU must be derived from
+     * \ref PainterItemShaderCPU and \ref PainterBlendShaderCPU.
+     * The default shaders support filling (with and without
+     * anti-aliasing), non-dashed stroking (with and without
+     * anti-aliasing, line-segment tessellation only), coverage and
+     * distance field glyphs and the Porter-Duff blend modes. Dashed
+     * stroking, arc-stroking, curve-pair glyphs and the W3C blend
+     * modes are not supported (see unsupported_shaders()); draws
+     * using them are skipped and the first such draw of each is
+     * reported to std::cerr. Images are sampled from the base
+     * level only.
+     */
+    class PainterBackendCPU:public PainterBackend
+    {
+    public:
+      /*!
+       * \brief
+       * A ConfigurationCPU gives parameters how to create
+       * a PainterBackendCPU.
+       */
+      class ConfigurationCPU
+      {
+      public:
+        /*!
+         * Ctor.
+         */
+        ConfigurationCPU(void);
+
+        /*!
+         * Copy ctor.
+         * \param obj value from which to copy
+         */
+        ConfigurationCPU(const ConfigurationCPU &obj);
+
+        ~ConfigurationCPU();
+
+        /*!
+         * Assignment operator
+         * \param rhs value from which to copy
+         */
+        ConfigurationCPU&
+        operator=(const ConfigurationCPU &rhs);
+
+        /*!
+         * Swap operation
+         * \param obj object with which to swap
+         */
+        void
+        swap(ConfigurationCPU &obj);
+
+        /*!
+         * The ImageAtlasCPU to be used by the painter
+         */
+        const reference_counted_ptr<ImageAtlasCPU>&
+        image_atlas(void) const;
+
+        /*!
+         * Set the value returned by image_atlas(void) const.
+         */
+        ConfigurationCPU&
+        image_atlas(const reference_counted_ptr<ImageAtlasCPU> &v);
+
+        /*!
+         * The ColorStopAtlasCPU to be used by the painter
+         */
+        const reference_counted_ptr<ColorStopAtlasCPU>&
+        colorstop_atlas(void) const;
+
+        /*!
+         * Set the value returned by colorstop_atlas(void) const.
+         */
+        ConfigurationCPU&
+        colorstop_atlas(const reference_counted_ptr<ColorStopAtlasCPU> &v);
+
+        /*!
+         * The GlyphAtlasCPU to be used by the painter
+         */
+        const reference_counted_ptr<GlyphAtlasCPU>&
+        glyph_atlas(void) const;
+
+        /*!
+         * Set the value returned by glyph_atlas(void) const.
+         */
+        ConfigurationCPU&
+        glyph_atlas(const reference_counted_ptr<GlyphAtlasCPU> &v);
+
+        /*!
+         * Specifies the alignment in units of generic_data for
+         * packing of seperately accessible entries of generic data
+         * in PainterDraw::m_store. Initial value is 4.
+         */
+        int
+        alignment(void) const;
+
+        /*!
+         * Set the value returned by alignment(void) const.
+         */
+        ConfigurationCPU&
+        alignment(int);
+
+        /*!
+         * Specifies the maximum number of attributes
+         * a PainterDraw returned by map_draw() may store,
+         * i.e. the size of PainterDraw::m_attributes.
+         * Initial value is 512 * 512.
+         */
+        unsigned int
+        attributes_per_buffer(void) const;
+
+        /*!
+         * Set the value returned by attributes_per_buffer(void) const.
+         */
+        ConfigurationCPU&
+        attributes_per_buffer(unsigned int);
+
+        /*!
+         * Specifies the maximum number of indices
+         * a PainterDraw returned by map_draw() may store,
+         * i.e. the size of PainterDraw::m_indices.
+         * Initial value is 1.5 times the initial value
+         * of attributes_per_buffer().
+         */
+        unsigned int
+        indices_per_buffer(void) const;
+
+        /*!
+         * Set the value returned by indices_per_buffer(void) const.
+         */
+        ConfigurationCPU&
+        indices_per_buffer(unsigned int);
+
+        /*!
+         * Specifies the size (in units of generic_data) of
+         * PainterDraw::m_store of a PainterDraw returned by
+         * map_draw() is this value times alignment().
+         * Initial value is 1024 * 64.
+         */
+        unsigned int
+        data_blocks_per_store_buffer(void) const;
+
+        /*!
+         * Set the value returned by data_blocks_per_store_buffer(void) const.
+         */
+        ConfigurationCPU&
+        data_blocks_per_store_buffer(unsigned int);
+
+        /*!
+         * Specifies the number of threads used to shade
+         * vertices and rasterize; the thread calling
+         * PainterDraw::draw() is counted as one of the
+         * threads. A value of 0 indicates to use the
+         * value of std::thread::hardware_concurrency().
+         * Initial value is 0.
+         */
+        unsigned int
+        number_threads(void) const;
+
+        /*!
+         * Set the value returned by number_threads(void) const.
+         */
+        ConfigurationCPU&
+        number_threads(unsigned int);
+
+        /*!
+         * Specifies the log2 of the width and height
+         * of the screen space tiles to which triangles
+         * are binned. Initial value is 6.
+         */
+        unsigned int
+        log2_tile_size(void) const;
+
+        /*!
+         * Set the value returned by log2_tile_size(void) const.
+         */
+        ConfigurationCPU&
+        log2_tile_size(unsigned int);
+
+        /*!
+         * Creates those atlases that are nullptr with
+         * default parameters.
+         */
+        ConfigurationCPU&
+        create_missing_atlases(void);
+
+      private:
+        void *m_d;
+      };
+
+      /*!
+       * \brief
+       * A SurfaceCPU is the implementation of \ref PainterBackend::Surface
+       * for the CPU backend; it holds a color buffer (of 8-bit per channel
+       * pre-multiplied by alpha RGBA values) and a depth buffer in system
+       * memory.
+       */
+      class SurfaceCPU:public Surface
+      {
+      public:
+        /*!
+         * Ctor.
+         * \param dimensions the width and height of the SurfaceCPU
+         */
+        explicit
+        SurfaceCPU(ivec2 dimensions);
+
+        ~SurfaceCPU();
+
+        /*!
+         * Set the viewport of the SurfaceCPU; the
+         * initial value is the entire surface.
+         */
+        SurfaceCPU&
+        viewport(Viewport vwp);
+
+        /*!
+         * The clear color, initial value is (0, 0, 0, 0).
+         */
+        const vec4&
+        clear_color(void) const;
+
+        /*!
+         * Change the value returned by clear_color(void) const.
+         */
+        SurfaceCPU&
+        clear_color(const vec4&);
+
+        /*!
+         * Returns the color buffer of the SurfaceCPU. The pixels
+         * are in row major order starting with the bottom row,
+         * i.e. the same layout glReadPixels() would produce.
+         */
+        c_array<const u8vec4>
+        pixels(void) const;
+
+        virtual
+        Viewport
+        viewport(void) const;
+
+        virtual
+        ivec2
+        dimensions(void) const;
+
+        virtual
+        reference_counted_ptr<Image>
+        image(const reference_counted_ptr<ImageAtlas> &atlas) const;
+
+      private:
+        friend class PainterBackendCPU;
+        void *m_d;
+      };
+
+      /*!
+       * Create a PainterBackendCPU configured via a ConfigurationCPU
+       * value; any atlases not set in the ConfigurationCPU are created
+       * with default parameters.
+       * \param config_cpu ConfigurationCPU providing configuration parameters
+       */
+      static
+      reference_counted_ptr<PainterBackendCPU>
+      create(ConfigurationCPU config_cpu = ConfigurationCPU());
+
+      ~PainterBackendCPU();
+
+      virtual
+      unsigned int
+      attribs_per_mapping(void) const;
+
+      virtual
+      unsigned int
+      indices_per_mapping(void) const;
+
+      virtual
+      void
+      on_pre_draw(const reference_counted_ptr<Surface> &surface,
+                  bool clear_color_buffer,
+                  const Surface::Viewport &damage_rect);
+
+      virtual
+      void
+      on_post_draw(void);
+
+      virtual
+      reference_counted_ptr<const PainterDraw>
+      map_draw(void);
+
+      /*!
+       * Returns the ConfigurationCPU (with the atlases filled in)
+       * of the PainterBackendCPU.
+       */
+      const ConfigurationCPU&
+      configuration_cpu(void) const;
+
+      /*!
+       * Returns the number of threads (including the calling
+       * thread) used by the PainterBackendCPU for drawing.
+       */
+      unsigned int
+      number_threads(void) const;
+
+      /*!
+       * Returns the names of those features of the default
+       * shaders that the PainterBackendCPU does not support.
+       */
+      c_array<const c_string>
+      unsupported_shaders(void) const;
+
+      /*!
+       * Returns true if the PainterBackendCPU draws with the
+       * given item shader, i.e. it is a \ref PainterItemShaderCPU
+       * (or a sub-shader of one) that is not one of the shaders
+       * listed by unsupported_shaders().
+       * \param shader item shader to query
+       */
+      bool
+      shader_supported(const reference_counted_ptr<PainterItemShader> &shader) const;
+
+      /*!
+       * Returns true if the PainterBackendCPU draws with the
+       * given blend shader, i.e. it is a \ref PainterBlendShaderCPU
+       * (or a sub-shader of one) that is not one of the shaders
+       * listed by unsupported_shaders().
+       * \param shader blend shader to query
+       */
+      bool
+      shader_supported(const reference_counted_ptr<PainterBlendShader> &shader) const;
+
+    private:
+      PainterBackendCPU(const ConfigurationCPU &config_cpu,
+                        const PainterShaderSet &shaders);
+
+      void *m_d;
+    };
+/*! @} */
+  }
+}
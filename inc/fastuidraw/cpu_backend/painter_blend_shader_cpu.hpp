@@ -0,0 +1,78 @@
+/*!
+ * \file painter_blend_shader_cpu.hpp
+ * \brief file painter_blend_shader_cpu.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/painter/painter_blend_shader.hpp>
+
+namespace fastuidraw
+{
+  namespace cpu
+  {
+/*!\addtogroup CPUBackend
+ * @{
+ */
+
+    /*!
+     * \brief
+     * A PainterBlendShaderCPU is a PainterBlendShader whose blending
+     * is implemented as a C++ virtual function. Since the blending is
+     * performed by the rasterizer of \ref PainterBackendCPU directly
+     * against the color buffer, a PainterBlendShaderCPU is always of
+     * type PainterBlendShader::framebuffer_fetch.
+     *
+     * The function blend() is called from multiple threads
+     * concurrently and thus implementations must not modify
+     * any state.
+     */
+    class PainterBlendShaderCPU:public PainterBlendShader
+    {
+    public:
+      /*!
+       * Ctor.
+       * \param num_sub_shaders number of sub-shaders
+       */
+      explicit
+      PainterBlendShaderCPU(unsigned int num_sub_shaders = 1):
+        PainterBlendShader(framebuffer_fetch, num_sub_shaders)
+      {}
+
+      /*!
+       * To be implemented by a derived class to blend a fragment
+       * color against the color value already present in the
+       * color buffer; all colors are pre-multiplied by alpha.
+       * \param sub_shader which sub-shader of the shader
+       * \param shader_data_offset offset into data_store of the
+       *                           blend shader data
+       * \param data_store the data store of the draw,
+       *                   i.e. PainterDraw::m_store
+       * \param src color emitted by the fragment
+       * \param dst color value already in the color buffer
+       */
+      virtual
+      vec4
+      blend(uint32_t sub_shader,
+            unsigned int shader_data_offset,
+            c_array<const generic_data> data_store,
+            const vec4 &src, const vec4 &dst) const = 0;
+    };
+/*! @} */
+  }
+}
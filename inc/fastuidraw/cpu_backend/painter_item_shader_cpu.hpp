@@ -0,0 +1,189 @@
+/*!
+ * \file painter_item_shader_cpu.hpp
+ * \brief file painter_item_shader_cpu.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/matrix.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/painter/painter_attribute.hpp>
+#include <fastuidraw/painter/painter_item_shader.hpp>
+
+namespace fastuidraw
+{
+  namespace cpu
+  {
+    class GlyphAtlasCPU;
+
+/*!\addtogroup CPUBackend
+ * @{
+ */
+
+    /*!
+     * \brief
+     * A PainterItemShaderCPU is a PainterItemShader whose vertex
+     * and fragment stages are implemented as C++ virtual functions
+     * that are run by \ref PainterBackendCPU.
+     *
+     * The vertex stage computes the position of a vertex in item
+     * coordinates, the brush coordinate of the vertex and a set of
+     * varyings. The rasterizer interpolates (perspective correctly)
+     * the varyings across each triangle and hands them, along with
+     * their screen space derivatives, to the fragment stage.
+     *
+     * Both stages are called from multiple threads concurrently and
+     * thus implementations must not modify any state.
+     */
+    class PainterItemShaderCPU:public PainterItemShader
+    {
+    public:
+      enum
+        {
+          /*!
+           * Maximum number of varyings a PainterItemShaderCPU
+           * can have.
+           */
+          max_varyings = 8
+        };
+
+      /*!
+       * Storage for the varyings of a PainterItemShaderCPU.
+       */
+      typedef vecN<float, max_varyings> varyings;
+
+      /*!
+       * \brief
+       * Values available to the vertex stage of a PainterItemShaderCPU.
+       */
+      class VertexEnvironment
+      {
+      public:
+        /*!
+         * The transformation from item coordinates to
+         * clip coordinates.
+         */
+        float3x3 m_item_matrix;
+
+        /*!
+         * The dimensions, in pixels, of the viewport.
+         */
+        vec2 m_viewport_pixels;
+
+        /*!
+         * The data store of the draw, i.e. PainterDraw::m_store.
+         */
+        c_array<const generic_data> m_data_store;
+      };
+
+      /*!
+       * \brief
+       * Values available to the fragment stage of a PainterItemShaderCPU.
+       */
+      class FragmentEnvironment
+      {
+      public:
+        /*!
+         * The data store of the draw, i.e. PainterDraw::m_store.
+         */
+        c_array<const generic_data> m_data_store;
+
+        /*!
+         * The glyph atlas of the \ref PainterBackendCPU
+         * doing the rendering.
+         */
+        const GlyphAtlasCPU *m_glyph_atlas;
+      };
+
+      /*!
+       * Ctor.
+       * \param num_varyings number of varyings the shader uses,
+       *                     must be no more than \ref max_varyings
+       * \param num_sub_shaders number of sub-shaders
+       */
+      explicit
+      PainterItemShaderCPU(unsigned int num_varyings,
+                           unsigned int num_sub_shaders = 1):
+        PainterItemShader(num_sub_shaders),
+        m_number_varyings(t_min(num_varyings, static_cast<unsigned int>(max_varyings)))
+      {
+        FASTUIDRAWassert(num_varyings <= max_varyings);
+      }
+
+      /*!
+       * Returns the number of varyings the shader uses.
+       */
+      unsigned int
+      number_varyings(void) const
+      {
+        return m_number_varyings;
+      }
+
+      /*!
+       * To be implemented by a derived class to perform the
+       * vertex stage. Returns the position in item coordinates
+       * (as the .xy component) and the brush coordinate (as the
+       * .zw component) of the vertex.
+       * \param sub_shader which sub-shader of the shader
+       * \param attrib the attribute of the vertex
+       * \param shader_data_offset offset into
+       *                           VertexEnvironment::m_data_store
+       *                           of the item shader data
+       * \param env values of the vertex environment
+       * \param[out] out_varyings location to which to write the varyings
+       * \param[out] z_add amount by which to increment the depth value
+       */
+      virtual
+      vec4
+      vertex_shade(uint32_t sub_shader,
+                   const PainterAttribute &attrib,
+                   unsigned int shader_data_offset,
+                   const VertexEnvironment &env,
+                   varyings &out_varyings,
+                   int &z_add) const = 0;
+
+      /*!
+       * To be implemented by a derived class to perform the
+       * fragment stage. Return false to discard the fragment.
+       * \param sub_shader which sub-shader of the shader
+       * \param shader_data_offset offset into
+       *                           FragmentEnvironment::m_data_store
+       *                           of the item shader data
+       * \param env values of the fragment environment
+       * \param v varyings at the fragment
+       * \param dvdx derivative of the varyings in x (pixel units)
+       * \param dvdy derivative of the varyings in y (pixel units)
+       * \param[out] out_color color (not pre-multiplied by alpha)
+       *                       emitted by the fragment
+       */
+      virtual
+      bool
+      fragment_shade(uint32_t sub_shader,
+                     unsigned int shader_data_offset,
+                     const FragmentEnvironment &env,
+                     const varyings &v,
+                     const varyings &dvdx,
+                     const varyings &dvdy,
+                     vec4 &out_color) const = 0;
+
+    private:
+      unsigned int m_number_varyings;
+    };
+/*! @} */
+  }
+}
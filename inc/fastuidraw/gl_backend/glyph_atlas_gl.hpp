@@ -206,6 +206,20 @@ namespace gl
       params&
       alignment(unsigned int v);
 
+      /*!
+       * Specifies how rectangles of texels are allocated from
+       * the texel store, initial value is \ref
+       * GlyphAtlas::tree_texel_allocator.
+       */
+      enum GlyphAtlas::texel_allocator_t
+      texel_allocator(void) const;
+
+      /*!
+       * Set the value for texel_allocator(void) const
+       */
+      params&
+      texel_allocator(enum GlyphAtlas::texel_allocator_t v);
+
     private:
       void *m_d;
     };
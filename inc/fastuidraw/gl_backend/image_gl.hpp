@@ -186,6 +186,26 @@ namespace gl
       params&
       delayed(bool v);
 
+      /*!
+       * Specifies how the color store holds its texels, initial
+       * value is \ref AtlasColorBackingStoreBase::uncompressed.
+       * A compressed color store is a texture of the S3TC format
+       * matching the value and only holds the base mipmap level.
+       * If the GL context does not support GL_EXT_texture_compression_s3tc
+       * and glCopyImageSubData, or if log2_color_tile_size() is less
+       * than 2, then the color store is uncompressed; the actual
+       * value is given by AtlasColorBackingStoreBase::compression()
+       * of ImageAtlas::color_store().
+       */
+      enum AtlasColorBackingStoreBase::compression_t
+      color_compression(void) const;
+
+      /*!
+       * Set the value for color_compression(void) const
+       */
+      params&
+      color_compression(enum AtlasColorBackingStoreBase::compression_t v);
+
     private:
       void *m_d;
     };
@@ -248,6 +268,30 @@ namespace gl
                     GLenum mag_filter = GL_LINEAR,
                     GLuint *tex = nullptr);
 
+    /*!
+     * Create an Image that is bindless that is backed directly
+     * by a texture whose contents are copied on the GPU, with
+     * glBlitFramebuffer, from a rectangle of the color attachment
+     * 0 of a framebuffer object. The copy is flipped vertically
+     * so that the first row of the Image is the row of the
+     * rectangle with the largest y-coordinate. Will return
+     * a nullptr if the current GL-context does not support
+     * bindless texturing. The framebuffer must not be
+     * multisampled.
+     * \param fbo framebuffer object from which to copy
+     * \param xy bottom-left corner of the rectangle to copy
+     * \param wh width and height of the rectangle to copy
+     * \param fmt format of the texels of the framebuffer
+     * \param min_filter value to pass to GL for the minification filter
+     * \param mag_filter value to pass to GL for the magnification filter
+     */
+    static
+    reference_counted_ptr<Image>
+    create_bindless(GLuint fbo, ivec2 xy, ivec2 wh,
+                    enum Image::format_t fmt,
+                    GLenum min_filter = GL_LINEAR,
+                    GLenum mag_filter = GL_LINEAR);
+
   private:
     void *m_d;
   };
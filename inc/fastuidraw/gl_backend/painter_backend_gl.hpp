@@ -661,6 +661,19 @@ namespace fastuidraw
         ivec2
         dimensions(void) const;
 
+        /*!
+         * Implements \ref PainterBackend::Surface::image(). If
+         * bindless texturing is supported, the viewport is copied
+         * on the GPU to a texture backing a bindless Image and the
+         * passed atlas is not used; otherwise the viewport is read
+         * back with glReadPixels and placed on the atlas.
+         * \param atlas ImageAtlas on which to place the image
+         *              if bindless texturing is not supported.
+         */
+        virtual
+        reference_counted_ptr<Image>
+        image(const reference_counted_ptr<ImageAtlas> &atlas) const;
+
       private:
         friend class PainterBackendGL;
         void *m_d;
@@ -722,7 +735,8 @@ namespace fastuidraw
       virtual
       void
       on_pre_draw(const reference_counted_ptr<Surface> &surface,
-                  bool clear_color_buffer);
+                  bool clear_color_buffer,
+                  const Surface::Viewport &damage_rect);
 
       virtual
       void
@@ -113,7 +113,9 @@ namespace fastuidraw
        * that compute the interval a distance value lies upon from
        * a repeated interval pattern. The parameter meanins are:
        * - intervals_location gives the location into the data store buffer where the
-       *   interval data is packed as (TODO: document format).
+       *   interval data is packed as an implicit search tree of blocks, as
+       *   described in PainterDashedStrokeParams; the search reads one
+       *   block per level of the tree.
        * - total_distance the period of the repeat interval pattern
        * - first_interval_start
        * - in_distance distance value to evaluate
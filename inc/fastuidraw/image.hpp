@@ -149,6 +149,33 @@ class Image;
     public reference_counted<AtlasColorBackingStoreBase>::default_base
   {
   public:
+    /*!
+     * \brief
+     * Enumeration to specify how a backing store
+     * holds its texels.
+     */
+    enum compression_t
+      {
+        /*!
+         * Texels are stored as RGBA8, 4 bytes per texel.
+         */
+        uncompressed,
+
+        /*!
+         * Texels are stored as BC1 (also known as DXT1)
+         * blocks of 4x4 texels, 8 bytes per block. Alpha
+         * is 1-bit: texels with alpha less than 128 are
+         * stored as transparent black.
+         */
+        bc1_compression,
+
+        /*!
+         * Texels are stored as BC3 (also known as DXT5)
+         * blocks of 4x4 texels, 16 bytes per block.
+         */
+        bc3_compression,
+      };
+
     /*!
      * Ctor.
      * \param whl provides the dimensions of the AtlasColorBackingStoreBase
@@ -165,6 +192,19 @@ class Image;
      */
     AtlasColorBackingStoreBase(int w, int h, int num_layers, bool presizable);
 
+    /*!
+     * Ctor.
+     * \param whl provides the dimensions of the AtlasColorBackingStoreBase
+     * \param presizable if true the object can be resized to be larger
+     * \param pcompression specifies how the texels are stored; if
+     *                     the value is not \ref uncompressed, then
+     *                     ImageAtlas only sets the data of mipmap
+     *                     level 0 and the color tile size must be a
+     *                     multiple of 4.
+     */
+    AtlasColorBackingStoreBase(ivec3 whl, bool presizable,
+                               enum compression_t pcompression);
+
     virtual
     ~AtlasColorBackingStoreBase();
 
@@ -217,6 +257,21 @@ class Image;
     bool
     resizeable(void) const;
 
+    /*!
+     * Returns how the backing store holds its texels
+     * (as passed in the ctor).
+     */
+    enum compression_t
+    compression(void) const;
+
+    /*!
+     * Returns the number of bytes of a single 4x4 block
+     * of texels as stored for compression(); returns 0
+     * if compression() is \ref uncompressed.
+     */
+    unsigned int
+    compressed_block_bytes(void) const;
+
     /*!
      * Resize the object by increasing the number of layers.
      * The routine resizeable() must return true, if not
@@ -239,6 +294,20 @@ class Image;
     void
     resize_implement(int new_num_layers) = 0;
 
+    /*!
+     * Provided as a convenience for a derived class to encode
+     * texels as the 4x4 blocks of compression(); compression()
+     * must not be \ref uncompressed.
+     * \param w width of the region of texels, must be a multiple of 4
+     * \param h height of the region of texels, must be a multiple of 4
+     * \param texels texels of the region, row-major
+     * \param dst location to which to write the blocks, row-major;
+     *            the size must be compressed_block_bytes() * (w / 4) * (h / 4)
+     */
+    void
+    compress_texels(int w, int h, c_array<const u8vec4> texels,
+                    c_array<uint8_t> dst) const;
+
   private:
     void *m_d;
   };
@@ -550,7 +619,38 @@ class Image;
     void
     resize_to_fit(int num_color_tiles, int num_index_tiles);
 
+    /*!
+     * Set the budget, in number of color tiles, of the color tiles
+     * of the \ref Image objects on the atlas. When an \ref Image
+     * needs its color tiles resident and doing so would exceed the
+     * budget, the color tiles of the least recently used images
+     * (that have not been used since the last time tile freeing was
+     * undelayed, see undelay_tile_freeing()) are evicted. The budget
+     * is a soft limit; it is exceeded if no images can be evicted.
+     * Only those images created while a budget is set can be
+     * evicted; such images keep a host-side copy of their color
+     * tiles from which they are restored, see Image::make_resident().
+     * A value of 0 indicates no budget, which is the initial value.
+     * \param v budget in number of color tiles
+     */
+    void
+    color_tile_budget(int v);
+
+    /*!
+     * Returns the value set by color_tile_budget(int).
+     */
+    int
+    color_tile_budget(void) const;
+
+    /*!
+     * Returns the number of color tiles held by the
+     * images that can be evicted and are resident.
+     */
+    int
+    number_evictable_resident_color_tiles(void) const;
+
   private:
+    friend class Image;
     void *m_d;
   };
 
@@ -580,6 +680,24 @@ class Image;
         bindless_texture2d
       };
 
+    /*!
+     * Gives the format of the texels of an Image
+     */
+    enum format_t
+      {
+        /*!
+         * Indicates that the texels are RGBA8 and
+         * not pre-multiplied by alpha
+         */
+        rgba_format,
+
+        /*!
+         * Indicates that the texels are RGBA8 and
+         * pre-multiplied by alpha
+         */
+        premultiplied_rgba_format
+      };
+
     /*!
      * Construct an \ref Image backed by an \ref ImageAtlas. If there is
      * insufficient room on the atlas, returns a nullptr handle.
@@ -590,11 +708,13 @@ class Image;
      * \param pslack number of pixels allowed to sample outside of color tile
      *               for the image. A value of one allows for bilinear
      *               filtering and a value of two allows for cubic filtering.
+     * \param fmt format of the texels of image_data
      */
     static
     reference_counted_ptr<Image>
     create(reference_counted_ptr<ImageAtlas> atlas, int w, int h,
-           const ImageSourceBase &image_data, unsigned int pslack);
+           const ImageSourceBase &image_data, unsigned int pslack,
+           enum format_t fmt = rgba_format);
 
     /*!
      * Construct an \ref Image backed by an \ref ImageAtlas. If there is
@@ -606,11 +726,13 @@ class Image;
      * \param pslack number of pixels allowed to sample outside of color tile
      *               for the image. A value of one allows for bilinear
      *               filtering and a value of two allows for cubic filtering.
+     * \param fmt format of the texels of image_data
      */
     static
     reference_counted_ptr<Image>
     create(reference_counted_ptr<ImageAtlas> atlas, int w, int h,
-           c_array<const u8vec4> image_data, unsigned int pslack);
+           c_array<const u8vec4> image_data, unsigned int pslack,
+           enum format_t fmt = rgba_format);
 
     /*!
      * Create an \ref Image backed by a bindless texture.
@@ -621,21 +743,55 @@ class Image;
      *             \ref on_atlas.
      * \param handle the bindless handle value used by the Gfx API in
      *               shaders to reference the texture.
+     * \param fmt format of the texels of the texture
      */
     static
     reference_counted_ptr<Image>
-    create_bindless(int w, int h, unsigned int m, enum type_t type, uint64_t handle);
+    create_bindless(int w, int h, unsigned int m, enum type_t type, uint64_t handle,
+                    enum format_t fmt = rgba_format);
 
     ~Image();
 
     /*!
      * Returns the number of index look-ups to get to the image data.
+     * A value of 0 indicates that the image is direct-mapped: it fits
+     * within a single color tile and master_index_tile() gives the
+     * location of that color tile instead of an index tile. Images
+     * created while the ImageAtlas has a color tile budget (see
+     * ImageAtlas::color_tile_budget()) are never direct-mapped.
      *
      * Only applies when type() returns \ref on_atlas.
      */
     unsigned int
     number_index_lookups(void) const;
 
+    /*!
+     * Returns true if the color tiles of the image are on the
+     * \ref ImageAtlas of the image; an image is non-resident only
+     * when its color tiles have been evicted to keep the atlas
+     * within its budget, see ImageAtlas::color_tile_budget().
+     *
+     * Only applies when type() returns \ref on_atlas.
+     */
+    bool
+    resident(void) const;
+
+    /*!
+     * Marks the image as used since the last time tile freeing
+     * was undelayed and, if its color tiles were evicted, restores
+     * them to the atlas from the host-side copy, evicting the color
+     * tiles of other images as needed. The index tiles of an Image
+     * are never evicted and the master index tile never changes,
+     * so data already packed with the image remains valid.
+     * PainterPacker calls make_resident() on the image of the brush
+     * of each draw; an application only needs to call it when it
+     * accesses the atlas directly.
+     *
+     * Only has effect when type() returns \ref on_atlas.
+     */
+    void
+    make_resident(void) const;
+
     /*!
      * Returns the dimensions of the image, i.e the width and height.
      */
@@ -661,6 +817,9 @@ class Image;
      * Returns the "head" index tile as returned by
      * ImageAtlas::add_index_tile() or
      * ImageAtlas::add_index_tile_index_data().
+     * If number_index_lookups() is 0, returns instead
+     * the color tile of the image as returned by
+     * ImageAtlas::add_color_tile().
      *
      * Only applies when type() returns \ref on_atlas.
      */
@@ -707,6 +866,12 @@ class Image;
     type_t
     type(void) const;
 
+    /*!
+     * Returns the format of the texels of the image.
+     */
+    format_t
+    format(void) const;
+
   protected:
     /*!
      * Protected ctor for creating an Image backed by a bindless texture;
@@ -720,12 +885,15 @@ class Image;
      *             \ref on_atlas.
      * \param handle the bindless handle value used by the Gfx API in
      *               shaders to reference the texture.
+     * \param fmt format of the texels of the texture
      */
-    Image(int w, int h, unsigned int m, enum type_t type, uint64_t handle);
+    Image(int w, int h, unsigned int m, enum type_t type, uint64_t handle,
+          enum format_t fmt = rgba_format);
 
   private:
     Image(reference_counted_ptr<ImageAtlas> atlas, int w, int h,
-          const ImageSourceBase &image_data, unsigned int pslack);
+          const ImageSourceBase &image_data, unsigned int pslack,
+          enum format_t fmt);
 
 
     void *m_d;
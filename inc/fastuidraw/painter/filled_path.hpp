@@ -93,6 +93,47 @@ public:
     const PainterAttributeData&
     aa_fuzz_painter_data(void) const;
 
+    /*!
+     * Returns the PainterAttributeData to draw the triangles for
+     * the portion of the FilledPath the Subset represents that
+     * have an edge on the boundary between regions of different
+     * winding numbers, so that their anti-aliasing is computed
+     * analytically in the fragment shader. These triangles are
+     * drawn below the triangles of painter_data(), and instead
+     * of the data of aa_fuzz_painter_data(). The index chunks
+     * are organized the same as painter_data() and there is a
+     * single attribute chunk. Each triangle has its own three
+     * vertices and its own z-offset; the z-offsets decrease in
+     * the order the triangles are in each index chunk, so that
+     * where the anti-aliased triangles overlap only one of them
+     * is blended. The z-offsets are the same for every index
+     * chunk and their range is given by z_range(0). The attribute
+     * data is packed as follows:
+     * - PainterAttribute::m_attrib0 .xy -> position of point in local coordinate (float)
+     * - PainterAttribute::m_attrib0 .zw -> position of the vertex i + 1 (mod 3)
+     *                                     of the triangle (float)
+     * - PainterAttribute::m_attrib1 .xyz -> for each edge of the triangle,
+     *                                       the winding number (int) of the
+     *                                       region across the edge, where the
+     *                                       edge i is opposite to the vertex i
+     *                                       of the triangle.
+     * - PainterAttribute::m_attrib1 .w -> bits 0-1 give which vertex i of the
+     *                                     triangle the attribute is and bits
+     *                                     2-4 give a mask of what edges are
+     *                                     on the boundary between regions of
+     *                                     different winding numbers.
+     * - PainterAttribute::m_attrib2 .xy -> position of the vertex i + 2 (mod 3)
+     *                                     of the triangle (float)
+     * - PainterAttribute::m_attrib2 .z -> the z-offset value (uint)
+     * - PainterAttribute::m_attrib2 .w -> 0 (free)
+     *
+     * The positions of the other two vertices let the vertex
+     * shader push the edges to be anti-aliased out by a pixel
+     * so that the pixels just outside the fill get coverage.
+     */
+    const PainterAttributeData&
+    aa_analytic_painter_data(void) const;
+
     /*!
      * Returns an array listing what winding number values
      * there are triangle in this Subset. To get the indices
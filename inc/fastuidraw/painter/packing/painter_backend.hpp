@@ -255,6 +255,43 @@ namespace fastuidraw
       virtual
       ivec2
       dimensions(void) const = 0;
+
+      /*!
+       * To be implemented by a derived class to return an
+       * \ref Image holding the current contents of the viewport
+       * of the Surface. The first row of the returned \ref Image
+       * is the top row of the viewport (i.e. the row with the
+       * largest y-coordinate in viewport coordinates) and the
+       * texels are pre-multiplied by alpha, i.e. Image::format()
+       * is \ref Image::premultiplied_rgba_format. Returns a nullptr
+       * handle if the image could not be created, for example
+       * if the atlas does not have room. It is an error to call
+       * image() while the Surface is being rendered to.
+       * \param atlas ImageAtlas on which to place the image
+       *              if the implementation does not create
+       *              an Image backed by a bindless texture.
+       */
+      virtual
+      reference_counted_ptr<Image>
+      image(const reference_counted_ptr<ImageAtlas> &atlas) const = 0;
+
+    protected:
+      /*!
+       * Provided as a conveniance to implement image(). Converts
+       * the pixels of a viewport, with the bottom row first, to
+       * texels as expected by \ref ImageSourceBase, with the top
+       * row first. The texel values are copied unchanged and so
+       * remain pre-multiplied by alpha.
+       * \param dimensions width and height of the pixel data
+       * \param src pixels from which to convert
+       * \param dst location to which to write the converted
+       *            texels, must not alias src.
+       */
+      static
+      void
+      convert_to_image_texels(ivec2 dimensions,
+                              c_array<const u8vec4> src,
+                              c_array<u8vec4> dst);
     };
 
     /*!
@@ -339,16 +376,22 @@ namespace fastuidraw
      * of PainterDraw objects who have had their PainterDraw::unmap()
      * routine called. An implementation will  will clear the depth
      * (aka occlusion) buffer and optionally the color buffer in the
-     * viewport of the \ref PainterBackend::Surface.
+     * region damage_rect of the \ref PainterBackend::Surface and
+     * restrict all rasterization of the draws to damage_rect.
      * \param surface the \ref PainterBackend::Surface to which to
      *                render content
      * \param clear_color_buffer if true, clear the color buffer
-     *                           on the viewport of the surface.
+     *                           on damage_rect of the surface.
+     * \param damage_rect region, in the same coordinates as
+     *                    \ref Surface::Viewport, to which to restrict
+     *                    rasterization and clearing; damage_rect is
+     *                    always contained in the viewport of surface.
      */
     virtual
     void
     on_pre_draw(const reference_counted_ptr<Surface> &surface,
-                bool clear_color_buffer) = 0;
+                bool clear_color_buffer,
+                const Surface::Viewport &damage_rect) = 0;
 
     /*!
      * Called just after calling PainterDraw::draw()
@@ -282,6 +282,26 @@ namespace fastuidraw
     begin(const reference_counted_ptr<PainterBackend::Surface> &surface,
           bool clear_color_buffer);
 
+    /*!
+     * Indicate to start drawing where only a portion of the
+     * surface is to be redrawn. Commands are buffered and not
+     * set to the backend until end() or flush() is called.
+     * All draw commands must be between a begin() / end() pair.
+     * \param surface the \ref PainterBackend::Surface to which
+     *                 to render content
+     * \param damage_rect region of surface to which clearing
+     *                    and rasterization is restricted, in the
+     *                    same coordinates as the viewport of the
+     *                    surface; damage_rect is intersected against
+     *                    the viewport of the surface.
+     * \param clear_color_buffer if true, clear the color buffer
+     *                           on damage_rect of the surface.
+     */
+    void
+    begin(const reference_counted_ptr<PainterBackend::Surface> &surface,
+          const PainterBackend::Surface::Viewport &damage_rect,
+          bool clear_color_buffer);
+
     /*!
      * Indicate to end drawing. Commands are buffered and not
      * sent to the backend until end() is called.
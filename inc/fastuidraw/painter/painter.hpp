@@ -24,10 +24,13 @@
 #include <fastuidraw/painter/stroked_path.hpp>
 #include <fastuidraw/painter/filled_path.hpp>
 #include <fastuidraw/painter/fill_rule.hpp>
+#include <fastuidraw/painter/path_boolean.hpp>
 #include <fastuidraw/painter/painter_brush.hpp>
 #include <fastuidraw/painter/painter_stroke_params.hpp>
 #include <fastuidraw/painter/painter_dashed_stroke_params.hpp>
 #include <fastuidraw/painter/painter_data.hpp>
+#include <fastuidraw/painter/painter_command_list.hpp>
+#include <fastuidraw/painter/painter_layer.hpp>
 #include <fastuidraw/painter/packing/painter_packer.hpp>
 
 namespace fastuidraw
@@ -59,7 +62,9 @@ namespace fastuidraw
    * One can specify the exact attribute and index data for a Painter
    * to consume, see \ref draw_generic(). In addition, the class
    * PainterAttributeData can be used to generate and save attribute and
-   * index data to be used repeatedly.
+   * index data to be used repeatedly. Sequences of drawing commands
+   * can be recorded to a PainterCommandList to be replayed
+   * repeatedly, see begin_command_list() and draw_command_list().
    */
   class Painter:public reference_counted<Painter>::default_base
   {
@@ -188,6 +193,8 @@ namespace fastuidraw
      * Drawing commands sent to 3D hardware are buffered and not
      * sent to hardware until end() is called.
      * All draw commands must be between a begin()/end() pair.
+     * Equivalent to begin() with the viewport of the surface as
+     * the only damage rectangle.
      * \param surface the \ref PainterBackend::Surface to which to render content
      * \param clear_color_buffer if true, clear the color buffer on the viewport
      *                           of the surface.
@@ -196,6 +203,32 @@ namespace fastuidraw
     begin(const reference_counted_ptr<PainterBackend::Surface> &surface,
           bool clear_color_buffer = true);
 
+    /*!
+     * Indicate to start drawing with methods of this Painter
+     * where only the damaged portions of the surface are to be
+     * redrawn. The damage rectangles are merged into their
+     * bounding box; that bounding box is used as the initial
+     * clipping so that all content outside of it is culled on
+     * CPU and the backend restricts rasterization (and clearing)
+     * to it. To redraw damage rectangles that are far apart
+     * without redrawing the area between them, issue a
+     * begin()/end() pair for each of them with clear_color_buffer
+     * as false for all but the first. Drawing commands sent to
+     * 3D hardware are buffered and not sent to hardware until
+     * end() is called. All draw commands must be between a
+     * begin()/end() pair.
+     * \param surface the \ref PainterBackend::Surface to which to render content
+     * \param damage the damaged regions of the surface, in the same
+     *               coordinates as \ref PainterBackend::Surface::Viewport;
+     *               if empty, all drawing is culled.
+     * \param clear_color_buffer if true, clear the color buffer on the
+     *                           bounding box of the damage
+     */
+    void
+    begin(const reference_counted_ptr<PainterBackend::Surface> &surface,
+          c_array<const PainterBackend::Surface::Viewport> damage,
+          bool clear_color_buffer = true);
+
     /*!
      * Indicate to end drawing with methods of this Painter.
      * Drawing commands sent to 3D hardware are buffered and not
@@ -333,6 +366,17 @@ namespace fastuidraw
     void
     clipInPath(const Path &path, const CustomFillRuleBase &fill_rule);
 
+    /*!
+     * Clip-in by the region of a PathBoolean, i.e. set the
+     * clipping to be the intersection of the current clipping
+     * against the region. Building a PathBoolean from a stack
+     * of clipInPath() and clipOutPath() calls and clipping to
+     * it draws one occluder instead of one per call.
+     * \param region PathBoolean whose region to clip against
+     */
+    void
+    clipInPath(const PathBoolean &region);
+
     /*!
      * Set the curve flatness requirement for TessellatedPath
      * and StrokedPath selection when stroking or filling paths
@@ -681,6 +725,50 @@ namespace fastuidraw
               bool with_shader_based_anti_aliasing,
               const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
 
+    /*!
+     * Fill a path by stencil-then-cover: triangle fans of each
+     * contour of the TessellatedPath of the path are drawn to
+     * the stencil buffer to accumulate the winding number at
+     * each pixel, and then the bounding box of the path (or
+     * the entire clipping region for the complement fill rules)
+     * is drawn with the brush where the stencil value passes the
+     * fill rule. This skips the triangulation of the FilledPath
+     * of the path, which makes it the better choice for paths
+     * that are drawn only a few times, for example animated
+     * shapes. The winding number is accumulated modulo 256.
+     * If PainterFillShader::supports_stencil_cover() is false
+     * or the transformation is such that the clipping region
+     * cannot be covered by a polygon, fills the path without
+     * anti-aliasing with fill_path() instead.
+     * \param shader shader with which to draw the triangle
+     *               fans and cover
+     * \param draw data for how to draw
+     * \param path path to fill
+     * \param fill_rule fill rule with which to fill the path
+     * \param call_back if non-nullptr handle, call back called when attribute data
+     *                  is added.
+     */
+    void
+    fill_path_stencil_cover(const PainterFillShader &shader, const PainterData &draw,
+                            const Path &path, enum PainterEnums::fill_rule_t fill_rule,
+                            const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
+
+    /*!
+     * Fill a path by stencil-then-cover using the default
+     * shader, see fill_path_stencil_cover(const PainterFillShader&,
+     * const PainterData&, const Path&, enum PainterEnums::fill_rule_t,
+     * const reference_counted_ptr<PainterPacker::DataCallBack>&).
+     * \param draw data for how to draw
+     * \param path path to fill
+     * \param fill_rule fill rule with which to fill the path
+     * \param call_back if non-nullptr handle, call back called when attribute data
+     *                  is added.
+     */
+    void
+    fill_path_stencil_cover(const PainterData &draw, const Path &path,
+                            enum PainterEnums::fill_rule_t fill_rule,
+                            const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
+
     /*!
      * Draw a convex polygon using a custom shader.
      * \param shader shader with which to draw the convex polygon
@@ -850,6 +938,98 @@ namespace fastuidraw
     void
     queue_action(const reference_counted_ptr<const PainterDraw::Action> &action);
 
+    /*!
+     * Start recording to a PainterCommandList; the PainterCommandList
+     * is first cleared. Until end_command_list() is called, the
+     * drawing, clipping, save() and restore() commands issued to
+     * the Painter are recorded to the PainterCommandList instead
+     * of being drawn. The transformation of the Painter at the time
+     * of begin_command_list() is the transformation the recorded
+     * commands are relative to. While recording, no culling against
+     * the clipping of the Painter is performed and clipping commands
+     * do not affect the subsequent draws of the recording. Must
+     * be called between begin() and end(). Calls to begin_command_list()
+     * cannot be nested.
+     * \param list PainterCommandList to which to record
+     */
+    void
+    begin_command_list(const reference_counted_ptr<PainterCommandList> &list);
+
+    /*!
+     * End recording to the PainterCommandList passed to
+     * begin_command_list(). The state of the Painter (transformation,
+     * clipping, blend mode and z-value) is restored to what
+     * it was when begin_command_list() was called. Each call
+     * to save() issued while recording must be matched by a
+     * call to restore() before calling end_command_list().
+     */
+    void
+    end_command_list(void);
+
+    /*!
+     * Returns true if the Painter is recording to a PainterCommandList,
+     * i.e. begin_command_list() has been called without end_command_list()
+     * being called after it.
+     */
+    bool
+    recording_command_list(void) const;
+
+    /*!
+     * Draw the contents of a PainterCommandList. The transformation
+     * of each recorded command is the current transformation of
+     * the Painter concatenated with the transformation of the
+     * command relative to the start of the recording; the recorded
+     * commands are clipped by the current clipping of the Painter.
+     * The transformation, clipping and blend mode of the Painter are
+     * the same after draw_command_list() as before, but the z-value
+     * of the Painter is incremented as if the recorded commands had
+     * been issued directly.
+     * \param list PainterCommandList to draw, may not be currently
+     *             recording
+     */
+    void
+    draw_command_list(const PainterCommandList &list);
+
+    /*!
+     * Start rendering the content of a PainterLayer; this is
+     * the same as calling begin() on PainterLayer::surface()
+     * with clearing the color buffer followed by setting the
+     * transformation to the orthogonal projection that maps the
+     * rectangle [0, w]x[0, h] to the viewport of the surface
+     * with y = 0 the top row, where (w, h) is given by
+     * PainterLayer::dimensions(). It is an error to call
+     * begin_layer() between a begin()/end() pair.
+     * \param layer PainterLayer whose content to render
+     */
+    void
+    begin_layer(const reference_counted_ptr<PainterLayer> &layer);
+
+    /*!
+     * End rendering the content of the PainterLayer passed to
+     * begin_layer(). This calls end() and then sets the \ref Image
+     * of the PainterLayer from the surface of the layer, see
+     * \ref PainterBackend::Surface::image(). Returns true if the
+     * Image was successfully created, in which case
+     * PainterLayer::valid() returns true as well.
+     */
+    bool
+    end_layer(void);
+
+    /*!
+     * Draw the content of a PainterLayer as a rectangle whose
+     * min-corner is at p and whose size is given by
+     * PainterLayer::dimensions(). If PainterLayer::valid()
+     * is false, nothing is drawn.
+     * \param layer PainterLayer to draw
+     * \param p min-corner of rectangle at which to draw the layer
+     * \param f filter to apply to the image of the layer; only a
+     *          transformation that is not a translation by an
+     *          integer amount of pixels benefits from filtering.
+     */
+    void
+    draw_layer(const PainterLayer &layer, const vec2 &p,
+               enum PainterBrush::image_filter f = PainterBrush::image_filter_nearest);
+
     /*!
      * Returns a stat on how much data the Packer has
      * handled since the last call to begin().
@@ -168,6 +168,13 @@ namespace fastuidraw
          */
         image_type_bit0,
 
+        /*!
+         * Bit up if an image is present and its texels are
+         * pre-multiplied by alpha, i.e. Image::format()
+         * is \ref Image::premultiplied_rgba_format
+         */
+        image_format_bit = image_type_bit0 + image_type_num_bits,
+
         /*!
          * Must be last enum, gives number of bits needed to hold shader bits
          * of a PainterBrush.
@@ -227,6 +234,11 @@ namespace fastuidraw
          * mask generated from \ref image_type_bit0 and \ref image_type_num_bits
          */
         image_type_mask = FASTUIDRAW_MASK(image_type_bit0, image_type_num_bits),
+
+        /*!
+         * mask generated from \ref image_format_bit
+         */
+        image_format_mask = FASTUIDRAW_MASK(image_format_bit, 1),
       };
 
     /*!
@@ -368,7 +380,9 @@ namespace fastuidraw
      * PainterBrush::shader(). The ratio of the size of the
      * image to the size of the master index is given by
      * pow(I, Image::number_index_lookups). where I is given
-     * by ImageAtlas::index_tile_size().
+     * by ImageAtlas::index_tile_size(). If the number of index
+     * look ups is zero, the image is direct-mapped and the
+     * atlas location is that of its color tile.
      * NOTE:
      * - packing it into 2 elements is likely overkill since
      *   alignment is likely to be 4. We could split the
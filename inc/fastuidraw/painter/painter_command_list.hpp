@@ -0,0 +1,115 @@
+/*!
+ * \file painter_command_list.hpp
+ * \brief file painter_command_list.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/reference_counted.hpp>
+
+namespace fastuidraw
+{
+///@cond
+class Painter;
+///@endcond
+
+/*!\addtogroup Painter
+ * @{
+ */
+
+  /*!
+   * \brief
+   * A PainterCommandList holds a recording of a sequence of
+   * Painter operations: the attribute and index data of each
+   * draw (after subset selection, tessellation selection and
+   * stroking/filling data generation), the brush and shader
+   * data of each draw already packed and the clipping and
+   * save()/restore() commands issued. A PainterCommandList is
+   * recorded with Painter::begin_command_list() and replayed
+   * any number of times with Painter::draw_command_list(), under
+   * the transformation and clipping of the Painter at the time of
+   * replay. Replaying skips all of the CPU work a Painter performs
+   * to issue the draws except for copying the attribute and index
+   * data and writing the header of each draw.
+   *
+   * The recorded data is the data a Painter chose for the
+   * transformation at the time of recording; for example, if the
+   * replay is under a transformation that magnifies considerably
+   * more than at recording, the curves of paths will appear
+   * faceted. In addition, glyphs drawn into a PainterCommandList
+   * must stay resident on their GlyphAtlas for as long as the
+   * PainterCommandList is replayed.
+   */
+  class PainterCommandList:
+    public reference_counted<PainterCommandList>::non_concurrent
+  {
+  public:
+    /*!
+     * Ctor, initializes the PainterCommandList as empty.
+     */
+    PainterCommandList(void);
+
+    ~PainterCommandList();
+
+    /*!
+     * Clear the PainterCommandList of all commands. It is
+     * an error to call clear() while the PainterCommandList
+     * is being recorded.
+     */
+    void
+    clear(void);
+
+    /*!
+     * Returns true if the PainterCommandList has no commands.
+     */
+    bool
+    empty(void) const;
+
+    /*!
+     * Returns true if this PainterCommandList is currently
+     * being recorded to by a Painter.
+     */
+    bool
+    recording(void) const;
+
+    /*!
+     * Returns the number of draws recorded.
+     */
+    unsigned int
+    number_draws(void) const;
+
+    /*!
+     * Returns the number of attributes held by
+     * all of the recorded draws.
+     */
+    unsigned int
+    number_attributes(void) const;
+
+    /*!
+     * Returns the number of indices held by
+     * all of the recorded draws.
+     */
+    unsigned int
+    number_indices(void) const;
+
+  private:
+    friend class Painter;
+    void *m_d;
+  };
+/*! @} */
+}
@@ -32,7 +32,19 @@ namespace fastuidraw
    * \brief
    * Class to specify dashed stroking parameters, data is packed
    * as according to PainterDashedStrokeParams::stroke_data_offset_t.
-   * Data for dashing is packed [TODO describe].
+   * Data for dashing is packed as the end points of the intervals
+   * of the dash pattern (i.e. the sums of the draw and space lengths
+   * up to and including an interval) arranged as an implicit
+   * search tree where each node is one block of the data store:
+   * if A is the alignment of the data store, each node holds A
+   * values and has (A + 1) children with the children of the node
+   * at block i at blocks i * (A + 1) + 1 + c for 0 <= c <= A. The
+   * values of a non-leaf node are the largest values of each of
+   * its first A children and the leaves hold the interval end
+   * points in order; unused entries are padded with a value
+   * greater than the total length of the dash pattern. Thus
+   * finding the interval of a distance takes a single read per
+   * level of the tree, see glsl::code::compute_interval().
    */
   class PainterDashedStrokeParams:public PainterItemShaderData
   {
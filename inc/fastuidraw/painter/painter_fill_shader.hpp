@@ -22,6 +22,7 @@
 
 #include <fastuidraw/painter/painter_item_shader.hpp>
 #include <fastuidraw/painter/painter_enums.hpp>
+#include <fastuidraw/painter/packing/painter_draw.hpp>
 
 namespace fastuidraw
 {
@@ -96,6 +97,100 @@ namespace fastuidraw
     PainterFillShader&
     aa_fuzz_shader(const reference_counted_ptr<PainterItemShader> &sh);
 
+    /*!
+     * Returns the PainterItemShader to use to draw with
+     * analytic anti-aliasing the triangles on the boundary
+     * of a fill rule. If non-null, anti-aliased filling with
+     * the fill rule first draws the triangles of
+     * FilledPath::Subset::painter_data() with item_shader()
+     * and then, below them, the triangles with this shader
+     * instead of the anti-alias fuzz; filling with a
+     * CustomFillRuleBase always draws the fuzz. The expected
+     * format of the attributes is as found in the \ref
+     * PainterAttributeData returned by
+     * FilledPath::Subset::aa_analytic_painter_data().
+     * \param fill_rule fill rule of the triangles
+     */
+    const reference_counted_ptr<PainterItemShader>&
+    aa_analytic_shader(enum PainterEnums::fill_rule_t fill_rule) const;
+
+    /*!
+     * Set the value returned by aa_analytic_shader(enum PainterEnums::fill_rule_t) const.
+     * Initial value is nullptr.
+     * \param fill_rule fill rule of the triangles
+     * \param sh value to use
+     */
+    PainterFillShader&
+    aa_analytic_shader(enum PainterEnums::fill_rule_t fill_rule,
+                       const reference_counted_ptr<PainterItemShader> &sh);
+
+    /*!
+     * Returns the action to be called before drawing the
+     * triangle fans of Painter::fill_path_stencil_cover().
+     * The action is to make the 3D API increment the stencil
+     * buffer for front facing triangles, decrement it for back
+     * facing triangles and to not write to the color or depth
+     * buffers.
+     */
+    const reference_counted_ptr<const PainterDraw::Action>&
+    stencil_action(void) const;
+
+    /*!
+     * Set the value returned by stencil_action(void) const.
+     * Initial value is nullptr.
+     * \param a value to use
+     */
+    PainterFillShader&
+    stencil_action(const reference_counted_ptr<const PainterDraw::Action> &a);
+
+    /*!
+     * Returns the action to be called before drawing the cover
+     * of Painter::fill_path_stencil_cover() for a fill rule.
+     * The action is to make the 3D API draw only where the
+     * stencil value passes the fill rule, to restore writing
+     * to the color and depth buffers and to reset the stencil
+     * buffer to zero where the cover is drawn.
+     * \param fill_rule fill rule of the cover
+     */
+    const reference_counted_ptr<const PainterDraw::Action>&
+    cover_action(enum PainterEnums::fill_rule_t fill_rule) const;
+
+    /*!
+     * Set the value returned by cover_action(enum PainterEnums::fill_rule_t) const.
+     * Initial value is nullptr.
+     * \param fill_rule fill rule of the cover
+     * \param a value to use
+     */
+    PainterFillShader&
+    cover_action(enum PainterEnums::fill_rule_t fill_rule,
+                 const reference_counted_ptr<const PainterDraw::Action> &a);
+
+    /*!
+     * Returns the action to be called after drawing the cover
+     * of Painter::fill_path_stencil_cover(); the action is to
+     * restore the 3D API state changed by stencil_action()
+     * and cover_action().
+     */
+    const reference_counted_ptr<const PainterDraw::Action>&
+    end_cover_action(void) const;
+
+    /*!
+     * Set the value returned by end_cover_action(void) const.
+     * Initial value is nullptr.
+     * \param a value to use
+     */
+    PainterFillShader&
+    end_cover_action(const reference_counted_ptr<const PainterDraw::Action> &a);
+
+    /*!
+     * Returns true if stencil_action(), end_cover_action()
+     * and cover_action() for each fill rule are all non-null,
+     * i.e. if Painter::fill_path_stencil_cover() can fill by
+     * stencil-then-cover with this PainterFillShader.
+     */
+    bool
+    supports_stencil_cover(void) const;
+
   private:
     void *m_d;
   };
@@ -0,0 +1,109 @@
+/*!
+ * \file painter_layer.hpp
+ * \brief file painter_layer.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/image.hpp>
+#include <fastuidraw/painter/packing/painter_backend.hpp>
+
+namespace fastuidraw
+{
+///@cond
+class Painter;
+///@endcond
+
+/*!\addtogroup Painter
+ * @{
+ */
+
+  /*!
+   * \brief
+   * A PainterLayer represents content rendered once by a Painter
+   * to an offscreen \ref PainterBackend::Surface and kept as an
+   * \ref Image so that it can be drawn as a single rectangle in
+   * later frames. The content of a PainterLayer is rendered
+   * between Painter::begin_layer() and Painter::end_layer() and
+   * drawn with Painter::draw_layer(). When the content the layer
+   * represents changes, call invalidate() and render it again.
+   *
+   * The Image of a PainterLayer is created from the pixels of
+   * the surface (see \ref PainterBackend::Surface::image()), so
+   * drawing a PainterLayer under a transformation that is not
+   * a translation resamples the content.
+   */
+  class PainterLayer:
+    public reference_counted<PainterLayer>::non_concurrent
+  {
+  public:
+    /*!
+     * Ctor.
+     * \param surface the \ref PainterBackend::Surface to which the
+     *                content of the layer is rendered; the size
+     *                of the layer is the size of the viewport of
+     *                the surface.
+     */
+    explicit
+    PainterLayer(const reference_counted_ptr<PainterBackend::Surface> &surface);
+
+    ~PainterLayer();
+
+    /*!
+     * Returns the \ref PainterBackend::Surface passed in the ctor.
+     */
+    const reference_counted_ptr<PainterBackend::Surface>&
+    surface(void) const;
+
+    /*!
+     * Returns the width and height of the layer, i.e. the
+     * dimensions of the viewport of surface().
+     */
+    ivec2
+    dimensions(void) const;
+
+    /*!
+     * Returns true if the content of the PainterLayer has
+     * been rendered (by Painter::begin_layer() and
+     * Painter::end_layer()) and not invalidated since.
+     */
+    bool
+    valid(void) const;
+
+    /*!
+     * Returns the \ref Image holding the content of the
+     * PainterLayer; returns a nullptr handle if valid()
+     * is false.
+     */
+    const reference_counted_ptr<const Image>&
+    image(void) const;
+
+    /*!
+     * Mark the PainterLayer as needing its content rendered
+     * again, releasing the \ref Image holding the content.
+     */
+    void
+    invalidate(void);
+
+  private:
+    friend class Painter;
+    void *m_d;
+  };
+/*! @} */
+}
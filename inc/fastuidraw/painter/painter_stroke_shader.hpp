@@ -83,6 +83,54 @@ namespace fastuidraw
     stroking_distances(const PainterShaderData::DataBase *data,
                        float *out_pixel_space_distance,
                        float *out_item_space_distance) const = 0;
+
+    /*!
+     * To be optionally implemented by a derived class to indicate
+     * that distance_range_culled() may return true for the passed
+     * data. Painter only queries distance_range_culled() if this
+     * returns true. Default implementation returns false.
+     * \param data PainterItemShaderData::DataBase object holding
+     *             the data to be sent to the shader
+     * \param one_pixel_distance the length of a pixel in local
+     *                           coordinates
+     */
+    virtual
+    bool
+    has_distance_culling(const PainterShaderData::DataBase *data,
+                         float one_pixel_distance) const
+    {
+      FASTUIDRAWunused(data);
+      FASTUIDRAWunused(one_pixel_distance);
+      return false;
+    }
+
+    /*!
+     * To be optionally implemented by a derived class to indicate
+     * that the stroking draws nothing for those portions of a path
+     * whose distance from the start of their contour is within a
+     * range of values, for example a range that is inside of a
+     * skip interval of a dash pattern. Painter uses this to cull
+     * the portions of a StrokedPath that draw nothing, see
+     * StrokedPath::select_subsets(). Default implementation
+     * returns false.
+     * \param data PainterItemShaderData::DataBase object holding
+     *             the data to be sent to the shader
+     * \param one_pixel_distance the length of a pixel in local
+     *                           coordinates
+     * \param distances range of distances from the start of
+     *                  the contour
+     */
+    virtual
+    bool
+    distance_range_culled(const PainterShaderData::DataBase *data,
+                          float one_pixel_distance,
+                          range_type<float> distances) const
+    {
+      FASTUIDRAWunused(data);
+      FASTUIDRAWunused(one_pixel_distance);
+      FASTUIDRAWunused(distances);
+      return false;
+    }
   };
 
   /*!
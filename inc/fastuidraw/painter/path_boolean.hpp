@@ -0,0 +1,213 @@
+/*!
+ * \file path_boolean.hpp
+ * \brief file path_boolean.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/painter/painter_enums.hpp>
+#include <fastuidraw/painter/fill_rule.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Painter
+ * @{
+ */
+
+  /*!
+   * \brief
+   * A PathBoolean represents a region of the plane built by
+   * combining the fills of Path objects with boolean operations.
+   * The region is realized as a Path made of line segments,
+   * path(), so that the region is given by filling path() with
+   * the fill rule \ref PainterEnums::nonzero_fill_rule, or
+   * with its complement if complement() is true. Each operation
+   * runs the tessellator once over the operands to extract the
+   * boundary of the regions the operation selects, so the
+   * Painter can clip against an entire stack of clipInPath()
+   * and clipOutPath() calls by drawing a single occluder,
+   * see Painter::clipInPath(const PathBoolean&).
+   */
+  class PathBoolean:noncopyable
+  {
+  public:
+    /*!
+     * \brief
+     * Enumeration to specify how to combine the region of a
+     * PathBoolean with the fill of a Path.
+     */
+    enum operation_t
+      {
+        /*!
+         * Set the region as the union of the region
+         * and the fill of the Path.
+         */
+        union_operation,
+
+        /*!
+         * Set the region as the intersection of the
+         * region and the fill of the Path.
+         */
+        intersect_operation,
+
+        /*!
+         * Set the region as the region minus the fill
+         * of the Path.
+         */
+        difference_operation,
+
+        /*!
+         * Set the region as those points that are in
+         * exactly one of the region and the fill of
+         * the Path.
+         */
+        xor_operation,
+      };
+
+    /*!
+     * Ctor. Initializes the region as the entire plane.
+     * \param max_distance value passed to Path::tessellation(float)
+     *                     const to fetch the TessellatedPath of the
+     *                     Path objects whose fills are combined; the
+     *                     default value fetches the lowest level of
+     *                     detail.
+     */
+    explicit
+    PathBoolean(float max_distance = -1.0f);
+
+    ~PathBoolean();
+
+    /*!
+     * Set the region to the entire plane.
+     */
+    PathBoolean&
+    clear(void);
+
+    /*!
+     * Set the region as the fill of a Path.
+     * \param path Path whose fill is the region
+     * \param fill_rule fill rule with which to fill path
+     */
+    PathBoolean&
+    set(const Path &path, const CustomFillRuleBase &fill_rule);
+
+    /*!
+     * Set the region as the fill of a Path.
+     * \param path Path whose fill is the region
+     * \param fill_rule fill rule with which to fill path
+     */
+    PathBoolean&
+    set(const Path &path, enum PainterEnums::fill_rule_t fill_rule);
+
+    /*!
+     * Combine the region with the fill of a Path.
+     * \param op operation with which to combine
+     * \param path Path whose fill to combine with the region
+     * \param fill_rule fill rule with which to fill path
+     */
+    PathBoolean&
+    combine(enum operation_t op, const Path &path,
+            const CustomFillRuleBase &fill_rule);
+
+    /*!
+     * Combine the region with the fill of a Path.
+     * \param op operation with which to combine
+     * \param path Path whose fill to combine with the region
+     * \param fill_rule fill rule with which to fill path
+     */
+    PathBoolean&
+    combine(enum operation_t op, const Path &path,
+            enum PainterEnums::fill_rule_t fill_rule);
+
+    /*!
+     * Combine the region with the region of another
+     * PathBoolean.
+     * \param op operation with which to combine
+     * \param obj PathBoolean whose region to combine with the region
+     */
+    PathBoolean&
+    combine(enum operation_t op, const PathBoolean &obj);
+
+    /*!
+     * Provided as a conveniance, equivalent to
+     * \code
+     * combine(intersect_operation, path, fill_rule);
+     * \endcode
+     * which is the clipping of Painter::clipInPath().
+     */
+    PathBoolean&
+    clip_in(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
+    {
+      return combine(intersect_operation, path, fill_rule);
+    }
+
+    /*!
+     * Provided as a conveniance, equivalent to
+     * \code
+     * combine(difference_operation, path, fill_rule);
+     * \endcode
+     * which is the clipping of Painter::clipOutPath().
+     */
+    PathBoolean&
+    clip_out(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
+    {
+      return combine(difference_operation, path, fill_rule);
+    }
+
+    /*!
+     * If true, the region is the complement of the
+     * fill of path(), i.e. is unbounded.
+     */
+    bool
+    complement(void) const;
+
+    /*!
+     * Returns true if the region is empty, i.e.
+     * complement() is false and path() has no
+     * contours.
+     */
+    bool
+    empty(void) const;
+
+    /*!
+     * Returns a Path whose fill with \ref
+     * PainterEnums::nonzero_fill_rule is the region if
+     * complement() is false or is the complement of the
+     * region if complement() is true. The winding number
+     * of the returned Path is 0 or 1 at every point, so
+     * it can also be filled with \ref
+     * PainterEnums::odd_even_fill_rule.
+     */
+    const Path&
+    path(void) const;
+
+    /*!
+     * Returns the fill rule with which to fill path()
+     * to give the region, i.e. \ref
+     * PainterEnums::complement_nonzero_fill_rule if
+     * complement() is true and \ref
+     * PainterEnums::nonzero_fill_rule otherwise.
+     */
+    enum PainterEnums::fill_rule_t
+    fill_rule(void) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+}
@@ -35,6 +35,7 @@ class TessellatedPath;
 class Path;
 class PainterAttribute;
 class PainterAttributeData;
+class StrokingDataSelectorBase;
 ///@endcond
 
 /*!\addtogroup Paths
@@ -190,6 +191,48 @@ public:
                  unsigned int max_index_cnt,
                  c_array<unsigned int> dst) const;
 
+  /*!
+   * Same as select_subsets() above, but additionally culls
+   * those Subset objects whose edges are all at distances from
+   * their contour start for which
+   * StrokingDataSelectorBase::distance_range_culled() returns
+   * true, for example those completely within skip intervals
+   * of a dash pattern.
+   * \param scratch_space scratch space for computations
+   * \param clip_equations array of clip equations
+   * \param clip_matrix_local 3x3 transformation from local (x, y, 1)
+   *                          coordinates to clip coordinates.
+   * \param recip_dimensions holds the reciprocal of the dimensions of the viewport
+   * \param pixels_additional_room amount in -pixels- to push clip equations by
+   *                               to grab additional edges
+   * \param item_space_additional_room amount in local coordinates to push clip
+   *                              equations by to grab additional edges
+   * \param distance_culler if non-null, object used to cull by distance
+   * \param distance_culler_data data passed to the methods of distance_culler
+   * \param one_pixel_distance length of a pixel in local coordinates,
+   *                           passed to the methods of distance_culler
+   * \param max_attribute_cnt only allow those chunks for which have no more
+   *                          than max_attribute_cnt attributes
+   * \param max_index_cnt only allow those chunks for which have no more
+   *                      than max_index_cnt indices
+   * \param[out] dst location to which to write the \ref Subset ID values
+   * \returns the number of Subset object ID's written to dst, that
+   *          number is guaranteed to be no more than number_subsets().
+   */
+  unsigned int
+  select_subsets(ScratchSpace &scratch_space,
+                 c_array<const vec3> clip_equations,
+                 const float3x3 &clip_matrix_local,
+                 const vec2 &recip_dimensions,
+                 float pixels_additional_room,
+                 float item_space_additional_room,
+                 const StrokingDataSelectorBase *distance_culler,
+                 const PainterShaderData::DataBase *distance_culler_data,
+                 float one_pixel_distance,
+                 unsigned int max_attribute_cnt,
+                 unsigned int max_index_cnt,
+                 c_array<unsigned int> dst) const;
+
   /*!
    * In contrast to select_subsets() which performs hierarchical
    * culling against a set of clip equations, this routine performs
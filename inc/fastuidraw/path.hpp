@@ -26,6 +26,7 @@
 #include <fastuidraw/util/reference_counted.hpp>
 #include <fastuidraw/path_enums.hpp>
 #include <fastuidraw/tessellated_path.hpp>
+#include <fastuidraw/shared_path_geometry.hpp>
 
 namespace fastuidraw  {
 
@@ -82,6 +83,48 @@ public:
                         float *out_max_distance) = 0;
   };
 
+  /*!
+   * \brief
+   * A GeometryKey accumulates values that together with the
+   * type of an \ref interpolator_base, its start_pt(), end_pt()
+   * and edge_type() completely determine the geometry of the
+   * interpolator. A GeometryKey is used to find the Path objects
+   * whose geometry is identical, see Path::share_geometry().
+   */
+  class GeometryKey:fastuidraw::noncopyable
+  {
+  public:
+    /*!
+     * Ctor, initializes as having no values.
+     */
+    GeometryKey(void);
+
+    ~GeometryKey();
+
+    /*!
+     * Add a value to the GeometryKey.
+     * \param v value to add
+     */
+    GeometryKey&
+    add(float v);
+
+    /*!
+     * Add a point to the GeometryKey.
+     * \param pt point to add
+     */
+    GeometryKey&
+    add(const vec2 &pt);
+
+    /*!
+     * Returns the values added, as their bits.
+     */
+    c_array<const generic_data>
+    values(void) const;
+
+  private:
+    void *m_d;
+  };
+
   /*!
    * \brief
    * Base class to describe how to interpolate from one
@@ -178,6 +221,24 @@ public:
     interpolator_base*
     deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const = 0;
 
+    /*!
+     * To be optionally implemented by a derived class to add to a
+     * \ref GeometryKey the values that, together with the type of
+     * the interpolator, start_pt(), end_pt() and edge_type(), completely
+     * determine the geometry of the interpolator. Return false if the
+     * interpolator cannot describe its geometry; a Path using such an
+     * interpolator never shares its geometry, see Path::share_geometry().
+     * Default implementation returns false.
+     * \param key GeometryKey to which to add values
+     */
+    virtual
+    bool
+    add_to_geometry_key(GeometryKey *key) const
+    {
+      FASTUIDRAWunused(key);
+      return false;
+    }
+
   private:
     friend class PathContour;
     void *m_d;
@@ -218,6 +279,10 @@ public:
     virtual
     interpolator_base*
     deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const;
+
+    virtual
+    bool
+    add_to_geometry_key(GeometryKey *key) const;
   };
 
   /*!
@@ -369,6 +434,10 @@ public:
     interpolator_base*
     deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const;
 
+    virtual
+    bool
+    add_to_geometry_key(GeometryKey *key) const;
+
     virtual
     unsigned int
     minimum_tessellation_recursion(void) const;
@@ -416,6 +485,10 @@ public:
     interpolator_base*
     deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const;
 
+    virtual
+    bool
+    add_to_geometry_key(GeometryKey *key) const;
+
     virtual
     reference_counted_ptr<tessellation_state>
     produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
@@ -995,6 +1068,29 @@ public:
   reference_counted_ptr<const PathContour>
   contour(unsigned int i) const;
 
+  /*!
+   * Set the SharedPathGeometry with which this Path shares its
+   * tessellations (and thus the FilledPath and StrokedPath
+   * objects of those tessellations); the Path shares with the
+   * other Path objects using the same SharedPathGeometry whose
+   * contours are identical, i.e. have the same points, edge types
+   * and interpolators as according to
+   * PathContour::interpolator_base::add_to_geometry_key(). A Path
+   * using a SharedPathGeometry, and the copies made of it, are to
+   * be used only on the thread that uses the SharedPathGeometry.
+   * Default value is nullptr, i.e. no sharing.
+   * \param v share group, nullptr to not share geometry
+   */
+  Path&
+  share_geometry(const reference_counted_ptr<SharedPathGeometry> &v);
+
+  /*!
+   * Returns the value set by
+   * share_geometry(const reference_counted_ptr<SharedPathGeometry>&).
+   */
+  const reference_counted_ptr<SharedPathGeometry>&
+  share_geometry(void) const;
+
   /*!
    * Returns true if each PathContour of the Path is flat.
    */
@@ -1023,7 +1119,12 @@ public:
    * level of detail. The TessellatedPath is constructed
    * lazily. Additionally, if this Path changes its geometry,
    * then a new TessellatedPath will be contructed on the
-   * next call to tessellation().
+   * next call to tessellation(). If thresh is larger than
+   * the TessellatedPath::max_distance() of the lowest level of
+   * detail tessellation, the returned TessellatedPath may be
+   * made from the lowest level of detail tessellation by
+   * TessellatedPath::create_simplified(), so that a Path with
+   * many edges drawn small uses far fewer segments.
    * \param thresh the returned tessellated path will be so that
    *               TessellatedPath::max_distance() is no more than
    *               thresh. A non-positive value will return the
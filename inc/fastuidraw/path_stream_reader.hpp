@@ -0,0 +1,130 @@
+/*!
+ * \file path_stream_reader.hpp
+ * \brief file path_stream_reader.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/util/data_buffer_base.hpp>
+
+namespace fastuidraw  {
+
+///@cond
+class Path;
+///@endcond
+
+/*!\addtogroup Paths
+ * @{
+ */
+
+/*!
+ * \brief
+ * A PathStreamReader reads the contours of a path from a
+ * text buffer a chunk at a time, so that the \ref Path
+ * objects made from the early chunks can be used (for
+ * example tessellated by another thread) while the later
+ * chunks are read. The format of the text is:
+ *  - [ marks the start of a contour
+ *  - R[ marks the start of a contour whose edges are in reverse order
+ *  - ] marks the end of a contour
+ *  - [[ marks the start of a sequence of control points
+ *  - ]] marks the end of a sequence of control points
+ *  - arc marks an arc edge, the next value is the angle in degrees
+ *  - value0 value1 marks a coordinate (control point or edge point)
+ *
+ * Tokens are separated by white space, commas and parentheses;
+ * tokens that are not recognized are ignored as are values
+ * that come before the first contour. A pair of values that
+ * is split across contours is not joined.
+ */
+class PathStreamReader:noncopyable
+{
+public:
+  /*!
+   * Ctor.
+   * \param buffer buffer holding the text to read, the
+   *               PathStreamReader retains a reference
+   *               to the buffer.
+   */
+  explicit
+  PathStreamReader(const reference_counted_ptr<const DataBufferBase> &buffer);
+
+  /*!
+   * Ctor.
+   * \param text text to read, the text is NOT copied and
+   *             must stay alive for the lifetime of the
+   *             PathStreamReader.
+   */
+  explicit
+  PathStreamReader(c_array<const uint8_t> text);
+
+  ~PathStreamReader();
+
+  /*!
+   * Returns the number of threads used to build the contours
+   * of each chunk read by read_contours(). Default value is 1.
+   */
+  unsigned int
+  number_threads(void) const;
+
+  /*!
+   * Set the value returned by number_threads(void) const.
+   * Values are clamped to be atleast 1.
+   * \param n value to use
+   */
+  PathStreamReader&
+  number_threads(unsigned int n);
+
+  /*!
+   * Read the next chunk of contours and add them to a \ref Path.
+   * Returns the number of contours read, which is less than
+   * max_contours only if the end of the text was reached.
+   * \param dst Path to which to add the contours
+   * \param max_contours maximum number of contours to read
+   */
+  unsigned int
+  read_contours(Path &dst, unsigned int max_contours);
+
+  /*!
+   * Returns true if all of the text has been read.
+   */
+  bool
+  at_end(void) const;
+
+  /*!
+   * Convenience function to read all of the contours of a
+   * text and add them to a \ref Path.
+   * \param dst Path to which to add the contours
+   * \param text text to read
+   * \param number_threads number of threads to use to build
+   *                       the contours
+   */
+  static
+  void
+  read_path(Path &dst, c_array<const uint8_t> text,
+            unsigned int number_threads = 1);
+
+private:
+  void *m_d;
+};
+
+/*! @} */
+}
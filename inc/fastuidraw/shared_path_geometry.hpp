@@ -0,0 +1,119 @@
+/*!
+ * \file shared_path_geometry.hpp
+ * \brief file shared_path_geometry.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/reference_counted.hpp>
+
+namespace fastuidraw  {
+
+/*!\addtogroup Paths
+ * @{
+ */
+
+/*!
+ * \brief
+ * A SharedPathGeometry is a share group of geometry for
+ * \ref Path objects; the Path objects given the same
+ * SharedPathGeometry via Path::share_geometry() whose
+ * contours are identical use one set of tessellations
+ * (together with their StrokedPath and FilledPath).
+ *
+ * The shared tessellations, and the SharedPathGeometry itself,
+ * use non-concurrent reference counts and create their data
+ * lazily. Hence a SharedPathGeometry and all the Path objects
+ * that use it are to be used from only one thread at a time;
+ * to draw the same geometry from several threads, give each
+ * thread its own SharedPathGeometry.
+ *
+ * Only identical coordinates are shared; contours that are
+ * translates of each other are not. The tessellation of a
+ * Path, and everything computed from it (filling, stroking,
+ * PathBoolean, bounding boxes), is in the coordinates of
+ * the Path, so a translated copy cannot use the same
+ * tessellation. To draw the same contours at different
+ * locations, create them once and position them with the
+ * transformation of the Painter.
+ */
+class SharedPathGeometry:
+    public reference_counted<SharedPathGeometry>::non_concurrent
+{
+public:
+  /*!
+   * \brief
+   * Statistics of a SharedPathGeometry.
+   */
+  class Statistics
+  {
+  public:
+    Statistics(void):
+      m_number_geometries(0),
+      m_number_paths(0),
+      m_bytes(0),
+      m_shared_bytes(0)
+    {}
+
+    /*!
+     * Number of distinct geometries that are shared.
+     */
+    unsigned int m_number_geometries;
+
+    /*!
+     * Number of Path objects that use a shared geometry.
+     */
+    unsigned int m_number_paths;
+
+    /*!
+     * Bytes used by the tessellations of the shared
+     * geometries, each geometry counted once, as estimated
+     * by TessellatedPath::memory_consumption().
+     */
+    uint64_t m_bytes;
+
+    /*!
+     * Bytes saved by sharing, i.e. the additional bytes
+     * that would be used if each Path using a shared
+     * geometry had its own copy of the tessellations
+     * generated so far.
+     */
+    uint64_t m_shared_bytes;
+  };
+
+  /*!
+   * Ctor.
+   */
+  SharedPathGeometry(void);
+
+  ~SharedPathGeometry();
+
+  /*!
+   * Returns the current statistics of the SharedPathGeometry.
+   */
+  Statistics
+  statistics(void) const;
+
+private:
+  friend class Path;
+  void *m_d;
+};
+
+/*! @} */
+
+}
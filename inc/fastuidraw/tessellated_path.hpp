@@ -33,6 +33,10 @@ namespace fastuidraw  {
 class Path;
 class StrokedPath;
 class FilledPath;
+namespace detail
+{
+  class TessellatedPathCacheAccess;
+}
 ///@endcond
 
 /*!\addtogroup Paths
@@ -55,6 +59,15 @@ class FilledPath;
  * as the \ref PathContour::interpolator_base objects of
  * the source \ref PathContour. In particular, for each contour
  * of a TessellatedPath, the closing edge is the last edge.
+ *
+ * A TessellatedPath stores its segments compactly, as separate
+ * arrays of points, arc data and distances, and derives the
+ * remaining fields of \ref segment when a segment is fetched.
+ * The arrays of \ref segment values returned by segment_data(),
+ * contour_segment_data() and edge_segment_data() are realized
+ * on the first call to any of them; sequential scans that only
+ * need points or a few segments should use contour_points()
+ * and segment_at() instead.
  */
 class TessellatedPath:
     public reference_counted<TessellatedPath>::non_concurrent
@@ -384,11 +397,36 @@ public:
   max_recursion(void) const;
 
   /*!
-   * Returns all the segment data
+   * Returns all the segment data. The array is realized
+   * from the compact storage of the TessellatedPath on
+   * the first call and then kept for the lifetime of the
+   * TessellatedPath.
    */
   c_array<const segment>
   segment_data(void) const;
 
+  /*!
+   * Returns the number of segments, i.e. the size
+   * of segment_data(), without realizing segment_data().
+   */
+  unsigned int
+  number_segments(void) const;
+
+  /*!
+   * Returns the named \ref segment of the named edge of
+   * the named contour computed from the compact storage
+   * of the TessellatedPath, i.e. the value of segment_data()[I]
+   * without realizing segment_data().
+   * \param contour which path contour to query, must have
+   *                that 0 <= contour < number_contours()
+   * \param edge which edge of the contour to query, must
+   *             have that 0 <= edge < number_edges(contour)
+   * \param I index of the segment, must be in the range
+   *          edge_range(contour, edge)
+   */
+  segment
+  segment_at(unsigned int contour, unsigned int edge, unsigned int I) const;
+
   /*!
    * Returns the number of contours
    */
@@ -416,6 +454,19 @@ public:
   c_array<const segment>
   contour_segment_data(unsigned int contour) const;
 
+  /*!
+   * Returns the points of the named contour: the start
+   * point of each segment of the contour followed by the
+   * end point of the last segment of the contour, i.e.
+   * the size of the returned array is one more than the
+   * number of segments of the contour. Element i is
+   * segment::m_start_pt of contour_segment_data(contour)[i].
+   * \param contour which path contour to query, must have
+   *                that 0 <= contour < number_contours()
+   */
+  c_array<const vec2>
+  contour_points(unsigned int contour) const;
+
   /*!
    * Returns the number of edges for the named contour
    * \param contour which path contour to query, must have
@@ -482,6 +533,18 @@ public:
   vec2
   bounding_box_size(void) const;
 
+  /*!
+   * Returns an estimate of the number of bytes used by this
+   * TessellatedPath, including segment_data() if it has been
+   * realized and the StrokedPath and FilledPath returned by
+   * stroked() and filled() if they have been constructed.
+   * The bytes of the StrokedPath and FilledPath are estimated
+   * from the number of segments since their attribute data is
+   * made on demand.
+   */
+  size_t
+  memory_consumption(void) const;
+
   /*!
    * Returns this TessellatedPath realized as a \ref Path;
    * this is rarely the same value as the original \ref Path
@@ -508,9 +571,37 @@ public:
   const reference_counted_ptr<const FilledPath>&
   filled(void) const;
 
+  /*!
+   * Create a TessellatedPath with fewer segments that approximates
+   * this TessellatedPath, made by removing points of each contour
+   * with the Douglas-Peucker algorithm so that each removed point
+   * is within tolerance of the segment that replaces it. The returned
+   * TessellatedPath has the same number of contours, but its edges
+   * are made from the edges of this TessellatedPath that begin at a
+   * retained point; its max_distance() is the max_distance() of this
+   * TessellatedPath plus tolerance. NOTE: will return a null-reference
+   * if \ref has_arcs() returns true.
+   * \param tolerance how far the removed points may be from the
+   *                  returned TessellatedPath
+   */
+  reference_counted_ptr<TessellatedPath>
+  create_simplified(float tolerance) const;
+
 private:
+  friend class detail::TessellatedPathCacheAccess;
+
   TessellatedPath(Refiner *p, float threshhold,
                   unsigned int additional_recursion_count);
+  TessellatedPath(const TessellatedPath &src, float tolerance);
+
+  /* Returns a value that is incremented each time data that
+   * is made on demand (the segment arrays, stroked() and
+   * filled()) is made; memory_consumption() only changes
+   * when this value changes.
+   */
+  unsigned int
+  lazy_generation(void) const;
+
   void *m_d;
 };
 
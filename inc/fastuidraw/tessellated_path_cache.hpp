@@ -0,0 +1,141 @@
+/*!
+ * \file tessellated_path_cache.hpp
+ * \brief file tessellated_path_cache.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include <fastuidraw/util/util.hpp>
+
+namespace fastuidraw  {
+
+/*!\addtogroup Paths
+ * @{
+ */
+
+/*!
+ * \brief
+ * TessellatedPathCache is the process-wide accounting of
+ * the TessellatedPath objects that \ref Path objects keep
+ * for Path::tessellation() and Path::arc_tessellation(),
+ * together with their StrokedPath and FilledPath. Each Path
+ * always keeps its coarsest tessellation; its finer levels of
+ * detail are evicted least-recently-used first whenever the
+ * bytes used by all tessellations exceeds the budget. An
+ * evicted level of detail is regenerated by the owning Path
+ * the next time it is requested.
+ *
+ * Eviction runs during calls to Path::tessellation() and
+ * Path::arc_tessellation() (of any Path) and when the budget
+ * is set. Evicting only marks a level of detail; the owning
+ * Path drops its reference to the TessellatedPath at the start
+ * of its next call to Path::tessellation() or
+ * Path::arc_tessellation(), so that eviction never modifies a
+ * Path other than the one being used. A TessellatedPath is
+ * freed once no other references to it remain. The bytes of
+ * an evicted level of detail are removed from Statistics when
+ * it is evicted. Different Path objects may be used from
+ * different threads; as with Path objects in general, a single
+ * Path should not be used from more than one thread at a time.
+ */
+class TessellatedPathCache
+{
+public:
+  /*!
+   * \brief
+   * Statistics of the TessellatedPathCache.
+   */
+  class Statistics
+  {
+  public:
+    Statistics(void):
+      m_budget(0),
+      m_bytes_used(0),
+      m_bytes_pinned(0),
+      m_number_tessellations(0),
+      m_number_evicted(0),
+      m_bytes_evicted(0)
+    {}
+
+    /*!
+     * The budget in bytes, see budget(uint64_t).
+     */
+    uint64_t m_budget;
+
+    /*!
+     * Bytes used by all TessellatedPath objects held
+     * by Path objects, as estimated by
+     * TessellatedPath::memory_consumption().
+     */
+    uint64_t m_bytes_used;
+
+    /*!
+     * Bytes of \ref m_bytes_used that cannot be evicted,
+     * i.e. the bytes of the coarsest tessellation of
+     * each Path.
+     */
+    uint64_t m_bytes_pinned;
+
+    /*!
+     * Number of TessellatedPath objects held by
+     * Path objects.
+     */
+    unsigned int m_number_tessellations;
+
+    /*!
+     * Number of TessellatedPath objects evicted
+     * since the start of the process.
+     */
+    uint64_t m_number_evicted;
+
+    /*!
+     * Bytes evicted since the start of the process.
+     */
+    uint64_t m_bytes_evicted;
+  };
+
+  /*!
+   * Set the budget in bytes for all TessellatedPath objects
+   * held by Path objects; if the new budget is exceeded,
+   * finer levels of detail are evicted immediately. A value
+   * of 0 indicates no budget, i.e. nothing is evicted. The
+   * default value is 0.
+   * \param bytes budget in bytes
+   */
+  static
+  void
+  budget(uint64_t bytes);
+
+  /*!
+   * Returns the value set by budget(uint64_t).
+   */
+  static
+  uint64_t
+  budget(void);
+
+  /*!
+   * Returns the current statistics of the cache.
+   */
+  static
+  Statistics
+  statistics(void);
+};
+
+/*! @} */
+
+}
@@ -0,0 +1,94 @@
+/*!
+ * \file character_coverage.hpp
+ * \brief file character_coverage.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include <fastuidraw/util/util.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Text
+ * @{
+ */
+
+  /*!
+   * \brief
+   * A CharacterCoverage is a set of character codes, typically
+   * the character codes a font has glyphs for. The set is stored
+   * as a bitset for each block of 256 consecutive character codes
+   * that has an element, so that asking if a character code is in
+   * the set is a search over the blocks followed by a bit test.
+   */
+  class CharacterCoverage
+  {
+  public:
+    /*!
+     * Ctor, initializes the set as empty.
+     */
+    CharacterCoverage(void);
+
+    /*!
+     * Copy ctor.
+     * \param obj value from which to copy
+     */
+    CharacterCoverage(const CharacterCoverage &obj);
+
+    ~CharacterCoverage();
+
+    /*!
+     * Assignment operator.
+     * \param obj value from which to copy
+     */
+    CharacterCoverage&
+    operator=(const CharacterCoverage &obj);
+
+    /*!
+     * Swap operation
+     * \param obj object with which to swap
+     */
+    void
+    swap(CharacterCoverage &obj);
+
+    /*!
+     * Add a character code to the set. Adding character
+     * codes in increasing order is the fastest.
+     * \param character_code character code to add
+     */
+    CharacterCoverage&
+    add(uint32_t character_code);
+
+    /*!
+     * Returns true if a character code is in the set.
+     * \param character_code character code to query
+     */
+    bool
+    contains(uint32_t character_code) const;
+
+    /*!
+     * Returns the number of character codes in the set.
+     */
+    unsigned int
+    number_characters(void) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+}
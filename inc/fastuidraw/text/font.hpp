@@ -24,6 +24,7 @@
 #include <fastuidraw/util/vecN.hpp>
 #include <fastuidraw/path.hpp>
 #include <fastuidraw/text/font_properties.hpp>
+#include <fastuidraw/text/character_coverage.hpp>
 #include <fastuidraw/text/glyph_render_data.hpp>
 
 namespace fastuidraw
@@ -75,6 +76,24 @@ namespace fastuidraw
     uint32_t
     glyph_code(uint32_t pcharacter_code) const = 0;
 
+    /*!
+     * May be implemented by a derived class to return the
+     * set of character codes for which glyph_code() returns
+     * a non-zero value; a caller can then skip fonts that do
+     * not have a character without calling glyph_code(). A
+     * return value of nullptr indicates that the font does
+     * not provide the set and that glyph_code() must be
+     * called. The returned object must stay valid for the
+     * lifetime of the font. Default implementation is to
+     * return nullptr.
+     */
+    virtual
+    const CharacterCoverage*
+    character_coverage(void) const
+    {
+      return nullptr;
+    }
+
     /*!
      * To be implemented by a derived class to indicate
      * that it will return non-nullptr in
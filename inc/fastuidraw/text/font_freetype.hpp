@@ -36,7 +36,10 @@ namespace fastuidraw
    *
    * The conversion from character codes to glyph codes
    * for FontFreeType, i.e. glyph_code(uint32_t) const,
-   * is performed by libfreetype's FT_Get_Char_Index().
+   * is performed by libfreetype's FT_Get_Char_Index()
+   * and the character_coverage() of a FontFreeType is
+   * built by walking the character map of the face with
+   * FT_Get_First_Char() and FT_Get_Next_Char().
    */
   class FontFreeType:public FontBase
   {
@@ -123,6 +126,25 @@ namespace fastuidraw
       RenderParams&
       curve_pair_pixel_size(unsigned int v);
 
+      /*!
+       * The maximum number of FreeTypeFace objects a FontFreeType
+       * creates to generate glyph data from multiple threads at
+       * the same time. The FreeTypeFace objects are created as
+       * needed: the first when glyph data is first generated and
+       * another only when all of them are in use by other threads.
+       * A value of 0 is treated as 1.
+       */
+      unsigned int
+      max_number_faces(void) const;
+
+      /*!
+       * Set the value returned by max_number_faces(void) const,
+       * initial value is 8.
+       * \param v value
+       */
+      RenderParams&
+      max_number_faces(unsigned int v);
+
     private:
       void *m_d;
     };
@@ -203,6 +225,14 @@ namespace fastuidraw
     uint32_t
     glyph_code(uint32_t pcharacter_code) const;
 
+    /*!
+     * Returns the character codes of the character map of
+     * the font, computed the first time it is called.
+     */
+    virtual
+    const CharacterCoverage*
+    character_coverage(void) const;
+
     virtual
     bool
     can_create_rendering_data(enum glyph_type tp) const;
@@ -91,11 +91,27 @@ namespace fastuidraw
       virtual
       FT_Face
       create_face_implement(FT_Library lib) const = 0;
+
+      /*!
+       * To be optionally implemented by a derived class to return
+       * the bytes from which create_face_implement() creates the
+       * FT_Face, if any. The returned FreeTypeFace holds a reference
+       * to them so that they outlive the FT_Face even if the
+       * GeneratorBase is released first. Default implementation
+       * returns nullptr.
+       */
+      virtual
+      reference_counted_ptr<const DataBufferBase>
+      face_data(void) const;
     };
 
     /*!
      * \brief Implementation of GeneratorBase to create a FreeTypeFace
-     *        from a face index / file pair via lib FreeType's FT_New_Face
+     *        from a face index / file pair. The file is mapped into
+     *        memory (see MappedDataBuffer) when the first FreeTypeFace
+     *        is created and all FreeTypeFace objects made by the
+     *        GeneratorFile are created from those bytes via lib
+     *        FreeType's FT_New_Memory_Face.
      */
     class GeneratorFile:public GeneratorBase
     {
@@ -114,6 +130,10 @@ namespace fastuidraw
       FT_Face
       create_face_implement(FT_Library lib) const;
 
+      virtual
+      reference_counted_ptr<const DataBufferBase>
+      face_data(void) const;
+
     private:
       void *m_d;
     };
@@ -137,8 +157,8 @@ namespace fastuidraw
                       int face_index);
 
       /*!
-       * Ctor. Provided as a convenience, a DataBuffer object is created
-       *        from the named file and used as the memory source.
+       * Ctor. Provided as a convenience, a MappedDataBuffer object is
+       *        created from the named file and used as the memory source.
        * \param filename name of file from which to source the created
        *                 FT_Face objects
        * \param face_index face index of file
@@ -152,6 +172,10 @@ namespace fastuidraw
       FT_Face
       create_face_implement(FT_Library lib) const;
 
+      virtual
+      reference_counted_ptr<const DataBufferBase>
+      face_data(void) const;
+
     private:
       void *m_d;
     };
@@ -162,9 +186,14 @@ namespace fastuidraw
      *        takes ownership of pFace and pFace will be deleted when
      *        the created FreeTypeFace is deleted.
      * \param pLib the FreeTypeLib that was used to create pFace
+     * \param pData if non-null, the bytes from which pFace was
+     *              created; the created FreeTypeFace keeps them
+     *              alive until pFace is deleted
      */
     FreeTypeFace(FT_Face pFace,
-                 const reference_counted_ptr<FreeTypeLib> &pLib);
+                 const reference_counted_ptr<FreeTypeLib> &pLib,
+                 const reference_counted_ptr<const DataBufferBase> &pData
+                 = reference_counted_ptr<const DataBufferBase>());
 
     ~FreeTypeFace();
 
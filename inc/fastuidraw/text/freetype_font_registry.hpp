@@ -0,0 +1,143 @@
+/*!
+ * \file freetype_font_registry.hpp
+ * \brief file freetype_font_registry.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/text/font_freetype.hpp>
+#include <fastuidraw/text/glyph_selector.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Text
+ * @{
+ */
+
+  /*!
+   * \brief
+   * A FreeTypeFontRegistry finds the scalable fonts of files
+   * and directories and makes for each a
+   * GlyphSelector::FontGeneratorBase whose \ref FontFreeType
+   * is only created when the GlyphSelector first needs the font.
+   * The FontProperties of the fonts of a file, together with the
+   * size and modification time of the file, can be saved to and
+   * loaded from a cache file so that a file whose size and
+   * modification time match its cache entry is not opened at
+   * all until one of its fonts is used.
+   */
+  class FreeTypeFontRegistry:
+    public reference_counted<FreeTypeFontRegistry>::default_base
+  {
+  public:
+    /*!
+     * Ctor.
+     * \param lib the FreeTypeLib used by the \ref FontFreeType objects
+     *            made by the font generators, a null value indicates
+     *            that each \ref FontFreeType uses a private FreeTypeLib
+     * \param render_params the \ref FontFreeType::RenderParams of the
+     *                      \ref FontFreeType objects made by the font
+     *                      generators
+     */
+    explicit
+    FreeTypeFontRegistry(const reference_counted_ptr<FreeTypeLib> &lib
+                         = reference_counted_ptr<FreeTypeLib>(),
+                         const FontFreeType::RenderParams &render_params
+                         = FontFreeType::RenderParams());
+
+    ~FreeTypeFontRegistry();
+
+    /*!
+     * Returns the number of threads used by add_path() to
+     * open the font files that are not in the cache. Default
+     * value is 1.
+     */
+    unsigned int
+    number_threads(void) const;
+
+    /*!
+     * Set the value returned by number_threads(void) const.
+     * Values are clamped to be atleast 1.
+     * \param n value to use
+     */
+    FreeTypeFontRegistry&
+    number_threads(unsigned int n);
+
+    /*!
+     * Load the entries of a cache file written by save_cache();
+     * the entries are used by later calls to add_path(). Returns
+     * routine_fail if the file could not be read.
+     * \param filename name of the cache file
+     */
+    enum return_code
+    load_cache(c_string filename);
+
+    /*!
+     * Write the entries of the files loaded by load_cache()
+     * and of the files added by add_path() to a cache file.
+     * Returns routine_fail if the file could not be written.
+     * \param filename name of the cache file
+     */
+    enum return_code
+    save_cache(c_string filename) const;
+
+    /*!
+     * Add the scalable fonts of a file or, if path names a
+     * directory, of all the files within the directory and
+     * its subdirectories. A file already added, including
+     * through a different path or a symbolic link, is skipped
+     * and each directory is walked at most once so that
+     * symbolic links forming a loop are not followed forever.
+     * Returns the number of fonts added.
+     * \param path file or directory to add
+     */
+    unsigned int
+    add_path(c_string path);
+
+    /*!
+     * Returns the number of fonts added by add_path().
+     */
+    unsigned int
+    number_fonts(void) const;
+
+    /*!
+     * Returns the font generator of a font added by add_path(). The
+     * FontProperties::source_label() of the font is the filename
+     * and face index separated by a colon.
+     * \param I which font, must have that 0 <= I < number_fonts()
+     */
+    const reference_counted_ptr<const GlyphSelector::FontGeneratorBase>&
+    font_generator(unsigned int I) const;
+
+    /*!
+     * Add the font generators of all fonts added by add_path()
+     * to a GlyphSelector with GlyphSelector::add_font_generator().
+     * Calling register_fonts() again on the same GlyphSelector,
+     * for example after more calls to add_path(), only adds the
+     * fonts that the GlyphSelector does not already have.
+     * \param selector GlyphSelector to which to add the fonts
+     */
+    void
+    register_fonts(GlyphSelector &selector) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+}
@@ -270,13 +270,39 @@ namespace fastuidraw
       unsigned int m_bottom;
     };
 
+    /*!
+     * Enumeration to specify how rectangles of texels are
+     * allocated from the layers of the texel store.
+     */
+    enum texel_allocator_t
+      {
+        /*!
+         * Allocate rectangles from a tree of nodes where
+         * an allocation that lands in an occupied node splits
+         * the node.
+         */
+        tree_texel_allocator,
+
+        /*!
+         * Allocate rectangles from shelves, i.e. horizontal
+         * strips whose height is the height of their rectangles
+         * rounded up to one of 4 classes per power of two. For
+         * the many small rectangles of glyphs, this packs tighter
+         * and allocates and deallocates faster than \ref
+         * tree_texel_allocator.
+         */
+        shelf_texel_allocator,
+      };
+
     /*!
      * Ctor.
      * \param ptexel_store GlyphAtlasTexelBackingStoreBase to which to store texel data
      * \param pgeometry_store GlyphAtlasGeometryBackingStoreBase to which to store geometry data
+     * \param ptexel_allocator specifies how rectangles of texels are allocated
      */
     GlyphAtlas(reference_counted_ptr<GlyphAtlasTexelBackingStoreBase> ptexel_store,
-               reference_counted_ptr<GlyphAtlasGeometryBackingStoreBase> pgeometry_store);
+               reference_counted_ptr<GlyphAtlasGeometryBackingStoreBase> pgeometry_store,
+               enum texel_allocator_t ptexel_allocator = tree_texel_allocator);
 
     virtual
     ~GlyphAtlas();
@@ -327,6 +353,13 @@ namespace fastuidraw
     void
     flush(void) const;
 
+    /*!
+     * Returns how rectangles of texels are allocated,
+     * as passed to the ctor.
+     */
+    enum texel_allocator_t
+    texel_allocator(void) const;
+
     /*!
      * Returns the texel store for this GlyphAtlas.
      */
@@ -34,8 +34,14 @@ namespace fastuidraw
   /*!
    * \brief
    * A GlyphCache represents a cache of glyphs and manages the uploading
-   * of the data to a GlyphAtlas. Methods are reentrant but NOT thread
-   * safe.
+   * of the data to a GlyphAtlas. Methods are thread safe. The glyphs
+   * are stored in several shards, each behind its own mutex, so that
+   * fetch_glyph() from different threads rarely contends; the data of
+   * a glyph is generated only once, outside of the shard's mutex, and
+   * uploading glyph data to the GlyphAtlas (Glyph::upload_to_atlas())
+   * is serialized across the GlyphCache. A Glyph value must not be
+   * used by a thread while another thread removes it from the cache
+   * with delete_glyph() or clear_cache().
    */
   class GlyphCache:public reference_counted<GlyphCache>::default_base
   {
@@ -89,5 +89,69 @@ namespace fastuidraw {
     {}
   };
 
+  /*!
+   * \brief
+   * Represents the read-only contents of a file, mapped into
+   * memory when possible so that the pages are shared with
+   * other mappings of the file (for example by other processes)
+   * and are only loaded when accessed. If the file cannot be
+   * mapped, the file is copied into memory instead.
+   */
+  class MappedDataBufferBackingStore
+  {
+  public:
+    /*!
+     * Ctor.
+     * \param filename name of file to map
+     */
+    explicit
+    MappedDataBufferBackingStore(c_string filename);
+
+    ~MappedDataBufferBackingStore();
+
+    /*!
+     * Return a pointer to the contents of the file.
+     */
+    c_array<const uint8_t>
+    data(void) const;
+
+    /*!
+     * Returns true if the file is mapped into memory, i.e.
+     * returns false if the file could not be mapped and was
+     * copied into memory instead.
+     */
+    bool
+    mapped(void) const;
+
+  private:
+    void *m_d;
+  };
+
+  /*!
+   * \brief
+   * MappedDataBuffer is an implementation of DataBufferBase where
+   * the data is the contents of a file mapped read-only into memory,
+   * see MappedDataBufferBackingStore. Since the mapping is read-only,
+   * DataBufferBase::data_rw() returns an empty array.
+   */
+  class MappedDataBuffer:
+    private MappedDataBufferBackingStore,
+    public DataBufferBase
+  {
+  public:
+    /*!
+     * Ctor. Initialize the MappedDataBuffer to be backed by
+     * the contents of a file.
+     * \param filename name of file to map
+     */
+    explicit
+    MappedDataBuffer(c_string filename):
+      MappedDataBufferBackingStore(filename),
+      DataBufferBase(data(), c_array<uint8_t>())
+    {}
+
+    using MappedDataBufferBackingStore::mapped;
+  };
+
 /*! @} */
 } //namespace fastuidraw
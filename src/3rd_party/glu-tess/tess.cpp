@@ -695,12 +695,16 @@ fastuidraw_gluTessEndPolygon( fastuidraw_GLUtesselator *tess )
   tess->state = T_DORMANT;
 
   if( tess->mesh == nullptr ) {
-    if( tess->callMesh == &noMesh && CALL_TESS_WINDING_OR_WINDING_DATA(0) == FALSE) {
+    if( tess->callMesh == &noMesh && CALL_TESS_WINDING_OR_WINDING_DATA(0) == FALSE
+        && !tess->emit_boundary && !tess->emit_boundary_data) {
 
       /* Try some special code to make the easy cases go quickly
        * (eg. convex polygons).  This code does NOT handle multiple contours,
        * intersections, edge flags, and of course it does not generate
-       * an explicit mesh either.
+       * an explicit mesh either. It also does not emit boundaries, so
+       * it is skipped when boundaries are requested; a self-intersecting
+       * contour (eg. a pentagram) can pass its fan orientation test
+       * while having regions of winding number other than +-1.
        */
       if( glu_fastuidraw_gl_renderCache( tess )) {
         tess->polygonData= nullptr;
@@ -22,6 +22,9 @@ include $(dir)/Rules.mk
 dir := $(d)/private
 include $(dir)/Rules.mk
 
+dir := $(d)/cpu_backend
+include $(dir)/Rules.mk
+
 dir := $(d)/glsl
 include $(dir)/Rules.mk
 
@@ -29,7 +32,8 @@ dir := $(d)/gl_backend
 include $(dir)/Rules.mk
 
 FASTUIDRAW_SOURCES += $(call filelist, image.cpp colorstop.cpp \
-	colorstop_atlas.cpp path.cpp tessellated_path.cpp)
+	colorstop_atlas.cpp path.cpp tessellated_path.cpp \
+	tessellated_path_cache.cpp path_stream_reader.cpp)
 
 NEGL_SRCS += $(call filelist, egl_binding.cpp)
 
@@ -17,11 +17,13 @@
  */
 
 
+#include <map>
+#include <set>
 #include <vector>
 #include <algorithm>
 #include <mutex>
 #include <fastuidraw/colorstop_atlas.hpp>
-#include "private/interval_allocator.hpp"
+#include "private/segregated_interval_allocator.hpp"
 #include "private/util_private.hpp"
 
 namespace
@@ -82,7 +84,7 @@ namespace
     /* Each layer has an interval allocator to allocate
      * and free "color stop arrays"
      */
-    std::vector<fastuidraw::interval_allocator*> m_layer_allocator;
+    std::vector<fastuidraw::segregated_interval_allocator*> m_layer_allocator;
 
     /* m_available_layers[key] gives indices into m_layer_allocator
      * for those layers for which largest_free_interval() returns
@@ -152,7 +154,7 @@ add_bookkeeping(int new_size)
   m_layer_allocator.resize(new_size, nullptr);
   for(int y = old_size; y < new_size; ++y)
     {
-      m_layer_allocator[y] = FASTUIDRAWnew fastuidraw::interval_allocator(width);
+      m_layer_allocator[y] = FASTUIDRAWnew fastuidraw::segregated_interval_allocator(width);
       S.insert(y);
     }
 }
@@ -261,7 +263,7 @@ fastuidraw::ColorStopAtlas::
 
   FASTUIDRAWassert(d->m_delayed_interval_freeing_counter == 0);
   FASTUIDRAWassert(d->m_allocated == 0);
-  for(interval_allocator *q : d->m_layer_allocator)
+  for(segregated_interval_allocator *q : d->m_layer_allocator)
     {
       FASTUIDRAWdelete(q);
     }
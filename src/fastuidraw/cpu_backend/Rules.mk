@@ -0,0 +1,16 @@
+# Begin standard header
+sp 		:= $(sp).x
+dirstack_$(sp)	:= $(d)
+d		:= $(dir)
+# End standard header
+
+dir := $(d)/private
+include $(dir)/Rules.mk
+
+FASTUIDRAW_SOURCES += $(call filelist, image_cpu.cpp colorstop_atlas_cpu.cpp \
+	glyph_atlas_cpu.cpp painter_backend_cpu.cpp)
+
+# Begin standard footer
+d		:= $(dirstack_$(sp))
+sp		:= $(basename $(sp))
+# End standard footer
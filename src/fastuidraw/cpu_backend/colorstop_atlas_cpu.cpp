@@ -0,0 +1,200 @@
+/*!
+ * \file colorstop_atlas_cpu.cpp
+ * \brief file colorstop_atlas_cpu.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/cpu_backend/colorstop_atlas_cpu.hpp>
+
+#include "../private/util_private.hpp"
+
+namespace
+{
+  class BackingStore:public fastuidraw::ColorStopBackingStore
+  {
+  public:
+    BackingStore(int w, int l):
+      fastuidraw::ColorStopBackingStore(w, l, true),
+      m_texels(w * l)
+    {}
+
+    virtual
+    void
+    set_data(int x, int l, int w,
+             fastuidraw::c_array<const fastuidraw::u8vec4> data);
+
+    virtual
+    void
+    flush(void)
+    {}
+
+    fastuidraw::vec4
+    fetch(float x, int layer) const;
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::ColorStopBackingStore>
+    create(int w, int l)
+    {
+      BackingStore *p;
+      p = FASTUIDRAWnew BackingStore(w, l);
+      return fastuidraw::reference_counted_ptr<fastuidraw::ColorStopBackingStore>(p);
+    }
+
+  protected:
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      m_texels.resize(dimensions().x() * new_num_layers);
+    }
+
+  private:
+    fastuidraw::vec4
+    texel(int x, int layer) const
+    {
+      const fastuidraw::u8vec4 &v(m_texels[x + layer * dimensions().x()]);
+      return fastuidraw::vec4(v.x(), v.y(), v.z(), v.w()) / 255.0f;
+    }
+
+    std::vector<fastuidraw::u8vec4> m_texels;
+  };
+
+  class ColorStopAtlasCPUParamsPrivate
+  {
+  public:
+    ColorStopAtlasCPUParamsPrivate(void):
+      m_width(1024),
+      m_num_layers(32)
+    {}
+
+    int m_width;
+    int m_num_layers;
+  };
+
+  class ColorStopAtlasCPUPrivate
+  {
+  public:
+    explicit
+    ColorStopAtlasCPUPrivate(const fastuidraw::cpu::ColorStopAtlasCPU::params &P):
+      m_params(P)
+    {}
+
+    fastuidraw::cpu::ColorStopAtlasCPU::params m_params;
+  };
+}
+
+//////////////////////////
+// BackingStore methods
+void
+BackingStore::
+set_data(int x, int l, int w,
+         fastuidraw::c_array<const fastuidraw::u8vec4> data)
+{
+  FASTUIDRAWunused(w);
+  FASTUIDRAWassert(data.size() == static_cast<unsigned int>(w));
+  std::copy(data.begin(), data.end(),
+            m_texels.begin() + x + l * dimensions().x());
+}
+
+fastuidraw::vec4
+BackingStore::
+fetch(float x, int layer) const
+{
+  int w(dimensions().x()), x0, x1;
+  float t;
+
+  layer = fastuidraw::t_max(0, fastuidraw::t_min(layer, dimensions().y() - 1));
+  x -= 0.5f;
+  t = x - std::floor(x);
+  x0 = static_cast<int>(std::floor(x));
+  x1 = x0 + 1;
+  x0 = fastuidraw::t_max(0, fastuidraw::t_min(x0, w - 1));
+  x1 = fastuidraw::t_max(0, fastuidraw::t_min(x1, w - 1));
+
+  return texel(x0, layer) * (1.0f - t) + texel(x1, layer) * t;
+}
+
+///////////////////////////////////////////////
+// fastuidraw::cpu::ColorStopAtlasCPU::params methods
+fastuidraw::cpu::ColorStopAtlasCPU::params::
+params(void)
+{
+  m_d = FASTUIDRAWnew ColorStopAtlasCPUParamsPrivate();
+}
+
+fastuidraw::cpu::ColorStopAtlasCPU::params::
+params(const params &obj)
+{
+  ColorStopAtlasCPUParamsPrivate *d;
+  d = static_cast<ColorStopAtlasCPUParamsPrivate*>(obj.m_d);
+  m_d = FASTUIDRAWnew ColorStopAtlasCPUParamsPrivate(*d);
+}
+
+fastuidraw::cpu::ColorStopAtlasCPU::params::
+~params()
+{
+  ColorStopAtlasCPUParamsPrivate *d;
+  d = static_cast<ColorStopAtlasCPUParamsPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+assign_swap_implement(fastuidraw::cpu::ColorStopAtlasCPU::params)
+setget_implement(fastuidraw::cpu::ColorStopAtlasCPU::params,
+                 ColorStopAtlasCPUParamsPrivate,
+                 int, width)
+setget_implement(fastuidraw::cpu::ColorStopAtlasCPU::params,
+                 ColorStopAtlasCPUParamsPrivate,
+                 int, num_layers)
+
+//////////////////////////////////////////////////////
+// fastuidraw::cpu::ColorStopAtlasCPU methods
+fastuidraw::cpu::ColorStopAtlasCPU::
+ColorStopAtlasCPU(const params &P):
+  fastuidraw::ColorStopAtlas(BackingStore::create(P.width(), P.num_layers()))
+{
+  m_d = FASTUIDRAWnew ColorStopAtlasCPUPrivate(P);
+}
+
+fastuidraw::cpu::ColorStopAtlasCPU::
+~ColorStopAtlasCPU()
+{
+  ColorStopAtlasCPUPrivate *d;
+  d = static_cast<ColorStopAtlasCPUPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+const fastuidraw::cpu::ColorStopAtlasCPU::params&
+fastuidraw::cpu::ColorStopAtlasCPU::
+param_values(void)
+{
+  ColorStopAtlasCPUPrivate *d;
+  d = static_cast<ColorStopAtlasCPUPrivate*>(m_d);
+  return d->m_params;
+}
+
+fastuidraw::vec4
+fastuidraw::cpu::ColorStopAtlasCPU::
+fetch(float x, int layer) const
+{
+  const BackingStore *p;
+  p = static_cast<const BackingStore*>(backing_store().get());
+  return p->fetch(x, layer);
+}
@@ -0,0 +1,254 @@
+/*!
+ * \file glyph_atlas_cpu.cpp
+ * \brief file glyph_atlas_cpu.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <algorithm>
+#include <fastuidraw/cpu_backend/glyph_atlas_cpu.hpp>
+#include "../private/util_private.hpp"
+
+namespace
+{
+  class TexelStoreCPU:public fastuidraw::GlyphAtlasTexelBackingStoreBase
+  {
+  public:
+    explicit
+    TexelStoreCPU(fastuidraw::ivec3 dims):
+      fastuidraw::GlyphAtlasTexelBackingStoreBase(dims, true),
+      m_texels(dims.x() * dims.y() * dims.z(), 0)
+    {}
+
+    virtual
+    void
+    set_data(int x, int y, int l, int w, int h,
+             fastuidraw::c_array<const uint8_t> data);
+
+    virtual
+    void
+    flush(void)
+    {}
+
+    uint8_t
+    texel(int x, int y, int l) const
+    {
+      fastuidraw::ivec3 dims(dimensions());
+
+      x = std::max(0, std::min(x, dims.x() - 1));
+      y = std::max(0, std::min(y, dims.y() - 1));
+      l = std::max(0, std::min(l, dims.z() - 1));
+      return m_texels[x + dims.x() * (y + dims.y() * l)];
+    }
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasTexelBackingStoreBase>
+    create(fastuidraw::ivec3 dims)
+    {
+      TexelStoreCPU *p;
+      p = FASTUIDRAWnew TexelStoreCPU(dims);
+      return fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasTexelBackingStoreBase>(p);
+    }
+
+  protected:
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      fastuidraw::ivec3 dims(dimensions());
+      m_texels.resize(dims.x() * dims.y() * new_num_layers, 0);
+    }
+
+  private:
+    std::vector<uint8_t> m_texels;
+  };
+
+  class GeometryStoreCPU:public fastuidraw::GlyphAtlasGeometryBackingStoreBase
+  {
+  public:
+    GeometryStoreCPU(unsigned int alignment, unsigned int number_blocks):
+      fastuidraw::GlyphAtlasGeometryBackingStoreBase(alignment, number_blocks, true),
+      m_data(alignment * number_blocks)
+    {}
+
+    virtual
+    void
+    set_values(unsigned int location,
+               fastuidraw::c_array<const fastuidraw::generic_data> pdata)
+    {
+      FASTUIDRAWassert(pdata.size() % alignment() == 0);
+      std::copy(pdata.begin(), pdata.end(),
+                m_data.begin() + location * alignment());
+    }
+
+    virtual
+    void
+    flush(void)
+    {}
+
+    fastuidraw::c_array<const fastuidraw::generic_data>
+    data(void) const
+    {
+      return fastuidraw::make_c_array(m_data);
+    }
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasGeometryBackingStoreBase>
+    create(unsigned int alignment, unsigned int number_floats)
+    {
+      GeometryStoreCPU *p;
+      alignment = std::max(1u, alignment);
+      p = FASTUIDRAWnew GeometryStoreCPU(alignment, number_floats / alignment);
+      return fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasGeometryBackingStoreBase>(p);
+    }
+
+  protected:
+    virtual
+    void
+    resize_implement(unsigned int new_size)
+    {
+      m_data.resize(new_size * alignment());
+    }
+
+  private:
+    std::vector<fastuidraw::generic_data> m_data;
+  };
+
+  class GlyphAtlasCPUParamsPrivate
+  {
+  public:
+    GlyphAtlasCPUParamsPrivate(void):
+      m_texel_store_dimensions(1024, 1024, 4),
+      m_number_floats(256 * 1024),
+      m_alignment(4),
+      m_texel_allocator(fastuidraw::GlyphAtlas::tree_texel_allocator)
+    {}
+
+    fastuidraw::ivec3 m_texel_store_dimensions;
+    unsigned int m_number_floats;
+    unsigned int m_alignment;
+    enum fastuidraw::GlyphAtlas::texel_allocator_t m_texel_allocator;
+  };
+
+  class GlyphAtlasCPUPrivate
+  {
+  public:
+    explicit
+    GlyphAtlasCPUPrivate(const fastuidraw::cpu::GlyphAtlasCPU::params &P):
+      m_params(P)
+    {}
+
+    fastuidraw::cpu::GlyphAtlasCPU::params m_params;
+  };
+}
+
+////////////////////////////////////
+// TexelStoreCPU methods
+void
+TexelStoreCPU::
+set_data(int x, int y, int l, int w, int h,
+         fastuidraw::c_array<const uint8_t> data)
+{
+  fastuidraw::ivec3 dims(dimensions());
+
+  FASTUIDRAWassert(data.size() == static_cast<unsigned int>(w * h));
+  for (int b = 0; b < h; ++b)
+    {
+      std::copy(data.begin() + b * w, data.begin() + (b + 1) * w,
+                m_texels.begin() + x + dims.x() * (y + b + dims.y() * l));
+    }
+}
+
+////////////////////////////////////////////
+// fastuidraw::cpu::GlyphAtlasCPU::params methods
+fastuidraw::cpu::GlyphAtlasCPU::params::
+params(void)
+{
+  m_d = FASTUIDRAWnew GlyphAtlasCPUParamsPrivate();
+}
+
+fastuidraw::cpu::GlyphAtlasCPU::params::
+params(const params &obj)
+{
+  GlyphAtlasCPUParamsPrivate *d;
+  d = static_cast<GlyphAtlasCPUParamsPrivate*>(obj.m_d);
+  m_d = FASTUIDRAWnew GlyphAtlasCPUParamsPrivate(*d);
+}
+
+fastuidraw::cpu::GlyphAtlasCPU::params::
+~params()
+{
+  GlyphAtlasCPUParamsPrivate *d;
+  d = static_cast<GlyphAtlasCPUParamsPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+assign_swap_implement(fastuidraw::cpu::GlyphAtlasCPU::params)
+setget_implement(fastuidraw::cpu::GlyphAtlasCPU::params, GlyphAtlasCPUParamsPrivate,
+                 fastuidraw::ivec3, texel_store_dimensions)
+setget_implement(fastuidraw::cpu::GlyphAtlasCPU::params, GlyphAtlasCPUParamsPrivate,
+                 unsigned int, number_floats)
+setget_implement(fastuidraw::cpu::GlyphAtlasCPU::params, GlyphAtlasCPUParamsPrivate,
+                 unsigned int, alignment)
+setget_implement(fastuidraw::cpu::GlyphAtlasCPU::params, GlyphAtlasCPUParamsPrivate,
+                 enum fastuidraw::GlyphAtlas::texel_allocator_t, texel_allocator)
+
+////////////////////////////////////////////
+// fastuidraw::cpu::GlyphAtlasCPU methods
+fastuidraw::cpu::GlyphAtlasCPU::
+GlyphAtlasCPU(const params &P):
+  GlyphAtlas(TexelStoreCPU::create(P.texel_store_dimensions()),
+             GeometryStoreCPU::create(P.alignment(), P.number_floats()),
+             P.texel_allocator())
+{
+  m_d = FASTUIDRAWnew GlyphAtlasCPUPrivate(P);
+}
+
+fastuidraw::cpu::GlyphAtlasCPU::
+~GlyphAtlasCPU()
+{
+  GlyphAtlasCPUPrivate *d;
+  d = static_cast<GlyphAtlasCPUPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+const fastuidraw::cpu::GlyphAtlasCPU::params&
+fastuidraw::cpu::GlyphAtlasCPU::
+param_values(void) const
+{
+  GlyphAtlasCPUPrivate *d;
+  d = static_cast<GlyphAtlasCPUPrivate*>(m_d);
+  return d->m_params;
+}
+
+uint8_t
+fastuidraw::cpu::GlyphAtlasCPU::
+texel(int x, int y, int layer) const
+{
+  const TexelStoreCPU *p;
+  p = static_cast<const TexelStoreCPU*>(texel_store().get());
+  return p->texel(x, y, layer);
+}
+
+fastuidraw::c_array<const fastuidraw::generic_data>
+fastuidraw::cpu::GlyphAtlasCPU::
+geometry_data(void) const
+{
+  const GeometryStoreCPU *p;
+  p = static_cast<const GeometryStoreCPU*>(geometry_store().get());
+  return p->data();
+}
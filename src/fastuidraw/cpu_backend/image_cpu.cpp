@@ -0,0 +1,547 @@
+/*!
+ * \file image_cpu.cpp
+ * \brief file image_cpu.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <algorithm>
+#include <fastuidraw/cpu_backend/image_cpu.hpp>
+#include "../private/util_private.hpp"
+#include "../private/block_compress.hpp"
+
+namespace
+{
+  /* Simple store of u8vec4 texels laid out
+   * layer by layer, each layer in row major
+   * order.
+   */
+  class TexelArray
+  {
+  public:
+    explicit
+    TexelArray(fastuidraw::ivec3 dims):
+      m_dims(dims),
+      m_texels(dims.x() * dims.y() * dims.z())
+    {}
+
+    void
+    resize(int new_num_layers)
+    {
+      m_dims.z() = new_num_layers;
+      m_texels.resize(m_dims.x() * m_dims.y() * m_dims.z());
+    }
+
+    fastuidraw::u8vec4&
+    texel(int x, int y, int l)
+    {
+      return m_texels[x + m_dims.x() * (y + m_dims.y() * l)];
+    }
+
+    fastuidraw::u8vec4
+    clamped_texel(int x, int y, int l) const
+    {
+      x = std::max(0, std::min(x, m_dims.x() - 1));
+      y = std::max(0, std::min(y, m_dims.y() - 1));
+      l = std::max(0, std::min(l, m_dims.z() - 1));
+      return m_texels[x + m_dims.x() * (y + m_dims.y() * l)];
+    }
+
+  private:
+    fastuidraw::ivec3 m_dims;
+    std::vector<fastuidraw::u8vec4> m_texels;
+  };
+
+  /* Store of 4x4 compressed blocks laid out
+   * layer by layer, each layer in row major
+   * order of blocks.
+   */
+  class BlockArray
+  {
+  public:
+    BlockArray(fastuidraw::ivec3 dims,
+               enum fastuidraw::AtlasColorBackingStoreBase::compression_t tp):
+      m_type(tp),
+      m_bytes_per_block(fastuidraw::detail::block_compression_bytes_per_block(tp)),
+      m_dims(dims),
+      m_blocks_per_row(dims.x() / 4),
+      m_blocks_per_layer(m_blocks_per_row * (dims.y() / 4)),
+      m_bytes(m_bytes_per_block * m_blocks_per_layer * dims.z())
+    {}
+
+    void
+    resize(int new_num_layers)
+    {
+      m_dims.z() = new_num_layers;
+      m_bytes.resize(m_bytes_per_block * m_blocks_per_layer * m_dims.z());
+    }
+
+    /* (x, y) is the texel coordinate of the top-left
+     * corner of the block, i.e. a multiple of 4.
+     */
+    uint8_t*
+    block(int x, int y, int l)
+    {
+      return &m_bytes[block_offset(x, y, l)];
+    }
+
+    unsigned int
+    bytes_per_block(void) const
+    {
+      return m_bytes_per_block;
+    }
+
+    fastuidraw::u8vec4
+    clamped_texel(int x, int y, int l) const
+    {
+      x = std::max(0, std::min(x, m_dims.x() - 1));
+      y = std::max(0, std::min(y, m_dims.y() - 1));
+      l = std::max(0, std::min(l, m_dims.z() - 1));
+      return fastuidraw::detail::block_decompress_texel(m_type, &m_bytes[block_offset(x, y, l)],
+                                                        x & 3, y & 3);
+    }
+
+  private:
+    unsigned int
+    block_offset(int x, int y, int l) const
+    {
+      return m_bytes_per_block * ((x >> 2) + m_blocks_per_row * (y >> 2) + m_blocks_per_layer * l);
+    }
+
+    enum fastuidraw::AtlasColorBackingStoreBase::compression_t m_type;
+    unsigned int m_bytes_per_block;
+    fastuidraw::ivec3 m_dims;
+    int m_blocks_per_row, m_blocks_per_layer;
+    std::vector<uint8_t> m_bytes;
+  };
+
+  class ColorBackingStoreCPU:public fastuidraw::AtlasColorBackingStoreBase
+  {
+  public:
+    ColorBackingStoreCPU(int log2_tile_size, int log2_num_tiles_per_row_per_col, int number_layers,
+                         enum fastuidraw::AtlasColorBackingStoreBase::compression_t tp):
+      fastuidraw::AtlasColorBackingStoreBase(store_size(log2_tile_size, log2_num_tiles_per_row_per_col, number_layers),
+                                             true, tp),
+      m_texels(tp == uncompressed ? dimensions() : fastuidraw::ivec3(0, 0, 0)),
+      m_blocks(tp == uncompressed ? fastuidraw::ivec3(0, 0, 0) : dimensions(),
+               tp)
+    {
+      FASTUIDRAWassert(tp == uncompressed || log2_tile_size >= 2);
+    }
+
+    virtual
+    void
+    set_data(int mipmap_level, fastuidraw::ivec2 dst_xy, int dst_l, fastuidraw::ivec2 src_xy,
+             unsigned int size, const fastuidraw::ImageSourceBase &data);
+    virtual
+    void
+    set_data(int mipmap_level, fastuidraw::ivec2 dst_xy, int dst_l,
+             unsigned int size, fastuidraw::u8vec4 color_value);
+
+    virtual
+    void
+    flush(void)
+    {}
+
+    fastuidraw::u8vec4
+    texel(int x, int y, int l) const
+    {
+      return (compression() == uncompressed) ?
+        m_texels.clamped_texel(x, y, l) :
+        m_blocks.clamped_texel(x, y, l);
+    }
+
+    static
+    fastuidraw::ivec3
+    store_size(int log2_tile_size, int log2_num_tiles_per_row_per_col, int num_layers);
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::AtlasColorBackingStoreBase>
+    create(int log2_tile_size, int log2_num_tiles_per_row_per_col, int num_layers,
+           enum fastuidraw::AtlasColorBackingStoreBase::compression_t tp)
+    {
+      ColorBackingStoreCPU *p;
+      p = FASTUIDRAWnew ColorBackingStoreCPU(log2_tile_size, log2_num_tiles_per_row_per_col, num_layers, tp);
+      return fastuidraw::reference_counted_ptr<fastuidraw::AtlasColorBackingStoreBase>(p);
+    }
+
+  protected:
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      if (compression() == uncompressed)
+        {
+          m_texels.resize(new_num_layers);
+        }
+      else
+        {
+          m_blocks.resize(new_num_layers);
+        }
+    }
+
+  private:
+    /* compress size-by-size texels and place the blocks
+     * with the top-left block at dst_xy
+     */
+    void
+    set_blocks(fastuidraw::ivec2 dst_xy, int dst_l, unsigned int size,
+               fastuidraw::c_array<const fastuidraw::u8vec4> texels);
+
+    /* only one of m_texels and m_blocks is non-empty */
+    TexelArray m_texels;
+    BlockArray m_blocks;
+  };
+
+  class IndexBackingStoreCPU:public fastuidraw::AtlasIndexBackingStoreBase
+  {
+  public:
+    IndexBackingStoreCPU(int log2_tile_size,
+                         int log2_num_index_tiles_per_row_per_col,
+                         int num_layers):
+      fastuidraw::AtlasIndexBackingStoreBase(store_size(log2_tile_size, log2_num_index_tiles_per_row_per_col, num_layers),
+                                             true),
+      m_texels(dimensions())
+    {}
+
+    virtual
+    void
+    set_data(int x, int y, int l,
+             int w, int h,
+             fastuidraw::c_array<const fastuidraw::ivec3> data,
+             int slack,
+             const fastuidraw::AtlasColorBackingStoreBase *C,
+             int pcolor_tile_size)
+    {
+      FASTUIDRAWunused(slack);
+      FASTUIDRAWunused(C);
+      FASTUIDRAWunused(pcolor_tile_size);
+      set_data(x, y, l, w, h, data);
+    }
+
+    virtual
+    void
+    set_data(int x, int y, int l,
+             int w, int h,
+             fastuidraw::c_array<const fastuidraw::ivec3> data);
+
+    virtual
+    void
+    flush(void)
+    {}
+
+    fastuidraw::u8vec4
+    texel(int x, int y, int l) const
+    {
+      return m_texels.clamped_texel(x, y, l);
+    }
+
+    static
+    fastuidraw::ivec3
+    store_size(int log2_tile_size,
+               int log2_num_index_tiles_per_row_per_col,
+               int num_layers);
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::AtlasIndexBackingStoreBase>
+    create(int log2_tile_size,
+           int log2_num_index_tiles_per_row_per_col,
+           int num_layers)
+    {
+      IndexBackingStoreCPU *p;
+      p = FASTUIDRAWnew IndexBackingStoreCPU(log2_tile_size,
+                                            log2_num_index_tiles_per_row_per_col,
+                                            num_layers);
+      return fastuidraw::reference_counted_ptr<fastuidraw::AtlasIndexBackingStoreBase>(p);
+    }
+
+  protected:
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      m_texels.resize(new_num_layers);
+    }
+
+  private:
+    /*
+     * Data packed is the same as the GL backend:
+     *  - .x    ===> which x-tile.
+     *  - .y    ===> which y-tile.
+     *  - .z/.w ===> which layer packed as layer = z + 256 * w
+     */
+    TexelArray m_texels;
+  };
+
+  class ImageAtlasCPUParamsPrivate
+  {
+  public:
+    ImageAtlasCPUParamsPrivate(void):
+      m_log2_color_tile_size(5),
+      m_log2_num_color_tiles_per_row_per_col(4),
+      m_num_color_layers(1),
+      m_log2_index_tile_size(2),
+      m_log2_num_index_tiles_per_row_per_col(6),
+      m_num_index_layers(4),
+      m_color_compression(fastuidraw::AtlasColorBackingStoreBase::uncompressed)
+    {}
+
+    int m_log2_color_tile_size;
+    int m_log2_num_color_tiles_per_row_per_col;
+    int m_num_color_layers;
+    int m_log2_index_tile_size;
+    int m_log2_num_index_tiles_per_row_per_col;
+    int m_num_index_layers;
+    enum fastuidraw::AtlasColorBackingStoreBase::compression_t m_color_compression;
+  };
+
+  class ImageAtlasCPUPrivate
+  {
+  public:
+    ImageAtlasCPUPrivate(const fastuidraw::cpu::ImageAtlasCPU::params &P):
+      m_params(P)
+    {}
+
+    fastuidraw::cpu::ImageAtlasCPU::params m_params;
+  };
+
+} //namespace
+
+////////////////////////////////////////////
+// ColorBackingStoreCPU methods
+void
+ColorBackingStoreCPU::
+set_data(int mipmap_level, fastuidraw::ivec2 dst_xy, int dst_l, fastuidraw::ivec2 src_xy,
+         unsigned int size, const fastuidraw::ImageSourceBase &image_data)
+{
+  using namespace fastuidraw;
+
+  /* the CPU backend only samples from the base level */
+  if (mipmap_level != 0)
+    {
+      return;
+    }
+
+  std::vector<u8vec4> data_storage(size * size);
+  image_data.fetch_texels(mipmap_level, src_xy, size, size,
+                          make_c_array(data_storage));
+
+  if (compression() != uncompressed)
+    {
+      set_blocks(dst_xy, dst_l, size, make_c_array(data_storage));
+      return;
+    }
+
+  for (unsigned int y = 0, idx = 0; y < size; ++y)
+    {
+      for (unsigned int x = 0; x < size; ++x, ++idx)
+        {
+          m_texels.texel(dst_xy.x() + x, dst_xy.y() + y, dst_l) = data_storage[idx];
+        }
+    }
+}
+
+void
+ColorBackingStoreCPU::
+set_data(int mipmap_level, fastuidraw::ivec2 dst_xy, int dst_l,
+         unsigned int size, fastuidraw::u8vec4 color_value)
+{
+  if (mipmap_level != 0)
+    {
+      return;
+    }
+
+  if (compression() != uncompressed)
+    {
+      std::vector<fastuidraw::u8vec4> data_storage(size * size, color_value);
+      set_blocks(dst_xy, dst_l, size, fastuidraw::make_c_array(data_storage));
+      return;
+    }
+
+  for (unsigned int y = 0; y < size; ++y)
+    {
+      for (unsigned int x = 0; x < size; ++x)
+        {
+          m_texels.texel(dst_xy.x() + x, dst_xy.y() + y, dst_l) = color_value;
+        }
+    }
+}
+
+void
+ColorBackingStoreCPU::
+set_blocks(fastuidraw::ivec2 dst_xy, int dst_l, unsigned int size,
+           fastuidraw::c_array<const fastuidraw::u8vec4> texels)
+{
+  using namespace fastuidraw;
+
+  unsigned int bytes_per_block(m_blocks.bytes_per_block());
+  unsigned int blocks_per_row(size / 4);
+  std::vector<uint8_t> blocks(bytes_per_block * blocks_per_row * blocks_per_row);
+
+  /* tiles are aligned to the color tile size, which is
+   * a multiple of 4, so blocks never straddle tiles
+   */
+  FASTUIDRAWassert(size % 4 == 0);
+  FASTUIDRAWassert(dst_xy.x() % 4 == 0 && dst_xy.y() % 4 == 0);
+
+  detail::block_compress(compression(), size, size, texels, make_c_array(blocks));
+  for (unsigned int by = 0; by < blocks_per_row; ++by)
+    {
+      std::copy(blocks.begin() + by * blocks_per_row * bytes_per_block,
+                blocks.begin() + (by + 1) * blocks_per_row * bytes_per_block,
+                m_blocks.block(dst_xy.x(), dst_xy.y() + 4 * by, dst_l));
+    }
+}
+
+fastuidraw::ivec3
+ColorBackingStoreCPU::
+store_size(int log2_tile_size, int log2_num_tiles_per_row_per_col, int num_layers)
+{
+  /* Because the index type is an 8-bit integer, log2_num_tiles_per_row_per_col
+   * must be clamped to 8.
+   */
+  log2_num_tiles_per_row_per_col = std::max(1, std::min(8, log2_num_tiles_per_row_per_col));
+  int v(1 << (log2_num_tiles_per_row_per_col + log2_tile_size));
+  return fastuidraw::ivec3(v, v, num_layers);
+}
+
+//////////////////////////////////////////
+// IndexBackingStoreCPU methods
+void
+IndexBackingStoreCPU::
+set_data(int x, int y, int l,
+         int w, int h,
+         fastuidraw::c_array<const fastuidraw::ivec3> data)
+{
+  for(int idx = 0, b = 0; b < h; ++b)
+    {
+      for(int a = 0; a < w; ++a, ++idx)
+        {
+          fastuidraw::u8vec4 &dst(m_texels.texel(x + a, y + b, l));
+
+          dst.x() = data[idx].x();
+          dst.y() = data[idx].y();
+          dst.z() = ( data[idx].z() ) & 0xFF;
+          dst.w() = ( data[idx].z() ) >> 8;
+        }
+    }
+}
+
+fastuidraw::ivec3
+IndexBackingStoreCPU::
+store_size(int log2_tile_size, int log2_num_index_tiles_per_row_per_col, int num_layers)
+{
+  /* Size is just 2^(log2_tile_size + log2_num_index_tiles_per_row_per_col),
+   * however, because index is an 8 bit integer, log2_num_index_tiles_per_row_per_col
+   * must be capped to 8
+   */
+  log2_num_index_tiles_per_row_per_col = std::min(8, std::max(1, log2_num_index_tiles_per_row_per_col));
+  int v(1 << (log2_num_index_tiles_per_row_per_col + log2_tile_size));
+  return fastuidraw::ivec3(v, v, num_layers);
+}
+
+//////////////////////////////////////////////
+// fastuidraw::cpu::ImageAtlasCPU::params methods
+fastuidraw::cpu::ImageAtlasCPU::params::
+params(void)
+{
+  m_d = FASTUIDRAWnew ImageAtlasCPUParamsPrivate();
+}
+
+fastuidraw::cpu::ImageAtlasCPU::params::
+params(const params &obj)
+{
+  ImageAtlasCPUParamsPrivate *d;
+  d = static_cast<ImageAtlasCPUParamsPrivate*>(obj.m_d);
+  m_d = FASTUIDRAWnew ImageAtlasCPUParamsPrivate(*d);
+}
+
+fastuidraw::cpu::ImageAtlasCPU::params::
+~params()
+{
+  ImageAtlasCPUParamsPrivate *d;
+  d = static_cast<ImageAtlasCPUParamsPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+assign_swap_implement(fastuidraw::cpu::ImageAtlasCPU::params)
+setget_implement(fastuidraw::cpu::ImageAtlasCPU::params, ImageAtlasCPUParamsPrivate,
+                 int, log2_color_tile_size)
+setget_implement(fastuidraw::cpu::ImageAtlasCPU::params, ImageAtlasCPUParamsPrivate,
+                 int, log2_num_color_tiles_per_row_per_col)
+setget_implement(fastuidraw::cpu::ImageAtlasCPU::params, ImageAtlasCPUParamsPrivate,
+                 int, num_color_layers)
+setget_implement(fastuidraw::cpu::ImageAtlasCPU::params, ImageAtlasCPUParamsPrivate,
+                 int, log2_index_tile_size)
+setget_implement(fastuidraw::cpu::ImageAtlasCPU::params, ImageAtlasCPUParamsPrivate,
+                 int, log2_num_index_tiles_per_row_per_col)
+setget_implement(fastuidraw::cpu::ImageAtlasCPU::params, ImageAtlasCPUParamsPrivate,
+                 int, num_index_layers)
+setget_implement(fastuidraw::cpu::ImageAtlasCPU::params, ImageAtlasCPUParamsPrivate,
+                 enum fastuidraw::AtlasColorBackingStoreBase::compression_t, color_compression)
+
+/////////////////////////////////////////////////
+// fastuidraw::cpu::ImageAtlasCPU methods
+fastuidraw::cpu::ImageAtlasCPU::
+ImageAtlasCPU(const params &P):
+  fastuidraw::ImageAtlas(1 << P.log2_color_tile_size(), //color tile size
+                        1 << P.log2_index_tile_size(), //index tile size
+                        ColorBackingStoreCPU::create(P.log2_color_tile_size(),
+                                                     P.log2_num_color_tiles_per_row_per_col(),
+                                                     P.num_color_layers(),
+                                                     P.color_compression()),
+                        IndexBackingStoreCPU::create(P.log2_index_tile_size(),
+                                                     P.log2_num_index_tiles_per_row_per_col(),
+                                                     P.num_index_layers()))
+{
+  m_d = FASTUIDRAWnew ImageAtlasCPUPrivate(P);
+}
+
+fastuidraw::cpu::ImageAtlasCPU::
+~ImageAtlasCPU()
+{
+  ImageAtlasCPUPrivate *d;
+  d = static_cast<ImageAtlasCPUPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+const fastuidraw::cpu::ImageAtlasCPU::params&
+fastuidraw::cpu::ImageAtlasCPU::
+param_values(void) const
+{
+  ImageAtlasCPUPrivate *d;
+  d = static_cast<ImageAtlasCPUPrivate*>(m_d);
+  return d->m_params;
+}
+
+fastuidraw::u8vec4
+fastuidraw::cpu::ImageAtlasCPU::
+color_texel(int x, int y, int layer) const
+{
+  const ColorBackingStoreCPU *p;
+  p = static_cast<const ColorBackingStoreCPU*>(color_store().get());
+  return p->texel(x, y, layer);
+}
+
+fastuidraw::u8vec4
+fastuidraw::cpu::ImageAtlasCPU::
+index_texel(int x, int y, int layer) const
+{
+  const IndexBackingStoreCPU *p;
+  p = static_cast<const IndexBackingStoreCPU*>(index_store().get());
+  return p->texel(x, y, layer);
+}
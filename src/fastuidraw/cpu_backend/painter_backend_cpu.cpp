@@ -0,0 +1,575 @@
+/*!
+ * \file painter_backend_cpu.cpp
+ * \brief file painter_backend_cpu.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <thread>
+#include <fastuidraw/cpu_backend/painter_backend_cpu.hpp>
+#include "private/painter_shader_registrar_cpu.hpp"
+#include "private/backend_shaders_cpu.hpp"
+#include "private/rasterizer_cpu.hpp"
+#include "../private/util_private.hpp"
+
+namespace
+{
+  class ConfigurationCPUPrivate
+  {
+  public:
+    ConfigurationCPUPrivate(void):
+      m_alignment(4),
+      m_attributes_per_buffer(512 * 512),
+      m_indices_per_buffer((m_attributes_per_buffer * 6) / 4),
+      m_data_blocks_per_store_buffer(1024 * 64),
+      m_number_threads(0),
+      m_log2_tile_size(6)
+    {}
+
+    int m_alignment;
+    unsigned int m_attributes_per_buffer;
+    unsigned int m_indices_per_buffer;
+    unsigned int m_data_blocks_per_store_buffer;
+    unsigned int m_number_threads;
+    unsigned int m_log2_tile_size;
+    fastuidraw::reference_counted_ptr<fastuidraw::cpu::ImageAtlasCPU> m_image_atlas;
+    fastuidraw::reference_counted_ptr<fastuidraw::cpu::ColorStopAtlasCPU> m_colorstop_atlas;
+    fastuidraw::reference_counted_ptr<fastuidraw::cpu::GlyphAtlasCPU> m_glyph_atlas;
+  };
+
+  /* The backing of the arrays of a PainterDraw, these are
+   * recycled by the PainterBackendCPU so that each map_draw()
+   * does not need to allocate.
+   */
+  class DrawBuffers:fastuidraw::noncopyable
+  {
+  public:
+    explicit
+    DrawBuffers(const fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU &config):
+      m_attributes(config.attributes_per_buffer()),
+      m_header_attributes(config.attributes_per_buffer()),
+      m_indices(config.indices_per_buffer()),
+      m_store(config.data_blocks_per_store_buffer() * config.alignment())
+    {}
+
+    std::vector<fastuidraw::PainterAttribute> m_attributes;
+    std::vector<uint32_t> m_header_attributes;
+    std::vector<fastuidraw::PainterIndex> m_indices;
+    std::vector<fastuidraw::generic_data> m_store;
+  };
+
+  class PainterBackendCPUPrivate
+  {
+  public:
+    PainterBackendCPUPrivate(const fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU &config,
+                             fastuidraw::cpu::PainterBackendCPU *p);
+
+    ~PainterBackendCPUPrivate();
+
+    static
+    unsigned int
+    compute_number_threads(const fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU &config);
+
+    DrawBuffers*
+    request_buffers(void);
+
+    void
+    release_buffers(DrawBuffers *b);
+
+    fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU m_config;
+    fastuidraw::cpu::detail::PainterShaderRegistrarCPU *m_registrar;
+    fastuidraw::cpu::detail::rasterizer_cpu m_rasterizer;
+    std::vector<DrawBuffers*> m_free_buffers;
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend::Surface> m_surface;
+  };
+
+  class DrawCommandCPU:public fastuidraw::PainterDraw
+  {
+  public:
+    explicit
+    DrawCommandCPU(PainterBackendCPUPrivate *pr);
+
+    virtual
+    ~DrawCommandCPU();
+
+    virtual
+    void
+    draw_break(const fastuidraw::PainterShaderGroup &old_shaders,
+               const fastuidraw::PainterShaderGroup &new_shaders,
+               unsigned int indices_written) const;
+
+    virtual
+    void
+    draw_break(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> &action,
+               unsigned int indices_written) const;
+
+    virtual
+    void
+    draw(void) const;
+
+  protected:
+    virtual
+    void
+    unmap_implement(unsigned int attributes_written,
+                    unsigned int indices_written,
+                    unsigned int data_store_written) const;
+
+  private:
+    typedef std::pair<unsigned int, fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> > action_entry;
+
+    PainterBackendCPUPrivate *m_pr;
+    DrawBuffers *m_buffers;
+    mutable unsigned int m_attributes_written, m_indices_written, m_data_store_written;
+    mutable std::vector<action_entry> m_actions;
+  };
+
+  /* T is PainterItemShaderCPU or PainterBlendShaderCPU */
+  template<typename T>
+  bool
+  shader_supported_implement(const fastuidraw::PainterShader *shader)
+  {
+    if (shader && shader->parent())
+      {
+        shader = shader->parent().get();
+      }
+    return dynamic_cast<const T*>(shader)
+      && !dynamic_cast<const fastuidraw::cpu::detail::UnsupportedShaderCPU*>(shader);
+  }
+}
+
+//////////////////////////////////////////
+// PainterBackendCPUPrivate methods
+PainterBackendCPUPrivate::
+PainterBackendCPUPrivate(const fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU &config,
+                         fastuidraw::cpu::PainterBackendCPU *p):
+  m_config(config),
+  m_rasterizer(compute_number_threads(config), config.log2_tile_size(), config.alignment())
+{
+  m_registrar = static_cast<fastuidraw::cpu::detail::PainterShaderRegistrarCPU*>(p->painter_shader_registrar().get());
+}
+
+PainterBackendCPUPrivate::
+~PainterBackendCPUPrivate()
+{
+  for (DrawBuffers *b : m_free_buffers)
+    {
+      FASTUIDRAWdelete(b);
+    }
+}
+
+unsigned int
+PainterBackendCPUPrivate::
+compute_number_threads(const fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU &config)
+{
+  unsigned int return_value(config.number_threads());
+
+  if (return_value == 0)
+    {
+      return_value = std::thread::hardware_concurrency();
+    }
+  return fastuidraw::t_max(1u, return_value);
+}
+
+DrawBuffers*
+PainterBackendCPUPrivate::
+request_buffers(void)
+{
+  DrawBuffers *return_value;
+
+  if (m_free_buffers.empty())
+    {
+      return_value = FASTUIDRAWnew DrawBuffers(m_config);
+    }
+  else
+    {
+      return_value = m_free_buffers.back();
+      m_free_buffers.pop_back();
+    }
+  return return_value;
+}
+
+void
+PainterBackendCPUPrivate::
+release_buffers(DrawBuffers *b)
+{
+  m_free_buffers.push_back(b);
+}
+
+//////////////////////////////////////////
+// DrawCommandCPU methods
+DrawCommandCPU::
+DrawCommandCPU(PainterBackendCPUPrivate *pr):
+  m_pr(pr),
+  m_buffers(pr->request_buffers()),
+  m_attributes_written(0),
+  m_indices_written(0),
+  m_data_store_written(0)
+{
+  m_attributes = fastuidraw::make_c_array(m_buffers->m_attributes);
+  m_header_attributes = fastuidraw::make_c_array(m_buffers->m_header_attributes);
+  m_indices = fastuidraw::make_c_array(m_buffers->m_indices);
+  m_store = fastuidraw::make_c_array(m_buffers->m_store);
+}
+
+DrawCommandCPU::
+~DrawCommandCPU()
+{
+  m_pr->release_buffers(m_buffers);
+}
+
+void
+DrawCommandCPU::
+draw_break(const fastuidraw::PainterShaderGroup &old_shaders,
+           const fastuidraw::PainterShaderGroup &new_shaders,
+           unsigned int indices_written) const
+{
+  /* the rasterizer fetches the shaders per triangle,
+   * thus a change of shaders does not break the draw.
+   */
+  FASTUIDRAWunused(old_shaders);
+  FASTUIDRAWunused(new_shaders);
+  FASTUIDRAWunused(indices_written);
+}
+
+void
+DrawCommandCPU::
+draw_break(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> &action,
+           unsigned int indices_written) const
+{
+  if (action)
+    {
+      m_actions.push_back(action_entry(indices_written, action));
+    }
+}
+
+void
+DrawCommandCPU::
+unmap_implement(unsigned int attributes_written,
+                unsigned int indices_written,
+                unsigned int data_store_written) const
+{
+  m_attributes_written = attributes_written;
+  m_indices_written = indices_written;
+  m_data_store_written = data_store_written;
+}
+
+void
+DrawCommandCPU::
+draw(void) const
+{
+  fastuidraw::cpu::detail::draw_input input;
+  fastuidraw::cpu::detail::rasterizer_cpu &r(m_pr->m_rasterizer);
+  unsigned int begin(0);
+
+  input.m_attributes = m_attributes.sub_array(0, m_attributes_written);
+  input.m_header_attributes = m_header_attributes.sub_array(0, m_attributes_written);
+  input.m_indices = m_indices.sub_array(0, m_indices_written);
+  input.m_store = m_store.sub_array(0, m_data_store_written);
+
+  r.shade_vertices(input);
+  for (const action_entry &a : m_actions)
+    {
+      r.draw_triangles(input, begin, a.first);
+      a.second->execute(nullptr);
+      begin = a.first;
+    }
+  r.draw_triangles(input, begin, m_indices_written);
+}
+
+//////////////////////////////////////////////
+// fastuidraw::cpu::PainterBackendCPU::SurfaceCPU methods
+fastuidraw::cpu::PainterBackendCPU::SurfaceCPU::
+SurfaceCPU(ivec2 dimensions)
+{
+  m_d = FASTUIDRAWnew detail::render_target(dimensions);
+}
+
+fastuidraw::cpu::PainterBackendCPU::SurfaceCPU::
+~SurfaceCPU()
+{
+  detail::render_target *d;
+  d = static_cast<detail::render_target*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+fastuidraw::c_array<const fastuidraw::u8vec4>
+fastuidraw::cpu::PainterBackendCPU::SurfaceCPU::
+pixels(void) const
+{
+  detail::render_target *d;
+  d = static_cast<detail::render_target*>(m_d);
+  return make_c_array(d->m_color);
+}
+
+fastuidraw::ivec2
+fastuidraw::cpu::PainterBackendCPU::SurfaceCPU::
+dimensions(void) const
+{
+  detail::render_target *d;
+  d = static_cast<detail::render_target*>(m_d);
+  return d->m_dimensions;
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::Image>
+fastuidraw::cpu::PainterBackendCPU::SurfaceCPU::
+image(const reference_counted_ptr<ImageAtlas> &atlas) const
+{
+  detail::render_target *d;
+  ivec2 pmin, pmax, wh;
+
+  d = static_cast<detail::render_target*>(m_d);
+  if (!d->clip_region(d->m_viewport, pmin, pmax))
+    {
+      return reference_counted_ptr<Image>();
+    }
+
+  wh = pmax - pmin;
+  std::vector<u8vec4> pixels(wh.x() * wh.y()), texels(wh.x() * wh.y());
+  for (int y = 0; y < wh.y(); ++y)
+    {
+      std::vector<u8vec4>::const_iterator src;
+
+      src = d->m_color.begin() + pmin.x() + (y + pmin.y()) * d->m_dimensions.x();
+      std::copy(src, src + wh.x(), pixels.begin() + y * wh.x());
+    }
+  convert_to_image_texels(wh, make_c_array(pixels), make_c_array(texels));
+
+  c_array<const u8vec4> level0(make_c_array(texels));
+  ImageSourceCArray src(uvec2(wh), c_array<const c_array<const u8vec4> >(&level0, 1));
+  return Image::create(atlas, wh.x(), wh.y(), src, 1,
+                       Image::premultiplied_rgba_format);
+}
+
+setget_implement(fastuidraw::cpu::PainterBackendCPU::SurfaceCPU,
+                 fastuidraw::cpu::detail::render_target,
+                 fastuidraw::PainterBackend::Surface::Viewport, viewport)
+setget_implement(fastuidraw::cpu::PainterBackendCPU::SurfaceCPU,
+                 fastuidraw::cpu::detail::render_target,
+                 const fastuidraw::vec4&, clear_color)
+
+//////////////////////////////////////////////
+// fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU methods
+fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU::
+ConfigurationCPU(void)
+{
+  m_d = FASTUIDRAWnew ConfigurationCPUPrivate();
+}
+
+fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU::
+ConfigurationCPU(const ConfigurationCPU &obj)
+{
+  ConfigurationCPUPrivate *d;
+  d = static_cast<ConfigurationCPUPrivate*>(obj.m_d);
+  m_d = FASTUIDRAWnew ConfigurationCPUPrivate(*d);
+}
+
+fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU::
+~ConfigurationCPU()
+{
+  ConfigurationCPUPrivate *d;
+  d = static_cast<ConfigurationCPUPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU&
+fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU::
+create_missing_atlases(void)
+{
+  ConfigurationCPUPrivate *d;
+  d = static_cast<ConfigurationCPUPrivate*>(m_d);
+
+  if (!d->m_image_atlas)
+    {
+      ImageAtlasCPU::params params;
+      d->m_image_atlas = FASTUIDRAWnew ImageAtlasCPU(params);
+    }
+
+  if (!d->m_glyph_atlas)
+    {
+      GlyphAtlasCPU::params params;
+      d->m_glyph_atlas = FASTUIDRAWnew GlyphAtlasCPU(params);
+    }
+
+  if (!d->m_colorstop_atlas)
+    {
+      ColorStopAtlasCPU::params params;
+      d->m_colorstop_atlas = FASTUIDRAWnew ColorStopAtlasCPU(params);
+    }
+
+  return *this;
+}
+
+assign_swap_implement(fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU)
+
+setget_implement(fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU, ConfigurationCPUPrivate,
+                 int, alignment)
+setget_implement(fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU, ConfigurationCPUPrivate,
+                 unsigned int, attributes_per_buffer)
+setget_implement(fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU, ConfigurationCPUPrivate,
+                 unsigned int, indices_per_buffer)
+setget_implement(fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU, ConfigurationCPUPrivate,
+                 unsigned int, data_blocks_per_store_buffer)
+setget_implement(fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU, ConfigurationCPUPrivate,
+                 unsigned int, number_threads)
+setget_implement(fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU, ConfigurationCPUPrivate,
+                 unsigned int, log2_tile_size)
+setget_implement(fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU, ConfigurationCPUPrivate,
+                 const fastuidraw::reference_counted_ptr<fastuidraw::cpu::ImageAtlasCPU>&, image_atlas)
+setget_implement(fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU, ConfigurationCPUPrivate,
+                 const fastuidraw::reference_counted_ptr<fastuidraw::cpu::ColorStopAtlasCPU>&, colorstop_atlas)
+setget_implement(fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU, ConfigurationCPUPrivate,
+                 const fastuidraw::reference_counted_ptr<fastuidraw::cpu::GlyphAtlasCPU>&, glyph_atlas)
+
+///////////////////////////////////////////////
+// fastuidraw::cpu::PainterBackendCPU methods
+fastuidraw::reference_counted_ptr<fastuidraw::cpu::PainterBackendCPU>
+fastuidraw::cpu::PainterBackendCPU::
+create(ConfigurationCPU config_cpu)
+{
+  detail::ShaderSetCreatorCPU creator;
+
+  config_cpu.create_missing_atlases();
+  return FASTUIDRAWnew PainterBackendCPU(config_cpu, creator.create_shader_set());
+}
+
+fastuidraw::cpu::PainterBackendCPU::
+PainterBackendCPU(const ConfigurationCPU &config_cpu,
+                  const PainterShaderSet &shaders):
+  PainterBackend(config_cpu.glyph_atlas(),
+                 config_cpu.image_atlas(),
+                 config_cpu.colorstop_atlas(),
+                 FASTUIDRAWnew detail::PainterShaderRegistrarCPU(),
+                 ConfigurationBase()
+                 .alignment(config_cpu.alignment())
+                 .blend_type(PainterBlendShader::framebuffer_fetch)
+                 .supports_bindless_texturing(false),
+                 shaders)
+{
+  m_d = FASTUIDRAWnew PainterBackendCPUPrivate(config_cpu, this);
+}
+
+fastuidraw::cpu::PainterBackendCPU::
+~PainterBackendCPU()
+{
+  PainterBackendCPUPrivate *d;
+  d = static_cast<PainterBackendCPUPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+const fastuidraw::cpu::PainterBackendCPU::ConfigurationCPU&
+fastuidraw::cpu::PainterBackendCPU::
+configuration_cpu(void) const
+{
+  PainterBackendCPUPrivate *d;
+  d = static_cast<PainterBackendCPUPrivate*>(m_d);
+  return d->m_config;
+}
+
+unsigned int
+fastuidraw::cpu::PainterBackendCPU::
+number_threads(void) const
+{
+  PainterBackendCPUPrivate *d;
+  d = static_cast<PainterBackendCPUPrivate*>(m_d);
+  return d->m_rasterizer.number_threads();
+}
+
+fastuidraw::c_array<const fastuidraw::c_string>
+fastuidraw::cpu::PainterBackendCPU::
+unsupported_shaders(void) const
+{
+  return detail::ShaderSetCreatorCPU::unsupported_shader_names();
+}
+
+bool
+fastuidraw::cpu::PainterBackendCPU::
+shader_supported(const reference_counted_ptr<PainterItemShader> &shader) const
+{
+  return shader_supported_implement<PainterItemShaderCPU>(shader.get());
+}
+
+bool
+fastuidraw::cpu::PainterBackendCPU::
+shader_supported(const reference_counted_ptr<PainterBlendShader> &shader) const
+{
+  return shader_supported_implement<PainterBlendShaderCPU>(shader.get());
+}
+
+unsigned int
+fastuidraw::cpu::PainterBackendCPU::
+attribs_per_mapping(void) const
+{
+  return configuration_cpu().attributes_per_buffer();
+}
+
+unsigned int
+fastuidraw::cpu::PainterBackendCPU::
+indices_per_mapping(void) const
+{
+  return configuration_cpu().indices_per_buffer();
+}
+
+void
+fastuidraw::cpu::PainterBackendCPU::
+on_pre_draw(const reference_counted_ptr<Surface> &surface,
+            bool clear_color_buffer,
+            const Surface::Viewport &damage_rect)
+{
+  PainterBackendCPUPrivate *d;
+  detail::render_target *target;
+  detail::shader_tables tables;
+
+  d = static_cast<PainterBackendCPUPrivate*>(m_d);
+  FASTUIDRAWassert(surface.dynamic_cast_ptr<SurfaceCPU>());
+
+  d->m_surface = surface;
+  target = static_cast<detail::render_target*>(surface.static_cast_ptr<SurfaceCPU>()->m_d);
+  if (clear_color_buffer)
+    {
+      target->clear_color_buffer(damage_rect);
+    }
+  target->clear_depth_buffer(damage_rect);
+
+  /* the shader tables are copied once per draw so that
+   * the rasterizer threads do not need to lock.
+   */
+  d->m_registrar->fetch_tables(tables);
+  d->m_rasterizer.begin(target, damage_rect, tables,
+                        d->m_config.image_atlas().get(),
+                        d->m_config.colorstop_atlas().get(),
+                        d->m_config.glyph_atlas().get());
+}
+
+void
+fastuidraw::cpu::PainterBackendCPU::
+on_post_draw(void)
+{
+  PainterBackendCPUPrivate *d;
+  d = static_cast<PainterBackendCPUPrivate*>(m_d);
+  d->m_rasterizer.end();
+  d->m_surface.clear();
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw>
+fastuidraw::cpu::PainterBackendCPU::
+map_draw(void)
+{
+  PainterBackendCPUPrivate *d;
+  d = static_cast<PainterBackendCPUPrivate*>(m_d);
+  return FASTUIDRAWnew DrawCommandCPU(d);
+}
@@ -0,0 +1,14 @@
+# Begin standard header
+sp 		:= $(sp).x
+dirstack_$(sp)	:= $(d)
+d		:= $(dir)
+# End standard header
+
+FASTUIDRAW_PRIVATE_SOURCES += $(call filelist, thread_pool.cpp \
+	painter_shader_registrar_cpu.cpp backend_shaders_cpu.cpp \
+	brush_cpu.cpp rasterizer_cpu.cpp)
+
+# Begin standard footer
+d		:= $(dirstack_$(sp))
+sp		:= $(basename $(sp))
+# End standard footer
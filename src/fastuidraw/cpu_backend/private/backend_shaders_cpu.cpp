@@ -0,0 +1,1042 @@
+/*!
+ * \file backend_shaders_cpu.cpp
+ * \brief file backend_shaders_cpu.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <cmath>
+#include <iostream>
+#include <fastuidraw/util/math.hpp>
+#include <fastuidraw/painter/stroked_point.hpp>
+#include <fastuidraw/painter/painter_stroke_params.hpp>
+#include <fastuidraw/painter/painter_dashed_stroke_params.hpp>
+#include <fastuidraw/cpu_backend/glyph_atlas_cpu.hpp>
+#include "backend_shaders_cpu.hpp"
+
+namespace
+{
+  enum stroke_render_pass_t
+    {
+      stroke_non_aa,
+      stroke_aa_pass1,
+      stroke_aa_pass2,
+
+      stroke_number_render_passes
+    };
+
+  /* sub-shaders of the unsupported shader standing in
+   * for all the shaders of a PainterStrokeShader
+   */
+  enum unsupported_stroke_shader_t
+    {
+      unsupported_non_aa,
+      unsupported_aa_pass1,
+      unsupported_aa_pass2,
+      unsupported_arc_non_aa,
+      unsupported_arc_aa_pass1,
+      unsupported_arc_aa_pass2,
+
+      unsupported_number_stroke_shaders
+    };
+
+  const fastuidraw::c_string unsupported_arc_stroke = "arc-stroking";
+  const fastuidraw::c_string unsupported_dashed_stroke = "dashed stroking";
+  const fastuidraw::c_string unsupported_curve_pair_glyph = "curve-pair glyphs";
+  const fastuidraw::c_string unsupported_w3c_blend = "W3C blend modes";
+
+  inline
+  float
+  sign_of(float v)
+  {
+    return (v > 0.0f) ? 1.0f : ((v < 0.0f) ? -1.0f : 0.0f);
+  }
+
+  inline
+  fastuidraw::vec2
+  unpack_unit_vector(float x, uint32_t b)
+  {
+    fastuidraw::vec2 return_value;
+
+    return_value.x() = x;
+    return_value.y() = std::sqrt(fastuidraw::t_max(0.0f, 1.0f - x * x));
+    if (b != 0u)
+      {
+        return_value.y() = -return_value.y();
+      }
+    return return_value;
+  }
+
+  inline
+  fastuidraw::vec2
+  circular_interpolate(const fastuidraw::vec2 &v0, const fastuidraw::vec2 &v1,
+                       float d, float interpolate)
+  {
+    float angle, c, s;
+
+    angle = std::acos(fastuidraw::t_max(-1.0f, fastuidraw::t_min(1.0f, d)));
+    c = std::cos(angle * interpolate);
+    s = std::sin(angle * interpolate) * sign_of(v0.x() * v1.y() - v1.x() * v0.y());
+    return fastuidraw::vec2(c * v0.x() - s * v0.y(),
+                            s * v0.x() + c * v0.y());
+  }
+
+  /* Port of the vertex shader utilities of the GLSL shaders
+   * (fastuidraw_align.vert.glsl and friends) that compute
+   * local distances and directions from pixel quantities.
+   */
+  class Transformer
+  {
+  public:
+    explicit
+    Transformer(const fastuidraw::cpu::PainterItemShaderCPU::VertexEnvironment &env):
+      m_matrix(env.m_item_matrix),
+      m_viewport(env.m_viewport_pixels),
+      m_recip_viewport(1.0f / env.m_viewport_pixels.x(),
+                       1.0f / env.m_viewport_pixels.y())
+    {}
+
+    fastuidraw::vec3
+    point(const fastuidraw::vec2 &p) const
+    {
+      return m_matrix * fastuidraw::vec3(p.x(), p.y(), 1.0f);
+    }
+
+    fastuidraw::vec3
+    direction(const fastuidraw::vec2 &v) const
+    {
+      return m_matrix * fastuidraw::vec3(v.x(), v.y(), 0.0f);
+    }
+
+    float
+    local_distance_from_pixel_distance(float pixel_distance,
+                                       const fastuidraw::vec3 &clip_p,
+                                       const fastuidraw::vec3 &clip_direction) const
+    {
+      fastuidraw::vec3 p, v;
+      fastuidraw::vec2 zeta;
+
+      p = fastuidraw::vec3(0.5f * m_viewport.x() * clip_p.x(),
+                           0.5f * m_viewport.y() * clip_p.y(),
+                           clip_p.z());
+      v = fastuidraw::vec3(0.5f * m_viewport.x() * clip_direction.x(),
+                           0.5f * m_viewport.y() * clip_direction.y(),
+                           clip_direction.z());
+      zeta = fastuidraw::vec2(v.x() * p.z() - v.z() * p.x(),
+                              v.y() * p.z() - v.z() * p.y());
+      return pixel_distance * p.z() * p.z()
+        / (-pixel_distance * std::abs(p.z() * v.z()) + zeta.magnitude());
+    }
+
+    /* Q is given as columns Q0, Q1 and so is adjQ */
+    void
+    compute_Q_adjoint_Q(const fastuidraw::vec3 &pclip_p,
+                        fastuidraw::vec2 &Q0, fastuidraw::vec2 &Q1,
+                        fastuidraw::vec2 &adjQ0, fastuidraw::vec2 &adjQ1) const
+    {
+      fastuidraw::vec3 clip(m_viewport.x() * pclip_p.x(),
+                            m_viewport.y() * pclip_p.y(),
+                            pclip_p.z());
+
+      Q0.x() = clip.z() * m_matrix(0, 0) - clip.x() * m_matrix(2, 0);
+      Q0.y() = clip.z() * m_matrix(1, 0) - clip.y() * m_matrix(2, 0);
+      Q1.x() = clip.z() * m_matrix(0, 1) - clip.x() * m_matrix(2, 1);
+      Q1.y() = clip.z() * m_matrix(1, 1) - clip.y() * m_matrix(2, 1);
+
+      adjQ0 = fastuidraw::vec2(Q1.y(), -Q0.y());
+      adjQ1 = fastuidraw::vec2(-Q1.x(), Q0.x());
+    }
+
+    fastuidraw::vec2
+    align_normal_to_screen(const fastuidraw::vec3 &clip_p,
+                           const fastuidraw::vec2 &n) const
+    {
+      fastuidraw::vec2 Q0, Q1, adjQ0, adjQ1, t, ts, ns;
+
+      compute_Q_adjoint_Q(clip_p, Q0, Q1, adjQ0, adjQ1);
+      t = fastuidraw::vec2(-n.y(), n.x());
+      ts = m_viewport * (Q0 * t.x() + Q1 * t.y());
+      ns = m_recip_viewport * fastuidraw::vec2(ts.y(), -ts.x());
+      return adjQ0 * ns.x() + adjQ1 * ns.y();
+    }
+
+    const fastuidraw::float3x3 &m_matrix;
+    fastuidraw::vec2 m_viewport, m_recip_viewport;
+  };
+
+  /* Emulation of bilinear filtering of the glyph texel store,
+   * exactly as the GLSL glyph shaders do when the texel store
+   * is emulated.
+   */
+  float
+  glyph_texel(const fastuidraw::cpu::GlyphAtlasCPU *atlas,
+              float tx, float ty, int layer)
+  {
+    int x, y;
+    float mx, my, f00, f01, f10, f11, f0, f1;
+
+    x = static_cast<int>(tx);
+    y = static_cast<int>(ty);
+    mx = tx - static_cast<float>(x);
+    my = ty - static_cast<float>(y);
+
+    f00 = static_cast<float>(atlas->texel(x, y, layer));
+    f01 = static_cast<float>(atlas->texel(x, y + 1, layer));
+    f10 = static_cast<float>(atlas->texel(x + 1, y, layer));
+    f11 = static_cast<float>(atlas->texel(x + 1, y + 1, layer));
+
+    f0 = f00 + (f01 - f00) * my;
+    f1 = f10 + (f11 - f10) * my;
+    return (f0 + (f1 - f0) * mx) / 255.0f;
+  }
+
+  class FillShaderCPU:public fastuidraw::cpu::PainterItemShaderCPU
+  {
+  public:
+    FillShaderCPU(void):
+      fastuidraw::cpu::PainterItemShaderCPU(0)
+    {}
+
+    virtual
+    fastuidraw::vec4
+    vertex_shade(uint32_t, const fastuidraw::PainterAttribute &attrib,
+                 unsigned int, const VertexEnvironment&,
+                 varyings&, int &z_add) const
+    {
+      float x, y;
+
+      x = fastuidraw::unpack_float(attrib.m_attrib0.x());
+      y = fastuidraw::unpack_float(attrib.m_attrib0.y());
+      z_add = 0;
+      return fastuidraw::vec4(x, y, x, y);
+    }
+
+    virtual
+    bool
+    fragment_shade(uint32_t, unsigned int, const FragmentEnvironment&,
+                   const varyings&, const varyings&, const varyings&,
+                   fastuidraw::vec4 &out_color) const
+    {
+      out_color = fastuidraw::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+      return true;
+    }
+  };
+
+  class FillAAFuzzShaderCPU:public fastuidraw::cpu::PainterItemShaderCPU
+  {
+  public:
+    FillAAFuzzShaderCPU(void):
+      fastuidraw::cpu::PainterItemShaderCPU(1)
+    {}
+
+    virtual
+    fastuidraw::vec4
+    vertex_shade(uint32_t, const fastuidraw::PainterAttribute &attrib,
+                 unsigned int, const VertexEnvironment &env,
+                 varyings &out_varyings, int &z_add) const
+    {
+      fastuidraw::vec2 p, n;
+      float sgn;
+
+      p.x() = fastuidraw::unpack_float(attrib.m_attrib0.x());
+      p.y() = fastuidraw::unpack_float(attrib.m_attrib0.y());
+      n.x() = fastuidraw::unpack_float(attrib.m_attrib0.z());
+      n.y() = fastuidraw::unpack_float(attrib.m_attrib0.w());
+      sgn = fastuidraw::unpack_float(attrib.m_attrib1.x());
+
+      if (std::abs(sgn) > 0.5f)
+        {
+          Transformer T(env);
+          fastuidraw::vec3 clip_p;
+          float dist;
+
+          clip_p = T.point(p);
+          n = T.align_normal_to_screen(clip_p, n * sgn);
+          dist = T.local_distance_from_pixel_distance(1.0f, clip_p, T.direction(n));
+          p += dist * n;
+        }
+
+      out_varyings[0] = sgn;
+      z_add = static_cast<int>(attrib.m_attrib1.y());
+      return fastuidraw::vec4(p.x(), p.y(), p.x(), p.y());
+    }
+
+    virtual
+    bool
+    fragment_shade(uint32_t, unsigned int, const FragmentEnvironment&,
+                   const varyings &v, const varyings&, const varyings&,
+                   fastuidraw::vec4 &out_color) const
+    {
+      out_color = fastuidraw::vec4(1.0f, 1.0f, 1.0f, 1.0f - std::abs(v[0]));
+      return true;
+    }
+  };
+
+  class GlyphShaderCPU:public fastuidraw::cpu::PainterItemShaderCPU
+  {
+  public:
+    enum
+      {
+        tex_coord_x_varying,
+        tex_coord_y_varying,
+        tex_coord_layer_varying,
+
+        number_glyph_varyings
+      };
+
+    explicit
+    GlyphShaderCPU(bool distance_field):
+      fastuidraw::cpu::PainterItemShaderCPU(number_glyph_varyings),
+      m_distance_field(distance_field)
+    {}
+
+    virtual
+    fastuidraw::vec4
+    vertex_shade(uint32_t, const fastuidraw::PainterAttribute &attrib,
+                 unsigned int, const VertexEnvironment&,
+                 varyings &out_varyings, int &z_add) const
+    {
+      float x, y;
+
+      out_varyings[tex_coord_x_varying] = fastuidraw::unpack_float(attrib.m_attrib0.x());
+      out_varyings[tex_coord_y_varying] = fastuidraw::unpack_float(attrib.m_attrib0.y());
+      out_varyings[tex_coord_layer_varying] = fastuidraw::unpack_float(attrib.m_attrib2.z());
+
+      x = fastuidraw::unpack_float(attrib.m_attrib1.x());
+      y = fastuidraw::unpack_float(attrib.m_attrib1.y());
+      z_add = 0;
+      return fastuidraw::vec4(x, y, x, y);
+    }
+
+    virtual
+    bool
+    fragment_shade(uint32_t, unsigned int, const FragmentEnvironment &env,
+                   const varyings &v, const varyings &dvdx, const varyings &dvdy,
+                   fastuidraw::vec4 &out_color) const
+    {
+      float texel, coverage;
+
+      texel = glyph_texel(env.m_glyph_atlas,
+                          v[tex_coord_x_varying], v[tex_coord_y_varying],
+                          static_cast<int>(v[tex_coord_layer_varying] + 0.5f));
+      if (m_distance_field)
+        {
+          fastuidraw::vec2 dx, dy;
+          float dist, scale;
+
+          dx = fastuidraw::vec2(dvdx[tex_coord_x_varying], dvdx[tex_coord_y_varying]);
+          dy = fastuidraw::vec2(dvdy[tex_coord_x_varying], dvdy[tex_coord_y_varying]);
+          dist = 2.0f * texel - 1.0f;
+          scale = std::sqrt(0.5f * (dot(dx, dx) + dot(dy, dy)));
+          coverage = smoothstep(-0.4f * scale, 0.4f * scale, dist);
+        }
+      else
+        {
+          coverage = texel;
+        }
+
+      out_color = fastuidraw::vec4(1.0f, 1.0f, 1.0f, coverage);
+      return true;
+    }
+
+  private:
+    static
+    float
+    smoothstep(float edge0, float edge1, float x)
+    {
+      float t;
+
+      if (edge0 == edge1)
+        {
+          return (x < edge0) ? 0.0f : 1.0f;
+        }
+      t = fastuidraw::t_max(0.0f, fastuidraw::t_min(1.0f, (x - edge0) / (edge1 - edge0)));
+      return t * t * (3.0f - 2.0f * t);
+    }
+
+    bool m_distance_field;
+  };
+
+  /* Port of the non-dashed, line-segment only stroking
+   * shader; the sub-shader is the render pass as given
+   * by stroke_render_pass_t.
+   */
+  class StrokeShaderCPU:public fastuidraw::cpu::PainterItemShaderCPU
+  {
+  public:
+    StrokeShaderCPU(void):
+      fastuidraw::cpu::PainterItemShaderCPU(1, stroke_number_render_passes)
+    {}
+
+    virtual
+    fastuidraw::vec4
+    vertex_shade(uint32_t sub_shader, const fastuidraw::PainterAttribute &attrib,
+                 unsigned int shader_data_offset, const VertexEnvironment &env,
+                 varyings &out_varyings, int &z_add) const;
+
+    virtual
+    bool
+    fragment_shade(uint32_t sub_shader, unsigned int, const FragmentEnvironment&,
+                   const varyings &v, const varyings &dvdx, const varyings &dvdy,
+                   fastuidraw::vec4 &out_color) const
+    {
+      float alpha(1.0f);
+
+      if (sub_shader == stroke_aa_pass2)
+        {
+          float q, dd;
+
+          /* modulate by coverage to boundary */
+          q = 1.0f - v[0];
+          dd = fastuidraw::t_max(q, std::abs(dvdx[0]) + std::abs(dvdy[0]));
+          alpha = (dd > 0.0f) ? q / dd : 0.0f;
+        }
+
+      out_color = fastuidraw::vec4(1.0f, 1.0f, 1.0f, alpha);
+      return true;
+    }
+
+  private:
+    static
+    fastuidraw::vec2
+    compute_offset(uint32_t packed_data, int offset_type,
+                   const fastuidraw::vec2 &pre_offset,
+                   const fastuidraw::vec2 &auxiliary_offset,
+                   float miter_limit);
+
+    static
+    fastuidraw::vec2
+    compute_offset_pixels(const Transformer &T,
+                          uint32_t packed_data, int offset_type,
+                          const fastuidraw::vec2 &position,
+                          const fastuidraw::vec2 &pre_offset,
+                          const fastuidraw::vec2 &auxiliary_offset,
+                          float miter_limit, float &stroke_radius);
+  };
+
+  /* The rasterizer never invokes the shading methods
+   * of an UnsupportedItemShaderCPU or UnsupportedBlendShaderCPU;
+   * they discard and leave the destination unchanged.
+   */
+  class UnsupportedItemShaderCPU:
+    public fastuidraw::cpu::PainterItemShaderCPU,
+    public fastuidraw::cpu::detail::UnsupportedShaderCPU
+  {
+  public:
+    UnsupportedItemShaderCPU(fastuidraw::c_string name,
+                             unsigned int num_sub_shaders = 1):
+      fastuidraw::cpu::PainterItemShaderCPU(0, num_sub_shaders),
+      fastuidraw::cpu::detail::UnsupportedShaderCPU(name)
+    {}
+
+    virtual
+    fastuidraw::vec4
+    vertex_shade(uint32_t, const fastuidraw::PainterAttribute&,
+                 unsigned int, const VertexEnvironment&,
+                 varyings&, int &z_add) const
+    {
+      z_add = 0;
+      return fastuidraw::vec4(0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    virtual
+    bool
+    fragment_shade(uint32_t, unsigned int, const FragmentEnvironment&,
+                   const varyings&, const varyings&, const varyings&,
+                   fastuidraw::vec4&) const
+    {
+      return false;
+    }
+  };
+
+  class UnsupportedBlendShaderCPU:
+    public fastuidraw::cpu::PainterBlendShaderCPU,
+    public fastuidraw::cpu::detail::UnsupportedShaderCPU
+  {
+  public:
+    UnsupportedBlendShaderCPU(fastuidraw::c_string name,
+                              unsigned int num_sub_shaders):
+      fastuidraw::cpu::PainterBlendShaderCPU(num_sub_shaders),
+      fastuidraw::cpu::detail::UnsupportedShaderCPU(name)
+    {}
+
+    virtual
+    fastuidraw::vec4
+    blend(uint32_t, unsigned int,
+          fastuidraw::c_array<const fastuidraw::generic_data>,
+          const fastuidraw::vec4&, const fastuidraw::vec4 &D) const
+    {
+      return D;
+    }
+  };
+
+  /* All Porter-Duff modes as one shader; the sub-shader
+   * is the value of PainterEnums::blend_mode_t.
+   */
+  class PorterDuffBlendShaderCPU:public fastuidraw::cpu::PainterBlendShaderCPU
+  {
+  public:
+    PorterDuffBlendShaderCPU(void):
+      fastuidraw::cpu::PainterBlendShaderCPU(fastuidraw::PainterEnums::blend_porter_duff_xor + 1)
+    {}
+
+    virtual
+    fastuidraw::vec4
+    blend(uint32_t sub_shader, unsigned int,
+          fastuidraw::c_array<const fastuidraw::generic_data>,
+          const fastuidraw::vec4 &S, const fastuidraw::vec4 &D) const
+    {
+      using namespace fastuidraw::PainterEnums;
+      float one_minus_Sa(1.0f - S.w()), one_minus_Da(1.0f - D.w());
+
+      switch (sub_shader)
+        {
+        default:
+        case blend_porter_duff_clear:
+          return fastuidraw::vec4(0.0f, 0.0f, 0.0f, 0.0f);
+
+        case blend_porter_duff_src:
+          return S;
+
+        case blend_porter_duff_dst:
+          return D;
+
+        case blend_porter_duff_src_over:
+          return S + D * one_minus_Sa;
+
+        case blend_porter_duff_dst_over:
+          return D + S * one_minus_Da;
+
+        case blend_porter_duff_src_in:
+          return S * D.w();
+
+        case blend_porter_duff_dst_in:
+          return D * S.w();
+
+        case blend_porter_duff_src_out:
+          return S * one_minus_Da;
+
+        case blend_porter_duff_dst_out:
+          return D * one_minus_Sa;
+
+        case blend_porter_duff_src_atop:
+          return S * D.w() + D * one_minus_Sa;
+
+        case blend_porter_duff_dst_atop:
+          return D * S.w() + S * one_minus_Da;
+
+        case blend_porter_duff_xor:
+          return S * one_minus_Da + D * one_minus_Sa;
+        }
+    }
+  };
+}
+
+//////////////////////////////////////
+// StrokeShaderCPU methods
+fastuidraw::vec4
+StrokeShaderCPU::
+vertex_shade(uint32_t sub_shader, const fastuidraw::PainterAttribute &attrib,
+             unsigned int shader_data_offset, const VertexEnvironment &env,
+             varyings &out_varyings, int &z_add) const
+{
+  using namespace fastuidraw;
+  const float anti_alias_thickness = 1.5f;
+  vec2 position, pre_offset, auxiliary_offset, p;
+  uint32_t packed_data;
+  int offset_type, on_boundary;
+  float stroke_radius, miter_limit;
+  bool stroke_width_pixels;
+
+  position = vec2(unpack_float(attrib.m_attrib0.x()), unpack_float(attrib.m_attrib0.y()));
+  pre_offset = vec2(unpack_float(attrib.m_attrib0.z()), unpack_float(attrib.m_attrib0.w()));
+  auxiliary_offset = vec2(unpack_float(attrib.m_attrib1.z()), unpack_float(attrib.m_attrib1.w()));
+  packed_data = attrib.m_attrib2.x();
+
+  offset_type = unpack_bits(StrokedPoint::offset_type_bit0,
+                            StrokedPoint::offset_type_num_bits,
+                            packed_data);
+  on_boundary = unpack_bits(StrokedPoint::boundary_bit, 1u, packed_data);
+
+  stroke_radius = env.m_data_store[shader_data_offset + PainterStrokeParams::stroke_radius_offset].f;
+  miter_limit = env.m_data_store[shader_data_offset + PainterStrokeParams::stroke_miter_limit_offset].f;
+  stroke_width_pixels = (stroke_radius < 0.0f);
+  stroke_radius = std::abs(stroke_radius);
+
+  /* Reduce the stroking width by 1-pixel when doing 2-pass
+   * non-dashed stroking.
+   */
+  if (sub_shader == stroke_aa_pass1 && stroke_width_pixels)
+    {
+      stroke_radius = t_max(stroke_radius - anti_alias_thickness, 0.0f);
+    }
+
+  if (on_boundary != 0)
+    {
+      vec2 offset;
+
+      if (stroke_width_pixels)
+        {
+          Transformer T(env);
+          offset = compute_offset_pixels(T, packed_data, offset_type,
+                                         position, pre_offset, auxiliary_offset,
+                                         miter_limit, stroke_radius);
+        }
+      else
+        {
+          offset = compute_offset(packed_data, offset_type,
+                                  pre_offset, auxiliary_offset,
+                                  miter_limit);
+        }
+
+      p = position + stroke_radius * offset;
+      if (sub_shader == stroke_aa_pass1 && !stroke_width_pixels)
+        {
+          Transformer T(env);
+          float r;
+
+          r = T.local_distance_from_pixel_distance(anti_alias_thickness, T.point(p), T.direction(offset));
+          p -= t_min(stroke_radius, r) * offset;
+        }
+    }
+  else
+    {
+      p = position;
+    }
+
+  out_varyings[0] = static_cast<float>(on_boundary);
+  z_add = unpack_bits(StrokedPoint::depth_bit0, StrokedPoint::depth_num_bits, packed_data);
+  return vec4(p.x(), p.y(), p.x(), p.y());
+}
+
+fastuidraw::vec2
+StrokeShaderCPU::
+compute_offset(uint32_t packed_data, int offset_type,
+               const fastuidraw::vec2 &pre_offset,
+               const fastuidraw::vec2 &auxiliary_offset,
+               float miter_limit)
+{
+  using namespace fastuidraw;
+  switch (offset_type)
+    {
+    case StrokedPoint::offset_miter_clip_join:
+      {
+        vec2 n0(pre_offset), Jn0(n0.y(), -n0.x());
+        vec2 n1(auxiliary_offset), Jn1(n1.y(), -n1.x());
+        float r, det, lambda;
+
+        det = dot(Jn1, n0);
+        lambda = -sign_of(det);
+        r = (det != 0.0f) ? (dot(n0, n1) - 1.0f) / det : 0.0f;
+        if (packed_data & StrokedPoint::lambda_negated_mask)
+          {
+            lambda = -lambda;
+          }
+
+        /* enforce miter-limit */
+        if (miter_limit >= 0.0f)
+          {
+            float mm;
+            mm = miter_limit * std::abs(r) / std::sqrt(1.0f + r * r);
+            r = t_max(-mm, t_min(mm, r));
+          }
+        return lambda * (n0 + r * Jn0);
+      }
+
+    case StrokedPoint::offset_miter_join:
+    case StrokedPoint::offset_miter_bevel_join:
+      {
+        vec2 n0(pre_offset), Jn0(n0.y(), -n0.x());
+        vec2 n1(auxiliary_offset);
+        vec2 n0_plus_n1(n0 + n1);
+        float r, lambda, den;
+
+        lambda = sign_of(dot(Jn0, n1));
+        den = 1.0f + dot(n0, n1);
+        r = (den != 0.0f) ? 1.0f / den : 0.0f;
+
+        /* enforce miter-limit */
+        if (miter_limit >= 0.0f)
+          {
+            float d, den_m;
+
+            d = dot(n0_plus_n1, n0_plus_n1);
+            den_m = miter_limit * den;
+            if (d >= den_m * den_m)
+              {
+                r = (offset_type == StrokedPoint::offset_miter_bevel_join) ?
+                  0.5f :
+                  miter_limit / std::sqrt(d);
+              }
+          }
+        r = t_max(r, 0.5f) * lambda;
+        return r * n0_plus_n1;
+      }
+
+    case StrokedPoint::offset_rounded_join:
+      return unpack_unit_vector(auxiliary_offset.y(),
+                                packed_data & StrokedPoint::sin_sign_mask);
+
+    case StrokedPoint::offset_square_cap:
+      return pre_offset + auxiliary_offset;
+
+    case StrokedPoint::offset_rounded_cap:
+      {
+        vec2 v(pre_offset.y(), -pre_offset.x());
+        return auxiliary_offset.x() * v + auxiliary_offset.y() * pre_offset;
+      }
+
+    default:
+      return pre_offset;
+    }
+}
+
+fastuidraw::vec2
+StrokeShaderCPU::
+compute_offset_pixels(const Transformer &T,
+                      uint32_t packed_data, int offset_type,
+                      const fastuidraw::vec2 &position,
+                      const fastuidraw::vec2 &pre_offset,
+                      const fastuidraw::vec2 &auxiliary_offset,
+                      float miter_limit, float &stroke_radius)
+{
+  using namespace fastuidraw;
+  switch (offset_type)
+    {
+    case StrokedPoint::offset_miter_clip_join:
+    case StrokedPoint::offset_miter_join:
+    case StrokedPoint::offset_miter_bevel_join:
+      {
+        vec2 n0(pre_offset), v0(n0.y(), -n0.x());
+        vec2 n1(auxiliary_offset), v1(n1.y(), -n1.x());
+        vec2 delta_d, d0, d1, offset;
+        vec3 clip_p;
+        float det, r, r0, r1, lambda;
+
+        lambda = -sign_of(dot(v1, n0));
+        clip_p = T.point(position);
+        if (offset_type == StrokedPoint::offset_miter_clip_join)
+          {
+            if (packed_data & StrokedPoint::lambda_negated_mask)
+              {
+                lambda = -lambda;
+              }
+            n0 = lambda * T.align_normal_to_screen(clip_p, n0);
+            n1 = lambda * T.align_normal_to_screen(clip_p, n1);
+          }
+        else
+          {
+            n0 = (lambda * T.align_normal_to_screen(clip_p, n0)).normal_vector();
+            n1 = (lambda * T.align_normal_to_screen(clip_p, n1)).normal_vector();
+          }
+
+        r0 = T.local_distance_from_pixel_distance(stroke_radius, clip_p, T.direction(n0));
+        r1 = T.local_distance_from_pixel_distance(stroke_radius, clip_p, T.direction(n1));
+        d0 = r0 * n0;
+        d1 = r1 * n1;
+
+        /* compute where the lines L0 and L1 intersect
+         * where L0 = { p0 + s * v0 | s > 0}
+         * and L1 = { p1 - s * v1 | s > 0}
+         */
+        delta_d = d1 - d0;
+        det = v0.x() * v1.y() - v0.y() * v1.x();
+        stroke_radius = 1.0f;
+
+        if (offset_type == StrokedPoint::offset_miter_clip_join)
+          {
+            r = (det != 0.0f) ? (v1.y() * delta_d.x() - v1.x() * delta_d.y()) / det : 0.0f;
+            if (miter_limit >= 0.0f)
+              {
+                float m, mm;
+
+                m = miter_limit * d0.magnitude();
+                mm = m * std::abs(r) / (d0 + r * v0).magnitude();
+                r = t_max(-mm, t_min(mm, r));
+              }
+            return d0 + r * v0;
+          }
+
+        if (det == 0.0f)
+          {
+            return 0.5f * (d0 + d1);
+          }
+
+        r = (v1.y() * delta_d.x() - v1.x() * delta_d.y()) / det;
+        offset = d0 + r * v0;
+        if (miter_limit >= 0.0f)
+          {
+            float m, l;
+
+            m = miter_limit * t_max(r0, r1);
+            l = offset.magnitude();
+            if (l > m)
+              {
+                if (offset_type == StrokedPoint::offset_miter_bevel_join)
+                  {
+                    offset = 0.5f * (d0 + d1);
+                  }
+                else
+                  {
+                    float k;
+                    k = 0.5f * (d0 + d1).magnitude();
+                    offset *= t_max(m, k) / l;
+                  }
+              }
+          }
+        return offset;
+      }
+
+    case StrokedPoint::offset_rounded_join:
+      {
+        vec2 n0, n1, t0, t1, screen_t0, screen_t1, screen_t, screen_n;
+        vec2 Q0, Q1, adjQ0, adjQ1, offset;
+        vec3 clip_p;
+        float interpolate, d;
+
+        n0 = unpack_unit_vector(pre_offset.x(), packed_data & StrokedPoint::normal0_y_sign_mask);
+        n1 = unpack_unit_vector(pre_offset.y(), packed_data & StrokedPoint::normal1_y_sign_mask);
+        interpolate = auxiliary_offset.x();
+
+        clip_p = T.point(position);
+        T.compute_Q_adjoint_Q(clip_p, Q0, Q1, adjQ0, adjQ1);
+
+        t0 = vec2(-n0.y(), n0.x());
+        t1 = vec2(-n1.y(), n1.x());
+        screen_t0 = (T.m_viewport * (Q0 * t0.x() + Q1 * t0.y())).normal_vector();
+        screen_t1 = (T.m_viewport * (Q0 * t1.x() + Q1 * t1.y())).normal_vector();
+        d = dot(screen_t0, screen_t1);
+
+        if (d > 0.0f)
+          {
+            screen_t = screen_t0 + interpolate * (screen_t1 - screen_t0);
+          }
+        else
+          {
+            /* screen_t0 and screen_t1 point in different
+             * directions, interpolate along a circle
+             */
+            screen_t = circular_interpolate(screen_t0, screen_t1, d, interpolate);
+          }
+
+        screen_n = T.m_recip_viewport * vec2(screen_t.y(), -screen_t.x());
+        offset = adjQ0 * screen_n.x() + adjQ1 * screen_n.y();
+        stroke_radius = T.local_distance_from_pixel_distance(stroke_radius, clip_p, T.direction(offset));
+        return offset;
+      }
+
+    case StrokedPoint::offset_square_cap:
+      {
+        vec3 clip_p;
+        float s0, s1;
+        vec2 n;
+
+        /* move along tangent named number of pixels */
+        clip_p = T.point(position);
+        s0 = T.local_distance_from_pixel_distance(stroke_radius, clip_p, T.direction(auxiliary_offset));
+
+        /* move along normal named number of pixels */
+        clip_p = T.point(position + s0 * auxiliary_offset);
+        n = T.align_normal_to_screen(clip_p, pre_offset);
+        s1 = T.local_distance_from_pixel_distance(stroke_radius, clip_p, T.direction(n));
+
+        stroke_radius = 1.0f;
+        return s0 * auxiliary_offset + s1 * n;
+      }
+
+    case StrokedPoint::offset_rounded_cap:
+      {
+        vec2 n(pre_offset), v(n.y(), -n.x()), tn;
+        vec3 clip_p;
+
+        clip_p = T.point(position);
+        n = T.align_normal_to_screen(clip_p, n);
+        tn.x() = T.local_distance_from_pixel_distance(auxiliary_offset.x() * stroke_radius,
+                                                      clip_p, T.direction(v));
+        tn.y() = T.local_distance_from_pixel_distance(auxiliary_offset.y() * stroke_radius,
+                                                      clip_p, T.direction(n));
+        stroke_radius = 1.0f;
+        return tn.x() * v + tn.y() * n;
+      }
+
+    default:
+      {
+        vec3 clip_p;
+        vec2 n;
+
+        clip_p = (packed_data & StrokedPoint::end_sub_edge_mask) ?
+          T.point(position + auxiliary_offset) :
+          T.point(position);
+        n = T.align_normal_to_screen(clip_p, pre_offset);
+        stroke_radius = T.local_distance_from_pixel_distance(stroke_radius, clip_p, T.direction(n));
+        return n;
+      }
+    }
+}
+
+namespace fastuidraw { namespace cpu { namespace detail {
+
+//////////////////////////////////////////
+// UnsupportedShaderCPU methods
+void
+UnsupportedShaderCPU::
+report(void) const
+{
+  if (!m_reported.exchange(true))
+    {
+      std::cerr << "fastuidraw::cpu::PainterBackendCPU: no shader for "
+                << m_name << ", such draws are skipped\n";
+    }
+}
+
+//////////////////////////////////////////
+// ShaderSetCreatorCPU methods
+c_array<const c_string>
+ShaderSetCreatorCPU::
+unsupported_shader_names(void)
+{
+  static const c_string names[] =
+    {
+      unsupported_arc_stroke,
+      unsupported_dashed_stroke,
+      unsupported_curve_pair_glyph,
+      unsupported_w3c_blend,
+    };
+  return c_array<const c_string>(names, sizeof(names) / sizeof(names[0]));
+}
+
+PainterGlyphShader
+ShaderSetCreatorCPU::
+create_glyph_shader(void)
+{
+  PainterGlyphShader return_value;
+
+  return_value
+    .shader(coverage_glyph, FASTUIDRAWnew GlyphShaderCPU(false))
+    .shader(distance_field_glyph, FASTUIDRAWnew GlyphShaderCPU(true))
+    .shader(curve_pair_glyph, FASTUIDRAWnew UnsupportedItemShaderCPU(unsupported_curve_pair_glyph));
+  return return_value;
+}
+
+PainterStrokeShader
+ShaderSetCreatorCPU::
+create_stroke_shader(void)
+{
+  reference_counted_ptr<PainterItemShader> root, arc_root;
+  PainterStrokeShader return_value;
+
+  root = FASTUIDRAWnew StrokeShaderCPU();
+  arc_root = FASTUIDRAWnew UnsupportedItemShaderCPU(unsupported_arc_stroke,
+                                                    unsupported_number_stroke_shaders);
+  return_value
+    .aa_type(PainterStrokeShader::draws_solid_then_fuzz)
+    .stroking_data_selector(PainterStrokeParams::stroking_data_selector())
+    .non_aa_shader(FASTUIDRAWnew PainterItemShader(stroke_non_aa, root))
+    .aa_shader_pass1(FASTUIDRAWnew PainterItemShader(stroke_aa_pass1, root))
+    .aa_shader_pass2(FASTUIDRAWnew PainterItemShader(stroke_aa_pass2, root))
+    .arc_non_aa_shader(FASTUIDRAWnew PainterItemShader(unsupported_arc_non_aa, arc_root))
+    .arc_aa_shader_pass1(FASTUIDRAWnew PainterItemShader(unsupported_arc_aa_pass1, arc_root))
+    .arc_aa_shader_pass2(FASTUIDRAWnew PainterItemShader(unsupported_arc_aa_pass2, arc_root));
+  return return_value;
+}
+
+PainterDashedStrokeShaderSet
+ShaderSetCreatorCPU::
+create_dashed_stroke_shader(void)
+{
+  /* the same (unsupported) shader for every cap style */
+  reference_counted_ptr<PainterItemShader> root;
+  PainterStrokeShader shader;
+  PainterDashedStrokeShaderSet return_value;
+
+  root = FASTUIDRAWnew UnsupportedItemShaderCPU(unsupported_dashed_stroke,
+                                                unsupported_number_stroke_shaders);
+  shader
+    .aa_type(PainterStrokeShader::draws_solid_then_fuzz)
+    .stroking_data_selector(PainterDashedStrokeParams::stroking_data_selector())
+    .non_aa_shader(FASTUIDRAWnew PainterItemShader(unsupported_non_aa, root))
+    .aa_shader_pass1(FASTUIDRAWnew PainterItemShader(unsupported_aa_pass1, root))
+    .aa_shader_pass2(FASTUIDRAWnew PainterItemShader(unsupported_aa_pass2, root))
+    .arc_non_aa_shader(FASTUIDRAWnew PainterItemShader(unsupported_arc_non_aa, root))
+    .arc_aa_shader_pass1(FASTUIDRAWnew PainterItemShader(unsupported_arc_aa_pass1, root))
+    .arc_aa_shader_pass2(FASTUIDRAWnew PainterItemShader(unsupported_arc_aa_pass2, root));
+
+  for (unsigned int i = 0; i < PainterEnums::number_cap_styles; ++i)
+    {
+      return_value.shader(static_cast<enum PainterEnums::cap_style>(i), shader);
+    }
+  return return_value;
+}
+
+PainterFillShader
+ShaderSetCreatorCPU::
+create_fill_shader(void)
+{
+  PainterFillShader return_value;
+
+  return_value
+    .item_shader(FASTUIDRAWnew FillShaderCPU())
+    .aa_fuzz_shader(FASTUIDRAWnew FillAAFuzzShaderCPU());
+  return return_value;
+}
+
+PainterBlendShaderSet
+ShaderSetCreatorCPU::
+create_blend_shaders(void)
+{
+  reference_counted_ptr<PainterBlendShader> root, w3c_root;
+  PainterBlendShaderSet return_value;
+
+  root = FASTUIDRAWnew PorterDuffBlendShaderCPU();
+  for (unsigned int i = 0; i <= PainterEnums::blend_porter_duff_xor; ++i)
+    {
+      enum PainterEnums::blend_mode_t md;
+
+      md = static_cast<enum PainterEnums::blend_mode_t>(i);
+      return_value.shader(md, BlendMode().blending_on(false),
+                          FASTUIDRAWnew PainterBlendShader(i, root));
+    }
+
+  w3c_root = FASTUIDRAWnew UnsupportedBlendShaderCPU(unsupported_w3c_blend,
+                                                     PainterEnums::blend_w3c_luminosity + 1
+                                                     - PainterEnums::blend_w3c_mulitply);
+  for (unsigned int i = PainterEnums::blend_w3c_mulitply; i <= PainterEnums::blend_w3c_luminosity; ++i)
+    {
+      enum PainterEnums::blend_mode_t md;
+
+      md = static_cast<enum PainterEnums::blend_mode_t>(i);
+      return_value.shader(md, BlendMode().blending_on(false),
+                          FASTUIDRAWnew PainterBlendShader(i - PainterEnums::blend_w3c_mulitply, w3c_root));
+    }
+  return return_value;
+}
+
+PainterShaderSet
+ShaderSetCreatorCPU::
+create_shader_set(void)
+{
+  PainterShaderSet return_value;
+  PainterGlyphShader glyph_shader(create_glyph_shader());
+
+  return_value
+    .glyph_shader(glyph_shader)
+    .glyph_shader_anisotropic(glyph_shader)
+    .stroke_shader(create_stroke_shader())
+    .dashed_stroke_shader(create_dashed_stroke_shader())
+    .fill_shader(create_fill_shader())
+    .blend_shaders(create_blend_shaders());
+  return return_value;
+}
+
+}}}
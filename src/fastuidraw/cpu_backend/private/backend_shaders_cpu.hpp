@@ -0,0 +1,94 @@
+/*!
+ * \file backend_shaders_cpu.hpp
+ * \brief file backend_shaders_cpu.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <fastuidraw/painter/painter_shader_set.hpp>
+#include <fastuidraw/cpu_backend/painter_item_shader_cpu.hpp>
+#include <fastuidraw/cpu_backend/painter_blend_shader_cpu.hpp>
+
+namespace fastuidraw { namespace cpu { namespace detail {
+
+/* Base class of the shaders that the default shader set
+ * places where the CPU backend has no port of a GLSL shader;
+ * the rasterizer skips draws using such a shader and reports
+ * the first such draw to std::cerr.
+ */
+class UnsupportedShaderCPU
+{
+public:
+  explicit
+  UnsupportedShaderCPU(c_string name):
+    m_name(name),
+    m_reported(false)
+  {}
+
+  virtual
+  ~UnsupportedShaderCPU()
+  {}
+
+  c_string
+  name(void) const
+  {
+    return m_name;
+  }
+
+  void
+  report(void) const;
+
+private:
+  c_string m_name;
+  mutable std::atomic<bool> m_reported;
+};
+
+/* Creates the default shaders of PainterBackendCPU; these
+ * are C++ ports of the GLSL shaders of the GL backend,
+ * specialized to what the CPU rasterizer supports.
+ */
+class ShaderSetCreatorCPU
+{
+public:
+  PainterShaderSet
+  create_shader_set(void);
+
+  /* names of the UnsupportedShaderCPU shaders of the
+   * value returned by create_shader_set()
+   */
+  static
+  c_array<const c_string>
+  unsupported_shader_names(void);
+
+private:
+  PainterGlyphShader
+  create_glyph_shader(void);
+
+  PainterStrokeShader
+  create_stroke_shader(void);
+
+  PainterDashedStrokeShaderSet
+  create_dashed_stroke_shader(void);
+
+  PainterFillShader
+  create_fill_shader(void);
+
+  PainterBlendShaderSet
+  create_blend_shaders(void);
+};
+
+}}}
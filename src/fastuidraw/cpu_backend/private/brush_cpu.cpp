@@ -0,0 +1,448 @@
+/*!
+ * \file brush_cpu.cpp
+ * \brief file brush_cpu.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <cmath>
+#include <fastuidraw/util/math.hpp>
+#include "brush_cpu.hpp"
+
+namespace
+{
+  inline
+  float
+  glsl_mod(float x, float y)
+  {
+    return (y != 0.0f) ? x - y * std::floor(x / y) : 0.0f;
+  }
+
+  inline
+  float
+  glsl_fract(float x)
+  {
+    return x - std::floor(x);
+  }
+
+  inline
+  fastuidraw::vec4
+  unpack_texel(const fastuidraw::u8vec4 &v)
+  {
+    return fastuidraw::vec4(v.x(), v.y(), v.z(), v.w()) / 255.0f;
+  }
+
+  fastuidraw::vec4
+  cubic_weights(float x)
+  {
+    float x_squared = x * x;
+    float x_cubed = x_squared * x;
+    float one_minus_x = 1.0f - x;
+    float one_minus_x_squared = one_minus_x * one_minus_x;
+    float one_minus_x_cubed = one_minus_x_squared  * one_minus_x;
+    fastuidraw::vec4 w;
+
+    w.x() = one_minus_x_cubed;
+    w.y() = 3.0f * x_cubed - 6.0f * x_squared + 4.0f;
+    w.z() = 3.0f * one_minus_x_cubed - 6.0f * one_minus_x_squared + 4.0f;
+    w.w() = x_cubed;
+    return w / 6.0f;
+  }
+}
+
+void
+fastuidraw::cpu::detail::brush_cpu::
+unpack(uint32_t shader, c_array<const generic_data> data,
+       unsigned int alignment)
+{
+  unsigned int current(0);
+  c_array<const generic_data> sub_src;
+
+  m_shader = shader;
+
+  sub_src = data.sub_array(current);
+  current += round_up_to_multiple(PainterBrush::pen_data_size, alignment);
+  m_pen.x() = sub_src[PainterBrush::pen_red_offset].f;
+  m_pen.y() = sub_src[PainterBrush::pen_green_offset].f;
+  m_pen.z() = sub_src[PainterBrush::pen_blue_offset].f;
+  m_pen.w() = sub_src[PainterBrush::pen_alpha_offset].f;
+
+  if (shader & PainterBrush::image_mask)
+    {
+      uint32_t xy, loc, sl;
+
+      sub_src = data.sub_array(current);
+      current += round_up_to_multiple(PainterBrush::image_data_size, alignment);
+
+      xy = sub_src[PainterBrush::image_size_xy_offset].u;
+      m_image_size.x() = unpack_bits(PainterBrush::image_size_x_bit0, PainterBrush::image_size_x_num_bits, xy);
+      m_image_size.y() = unpack_bits(PainterBrush::image_size_y_bit0, PainterBrush::image_size_y_num_bits, xy);
+
+      xy = sub_src[PainterBrush::image_start_xy_offset].u;
+      m_image_start.x() = unpack_bits(PainterBrush::image_size_x_bit0, PainterBrush::image_size_x_num_bits, xy);
+      m_image_start.y() = unpack_bits(PainterBrush::image_size_y_bit0, PainterBrush::image_size_y_num_bits, xy);
+
+      loc = sub_src[PainterBrush::image_atlas_location_xyz_offset].u;
+      m_image_master_tile.x() = unpack_bits(PainterBrush::image_atlas_location_x_bit0,
+                                            PainterBrush::image_atlas_location_x_num_bits, loc);
+      m_image_master_tile.y() = unpack_bits(PainterBrush::image_atlas_location_y_bit0,
+                                            PainterBrush::image_atlas_location_y_num_bits, loc);
+      m_image_master_tile.z() = unpack_bits(PainterBrush::image_atlas_location_z_bit0,
+                                            PainterBrush::image_atlas_location_z_num_bits, loc);
+
+      sl = sub_src[PainterBrush::image_slack_number_lookups_offset].u;
+      m_image_number_lookups = unpack_bits(PainterBrush::image_number_index_lookups_bit0,
+                                           PainterBrush::image_number_index_lookups_num_bits, sl);
+      m_image_slack = unpack_bits(PainterBrush::image_slack_bit0,
+                                  PainterBrush::image_slack_num_bits, sl);
+
+      m_image_filter = unpack_bits(PainterBrush::image_filter_bit0,
+                                   PainterBrush::image_filter_num_bits, shader);
+    }
+
+  if (shader & PainterBrush::gradient_mask)
+    {
+      uint32_t xy;
+
+      sub_src = data.sub_array(current);
+      if (shader & PainterBrush::radial_gradient_mask)
+        {
+          current += round_up_to_multiple(PainterBrush::radial_gradient_data_size, alignment);
+          m_gradient_r0 = sub_src[PainterBrush::gradient_start_radius_offset].f;
+          m_gradient_r1 = sub_src[PainterBrush::gradient_end_radius_offset].f;
+        }
+      else
+        {
+          current += round_up_to_multiple(PainterBrush::linear_gradient_data_size, alignment);
+        }
+
+      m_gradient_p0.x() = sub_src[PainterBrush::gradient_p0_x_offset].f;
+      m_gradient_p0.y() = sub_src[PainterBrush::gradient_p0_y_offset].f;
+      m_gradient_p1.x() = sub_src[PainterBrush::gradient_p1_x_offset].f;
+      m_gradient_p1.y() = sub_src[PainterBrush::gradient_p1_y_offset].f;
+
+      xy = sub_src[PainterBrush::gradient_color_stop_xy_offset].u;
+      m_colorstop_xy.x() = unpack_bits(PainterBrush::gradient_color_stop_x_bit0,
+                                       PainterBrush::gradient_color_stop_x_num_bits, xy);
+      m_colorstop_xy.y() = unpack_bits(PainterBrush::gradient_color_stop_y_bit0,
+                                       PainterBrush::gradient_color_stop_y_num_bits, xy);
+      m_colorstop_length = sub_src[PainterBrush::gradient_color_stop_length_offset].u;
+    }
+
+  if (shader & PainterBrush::repeat_window_mask)
+    {
+      sub_src = data.sub_array(current);
+      current += round_up_to_multiple(PainterBrush::repeat_window_data_size, alignment);
+      m_repeat_window_xy.x() = sub_src[PainterBrush::repeat_window_x_offset].f;
+      m_repeat_window_xy.y() = sub_src[PainterBrush::repeat_window_y_offset].f;
+      m_repeat_window_wh.x() = sub_src[PainterBrush::repeat_window_width_offset].f;
+      m_repeat_window_wh.y() = sub_src[PainterBrush::repeat_window_height_offset].f;
+    }
+
+  if (shader & PainterBrush::transformation_matrix_mask)
+    {
+      sub_src = data.sub_array(current);
+      current += round_up_to_multiple(PainterBrush::transformation_matrix_data_size, alignment);
+      m_transformation_matrix.x() = sub_src[PainterBrush::transformation_matrix_m00_offset].f;
+      m_transformation_matrix.y() = sub_src[PainterBrush::transformation_matrix_m01_offset].f;
+      m_transformation_matrix.z() = sub_src[PainterBrush::transformation_matrix_m10_offset].f;
+      m_transformation_matrix.w() = sub_src[PainterBrush::transformation_matrix_m11_offset].f;
+    }
+
+  if (shader & PainterBrush::transformation_translation_mask)
+    {
+      sub_src = data.sub_array(current);
+      current += round_up_to_multiple(PainterBrush::transformation_translation_data_size, alignment);
+      m_transformation_translation.x() = sub_src[PainterBrush::transformation_translation_x_offset].f;
+      m_transformation_translation.y() = sub_src[PainterBrush::transformation_translation_y_offset].f;
+    }
+}
+
+fastuidraw::vec2
+fastuidraw::cpu::detail::brush_cpu::
+transform(const vec2 &p) const
+{
+  vec2 q(p);
+
+  if (m_shader & PainterBrush::transformation_matrix_mask)
+    {
+      q = vec2(m_transformation_matrix.x() * p.x() + m_transformation_matrix.y() * p.y(),
+               m_transformation_matrix.z() * p.x() + m_transformation_matrix.w() * p.y());
+    }
+
+  if (m_shader & PainterBrush::transformation_translation_mask)
+    {
+      q += m_transformation_translation;
+    }
+
+  return q;
+}
+
+float
+fastuidraw::cpu::detail::brush_cpu::
+gradient_interpolate(const vec2 &p, float &good) const
+{
+  float t(1.0f);
+
+  good = 1.0f;
+  if (m_shader & PainterBrush::radial_gradient_mask)
+    {
+      vec2 q, delta_p;
+      float delta_r, a, b, c, desc;
+
+      q = p - m_gradient_p0;
+      delta_p = m_gradient_p1 - m_gradient_p0;
+      delta_r = m_gradient_r1 - m_gradient_r0;
+
+      c = dot(q, q) - m_gradient_r0 * m_gradient_r0;
+      b = 2.0f * (dot(q, delta_p) - m_gradient_r0 * delta_r);
+      a = dot(delta_p, delta_p) - delta_r * delta_r;
+      desc = b * b - 4.0f * a * c;
+
+      if (desc < 0.0f)
+        {
+          good = 0.0f;
+          t = 0.0f;
+        }
+      else
+        {
+          float t0, t1, recip_two_a;
+          bool g0, g1;
+
+          desc = std::sqrt(std::abs(desc));
+          recip_two_a = 0.5f / a;
+          t0 = (-b + desc) * recip_two_a;
+          t1 = (-b - desc) * recip_two_a;
+
+          /* if both t0 and t1 are in range or both are not
+           * in range, take the max, otherwise take the one
+           * that is in range.
+           */
+          g0 = (t0 >= 0.0f && t0 <= 1.0f);
+          g1 = (t1 >= 0.0f && t1 <= 1.0f);
+          if (g0 == g1)
+            {
+              t = t_max(t0, t1);
+            }
+          else
+            {
+              t = (g0) ? t0 : t1;
+            }
+        }
+    }
+  else
+    {
+      vec2 v, d;
+
+      v = m_gradient_p1 - m_gradient_p0;
+      d = p - m_gradient_p0;
+      t = dot(v, d) / dot(v, v);
+    }
+
+  return t;
+}
+
+fastuidraw::vec4
+fastuidraw::cpu::detail::brush_cpu::
+linear_fetch(const ImageAtlasCPU &image_atlas, vec2 tc, int layer)
+{
+  float fx, fy;
+  int x, y;
+  vec4 t00, t10, t01, t11, t0, t1;
+
+  /* texel centers are at half-integers */
+  tc -= vec2(0.5f, 0.5f);
+  fx = std::floor(tc.x());
+  fy = std::floor(tc.y());
+  x = static_cast<int>(fx);
+  y = static_cast<int>(fy);
+  fx = tc.x() - fx;
+  fy = tc.y() - fy;
+
+  t00 = unpack_texel(image_atlas.color_texel(x, y, layer));
+  t10 = unpack_texel(image_atlas.color_texel(x + 1, y, layer));
+  t01 = unpack_texel(image_atlas.color_texel(x, y + 1, layer));
+  t11 = unpack_texel(image_atlas.color_texel(x + 1, y + 1, layer));
+
+  t0 = t00 + fx * (t10 - t00);
+  t1 = t01 + fx * (t11 - t01);
+  return t0 + fy * (t1 - t0);
+}
+
+fastuidraw::vec4
+fastuidraw::cpu::detail::brush_cpu::
+cubic_fetch(const ImageAtlasCPU &image_atlas, vec2 tc, int layer)
+{
+  /* Cubic filtering realized as 4 bilinear fetches,
+   * see GPU Gems 2, Chapter 20.
+   */
+  vec2 fract_tc, linear_weight;
+  vec4 x_weights, y_weights;
+  vec4 corner_coords, weight_sums, texture_coords;
+  vec4 t00, t10, t01, t11;
+
+  tc -= vec2(0.5f, 0.5f);
+  fract_tc = vec2(glsl_fract(tc.x()), glsl_fract(tc.y()));
+  tc -= fract_tc;
+
+  x_weights = cubic_weights(fract_tc.x());
+  y_weights = cubic_weights(fract_tc.y());
+
+  corner_coords = vec4(tc.x() - 0.5f, tc.x() + 1.5f,
+                       tc.y() - 0.5f, tc.y() + 1.5f);
+  weight_sums = vec4(x_weights.x() + x_weights.y(), x_weights.z() + x_weights.w(),
+                     y_weights.x() + y_weights.y(), y_weights.z() + y_weights.w());
+  texture_coords = corner_coords
+    + vec4(x_weights.y(), x_weights.w(), y_weights.y(), y_weights.w()) / weight_sums;
+
+  t00 = linear_fetch(image_atlas, vec2(texture_coords.x(), texture_coords.z()), layer);
+  t10 = linear_fetch(image_atlas, vec2(texture_coords.y(), texture_coords.z()), layer);
+  t01 = linear_fetch(image_atlas, vec2(texture_coords.x(), texture_coords.w()), layer);
+  t11 = linear_fetch(image_atlas, vec2(texture_coords.y(), texture_coords.w()), layer);
+
+  linear_weight.x() = weight_sums.y() / (weight_sums.x() + weight_sums.y());
+  linear_weight.y() = weight_sums.w() / (weight_sums.z() + weight_sums.w());
+
+  t00 += linear_weight.x() * (t10 - t00);
+  t01 += linear_weight.x() * (t11 - t01);
+  return t00 + linear_weight.y() * (t01 - t00);
+}
+
+fastuidraw::vec4
+fastuidraw::cpu::detail::brush_cpu::
+image_color(const vec2 &p, const ImageAtlasCPU &image_atlas) const
+{
+  uint32_t image_type;
+  vec2 q, xy, tc;
+  float factor, color_tile_size, index_tile_size;
+  ivec2 ic;
+  u8vec4 tile;
+  int layer;
+
+  image_type = unpack_bits(PainterBrush::image_type_bit0,
+                           PainterBrush::image_type_num_bits, m_shader);
+  if (image_type != Image::on_atlas)
+    {
+      /* bindless images are not accessible from the CPU */
+      return vec4(1.0f, 1.0f, 1.0f, 1.0f);
+    }
+
+  color_tile_size = static_cast<float>(image_atlas.color_tile_size());
+  index_tile_size = static_cast<float>(image_atlas.index_tile_size());
+
+  q = vec2(glsl_mod(p.x(), m_image_size.x()), glsl_mod(p.y(), m_image_size.y()));
+  layer = m_image_master_tile.z();
+  if (m_image_number_lookups == 0)
+    {
+      /* direct-mapped image, the master tile is the color tile */
+      tc = q + m_image_start
+        + vec2(m_image_master_tile.x(), m_image_master_tile.y()) * color_tile_size
+        + vec2(m_image_slack, m_image_slack);
+    }
+  else
+    {
+      unsigned int ww;
+
+      ww = uint32_log2(image_atlas.index_tile_size()) * (m_image_number_lookups - 1u);
+      factor = 1.0f / ((color_tile_size - 2.0f * static_cast<float>(m_image_slack))
+                       * static_cast<float>(1u << ww));
+
+      /* convert from image coordinates to index-tile coordinates */
+      xy = q * factor
+        + vec2(m_image_master_tile.x(), m_image_master_tile.y()) * index_tile_size
+        + m_image_start * factor;
+
+      /* walk the index tiles to the color tile */
+      ic = ivec2(static_cast<int>(xy.x()), static_cast<int>(xy.y()));
+      tile = image_atlas.index_texel(ic.x(), ic.y(), layer);
+      layer = tile.z() + 256 * tile.w();
+      for (unsigned int i = 1; i < m_image_number_lookups; ++i)
+        {
+          xy -= vec2(ic.x(), ic.y());
+          tc = xy * index_tile_size + vec2(tile.x(), tile.y()) * index_tile_size;
+          ic = ivec2(static_cast<int>(tc.x()), static_cast<int>(tc.y()));
+          tile = image_atlas.index_texel(ic.x(), ic.y(), layer);
+          layer = tile.z() + 256 * tile.w();
+          xy = tc;
+        }
+
+      tc = (xy - vec2(ic.x(), ic.y())) * (color_tile_size - 2.0f * static_cast<float>(m_image_slack))
+        + vec2(m_image_slack, m_image_slack)
+        + vec2(tile.x(), tile.y()) * color_tile_size;
+    }
+
+  switch (m_image_filter)
+    {
+    case PainterBrush::image_filter_nearest:
+      return unpack_texel(image_atlas.color_texel(static_cast<int>(std::floor(tc.x())),
+                                                  static_cast<int>(std::floor(tc.y())),
+                                                  layer));
+
+    case PainterBrush::image_filter_linear:
+      return linear_fetch(image_atlas, tc, layer);
+
+    default:
+      return cubic_fetch(image_atlas, tc, layer);
+    }
+}
+
+fastuidraw::vec4
+fastuidraw::cpu::detail::brush_cpu::
+color(const vec2 &pp, const ImageAtlasCPU &image_atlas,
+      const ColorStopAtlasCPU &colorstop_atlas) const
+{
+  vec4 return_value(m_pen);
+  vec2 p(pp);
+
+  if (m_shader & PainterBrush::repeat_window_mask)
+    {
+      p -= m_repeat_window_xy;
+      p.x() = glsl_mod(p.x(), m_repeat_window_wh.x());
+      p.y() = glsl_mod(p.y(), m_repeat_window_wh.y());
+      p += m_repeat_window_xy;
+    }
+
+  if (m_shader & PainterBrush::gradient_mask)
+    {
+      float t, good;
+
+      t = gradient_interpolate(p, good);
+      if (m_shader & PainterBrush::gradient_repeat_mask)
+        {
+          t = glsl_fract(t);
+        }
+      else
+        {
+          t = t_max(0.0f, t_min(1.0f, t));
+        }
+      t = m_colorstop_xy.x() + t * m_colorstop_length;
+      return_value *= good * colorstop_atlas.fetch(t, static_cast<int>(m_colorstop_xy.y()));
+    }
+
+  if (m_shader & PainterBrush::image_mask)
+    {
+      vec4 c(image_color(p, image_atlas));
+
+      /* un-pre-multiply in float, see the GLSL brush shader */
+      if ((m_shader & PainterBrush::image_format_mask) && c.w() > 0.0f)
+        {
+          c.x() /= c.w();
+          c.y() /= c.w();
+          c.z() /= c.w();
+        }
+      return_value *= c;
+    }
+
+  return return_value;
+}
@@ -0,0 +1,92 @@
+/*!
+ * \file brush_cpu.hpp
+ * \brief file brush_cpu.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/painter/painter_brush.hpp>
+#include <fastuidraw/cpu_backend/image_cpu.hpp>
+#include <fastuidraw/cpu_backend/colorstop_atlas_cpu.hpp>
+
+namespace fastuidraw { namespace cpu { namespace detail {
+
+/* The brush of a header unpacked from the data store;
+ * the vertex and fragment computations are a port of
+ * fastuidraw_painter_brush.vert.glsl and
+ * fastuidraw_painter_brush.frag.glsl.
+ */
+class brush_cpu
+{
+public:
+  brush_cpu(void):
+    m_shader(0)
+  {}
+
+  /* Unpack the brush from data packed by PainterBrush::pack_data() */
+  void
+  unpack(uint32_t shader, c_array<const generic_data> data,
+         unsigned int alignment);
+
+  /* Apply the brush transformation to a point, the
+   * output is interpolated to each fragment.
+   */
+  vec2
+  transform(const vec2 &p) const;
+
+  /* Compute the brush color at a brush position; the
+   * returned color is NOT pre-multiplied by alpha.
+   */
+  vec4
+  color(const vec2 &p, const ImageAtlasCPU &image_atlas,
+        const ColorStopAtlasCPU &colorstop_atlas) const;
+
+private:
+  vec4
+  image_color(const vec2 &p, const ImageAtlasCPU &image_atlas) const;
+
+  float
+  gradient_interpolate(const vec2 &p, float &good) const;
+
+  static
+  vec4
+  linear_fetch(const ImageAtlasCPU &image_atlas, vec2 tc, int layer);
+
+  static
+  vec4
+  cubic_fetch(const ImageAtlasCPU &image_atlas, vec2 tc, int layer);
+
+  uint32_t m_shader;
+  vec4 m_pen;
+
+  vec2 m_image_size, m_image_start;
+  uvec3 m_image_master_tile;
+  unsigned int m_image_slack, m_image_number_lookups;
+  uint32_t m_image_filter;
+
+  vec2 m_gradient_p0, m_gradient_p1;
+  float m_gradient_r0, m_gradient_r1;
+  vec2 m_colorstop_xy;
+  float m_colorstop_length;
+
+  vec2 m_repeat_window_xy, m_repeat_window_wh;
+  vec4 m_transformation_matrix;
+  vec2 m_transformation_translation;
+};
+
+}}}
@@ -0,0 +1,99 @@
+/*!
+ * \file painter_shader_registrar_cpu.cpp
+ * \brief file painter_shader_registrar_cpu.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include "painter_shader_registrar_cpu.hpp"
+
+fastuidraw::cpu::detail::PainterShaderRegistrarCPU::
+PainterShaderRegistrarCPU(void)
+{
+  /* ID 0 is reserved to mean "no shader" */
+  m_tables.m_item_shaders.push_back(item_shader_entry());
+  m_tables.m_blend_shaders.push_back(blend_shader_entry());
+}
+
+void
+fastuidraw::cpu::detail::PainterShaderRegistrarCPU::
+fetch_tables(shader_tables &dst)
+{
+  Mutex::Guard m(mutex());
+  dst.m_item_shaders = m_tables.m_item_shaders;
+  dst.m_blend_shaders = m_tables.m_blend_shaders;
+}
+
+fastuidraw::PainterShader::Tag
+fastuidraw::cpu::detail::PainterShaderRegistrarCPU::
+absorb_item_shader(const reference_counted_ptr<PainterItemShader> &shader)
+{
+  reference_counted_ptr<const PainterItemShaderCPU> h;
+  PainterShader::Tag return_value;
+
+  FASTUIDRAWassert(!shader->parent());
+  FASTUIDRAWassert(shader.dynamic_cast_ptr<PainterItemShaderCPU>());
+  h = shader.static_cast_ptr<PainterItemShaderCPU>();
+
+  m_item_shaders.push_back(h);
+  return_value.m_ID = m_tables.m_item_shaders.size();
+  return_value.m_group = 0;
+  for (unsigned int i = 0, endi = h->number_sub_shaders(); i < endi; ++i)
+    {
+      m_tables.m_item_shaders.push_back(item_shader_entry(h.get(), i));
+    }
+
+  return return_value;
+}
+
+uint32_t
+fastuidraw::cpu::detail::PainterShaderRegistrarCPU::
+compute_item_sub_shader_group(const reference_counted_ptr<PainterItemShader> &shader)
+{
+  /* the rasterizer fetches the shader per triangle from
+   * the header, thus all shaders can be in the same group
+   */
+  FASTUIDRAWunused(shader);
+  return 0;
+}
+
+fastuidraw::PainterShader::Tag
+fastuidraw::cpu::detail::PainterShaderRegistrarCPU::
+absorb_blend_shader(const reference_counted_ptr<PainterBlendShader> &shader)
+{
+  reference_counted_ptr<const PainterBlendShaderCPU> h;
+  PainterShader::Tag return_value;
+
+  FASTUIDRAWassert(!shader->parent());
+  FASTUIDRAWassert(shader.dynamic_cast_ptr<PainterBlendShaderCPU>());
+  h = shader.static_cast_ptr<PainterBlendShaderCPU>();
+
+  m_blend_shaders.push_back(h);
+  return_value.m_ID = m_tables.m_blend_shaders.size();
+  return_value.m_group = 0;
+  for (unsigned int i = 0, endi = h->number_sub_shaders(); i < endi; ++i)
+    {
+      m_tables.m_blend_shaders.push_back(blend_shader_entry(h.get(), i));
+    }
+
+  return return_value;
+}
+
+uint32_t
+fastuidraw::cpu::detail::PainterShaderRegistrarCPU::
+compute_blend_sub_shader_group(const reference_counted_ptr<PainterBlendShader> &shader)
+{
+  FASTUIDRAWunused(shader);
+  return 0;
+}
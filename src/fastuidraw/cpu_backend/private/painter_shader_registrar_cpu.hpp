@@ -0,0 +1,120 @@
+/*!
+ * \file painter_shader_registrar_cpu.hpp
+ * \brief file painter_shader_registrar_cpu.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <fastuidraw/painter/packing/painter_shader_registrar.hpp>
+#include <fastuidraw/cpu_backend/painter_item_shader_cpu.hpp>
+#include <fastuidraw/cpu_backend/painter_blend_shader_cpu.hpp>
+#include "backend_shaders_cpu.hpp"
+
+namespace fastuidraw { namespace cpu { namespace detail {
+
+/* An entry of a shader table; the shader ID packed in
+ * the PainterHeader is the index into the table. Each
+ * sub-shader of a shader gets its own entry that refers
+ * to the root shader together with which sub-shader.
+ * If the shader is an UnsupportedShaderCPU, m_unsupported
+ * is non-null.
+ */
+template<typename T>
+class shader_entry
+{
+public:
+  shader_entry(void):
+    m_shader(nullptr),
+    m_sub_shader(0),
+    m_unsupported(nullptr)
+  {}
+
+  shader_entry(const T *sh, uint32_t sub):
+    m_shader(sh),
+    m_sub_shader(sub),
+    m_unsupported(dynamic_cast<const UnsupportedShaderCPU*>(sh))
+  {}
+
+  const T *m_shader;
+  uint32_t m_sub_shader;
+  const UnsupportedShaderCPU *m_unsupported;
+};
+
+typedef shader_entry<PainterItemShaderCPU> item_shader_entry;
+typedef shader_entry<PainterBlendShaderCPU> blend_shader_entry;
+
+/* The shader tables as seen by a draw; the tables hold
+ * plain pointers since the registrar keeps a reference
+ * to every shader registered to it.
+ */
+class shader_tables
+{
+public:
+  const item_shader_entry&
+  item_shader(uint32_t ID) const
+  {
+    static item_shader_entry null_entry;
+    return (ID < m_item_shaders.size()) ? m_item_shaders[ID] : null_entry;
+  }
+
+  const blend_shader_entry&
+  blend_shader(uint32_t ID) const
+  {
+    static blend_shader_entry null_entry;
+    return (ID < m_blend_shaders.size()) ? m_blend_shaders[ID] : null_entry;
+  }
+
+  std::vector<item_shader_entry> m_item_shaders;
+  std::vector<blend_shader_entry> m_blend_shaders;
+};
+
+class PainterShaderRegistrarCPU:public PainterShaderRegistrar
+{
+public:
+  PainterShaderRegistrarCPU(void);
+
+  /* Copy the current shader tables to dst; called at the
+   * start of drawing so that the rasterizer threads read
+   * tables that are not changed while they run.
+   */
+  void
+  fetch_tables(shader_tables &dst);
+
+protected:
+  virtual
+  PainterShader::Tag
+  absorb_item_shader(const reference_counted_ptr<PainterItemShader> &shader);
+
+  virtual
+  uint32_t
+  compute_item_sub_shader_group(const reference_counted_ptr<PainterItemShader> &shader);
+
+  virtual
+  PainterShader::Tag
+  absorb_blend_shader(const reference_counted_ptr<PainterBlendShader> &shader);
+
+  virtual
+  uint32_t
+  compute_blend_sub_shader_group(const reference_counted_ptr<PainterBlendShader> &shader);
+
+private:
+  shader_tables m_tables;
+  std::vector<reference_counted_ptr<const PainterItemShaderCPU> > m_item_shaders;
+  std::vector<reference_counted_ptr<const PainterBlendShaderCPU> > m_blend_shaders;
+};
+
+}}}
@@ -0,0 +1,830 @@
+/*!
+ * \file rasterizer_cpu.cpp
+ * \brief file rasterizer_cpu.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <fastuidraw/util/math.hpp>
+#include <fastuidraw/painter/painter_header.hpp>
+#include <fastuidraw/painter/painter_item_matrix.hpp>
+#include <fastuidraw/painter/painter_clip_equations.hpp>
+#include "rasterizer_cpu.hpp"
+
+namespace
+{
+  enum
+    {
+      /* number of vertices shaded by a single job */
+      vertex_job_size = 256,
+
+      /* width of the spans the edge equations are
+       * evaluated on; the loops over the span are
+       * written so that the compiler can vectorize
+       * them.
+       */
+      span_width = 4
+    };
+
+  /* triangles are clipped against w >= min_w */
+  const float min_w = 1e-6f;
+
+  inline
+  uint8_t
+  pack_color_channel(float v)
+  {
+    v = fastuidraw::t_max(0.0f, fastuidraw::t_min(1.0f, v));
+    return static_cast<uint8_t>(255.0f * v + 0.5f);
+  }
+}
+
+////////////////////////////////////////
+// fastuidraw::cpu::detail::render_target methods
+fastuidraw::cpu::detail::render_target::
+render_target(ivec2 dimensions):
+  m_dimensions(t_max(dimensions.x(), 1), t_max(dimensions.y(), 1)),
+  m_viewport(0, 0, m_dimensions.x(), m_dimensions.y()),
+  m_clear_color(0.0f, 0.0f, 0.0f, 0.0f),
+  m_color(m_dimensions.x() * m_dimensions.y()),
+  m_depth(m_dimensions.x() * m_dimensions.y(), 0.0f)
+{
+  clear_color_buffer(m_viewport);
+}
+
+void
+fastuidraw::cpu::detail::render_target::
+clear_color_buffer(const PainterBackend::Surface::Viewport &region)
+{
+  vec4 c(m_clear_color);
+  ivec2 pmin, pmax;
+  u8vec4 v;
+
+  /* the color buffer is pre-multiplied by alpha */
+  c.x() *= c.w();
+  c.y() *= c.w();
+  c.z() *= c.w();
+  for (unsigned int i = 0; i < 4; ++i)
+    {
+      v[i] = pack_color_channel(c[i]);
+    }
+
+  if (!clip_region(region, pmin, pmax))
+    {
+      return;
+    }
+
+  for (int y = pmin.y(); y < pmax.y(); ++y)
+    {
+      std::vector<u8vec4>::iterator row;
+
+      row = m_color.begin() + y * m_dimensions.x();
+      std::fill(row + pmin.x(), row + pmax.x(), v);
+    }
+}
+
+void
+fastuidraw::cpu::detail::render_target::
+clear_depth_buffer(const PainterBackend::Surface::Viewport &region)
+{
+  ivec2 pmin, pmax;
+
+  if (!clip_region(region, pmin, pmax))
+    {
+      return;
+    }
+
+  for (int y = pmin.y(); y < pmax.y(); ++y)
+    {
+      std::vector<float>::iterator row;
+
+      row = m_depth.begin() + y * m_dimensions.x();
+      std::fill(row + pmin.x(), row + pmax.x(), 0.0f);
+    }
+}
+
+bool
+fastuidraw::cpu::detail::render_target::
+clip_region(const PainterBackend::Surface::Viewport &region,
+            ivec2 &pmin, ivec2 &pmax) const
+{
+  pmin.x() = t_max(0, region.m_origin.x());
+  pmin.y() = t_max(0, region.m_origin.y());
+  pmax.x() = t_min(m_dimensions.x(), region.m_origin.x() + region.m_dimensions.x());
+  pmax.y() = t_min(m_dimensions.y(), region.m_origin.y() + region.m_dimensions.y());
+  return pmin.x() < pmax.x() && pmin.y() < pmax.y();
+}
+
+////////////////////////////////////////
+// fastuidraw::cpu::detail::rasterizer_cpu methods
+fastuidraw::cpu::detail::rasterizer_cpu::
+rasterizer_cpu(unsigned int number_threads, unsigned int log2_tile_size,
+               unsigned int alignment):
+  m_pool(number_threads),
+  m_log2_tile_size(t_max(2u, t_min(log2_tile_size, 12u))),
+  m_alignment(alignment),
+  m_target(nullptr),
+  m_image_atlas(nullptr),
+  m_colorstop_atlas(nullptr),
+  m_glyph_atlas(nullptr),
+  m_input(nullptr),
+  m_number_shaded_vertices(0)
+{}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+begin(render_target *target,
+      const PainterBackend::Surface::Viewport &damage_rect,
+      shader_tables &tables,
+      const ImageAtlasCPU *image_atlas,
+      const ColorStopAtlasCPU *colorstop_atlas,
+      const GlyphAtlasCPU *glyph_atlas)
+{
+  const PainterBackend::Surface::Viewport &vwp(target->m_viewport);
+  unsigned int tile_size(1u << m_log2_tile_size);
+
+  m_target = target;
+  std::swap(m_tables.m_item_shaders, tables.m_item_shaders);
+  std::swap(m_tables.m_blend_shaders, tables.m_blend_shaders);
+  m_image_atlas = image_atlas;
+  m_colorstop_atlas = colorstop_atlas;
+  m_glyph_atlas = glyph_atlas;
+
+  /* only those pixels within the viewport, the
+   * damage rect and the surface are rasterized.
+   */
+  m_viewport_pixels = vec2(vwp.m_dimensions);
+  m_region_min.x() = t_max(0, t_max(vwp.m_origin.x(), damage_rect.m_origin.x()));
+  m_region_min.y() = t_max(0, t_max(vwp.m_origin.y(), damage_rect.m_origin.y()));
+  m_region_max.x() = t_min(target->m_dimensions.x(),
+                           t_min(vwp.m_origin.x() + vwp.m_dimensions.x(),
+                                 damage_rect.m_origin.x() + damage_rect.m_dimensions.x()));
+  m_region_max.y() = t_min(target->m_dimensions.y(),
+                           t_min(vwp.m_origin.y() + vwp.m_dimensions.y(),
+                                 damage_rect.m_origin.y() + damage_rect.m_dimensions.y()));
+  m_region_max.x() = t_max(m_region_max.x(), m_region_min.x());
+  m_region_max.y() = t_max(m_region_max.y(), m_region_min.y());
+
+  m_number_tiles.x() = (m_region_max.x() - m_region_min.x() + tile_size - 1) >> m_log2_tile_size;
+  m_number_tiles.y() = (m_region_max.y() - m_region_min.y() + tile_size - 1) >> m_log2_tile_size;
+  m_tiles.resize(m_number_tiles.x() * m_number_tiles.y());
+  for (std::vector<unsigned int> &t : m_tiles)
+    {
+      t.clear();
+    }
+}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+end(void)
+{
+  m_target = nullptr;
+  m_input = nullptr;
+}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+unpack_header(const draw_input &input, uint32_t location,
+              decoded_header &dst)
+{
+  c_array<const generic_data> store(input.m_store);
+  c_array<const generic_data> h, matrix, clip;
+  uint32_t item_blend, item_ID, blend_ID, brush_location;
+
+  h = store.sub_array(location * m_alignment, PainterHeader::header_size);
+  matrix = store.sub_array(h[PainterHeader::item_matrix_location_offset].u * m_alignment,
+                           PainterItemMatrix::matrix_data_size);
+  clip = store.sub_array(h[PainterHeader::clip_equations_location_offset].u * m_alignment,
+                         PainterClipEquations::clip_data_size);
+
+  item_blend = h[PainterHeader::item_blend_shader_offset].u;
+  item_ID = unpack_bits(PainterHeader::item_shader_bit0,
+                        PainterHeader::item_shader_num_bits,
+                        item_blend);
+  blend_ID = unpack_bits(PainterHeader::blend_shader_bit0,
+                         PainterHeader::blend_shader_num_bits,
+                         item_blend);
+
+  const item_shader_entry &item(m_tables.item_shader(item_ID));
+  const blend_shader_entry &blend(m_tables.blend_shader(blend_ID));
+
+  dst.m_item_shader = item.m_shader;
+  dst.m_item_sub_shader = item.m_sub_shader;
+  dst.m_item_data_offset = h[PainterHeader::item_shader_data_location_offset].u * m_alignment;
+
+  dst.m_blend_shader = blend.m_shader;
+  dst.m_blend_sub_shader = blend.m_sub_shader;
+  dst.m_blend_data_offset = h[PainterHeader::blend_shader_data_location_offset].u * m_alignment;
+
+  /* a null item shader makes the draw skipped */
+  if (item.m_unsupported)
+    {
+      item.m_unsupported->report();
+      dst.m_item_shader = nullptr;
+    }
+  if (blend.m_unsupported)
+    {
+      blend.m_unsupported->report();
+      dst.m_item_shader = nullptr;
+    }
+
+  dst.m_item_matrix(0, 0) = matrix[PainterItemMatrix::matrix00_offset].f;
+  dst.m_item_matrix(0, 1) = matrix[PainterItemMatrix::matrix01_offset].f;
+  dst.m_item_matrix(0, 2) = matrix[PainterItemMatrix::matrix02_offset].f;
+  dst.m_item_matrix(1, 0) = matrix[PainterItemMatrix::matrix10_offset].f;
+  dst.m_item_matrix(1, 1) = matrix[PainterItemMatrix::matrix11_offset].f;
+  dst.m_item_matrix(1, 2) = matrix[PainterItemMatrix::matrix12_offset].f;
+  dst.m_item_matrix(2, 0) = matrix[PainterItemMatrix::matrix20_offset].f;
+  dst.m_item_matrix(2, 1) = matrix[PainterItemMatrix::matrix21_offset].f;
+  dst.m_item_matrix(2, 2) = matrix[PainterItemMatrix::matrix22_offset].f;
+
+  dst.m_clip_equations[0] = vec3(clip[PainterClipEquations::clip0_coeff_x].f,
+                                 clip[PainterClipEquations::clip0_coeff_y].f,
+                                 clip[PainterClipEquations::clip0_coeff_w].f);
+  dst.m_clip_equations[1] = vec3(clip[PainterClipEquations::clip1_coeff_x].f,
+                                 clip[PainterClipEquations::clip1_coeff_y].f,
+                                 clip[PainterClipEquations::clip1_coeff_w].f);
+  dst.m_clip_equations[2] = vec3(clip[PainterClipEquations::clip2_coeff_x].f,
+                                 clip[PainterClipEquations::clip2_coeff_y].f,
+                                 clip[PainterClipEquations::clip2_coeff_w].f);
+  dst.m_clip_equations[3] = vec3(clip[PainterClipEquations::clip3_coeff_x].f,
+                                 clip[PainterClipEquations::clip3_coeff_y].f,
+                                 clip[PainterClipEquations::clip3_coeff_w].f);
+
+  brush_location = h[PainterHeader::brush_shader_data_location_offset].u * m_alignment;
+  dst.m_brush.unpack(h[PainterHeader::brush_shader_offset].u,
+                     store.sub_array(brush_location),
+                     m_alignment);
+
+  dst.m_z = h[PainterHeader::z_offset].i;
+}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+compute_window_coordinates(shaded_vertex &v)
+{
+  const PainterBackend::Surface::Viewport &vwp(m_target->m_viewport);
+
+  if (v.m_clip_p.z() >= min_w)
+    {
+      vec2 ndc;
+
+      v.m_recip_w = 1.0f / v.m_clip_p.z();
+      ndc = vec2(v.m_clip_p.x(), v.m_clip_p.y()) * v.m_recip_w;
+      v.m_window_p.x() = float(vwp.m_origin.x()) + (0.5f * ndc.x() + 0.5f) * float(vwp.m_dimensions.x());
+      v.m_window_p.y() = float(vwp.m_origin.y()) + (0.5f * ndc.y() + 0.5f) * float(vwp.m_dimensions.y());
+    }
+  else
+    {
+      v.m_recip_w = 0.0f;
+      v.m_window_p = vec2(0.0f, 0.0f);
+    }
+}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+shade_vertex(const draw_input &input, unsigned int vertex)
+{
+  shaded_vertex &v(m_vertices[vertex]);
+  const decoded_header &h(m_headers[v.m_header]);
+  PainterItemShaderCPU::VertexEnvironment env;
+  vec4 item_p_brush_p;
+  int z_add(0);
+
+  if (!h.m_item_shader)
+    {
+      return;
+    }
+
+  env.m_item_matrix = h.m_item_matrix;
+  env.m_viewport_pixels = m_viewport_pixels;
+  env.m_data_store = input.m_store;
+
+  v.m_varyings = PainterItemShaderCPU::varyings(0.0f);
+  item_p_brush_p = h.m_item_shader->vertex_shade(h.m_item_sub_shader,
+                                                 input.m_attributes[vertex],
+                                                 h.m_item_data_offset,
+                                                 env, v.m_varyings, z_add);
+
+  v.m_clip_p = h.m_item_matrix * vec3(item_p_brush_p.x(), item_p_brush_p.y(), 1.0f);
+  for (unsigned int i = 0; i < 4; ++i)
+    {
+      v.m_clip_distances[i] = dot(h.m_clip_equations[i], v.m_clip_p);
+    }
+  v.m_depth = static_cast<float>(z_add + h.m_z);
+  v.m_brush_p = h.m_brush.transform(vec2(item_p_brush_p.z(), item_p_brush_p.w()));
+  compute_window_coordinates(v);
+}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+shade_vertices(const draw_input &input)
+{
+  unsigned int number_vertices, number_jobs;
+  uint32_t last_location(~0u);
+  unsigned int last_header(0);
+
+  m_input = &input;
+  m_headers.clear();
+  m_header_map.clear();
+
+  number_vertices = t_min(input.m_attributes.size(), input.m_header_attributes.size());
+  m_vertices.resize(number_vertices);
+  m_number_shaded_vertices = number_vertices;
+
+  /* Unpack each header once; the headers are unpacked at
+   * draw() time instead of when the PainterDraw is unmapped
+   * because values (for example the z of occluders) are
+   * patched by PainterDraw::DelayedAction objects.
+   */
+  for (unsigned int i = 0; i < number_vertices; ++i)
+    {
+      uint32_t location(input.m_header_attributes[i]);
+
+      if (location != last_location)
+        {
+          std::unordered_map<uint32_t, unsigned int>::const_iterator iter;
+
+          iter = m_header_map.find(location);
+          if (iter == m_header_map.end())
+            {
+              last_header = m_headers.size();
+              m_headers.push_back(decoded_header());
+              unpack_header(input, location, m_headers.back());
+              m_header_map[location] = last_header;
+            }
+          else
+            {
+              last_header = iter->second;
+            }
+          last_location = location;
+        }
+      m_vertices[i].m_header = last_header;
+    }
+
+  number_jobs = (number_vertices + vertex_job_size - 1) / vertex_job_size;
+  m_pool.run(number_jobs,
+             [this, &input, number_vertices](unsigned int job, unsigned int)
+             {
+               unsigned int begin, end;
+
+               begin = job * vertex_job_size;
+               end = t_min(begin + vertex_job_size, number_vertices);
+               for (unsigned int v = begin; v < end; ++v)
+                 {
+                   shade_vertex(input, v);
+                 }
+             });
+}
+
+fastuidraw::cpu::detail::rasterizer_cpu::shaded_vertex
+fastuidraw::cpu::detail::rasterizer_cpu::
+interpolate_vertex(const shaded_vertex &a, const shaded_vertex &b, float t)
+{
+  shaded_vertex return_value;
+  float s(1.0f - t);
+
+  /* all values are linear in clip-coordinates */
+  return_value.m_clip_p = s * a.m_clip_p + t * b.m_clip_p;
+  return_value.m_depth = s * a.m_depth + t * b.m_depth;
+  return_value.m_clip_distances = s * a.m_clip_distances + t * b.m_clip_distances;
+  return_value.m_brush_p = s * a.m_brush_p + t * b.m_brush_p;
+  return_value.m_varyings = s * a.m_varyings + t * b.m_varyings;
+  return_value.m_header = a.m_header;
+  compute_window_coordinates(return_value);
+
+  return return_value;
+}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+add_triangle(unsigned int v0, unsigned int v1, unsigned int v2)
+{
+  triangle tri;
+  vecN<vec2, 3> p;
+  vec2 pmin, pmax;
+  float area_2;
+
+  p[0] = m_vertices[v0].m_window_p;
+  p[1] = m_vertices[v1].m_window_p;
+  p[2] = m_vertices[v2].m_window_p;
+
+  area_2 = (p[1].x() - p[0].x()) * (p[2].y() - p[0].y())
+    - (p[1].y() - p[0].y()) * (p[2].x() - p[0].x());
+
+  if (!(area_2 != 0.0f) || !std::isfinite(area_2))
+    {
+      return;
+    }
+
+  /* there is no culling, triangles of either orientation
+   * are drawn; we make every triangle counter-clockwise.
+   */
+  tri.m_vertices = vecN<unsigned int, 3>(v0, v1, v2);
+  if (area_2 < 0.0f)
+    {
+      std::swap(tri.m_vertices[1], tri.m_vertices[2]);
+      std::swap(p[1], p[2]);
+      area_2 = -area_2;
+    }
+
+  tri.m_header = m_vertices[v0].m_header;
+  tri.m_recip_area_2 = 1.0f / area_2;
+  for (unsigned int i = 0; i < 3; ++i)
+    {
+      const vec2 &a(p[(i + 1) % 3]);
+      const vec2 &b(p[(i + 2) % 3]);
+      float dx(b.x() - a.x()), dy(b.y() - a.y());
+
+      /* E(q) = dx * (q.y - a.y) - dy * (q.x - a.x) */
+      tri.m_edges[i] = vec3(-dy, dx, dy * a.x() - dx * a.y());
+
+      /* top-left rule: a pixel center on an edge is
+       * covered if and only if the edge is a top
+       * or left edge of the triangle.
+       */
+      tri.m_include_zero[i] = (dy < 0.0f) || (dy == 0.0f && dx < 0.0f);
+    }
+
+  pmin = pmax = p[0];
+  for (unsigned int i = 1; i < 3; ++i)
+    {
+      pmin.x() = t_min(pmin.x(), p[i].x());
+      pmin.y() = t_min(pmin.y(), p[i].y());
+      pmax.x() = t_max(pmax.x(), p[i].x());
+      pmax.y() = t_max(pmax.y(), p[i].y());
+    }
+
+  /* pixel centers are at half-integers */
+  tri.m_min.x() = t_max(m_region_min.x(), static_cast<int>(std::floor(pmin.x() - 0.5f)));
+  tri.m_min.y() = t_max(m_region_min.y(), static_cast<int>(std::floor(pmin.y() - 0.5f)));
+  tri.m_max.x() = t_min(m_region_max.x(), static_cast<int>(std::ceil(pmax.x() + 0.5f)));
+  tri.m_max.y() = t_min(m_region_max.y(), static_cast<int>(std::ceil(pmax.y() + 0.5f)));
+
+  if (tri.m_min.x() >= tri.m_max.x() || tri.m_min.y() >= tri.m_max.y())
+    {
+      return;
+    }
+
+  m_triangles.push_back(tri);
+}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+clip_and_add_triangle(unsigned int v0, unsigned int v1, unsigned int v2)
+{
+  vecN<unsigned int, 3> in_poly(v0, v1, v2);
+  vecN<unsigned int, 4> out_poly;
+  unsigned int out_count(0), num_in(0);
+
+  for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (m_vertices[in_poly[i]].m_clip_p.z() >= min_w)
+        {
+          ++num_in;
+        }
+    }
+
+  if (num_in == 3)
+    {
+      add_triangle(v0, v1, v2);
+      return;
+    }
+
+  if (num_in == 0)
+    {
+      return;
+    }
+
+  /* clip the triangle against the plane w = min_w,
+   * new vertices are appended to m_vertices.
+   */
+  for (unsigned int i = 0; i < 3; ++i)
+    {
+      unsigned int a(in_poly[i]), b(in_poly[(i + 1) % 3]);
+      float wa(m_vertices[a].m_clip_p.z()), wb(m_vertices[b].m_clip_p.z());
+      bool a_in(wa >= min_w), b_in(wb >= min_w);
+
+      if (a_in)
+        {
+          out_poly[out_count++] = a;
+        }
+
+      if (a_in != b_in)
+        {
+          shaded_vertex v;
+          float t;
+
+          t = (min_w - wa) / (wb - wa);
+          v = interpolate_vertex(m_vertices[a], m_vertices[b], t);
+          out_poly[out_count++] = m_vertices.size();
+          m_vertices.push_back(v);
+        }
+    }
+
+  for (unsigned int i = 2; i < out_count; ++i)
+    {
+      add_triangle(out_poly[0], out_poly[i - 1], out_poly[i]);
+    }
+}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+bin_triangle(unsigned int tri_index)
+{
+  const triangle &tri(m_triangles[tri_index]);
+  ivec2 tmin, tmax;
+  int tile_size(1 << m_log2_tile_size);
+
+  tmin.x() = (tri.m_min.x() - m_region_min.x()) >> m_log2_tile_size;
+  tmin.y() = (tri.m_min.y() - m_region_min.y()) >> m_log2_tile_size;
+  tmax.x() = (tri.m_max.x() - 1 - m_region_min.x()) >> m_log2_tile_size;
+  tmax.y() = (tri.m_max.y() - 1 - m_region_min.y()) >> m_log2_tile_size;
+
+  for (int ty = tmin.y(); ty <= tmax.y(); ++ty)
+    {
+      for (int tx = tmin.x(); tx <= tmax.x(); ++tx)
+        {
+          vec2 cmin, cmax;
+          bool outside(false);
+
+          /* reject the tile if all of its pixel centers
+           * are outside of one of the edges.
+           */
+          cmin.x() = float(m_region_min.x() + tx * tile_size) + 0.5f;
+          cmin.y() = float(m_region_min.y() + ty * tile_size) + 0.5f;
+          cmax = cmin + vec2(float(tile_size - 1));
+          for (unsigned int e = 0; e < 3 && !outside; ++e)
+            {
+              const vec3 &E(tri.m_edges[e]);
+              float x, y;
+
+              x = (E.x() > 0.0f) ? cmax.x() : cmin.x();
+              y = (E.y() > 0.0f) ? cmax.y() : cmin.y();
+              outside = (E.x() * x + E.y() * y + E.z() < 0.0f);
+            }
+
+          if (!outside)
+            {
+              m_tiles[tx + ty * m_number_tiles.x()].push_back(tri_index);
+            }
+        }
+    }
+}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+draw_triangles(const draw_input &input,
+               unsigned int index_begin, unsigned int index_end)
+{
+  FASTUIDRAWassert(m_target);
+  FASTUIDRAWassert(m_input == &input);
+
+  index_end = t_min(index_end, static_cast<unsigned int>(input.m_indices.size()));
+  m_triangles.clear();
+  m_active_tiles.clear();
+
+  /* triangle setup and binning is done in order on
+   * the calling thread.
+   */
+  for (unsigned int i = index_begin; i + 2 < index_end; i += 3)
+    {
+      unsigned int v0(input.m_indices[i]);
+      unsigned int v1(input.m_indices[i + 1]);
+      unsigned int v2(input.m_indices[i + 2]);
+
+      if (v0 >= m_number_shaded_vertices
+          || v1 >= m_number_shaded_vertices
+          || v2 >= m_number_shaded_vertices)
+        {
+          continue;
+        }
+
+      const decoded_header &h(m_headers[m_vertices[v0].m_header]);
+      if (!h.m_item_shader || !h.m_blend_shader)
+        {
+          /* drawing with a shader the backend does not
+           * support, skip it.
+           */
+          continue;
+        }
+      clip_and_add_triangle(v0, v1, v2);
+    }
+
+  for (unsigned int t = 0, endt = m_triangles.size(); t < endt; ++t)
+    {
+      bin_triangle(t);
+    }
+
+  for (unsigned int t = 0, endt = m_tiles.size(); t < endt; ++t)
+    {
+      if (!m_tiles[t].empty())
+        {
+          m_active_tiles.push_back(t);
+        }
+    }
+
+  m_pool.run(m_active_tiles.size(),
+             [this](unsigned int job, unsigned int)
+             {
+               rasterize_tile(m_active_tiles[job]);
+             });
+
+  for (unsigned int t : m_active_tiles)
+    {
+      m_tiles[t].clear();
+    }
+}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+rasterize_tile(unsigned int tile)
+{
+  ivec2 tile_min, tile_max;
+  int tile_size(1 << m_log2_tile_size);
+
+  tile_min.x() = m_region_min.x() + (tile % m_number_tiles.x()) * tile_size;
+  tile_min.y() = m_region_min.y() + (tile / m_number_tiles.x()) * tile_size;
+  tile_max.x() = t_min(m_region_max.x(), tile_min.x() + tile_size);
+  tile_max.y() = t_min(m_region_max.y(), tile_min.y() + tile_size);
+
+  for (unsigned int tri : m_tiles[tile])
+    {
+      rasterize_triangle(m_triangles[tri], tile_min, tile_max);
+    }
+}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+rasterize_triangle(const triangle &tri, ivec2 tile_min, ivec2 tile_max)
+{
+  const decoded_header &h(m_headers[tri.m_header]);
+  ivec2 lo, hi;
+  vec3 E0(tri.m_edges[0]), E1(tri.m_edges[1]), E2(tri.m_edges[2]);
+
+  lo.x() = t_max(tile_min.x(), tri.m_min.x());
+  lo.y() = t_max(tile_min.y(), tri.m_min.y());
+  hi.x() = t_min(tile_max.x(), tri.m_max.x());
+  hi.y() = t_min(tile_max.y(), tri.m_max.y());
+
+  for (int y = lo.y(); y < hi.y(); ++y)
+    {
+      float py(float(y) + 0.5f);
+      float r0(E0.y() * py + E0.z());
+      float r1(E1.y() * py + E1.z());
+      float r2(E2.y() * py + E2.z());
+
+      for (int x = lo.x(); x < hi.x(); x += span_width)
+        {
+          float e0[span_width], e1[span_width], e2[span_width];
+          int covered[span_width];
+          int any_covered(0);
+
+          for (int k = 0; k < span_width; ++k)
+            {
+              float px(float(x + k) + 0.5f);
+              e0[k] = E0.x() * px + r0;
+              e1[k] = E1.x() * px + r1;
+              e2[k] = E2.x() * px + r2;
+            }
+
+          for (int k = 0; k < span_width; ++k)
+            {
+              int c0, c1, c2;
+
+              c0 = (e0[k] > 0.0f) | ((e0[k] == 0.0f) & tri.m_include_zero[0]);
+              c1 = (e1[k] > 0.0f) | ((e1[k] == 0.0f) & tri.m_include_zero[1]);
+              c2 = (e2[k] > 0.0f) | ((e2[k] == 0.0f) & tri.m_include_zero[2]);
+              covered[k] = c0 & c1 & c2 & (x + k < hi.x());
+              any_covered |= covered[k];
+            }
+
+          if (!any_covered)
+            {
+              continue;
+            }
+
+          for (int k = 0; k < span_width; ++k)
+            {
+              if (covered[k])
+                {
+                  vec3 b(e0[k], e1[k], e2[k]);
+                  shade_pixel(tri, h, x + k, y, b * tri.m_recip_area_2);
+                }
+            }
+        }
+    }
+}
+
+void
+fastuidraw::cpu::detail::rasterizer_cpu::
+shade_pixel(const triangle &tri, const decoded_header &h,
+            int x, int y, const vec3 &b)
+{
+  const shaded_vertex &v0(m_vertices[tri.m_vertices[0]]);
+  const shaded_vertex &v1(m_vertices[tri.m_vertices[1]]);
+  const shaded_vertex &v2(m_vertices[tri.m_vertices[2]]);
+  unsigned int pixel(x + y * m_target->m_dimensions.x());
+  vec3 recip_w(v0.m_recip_w, v1.m_recip_w, v2.m_recip_w);
+  vec3 q, pw;
+  float depth, sum;
+  vec4 clip_distances, item_color, brush_color, src, dst, out;
+  vec2 brush_p;
+  PainterItemShaderCPU::varyings v(0.0f), dvdx(0.0f), dvdy(0.0f);
+  PainterItemShaderCPU::FragmentEnvironment env;
+  unsigned int num_varyings;
+
+  /* depth is linear in screen space, depth test is GL_GEQUAL */
+  depth = b.x() * v0.m_depth + b.y() * v1.m_depth + b.z() * v2.m_depth;
+  if (depth < m_target->m_depth[pixel])
+    {
+      return;
+    }
+
+  /* perspective correct interpolation weights */
+  q = b * recip_w;
+  sum = q.x() + q.y() + q.z();
+  if (!(sum > 0.0f))
+    {
+      return;
+    }
+  pw = q / sum;
+
+  clip_distances = pw.x() * v0.m_clip_distances
+    + pw.y() * v1.m_clip_distances
+    + pw.z() * v2.m_clip_distances;
+  if (clip_distances.x() < 0.0f || clip_distances.y() < 0.0f
+      || clip_distances.z() < 0.0f || clip_distances.w() < 0.0f)
+    {
+      return;
+    }
+
+  num_varyings = h.m_item_shader->number_varyings();
+  if (num_varyings > 0)
+    {
+      vec3 bx, by, qx, qy;
+
+      /* derivatives are computed as forward differences
+       * by evaluating the interpolation at the neighboring
+       * pixel centers.
+       */
+      bx = b + vec3(tri.m_edges[0].x(), tri.m_edges[1].x(), tri.m_edges[2].x()) * tri.m_recip_area_2;
+      by = b + vec3(tri.m_edges[0].y(), tri.m_edges[1].y(), tri.m_edges[2].y()) * tri.m_recip_area_2;
+      qx = bx * recip_w;
+      qy = by * recip_w;
+      qx /= (qx.x() + qx.y() + qx.z());
+      qy /= (qy.x() + qy.y() + qy.z());
+
+      for (unsigned int i = 0; i < num_varyings; ++i)
+        {
+          float vv, vx, vy;
+
+          vv = pw.x() * v0.m_varyings[i] + pw.y() * v1.m_varyings[i] + pw.z() * v2.m_varyings[i];
+          vx = qx.x() * v0.m_varyings[i] + qx.y() * v1.m_varyings[i] + qx.z() * v2.m_varyings[i];
+          vy = qy.x() * v0.m_varyings[i] + qy.y() * v1.m_varyings[i] + qy.z() * v2.m_varyings[i];
+          v[i] = vv;
+          dvdx[i] = vx - vv;
+          dvdy[i] = vy - vv;
+        }
+    }
+
+  env.m_data_store = m_input->m_store;
+  env.m_glyph_atlas = m_glyph_atlas;
+  if (!h.m_item_shader->fragment_shade(h.m_item_sub_shader, h.m_item_data_offset,
+                                       env, v, dvdx, dvdy, item_color))
+    {
+      return;
+    }
+
+  brush_p = pw.x() * v0.m_brush_p + pw.y() * v1.m_brush_p + pw.z() * v2.m_brush_p;
+  brush_color = h.m_brush.color(brush_p, *m_image_atlas, *m_colorstop_atlas);
+
+  src = brush_color * item_color;
+  src.x() *= src.w();
+  src.y() *= src.w();
+  src.z() *= src.w();
+
+  const u8vec4 &d(m_target->m_color[pixel]);
+  dst = vec4(d.x(), d.y(), d.z(), d.w()) / 255.0f;
+
+  out = h.m_blend_shader->blend(h.m_blend_sub_shader, h.m_blend_data_offset,
+                                m_input->m_store, src, dst);
+
+  m_target->m_color[pixel] = u8vec4(pack_color_channel(out.x()),
+                                    pack_color_channel(out.y()),
+                                    pack_color_channel(out.z()),
+                                    pack_color_channel(out.w()));
+  m_target->m_depth[pixel] = depth;
+}
@@ -0,0 +1,236 @@
+/*!
+ * \file rasterizer_cpu.hpp
+ * \brief file rasterizer_cpu.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/matrix.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/painter/painter_attribute.hpp>
+#include <fastuidraw/painter/packing/painter_backend.hpp>
+#include <fastuidraw/cpu_backend/image_cpu.hpp>
+#include <fastuidraw/cpu_backend/glyph_atlas_cpu.hpp>
+#include <fastuidraw/cpu_backend/colorstop_atlas_cpu.hpp>
+#include "painter_shader_registrar_cpu.hpp"
+#include "thread_pool.hpp"
+#include "brush_cpu.hpp"
+
+namespace fastuidraw { namespace cpu { namespace detail {
+
+/* Color and depth buffer of a SurfaceCPU; the color
+ * buffer holds pre-multiplied by alpha values, both
+ * buffers are row major starting with the bottom row.
+ */
+class render_target:noncopyable
+{
+public:
+  explicit
+  render_target(ivec2 dimensions);
+
+  /* clear the pixels of the named region
+   * that are within the render_target.
+   */
+  void
+  clear_color_buffer(const PainterBackend::Surface::Viewport &region);
+
+  void
+  clear_depth_buffer(const PainterBackend::Surface::Viewport &region);
+
+  /* clip region against the render_target, returning
+   * false if the intersection is empty.
+   */
+  bool
+  clip_region(const PainterBackend::Surface::Viewport &region,
+              ivec2 &pmin, ivec2 &pmax) const;
+
+  ivec2 m_dimensions;
+  PainterBackend::Surface::Viewport m_viewport;
+  vec4 m_clear_color;
+  std::vector<u8vec4> m_color;
+  std::vector<float> m_depth;
+};
+
+/* The contents of a PainterDraw as seen by the rasterizer */
+class draw_input
+{
+public:
+  c_array<const PainterAttribute> m_attributes;
+  c_array<const uint32_t> m_header_attributes;
+  c_array<const PainterIndex> m_indices;
+  c_array<const generic_data> m_store;
+};
+
+/* Rasterizer that implements the drawing of a PainterBackendCPU.
+ * Drawing of a draw_input is done as:
+ *  1. shade_vertices() unpacks the headers and runs the vertex
+ *     shaders across the threads of the thread_pool
+ *  2. draw_triangles() is called for each range of indices between
+ *     the PainterDraw::Action values; it sets up the triangles
+ *     (clipping against w > 0), bins them to the screen tiles
+ *     they touch and rasterizes the tiles across the threads.
+ *     Each tile is processed by exactly one thread and walks
+ *     its triangles in submission order, so the results do not
+ *     depend on the number of threads.
+ */
+class rasterizer_cpu:noncopyable
+{
+public:
+  rasterizer_cpu(unsigned int number_threads, unsigned int log2_tile_size,
+                 unsigned int alignment);
+
+  unsigned int
+  number_threads(void)
+  {
+    return m_pool.number_threads();
+  }
+
+  /* Set the target and atlases; the passed shader
+   * tables are swapped into the rasterizer. Only the
+   * pixels within the viewport of the target and within
+   * damage_rect are rasterized.
+   */
+  void
+  begin(render_target *target,
+        const PainterBackend::Surface::Viewport &damage_rect,
+        shader_tables &tables,
+        const ImageAtlasCPU *image_atlas,
+        const ColorStopAtlasCPU *colorstop_atlas,
+        const GlyphAtlasCPU *glyph_atlas);
+
+  void
+  end(void);
+
+  void
+  shade_vertices(const draw_input &input);
+
+  void
+  draw_triangles(const draw_input &input,
+                 unsigned int index_begin, unsigned int index_end);
+
+private:
+  class decoded_header
+  {
+  public:
+    const PainterItemShaderCPU *m_item_shader;
+    uint32_t m_item_sub_shader;
+    unsigned int m_item_data_offset;
+
+    const PainterBlendShaderCPU *m_blend_shader;
+    uint32_t m_blend_sub_shader;
+    unsigned int m_blend_data_offset;
+
+    float3x3 m_item_matrix;
+    vecN<vec3, 4> m_clip_equations;
+    brush_cpu m_brush;
+    int m_z;
+  };
+
+  class shaded_vertex
+  {
+  public:
+    vec3 m_clip_p;
+    float m_depth;
+    vec4 m_clip_distances;
+    vec2 m_brush_p;
+    PainterItemShaderCPU::varyings m_varyings;
+    unsigned int m_header;
+
+    /* window coordinates and 1/w, valid only when w > 0 */
+    vec2 m_window_p;
+    float m_recip_w;
+  };
+
+  class triangle
+  {
+  public:
+    vecN<unsigned int, 3> m_vertices;
+    unsigned int m_header;
+
+    /* edge equations, edge i is opposite to vertex i,
+     * an edge equation E satisfies E(p) = A * x + B * y + C
+     * and is non-negative (with the top-left rule) exactly
+     * inside of the triangle; the barycentric coordinate
+     * of vertex i is E_i(p) / m_area_2.
+     */
+    vecN<vec3, 3> m_edges;
+    vecN<bool, 3> m_include_zero;
+    float m_recip_area_2;
+
+    /* pixel bounding box, min is inclusive, max is exclusive */
+    ivec2 m_min, m_max;
+  };
+
+  void
+  unpack_header(const draw_input &input, uint32_t location,
+                decoded_header &dst);
+
+  void
+  shade_vertex(const draw_input &input, unsigned int v);
+
+  void
+  compute_window_coordinates(shaded_vertex &v);
+
+  shaded_vertex
+  interpolate_vertex(const shaded_vertex &a, const shaded_vertex &b, float t);
+
+  void
+  add_triangle(unsigned int v0, unsigned int v1, unsigned int v2);
+
+  void
+  clip_and_add_triangle(unsigned int v0, unsigned int v1, unsigned int v2);
+
+  void
+  bin_triangle(unsigned int tri);
+
+  void
+  rasterize_tile(unsigned int tile);
+
+  void
+  rasterize_triangle(const triangle &tri, ivec2 tile_min, ivec2 tile_max);
+
+  void
+  shade_pixel(const triangle &tri, const decoded_header &h,
+              int x, int y, const vec3 &barycentric);
+
+  thread_pool m_pool;
+  unsigned int m_log2_tile_size, m_alignment;
+
+  render_target *m_target;
+  shader_tables m_tables;
+  const ImageAtlasCPU *m_image_atlas;
+  const ColorStopAtlasCPU *m_colorstop_atlas;
+  const GlyphAtlasCPU *m_glyph_atlas;
+  ivec2 m_region_min, m_region_max;
+  vec2 m_viewport_pixels;
+
+  const draw_input *m_input;
+  std::vector<decoded_header> m_headers;
+  std::unordered_map<uint32_t, unsigned int> m_header_map;
+  std::vector<shaded_vertex> m_vertices;
+  unsigned int m_number_shaded_vertices;
+
+  std::vector<triangle> m_triangles;
+  ivec2 m_number_tiles;
+  std::vector<std::vector<unsigned int> > m_tiles;
+  std::vector<unsigned int> m_active_tiles;
+};
+
+}}}
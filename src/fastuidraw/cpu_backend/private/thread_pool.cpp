@@ -0,0 +1,129 @@
+/*!
+ * \file thread_pool.cpp
+ * \brief file thread_pool.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include "thread_pool.hpp"
+
+fastuidraw::cpu::detail::thread_pool::
+thread_pool(unsigned int number_threads):
+  m_generation(0),
+  m_quit(false),
+  m_job(nullptr),
+  m_number_jobs(0),
+  m_next_job(0),
+  m_workers_running(0)
+{
+  number_threads = t_max(1u, number_threads);
+  for (unsigned int i = 1; i < number_threads; ++i)
+    {
+      m_workers.push_back(std::thread(&thread_pool::worker_main, this, i));
+    }
+}
+
+fastuidraw::cpu::detail::thread_pool::
+~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_start_condition.notify_all();
+
+  for (std::thread &t : m_workers)
+    {
+      t.join();
+    }
+}
+
+void
+fastuidraw::cpu::detail::thread_pool::
+run(unsigned int number_jobs, const job_function &f)
+{
+  if (number_jobs == 0)
+    {
+      return;
+    }
+
+  if (number_jobs == 1 || m_workers.empty())
+    {
+      for (unsigned int j = 0; j < number_jobs; ++j)
+        {
+          f(j, 0);
+        }
+      return;
+    }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_job = &f;
+    m_number_jobs = number_jobs;
+    m_next_job = 0;
+    m_workers_running = m_workers.size();
+    ++m_generation;
+  }
+  m_start_condition.notify_all();
+
+  do_jobs(0);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done_condition.wait(lock, [this] { return m_workers_running == 0; });
+  m_job = nullptr;
+}
+
+void
+fastuidraw::cpu::detail::thread_pool::
+do_jobs(unsigned int thread_id)
+{
+  for (unsigned int j = m_next_job++; j < m_number_jobs; j = m_next_job++)
+    {
+      (*m_job)(j, thread_id);
+    }
+}
+
+void
+fastuidraw::cpu::detail::thread_pool::
+worker_main(unsigned int thread_id)
+{
+  uint64_t generation_seen(0);
+
+  for (;;)
+    {
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_start_condition.wait(lock, [&] { return m_quit || m_generation != generation_seen; });
+        if (m_quit)
+          {
+            return;
+          }
+        generation_seen = m_generation;
+      }
+
+      do_jobs(thread_id);
+
+      bool last;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_workers_running;
+        last = (m_workers_running == 0);
+      }
+
+      if (last)
+        {
+          m_done_condition.notify_one();
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/*!
+ * \file thread_pool.hpp
+ * \brief file thread_pool.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/math.hpp>
+
+namespace fastuidraw { namespace cpu { namespace detail {
+
+/* A fixed set of worker threads that execute a batch of
+ * numbered jobs. The thread calling run() also executes
+ * jobs (as thread 0) and run() returns only after every
+ * job of the batch has completed. Jobs are handed out
+ * dynamically from an atomic counter, so a batch may have
+ * far more jobs than there are threads.
+ */
+class thread_pool:noncopyable
+{
+public:
+  /* Function to execute a job, first argument is
+   * the job number, the second is the thread number
+   * which is in the range [0, number_threads()).
+   */
+  typedef std::function<void (unsigned int, unsigned int)> job_function;
+
+  explicit
+  thread_pool(unsigned int number_threads);
+
+  ~thread_pool();
+
+  unsigned int
+  number_threads(void) const
+  {
+    return m_workers.size() + 1;
+  }
+
+  void
+  run(unsigned int number_jobs, const job_function &f);
+
+private:
+  void
+  worker_main(unsigned int thread_id);
+
+  void
+  do_jobs(unsigned int thread_id);
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_start_condition, m_done_condition;
+  uint64_t m_generation;
+  bool m_quit;
+
+  const job_function *m_job;
+  unsigned int m_number_jobs;
+  std::atomic<unsigned int> m_next_job;
+  unsigned int m_workers_running;
+};
+
+}}}
@@ -214,7 +214,8 @@ namespace
       m_delayed(false),
       m_alignment(4),
       m_type(fastuidraw::glsl::PainterShaderRegistrarGLSL::glyph_geometry_tbo),
-      m_log2_dims_geometry_store(-1, -1)
+      m_log2_dims_geometry_store(-1, -1),
+      m_texel_allocator(fastuidraw::GlyphAtlas::tree_texel_allocator)
     {}
 
     fastuidraw::ivec3 m_texel_store_dimensions;
@@ -223,6 +224,7 @@ namespace
     unsigned int m_alignment;
     enum fastuidraw::glsl::PainterShaderRegistrarGLSL::glyph_geometry_backing_t m_type;
     fastuidraw::ivec2 m_log2_dims_geometry_store;
+    enum fastuidraw::GlyphAtlas::texel_allocator_t m_texel_allocator;
   };
 
   class GlyphAtlasGLPrivate
@@ -819,6 +821,9 @@ setget_implement(fastuidraw::gl::GlyphAtlasGL::params,
 setget_implement(fastuidraw::gl::GlyphAtlasGL::params,
                  GlyphAtlasGLParamsPrivate,
                  bool, delayed);
+setget_implement(fastuidraw::gl::GlyphAtlasGL::params,
+                 GlyphAtlasGLParamsPrivate,
+                 enum fastuidraw::GlyphAtlas::texel_allocator_t, texel_allocator);
 set_implement(fastuidraw::gl::GlyphAtlasGL::params,
               GlyphAtlasGLParamsPrivate,
               unsigned int, alignment);
@@ -828,7 +833,8 @@ set_implement(fastuidraw::gl::GlyphAtlasGL::params,
 fastuidraw::gl::GlyphAtlasGL::
 GlyphAtlasGL(const params &P):
   GlyphAtlas(TexelStoreGL::create(P.texel_store_dimensions(), P.delayed()),
-             GeometryStoreGL::create(P))
+             GeometryStoreGL::create(P),
+             P.texel_allocator())
 {
   m_d = FASTUIDRAWnew GlyphAtlasGLPrivate(P);
 }
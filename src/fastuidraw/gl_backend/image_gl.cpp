@@ -45,7 +45,8 @@ namespace
   class ColorBackingStoreGL:public fastuidraw::AtlasColorBackingStoreBase
   {
   public:
-    ColorBackingStoreGL(int log2_tile_size, int log2_num_tiles_per_row_per_col, int number_layers, bool delayed);
+    ColorBackingStoreGL(int log2_tile_size, int log2_num_tiles_per_row_per_col, int number_layers, bool delayed,
+                        enum fastuidraw::AtlasColorBackingStoreBase::compression_t tp);
     ~ColorBackingStoreGL() {}
 
     virtual
@@ -74,12 +75,24 @@ namespace
     fastuidraw::ivec3
     store_size(int log2_tile_size, int log2_num_tiles_per_row_per_col, int num_layers);
 
+    /* returns the compression the GL context can provide for
+     * the requested compression; a compressed store needs the
+     * S3TC formats and, because the store is resized by copying
+     * its contents to a new texture, glCopyImageSubData.
+     */
+    static
+    enum fastuidraw::AtlasColorBackingStoreBase::compression_t
+    supported_compression(int log2_tile_size,
+                          enum fastuidraw::AtlasColorBackingStoreBase::compression_t tp);
+
     static
     fastuidraw::reference_counted_ptr<fastuidraw::AtlasColorBackingStoreBase>
-    create(int log2_tile_size, int log2_num_tiles_per_row_per_col, int num_layers, bool delayed)
+    create(int log2_tile_size, int log2_num_tiles_per_row_per_col, int num_layers, bool delayed,
+           enum fastuidraw::AtlasColorBackingStoreBase::compression_t tp)
     {
       ColorBackingStoreGL *p;
-      p = FASTUIDRAWnew ColorBackingStoreGL(log2_tile_size, log2_num_tiles_per_row_per_col, num_layers, delayed);
+      p = FASTUIDRAWnew ColorBackingStoreGL(log2_tile_size, log2_num_tiles_per_row_per_col, num_layers, delayed,
+                                            supported_compression(log2_tile_size, tp));
       return fastuidraw::reference_counted_ptr<fastuidraw::AtlasColorBackingStoreBase>(p);
     }
 
@@ -94,9 +107,20 @@ namespace
     }
 
   private:
-    typedef Texture<GL_RGBA8, GL_RGBA, GL_LINEAR, GL_NEAREST_MIPMAP_LINEAR>::type TextureGL;
+    typedef fastuidraw::gl::detail::TextureGLGeneric<GL_TEXTURE_2D_ARRAY> TextureGL;
+
+    static
+    GLenum
+    internal_format(enum fastuidraw::AtlasColorBackingStoreBase::compression_t tp);
+
+    /* upload size-by-size texels to the texture, compressing
+     * them first if the store is compressed
+     */
+    void
+    upload_texels(int mipmap_level, fastuidraw::ivec2 dst_xy, int dst_l,
+                  unsigned int size, fastuidraw::c_array<const fastuidraw::u8vec4> texels);
+
     TextureGL m_backing_store;
-    unsigned int m_number_mipmap_levels;
   };
 
   class IndexBackingStoreGL:public fastuidraw::AtlasIndexBackingStoreBase
@@ -184,7 +208,8 @@ namespace
   class ImageGLBindless:public fastuidraw::Image
   {
   public:
-    ImageGLBindless(int w, int h, unsigned int m, GLuint tex, GLuint64 handle);
+    ImageGLBindless(int w, int h, unsigned int m, GLuint tex, GLuint64 handle,
+                    enum fastuidraw::Image::format_t fmt = fastuidraw::Image::rgba_format);
     ~ImageGLBindless();
 
   private:
@@ -201,7 +226,8 @@ namespace
       m_log2_index_tile_size(2),
       m_log2_num_index_tiles_per_row_per_col(6),
       m_num_index_layers(4),
-      m_delayed(false)
+      m_delayed(false),
+      m_color_compression(fastuidraw::AtlasColorBackingStoreBase::uncompressed)
     {}
 
     int m_log2_color_tile_size;
@@ -211,6 +237,7 @@ namespace
     int m_log2_num_index_tiles_per_row_per_col;
     int m_num_index_layers;
     bool m_delayed;
+    enum fastuidraw::AtlasColorBackingStoreBase::compression_t m_color_compression;
   };
 
   class ImageAtlasGLPrivate
@@ -228,34 +255,68 @@ namespace
 ////////////////////////////////////////////
 // ColorBackingStoreGL methods
 ColorBackingStoreGL::
-ColorBackingStoreGL(int log2_tile_size,
-                    int log2_num_tiles_per_row_per_col,
-                    int number_layers,
-                    bool delayed):
+ColorBackingStoreGL(int log2_tile_size, int log2_num_tiles_per_row_per_col, int number_layers, bool delayed,
+                    enum fastuidraw::AtlasColorBackingStoreBase::compression_t tp):
   fastuidraw::AtlasColorBackingStoreBase(store_size(log2_tile_size, log2_num_tiles_per_row_per_col, number_layers),
-                                         true),
-  m_backing_store(dimensions(), delayed, log2_tile_size),
-  m_number_mipmap_levels(log2_tile_size)
+                                         true, tp),
+  /* a compressed store only holds the base level, see
+   * AtlasColorBackingStoreBase::compression_t
+   */
+  m_backing_store(internal_format(tp), GL_RGBA, GL_UNSIGNED_BYTE,
+                  GL_LINEAR, GL_NEAREST_MIPMAP_LINEAR,
+                  dimensions(), delayed,
+                  (tp == uncompressed) ? log2_tile_size : 1)
 {}
 
-void
+GLenum
 ColorBackingStoreGL::
-set_data(int mipmap_level, fastuidraw::ivec2 dst_xy, int dst_l, fastuidraw::ivec2 src_xy,
-         unsigned int size, const fastuidraw::ImageSourceBase &image_data)
+internal_format(enum fastuidraw::AtlasColorBackingStoreBase::compression_t tp)
+{
+  switch (tp)
+    {
+    case bc1_compression:
+      return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case bc3_compression:
+      return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    default:
+      return GL_RGBA8;
+    }
+}
+
+enum fastuidraw::AtlasColorBackingStoreBase::compression_t
+ColorBackingStoreGL::
+supported_compression(int log2_tile_size,
+                      enum fastuidraw::AtlasColorBackingStoreBase::compression_t tp)
 {
   using namespace fastuidraw;
+  using namespace gl;
 
-  if (mipmap_level >= m_backing_store.num_mipmaps())
+  if (tp == uncompressed || log2_tile_size < 2)
     {
-      return;
+      return uncompressed;
     }
 
+  ContextProperties ctx;
+  if (!ctx.has_extension("GL_EXT_texture_compression_s3tc")
+      || detail::CopyImageSubData::is_emulated())
+    {
+      return uncompressed;
+    }
+
+  return tp;
+}
+
+void
+ColorBackingStoreGL::
+upload_texels(int mipmap_level, fastuidraw::ivec2 dst_xy, int dst_l,
+              unsigned int size, fastuidraw::c_array<const fastuidraw::u8vec4> texels)
+{
+  using namespace fastuidraw;
+
   TextureGL::EntryLocation V;
-  std::vector<u8vec4> data_storage(size * size);
-  fastuidraw::c_array<u8vec4> data(make_c_array(data_storage));
-  fastuidraw::c_array<const uint8_t> raw_data;
+  c_array<const uint8_t> raw_data;
+  std::vector<uint8_t> blocks;
 
-  raw_data = data.reinterpret_pointer<const uint8_t>();
   V.m_mipmap_level = mipmap_level;
   V.m_location.x() = dst_xy.x();
   V.m_location.y() = dst_xy.y();
@@ -264,11 +325,43 @@ set_data(int mipmap_level, fastuidraw::ivec2 dst_xy, int dst_l, fastuidraw::ivec
   V.m_size.y() = size;
   V.m_size.z() = 1;
 
-  image_data.fetch_texels(V.m_mipmap_level, src_xy,
-                          V.m_size.x(), V.m_size.y(), data);
+  if (compression() == uncompressed)
+    {
+      raw_data = texels.reinterpret_pointer<const uint8_t>();
+    }
+  else
+    {
+      /* tiles are aligned to the color tile size, which is
+       * a multiple of 4, so blocks never straddle tiles
+       */
+      FASTUIDRAWassert(size % 4 == 0);
+      FASTUIDRAWassert(dst_xy.x() % 4 == 0 && dst_xy.y() % 4 == 0);
+      blocks.resize(compressed_block_bytes() * (size / 4) * (size / 4));
+      compress_texels(size, size, texels, make_c_array(blocks));
+      raw_data = make_c_array(blocks);
+    }
+
   m_backing_store.set_data_c_array(V, raw_data);
 }
 
+void
+ColorBackingStoreGL::
+set_data(int mipmap_level, fastuidraw::ivec2 dst_xy, int dst_l, fastuidraw::ivec2 src_xy,
+         unsigned int size, const fastuidraw::ImageSourceBase &image_data)
+{
+  using namespace fastuidraw;
+
+  if (mipmap_level >= m_backing_store.num_mipmaps())
+    {
+      return;
+    }
+
+  std::vector<u8vec4> data_storage(size * size);
+  image_data.fetch_texels(mipmap_level, src_xy, size, size,
+                          make_c_array(data_storage));
+  upload_texels(mipmap_level, dst_xy, dst_l, size, make_c_array(data_storage));
+}
+
 void
 ColorBackingStoreGL::
 set_data(int mipmap_level, fastuidraw::ivec2 dst_xy, int dst_l,
@@ -281,21 +374,8 @@ set_data(int mipmap_level, fastuidraw::ivec2 dst_xy, int dst_l,
       return;
     }
 
-  TextureGL::EntryLocation V;
   std::vector<u8vec4> data_storage(size * size, color_value);
-  fastuidraw::c_array<u8vec4> data(make_c_array(data_storage));
-  fastuidraw::c_array<const uint8_t> raw_data;
-
-  raw_data = data.reinterpret_pointer<const uint8_t>();
-  V.m_mipmap_level = mipmap_level;
-  V.m_location.x() = dst_xy.x();
-  V.m_location.y() = dst_xy.y();
-  V.m_location.z() = dst_l;
-  V.m_size.x() = size;
-  V.m_size.y() = size;
-  V.m_size.z() = 1;
-
-  m_backing_store.set_data_c_array(V, raw_data);
+  upload_texels(mipmap_level, dst_xy, dst_l, size, make_c_array(data_storage));
 }
 
 fastuidraw::ivec3
@@ -385,8 +465,9 @@ store_size(int log2_tile_size, int log2_num_index_tiles_per_row_per_col, int num
 // ImageGLBindless methods
 ImageGLBindless::
 ImageGLBindless(int w, int h, unsigned int m,
-                GLuint tex, GLuint64 handle):
-  fastuidraw::Image(w, h, m, fastuidraw::Image::bindless_texture2d, handle),
+                GLuint tex, GLuint64 handle,
+                enum fastuidraw::Image::format_t fmt):
+  fastuidraw::Image(w, h, m, fastuidraw::Image::bindless_texture2d, handle, fmt),
   m_texture(tex)
 {
 }
@@ -459,6 +540,10 @@ setget_implement(fastuidraw::gl::ImageAtlasGL::params,
 setget_implement(fastuidraw::gl::ImageAtlasGL::params,
                  ImageAtlasGLParamsPrivate,
                  bool, delayed)
+setget_implement(fastuidraw::gl::ImageAtlasGL::params,
+                 ImageAtlasGLParamsPrivate,
+                 enum fastuidraw::AtlasColorBackingStoreBase::compression_t,
+                 color_compression)
 
 //////////////////////////////////////////////
 // fastuidraw::gl::ImageAtlasGL methods
@@ -467,7 +552,7 @@ ImageAtlasGL(const params &P):
   fastuidraw::ImageAtlas(1 << P.log2_color_tile_size(), //color tile size
                         1 << P.log2_index_tile_size(), //index tile size
                         ColorBackingStoreGL::create(P.log2_color_tile_size(), P.log2_num_color_tiles_per_row_per_col(),
-                                                    P.num_color_layers(), P.delayed()),
+                                                    P.num_color_layers(), P.delayed(), P.color_compression()),
                         IndexBackingStoreGL::create(P.log2_index_tile_size(),
                                                     P.log2_num_index_tiles_per_row_per_col(),
                                                     P.num_index_layers(), P.delayed()))
@@ -560,3 +645,62 @@ create_bindless(int pw, int ph, unsigned int m, const ImageSourceBase &image,
 
   return FASTUIDRAWnew ImageGLBindless(pw, ph, m, texture, handle);
 }
+
+fastuidraw::reference_counted_ptr<fastuidraw::Image>
+fastuidraw::gl::ImageAtlasGL::
+create_bindless(GLuint fbo, ivec2 xy, ivec2 wh,
+                enum Image::format_t fmt,
+                GLenum min_filter, GLenum mag_filter)
+{
+  GLuint texture, dst_fbo;
+  GLint old_tex, old_read_fbo, old_draw_fbo;
+  GLboolean scissor_enabled;
+  GLuint64 handle;
+
+  if (detail::bindless().not_supported() || wh.x() <= 0 || wh.y() <= 0)
+    {
+      return reference_counted_ptr<fastuidraw::Image>();
+    }
+
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &old_tex);
+  glGenTextures(1, &texture);
+  FASTUIDRAWassert(texture != 0u);
+  glBindTexture(GL_TEXTURE_2D, texture);
+  detail::tex_storage<GL_TEXTURE_2D>(true, GL_RGBA8, wh, 1);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+  glBindTexture(GL_TEXTURE_2D, old_tex);
+
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &old_read_fbo);
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &old_draw_fbo);
+  scissor_enabled = glIsEnabled(GL_SCISSOR_TEST);
+
+  glGenFramebuffers(1, &dst_fbo);
+  FASTUIDRAWassert(dst_fbo != 0u);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, dst_fbo);
+  glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                         GL_TEXTURE_2D, texture, 0);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+
+  /* the scissor test applies to glBlitFramebuffer; the
+   * destination y-range is reversed to flip the rows.
+   */
+  glDisable(GL_SCISSOR_TEST);
+  glBlitFramebuffer(xy.x(), xy.y(), xy.x() + wh.x(), xy.y() + wh.y(),
+                    0, wh.y(), wh.x(), 0,
+                    GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  if (scissor_enabled)
+    {
+      glEnable(GL_SCISSOR_TEST);
+    }
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, old_read_fbo);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, old_draw_fbo);
+  glDeleteFramebuffers(1, &dst_fbo);
+
+  handle = detail::bindless().get_texture_handle(texture);
+  detail::bindless().make_texture_handle_resident(handle);
+
+  return FASTUIDRAWnew ImageGLBindless(wh.x(), wh.y(), 1, texture, handle, fmt);
+}
@@ -72,6 +72,72 @@ namespace
     }
   };
 
+  /* Action for the triangle fans of stencil-then-cover filling:
+   * front facing triangles increment and back facing triangles
+   * decrement the stencil buffer; color and depth are not written.
+   */
+  class StencilFanAction:public fastuidraw::PainterDraw::Action
+  {
+  public:
+    virtual
+    fastuidraw::gpu_dirty_state
+    execute(fastuidraw::PainterDraw::APIBase*) const
+    {
+      glEnable(GL_STENCIL_TEST);
+      glStencilMask(~0u);
+      glStencilFunc(GL_ALWAYS, 0, ~0u);
+      glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INCR_WRAP);
+      glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_DECR_WRAP);
+      glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+      glDepthMask(GL_FALSE);
+      return fastuidraw::gpu_dirty_state();
+    }
+  };
+
+  /* Action for the cover of stencil-then-cover filling: draw
+   * where (stencil & m_mask) compares by m_func against 0 and
+   * reset the stencil buffer to 0 everywhere the cover touches.
+   */
+  class StencilCoverAction:public fastuidraw::PainterDraw::Action
+  {
+  public:
+    StencilCoverAction(GLenum func, GLuint mask):
+      m_func(func),
+      m_mask(mask)
+    {}
+
+    virtual
+    fastuidraw::gpu_dirty_state
+    execute(fastuidraw::PainterDraw::APIBase*) const
+    {
+      glStencilFunc(m_func, 0, m_mask);
+      glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
+      glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+      glDepthMask(GL_TRUE);
+      return fastuidraw::gpu_dirty_state();
+    }
+
+  private:
+    GLenum m_func;
+    GLuint m_mask;
+  };
+
+  /* Action after the cover of stencil-then-cover filling;
+   * the returned flags make the backend restore the depth,
+   * stencil and mask state.
+   */
+  class StencilCoverEndAction:public fastuidraw::PainterDraw::Action
+  {
+  public:
+    virtual
+    fastuidraw::gpu_dirty_state
+    execute(fastuidraw::PainterDraw::APIBase*) const
+    {
+      return fastuidraw::gpu_dirty_state::depth_stencil
+        | fastuidraw::gpu_dirty_state::buffer_masks;
+    }
+  };
+
   class PainterBackendGLPrivate
   {
   public:
@@ -91,11 +157,15 @@ namespace
     set_gl_state(fastuidraw::gpu_dirty_state v,
                  bool clear_depth, bool clear_color);
 
+    void
+    set_scissor(void);
+
     fastuidraw::reference_counted_ptr<fastuidraw::gl::detail::PainterShaderRegistrarGL> m_reg_gl;
 
     GLuint m_nearest_filter_sampler;
     fastuidraw::gl::detail::painter_vao_pool *m_pool;
     fastuidraw::gl::detail::SurfaceGLPrivate *m_surface_gl;
+    fastuidraw::PainterBackend::Surface::Viewport m_damage_rect;
     bool m_uniform_ubo_ready;
     fastuidraw::gl::detail::PainterShaderRegistrarGL::program_set m_cached_programs;
 
@@ -833,6 +903,56 @@ compute_uber_shader_params(const fastuidraw::gl::PainterBackendGL::Configuration
 
   out_shaders = out_params.default_shaders(params.default_stroke_shader_aa_type(),
                                            q, q);
+
+  /* With blending_interlock the color is written by image
+   * stores which the stencil test and color mask do not
+   * block, so stencil-then-cover filling is only supported
+   * by the other blending types.
+   */
+  if (params.blending_type() != PainterBackendGL::blending_interlock)
+    {
+      PainterFillShader fill_shader(out_shaders.fill_shader());
+
+      fill_shader
+        .stencil_action(FASTUIDRAWnew StencilFanAction())
+        .cover_action(PainterEnums::nonzero_fill_rule,
+                      FASTUIDRAWnew StencilCoverAction(GL_NOTEQUAL, ~0u))
+        .cover_action(PainterEnums::complement_nonzero_fill_rule,
+                      FASTUIDRAWnew StencilCoverAction(GL_EQUAL, ~0u))
+        .cover_action(PainterEnums::odd_even_fill_rule,
+                      FASTUIDRAWnew StencilCoverAction(GL_NOTEQUAL, 1u))
+        .cover_action(PainterEnums::complement_odd_even_fill_rule,
+                      FASTUIDRAWnew StencilCoverAction(GL_EQUAL, 1u))
+        .end_cover_action(FASTUIDRAWnew StencilCoverEndAction());
+      out_shaders.fill_shader(fill_shader);
+    }
+}
+
+void
+PainterBackendGLPrivate::
+set_scissor(void)
+{
+  using namespace fastuidraw;
+
+  /* m_damage_rect is contained in the viewport, so
+   * scissoring to it also scissors to the viewport
+   */
+  const PainterBackend::Surface::Viewport &r(m_damage_rect);
+  ivec2 dimensions(m_surface_gl->m_properties.dimensions());
+
+  if (dimensions.x() > r.m_dimensions.x()
+      || dimensions.y() > r.m_dimensions.y()
+      || r.m_origin.x() != 0
+      || r.m_origin.y() != 0)
+    {
+      glEnable(GL_SCISSOR_TEST);
+      glScissor(r.m_origin.x(), r.m_origin.y(),
+                r.m_dimensions.x(), r.m_dimensions.y());
+    }
+  else
+    {
+      glDisable(GL_SCISSOR_TEST);
+    }
 }
 
 void
@@ -848,7 +968,6 @@ set_gl_state(fastuidraw::gpu_dirty_state v, bool clear_depth, bool clear_color_b
   enum PainterBackendGL::auxiliary_buffer_t aux_type;
   enum PainterBackendGL::blending_type_t blending_type;
   const PainterBackend::Surface::Viewport &vwp(m_surface_gl->m_viewport);
-  ivec2 dimensions(m_surface_gl->m_properties.dimensions());
   bool has_images;
 
   aux_type = uber_params.provide_auxiliary_image_buffer();
@@ -866,6 +985,11 @@ set_gl_state(fastuidraw::gpu_dirty_state v, bool clear_depth, bool clear_color_b
         {
           GLbitfield mask(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
+          /* the scissor must be set before the clear so that
+           * the clear is restricted to the damage rect
+           */
+          set_scissor();
+
           fbo = m_surface_gl->fbo(aux_type, blending_type);
           draw_buffers = m_surface_gl->draw_buffers(aux_type, blending_type);
 
@@ -975,20 +1099,7 @@ set_gl_state(fastuidraw::gpu_dirty_state v, bool clear_depth, bool clear_color_b
 
   if (v & gpu_dirty_state::viewport_scissor)
     {
-      if (dimensions.x() > vwp.m_dimensions.x()
-          || dimensions.y() > vwp.m_dimensions.y()
-          || vwp.m_origin.x() != 0
-          || vwp.m_origin.y() != 0)
-        {
-          glEnable(GL_SCISSOR_TEST);
-          glScissor(vwp.m_origin.x(), vwp.m_origin.y(),
-                    vwp.m_dimensions.x(), vwp.m_dimensions.y());
-        }
-      else
-        {
-          glDisable(GL_SCISSOR_TEST);
-        }
-
+      set_scissor();
       glViewport(vwp.m_origin.x(), vwp.m_origin.y(),
                  vwp.m_dimensions.x(), vwp.m_dimensions.y());
     }
@@ -1205,6 +1316,96 @@ dimensions(void) const
   return properties().dimensions();
 }
 
+fastuidraw::reference_counted_ptr<fastuidraw::Image>
+fastuidraw::gl::PainterBackendGL::SurfaceGL::
+image(const reference_counted_ptr<ImageAtlas> &atlas) const
+{
+  detail::SurfaceGLPrivate *d;
+  reference_counted_ptr<Image> return_value;
+  ivec2 pmin, pmax, wh, dims(dimensions());
+  GLint old_fbo;
+
+  d = static_cast<detail::SurfaceGLPrivate*>(m_d);
+  pmin.x() = t_max(0, d->m_viewport.m_origin.x());
+  pmin.y() = t_max(0, d->m_viewport.m_origin.y());
+  pmax.x() = t_min(dims.x(), d->m_viewport.m_origin.x() + d->m_viewport.m_dimensions.x());
+  pmax.y() = t_min(dims.y(), d->m_viewport.m_origin.y() + d->m_viewport.m_dimensions.y());
+  wh = pmax - pmin;
+  if (wh.x() <= 0 || wh.y() <= 0)
+    {
+      return return_value;
+    }
+
+  GLuint read_fbo, resolve_fbo(0), resolve_texture(0);
+
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &old_fbo);
+  read_fbo = d->fbo(detail::SurfaceGLPrivate::fbo_color_buffer);
+  if (d->m_properties.msaa() > 1)
+    {
+      GLint old_draw_fbo, old_tex;
+      GLboolean scissor_enabled;
+
+      /* a multisampled buffer can neither be read by glReadPixels
+       * nor be the source of a flipping blit, thus first resolve
+       * the viewport to a single sampled buffer.
+       */
+      glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &old_draw_fbo);
+      glGetIntegerv(GL_TEXTURE_BINDING_2D, &old_tex);
+      scissor_enabled = glIsEnabled(GL_SCISSOR_TEST);
+
+      glGenTextures(1, &resolve_texture);
+      glBindTexture(GL_TEXTURE_2D, resolve_texture);
+      detail::tex_storage<GL_TEXTURE_2D>(true, GL_RGBA8, dims, 1);
+      glBindTexture(GL_TEXTURE_2D, old_tex);
+
+      glGenFramebuffers(1, &resolve_fbo);
+      glBindFramebuffer(GL_DRAW_FRAMEBUFFER, resolve_fbo);
+      glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                             GL_TEXTURE_2D, resolve_texture, 0);
+      glBindFramebuffer(GL_READ_FRAMEBUFFER, read_fbo);
+      glDisable(GL_SCISSOR_TEST);
+      glBlitFramebuffer(pmin.x(), pmin.y(), pmax.x(), pmax.y(),
+                        pmin.x(), pmin.y(), pmax.x(), pmax.y(),
+                        GL_COLOR_BUFFER_BIT, GL_NEAREST);
+      if (scissor_enabled)
+        {
+          glEnable(GL_SCISSOR_TEST);
+        }
+      glBindFramebuffer(GL_DRAW_FRAMEBUFFER, old_draw_fbo);
+      read_fbo = resolve_fbo;
+    }
+
+  /* the color buffer is pre-multiplied by alpha, so is the
+   * Image; with bindless the copy stays on the GPU.
+   */
+  return_value = ImageAtlasGL::create_bindless(read_fbo, pmin, wh,
+                                               Image::premultiplied_rgba_format);
+  if (!return_value)
+    {
+      std::vector<u8vec4> pixels(wh.x() * wh.y()), texels(wh.x() * wh.y());
+
+      glBindFramebuffer(GL_READ_FRAMEBUFFER, read_fbo);
+      glPixelStorei(GL_PACK_ALIGNMENT, 1);
+      glReadPixels(pmin.x(), pmin.y(), wh.x(), wh.y(),
+                   GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+      convert_to_image_texels(wh, make_c_array(pixels), make_c_array(texels));
+
+      c_array<const u8vec4> level0(make_c_array(texels));
+      ImageSourceCArray src(uvec2(wh), c_array<const c_array<const u8vec4> >(&level0, 1));
+      return_value = Image::create(atlas, wh.x(), wh.y(), src, 1,
+                                   Image::premultiplied_rgba_format);
+    }
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, old_fbo);
+
+  if (resolve_fbo != 0)
+    {
+      glDeleteFramebuffers(1, &resolve_fbo);
+      glDeleteTextures(1, &resolve_texture);
+    }
+
+  return return_value;
+}
+
 get_implement(fastuidraw::gl::PainterBackendGL::SurfaceGL,
               fastuidraw::gl::detail::SurfaceGLPrivate,
               const fastuidraw::gl::PainterBackendGL::SurfaceGL::Properties&,
@@ -1755,12 +1956,14 @@ indices_per_mapping(void) const
 void
 fastuidraw::gl::PainterBackendGL::
 on_pre_draw(const reference_counted_ptr<Surface> &surface,
-            bool clear_color_buffer)
+            bool clear_color_buffer,
+            const Surface::Viewport &damage_rect)
 {
   PainterBackendGLPrivate *d;
 
   d = static_cast<PainterBackendGLPrivate*>(m_d);
   d->m_surface_gl = static_cast<detail::SurfaceGLPrivate*>(detail::SurfaceGLPrivate::surface_gl(surface)->m_d);
+  d->m_damage_rect = damage_rect;
 
   if (d->m_nearest_filter_sampler == 0)
     {
@@ -89,6 +89,8 @@ format_from_internal_format(GLenum fmt)
     case GL_RGBA8:
     case GL_RGBA32F:
     case GL_RGBA16F:
+    case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
       return GL_RGBA;
 
       //integer formats:
@@ -222,6 +224,14 @@ type_from_internal_format(GLenum fmt)
     }
 }
 
+bool
+fastuidraw::gl::detail::
+internal_format_is_compressed(GLenum fmt)
+{
+  return fmt == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+    || fmt == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+}
+
 ////////////////////////////////
 // CopyImageSubData methods
 fastuidraw::gl::detail::CopyImageSubData::
@@ -27,6 +27,17 @@
 #include <fastuidraw/gl_backend/ngl_header.hpp>
 #include <fastuidraw/gl_backend/gl_context_properties.hpp>
 
+/* The S3TC formats are not part of core GL, so the
+ * GL headers from which ngl is generated may lack them.
+ */
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 namespace fastuidraw { namespace gl { namespace detail {
 
 GLenum
@@ -35,6 +46,13 @@ format_from_internal_format(GLenum fmt);
 GLenum
 type_from_internal_format(GLenum fmt);
 
+/* returns true if the internal format is a block
+ * compressed format, i.e. data is set with
+ * glCompressedTexSubImage rather than glTexSubImage
+ */
+bool
+internal_format_is_compressed(GLenum fmt);
+
 class CopyImageSubData
 {
 public:
@@ -47,6 +65,17 @@ public:
              GLint dstX, GLint dstY, GLint dstZ,
              GLsizei width, GLsizei height, GLsizei depth) const;
 
+  /* returns true if the copy is emulated by blitting
+   * between FBO's; such a copy cannot be done on a
+   * texture with a compressed internal format.
+   */
+  static
+  bool
+  is_emulated(void)
+  {
+    return compute_type() == emulate_function;
+  }
+
 private:
   enum type_t
     {
@@ -190,6 +219,19 @@ tex_sub_image(int level, vecN<GLint, 3> offset,
                   format, type, pixels);
 }
 
+template<GLenum texture_target>
+inline
+void
+compressed_tex_sub_image(int level, vecN<GLint, 3> offset,
+                         vecN<GLsizei, 3> size, GLenum internalformat,
+                         c_array<const uint8_t> data)
+{
+  glCompressedTexSubImage3D(texture_target, level,
+                            offset.x(), offset.y(), offset.z(),
+                            size.x(), size.y(), size.z(),
+                            internalformat, data.size(), data.c_ptr());
+}
+
 //////////////////////////////////////////////
 // 2D
 
@@ -283,6 +325,19 @@ tex_sub_image(int level,
                   format, type, pixels);
 }
 
+template<GLenum texture_target>
+inline
+void
+compressed_tex_sub_image(int level, vecN<GLint, 2> offset,
+                         vecN<GLsizei, 2> size, GLenum internalformat,
+                         c_array<const uint8_t> data)
+{
+  glCompressedTexSubImage2D(texture_target, level,
+                            offset.x(), offset.y(),
+                            size.x(), size.y(),
+                            internalformat, data.size(), data.c_ptr());
+}
+
 
 //////////////////////////////////////////
 // 1D
@@ -419,6 +474,7 @@ private:
   flush_size_change(void);
 
   GLenum m_internal_format;
+  bool m_compressed;
   GLenum m_external_format;
   GLenum m_external_type;
   GLenum m_mag_filter;
@@ -451,6 +507,7 @@ TextureGLGeneric(GLenum internal_format,
                  vecN<int, N> dims, bool delayed,
                  unsigned int mipmap_levels):
   m_internal_format(internal_format),
+  m_compressed(internal_format_is_compressed(internal_format)),
   m_external_format(external_format),
   m_external_type(external_type),
   m_mag_filter(mag_filter),
@@ -605,11 +662,8 @@ flush(void)
       for(const auto &cmd : m_unflushed_commands)
         {
           FASTUIDRAWassert(!cmd.second.empty());
-          tex_sub_image<texture_target>(cmd.first.m_mipmap_level,
-                                        cmd.first.m_location,
-                                        cmd.first.m_size,
-                                        m_external_format, m_external_type,
-                                        &cmd.second[0]);
+          tex_subimage(cmd.first,
+                       c_array<const uint8_t>(&cmd.second[0], cmd.second.size()));
         }
       m_unflushed_commands.clear();
     }
@@ -639,11 +693,7 @@ set_data_vector(const EntryLocation &loc,
       flush_size_change();
       glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
       glBindTexture(texture_target, m_texture);
-      tex_sub_image<texture_target>(loc.m_mipmap_level,
-                                    loc.m_location,
-                                    loc.m_size,
-                                    m_external_format, m_external_type,
-                                    &data[0]);
+      tex_subimage(loc, c_array<const uint8_t>(&data[0], data.size()));
     }
 }
 
@@ -670,12 +720,34 @@ set_data_c_array(const EntryLocation &loc,
       flush_size_change();
       glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
       glBindTexture(texture_target, m_texture);
+      tex_subimage(loc, data);
+    }
+}
+
+template<GLenum texture_target>
+void
+TextureGLGeneric<texture_target>::
+tex_subimage(const EntryLocation &loc,
+             c_array<const uint8_t> data)
+{
+  /* for a compressed format, data holds the blocks
+   * covering loc and loc is aligned to the block size.
+   */
+  if (m_compressed)
+    {
+      compressed_tex_sub_image<texture_target>(loc.m_mipmap_level,
+                                               loc.m_location,
+                                               loc.m_size,
+                                               m_internal_format,
+                                               data);
+    }
+  else
+    {
       tex_sub_image<texture_target>(loc.m_mipmap_level,
                                     loc.m_location,
                                     loc.m_size,
                                     m_external_format, m_external_type,
                                     data.c_ptr());
-
     }
 }
 
@@ -461,6 +461,7 @@ add_enums(fastuidraw::glsl::ShaderSource &src)
     .add_macro("fastuidraw_image_type_num_bits", PainterBrush::image_type_num_bits)
     .add_macro("fastuidraw_image_type_on_atlas", Image::on_atlas)
     .add_macro("fastuidraw_image_type_bindless_texture2d", Image::bindless_texture2d)
+    .add_macro("fastuidraw_shader_image_format_mask", PainterBrush::image_format_mask)
 
     .add_macro("fastuidraw_image_mipmap_mask", PainterBrush::image_mipmap_mask)
     .add_macro("fastuidraw_image_mipmap_bit0", PainterBrush::image_mipmap_bit0)
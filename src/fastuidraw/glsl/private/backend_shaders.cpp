@@ -637,6 +637,45 @@ create_fill_shader(void)
                                                                     ShaderSource::from_resource),
                                                         varying_list().add_float_varying("fastuidraw_aa_fuzz")));
 
+  /* The analytic anti-aliasing shaders have yet to be validated
+   * on hardware, thus they are only part of the default fill
+   * shader when built with FASTUIDRAW_ANALYTIC_FILL_AA defined.
+   * The analytic anti-aliasing shader takes the fill rule as
+   * its sub-shader.
+   */
+  #ifdef FASTUIDRAW_ANALYTIC_FILL_AA
+  reference_counted_ptr<PainterItemShader> analytic_shader;
+  analytic_shader = FASTUIDRAWnew PainterItemShaderGLSL(false,
+                                                        ShaderSource()
+                                                        .add_macro("fastuidraw_fill_odd_even_fill_rule",
+                                                                   uint32_t(PainterEnums::odd_even_fill_rule))
+                                                        .add_macro("fastuidraw_fill_complement_odd_even_fill_rule",
+                                                                   uint32_t(PainterEnums::complement_odd_even_fill_rule))
+                                                        .add_macro("fastuidraw_fill_nonzero_fill_rule",
+                                                                   uint32_t(PainterEnums::nonzero_fill_rule))
+                                                        .add_source("fastuidraw_painter_fill_aa_analytic.vert.glsl.resource_string",
+                                                                    ShaderSource::from_resource)
+                                                        .remove_macro("fastuidraw_fill_odd_even_fill_rule")
+                                                        .remove_macro("fastuidraw_fill_complement_odd_even_fill_rule")
+                                                        .remove_macro("fastuidraw_fill_nonzero_fill_rule"),
+                                                        ShaderSource()
+                                                        .add_source("fastuidraw_painter_fill_aa_analytic.frag.glsl.resource_string",
+                                                                    ShaderSource::from_resource),
+                                                        varying_list()
+                                                        .add_float_varying("fastuidraw_aa_analytic_b0")
+                                                        .add_float_varying("fastuidraw_aa_analytic_b1")
+                                                        .add_float_varying("fastuidraw_aa_analytic_b2")
+                                                        .add_uint_varying("fastuidraw_aa_analytic_edges"),
+                                                        PainterEnums::fill_rule_data_count);
+  for (unsigned int i = 0; i < PainterEnums::fill_rule_data_count; ++i)
+    {
+      enum PainterEnums::fill_rule_t r;
+
+      r = static_cast<enum PainterEnums::fill_rule_t>(i);
+      fill_shader.aa_analytic_shader(r, FASTUIDRAWnew PainterItemShader(i, analytic_shader));
+    }
+  #endif
+
   return fill_shader;
 }
 
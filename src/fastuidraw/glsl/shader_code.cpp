@@ -237,7 +237,6 @@ compute_interval(c_string function_name, unsigned int data_alignment)
   ShaderSource return_value;
   std::ostringstream ostr;
 
-  c_string xyzw = "xyzw";
   c_string itypes[] =
     {
       "uint",
@@ -262,15 +261,7 @@ compute_interval(c_string function_name, unsigned int data_alignment)
       "xyzw",
     };
 
-  c_string start_interval[] =
-    {
-      "lastd",
-      "fV.x",
-      "fV.y",
-      "fV.z",
-    };
-
-  c_string end_interval[] =
+  c_string elements[] =
     {
       "fV.x",
       "fV.y",
@@ -278,17 +269,14 @@ compute_interval(c_string function_name, unsigned int data_alignment)
       "fV.w"
     };
 
-  c_string return_signs[] =
-    {
-      "1.0",
-      "-1.0",
-      "1.0",
-      "-1.0"
-    };
-
   FASTUIDRAWassert(data_alignment >=1 && data_alignment <= 4);
 
-  /* This.. is awful.
+  /* The interval end points are packed as an implicit search
+   * tree where each node is a block with data_alignment values
+   * and (data_alignment + 1) children, see PainterDashedStrokeParams.
+   * The number of values of a node that are no more than the
+   * distance gives which child to walk to; at the leaf that count
+   * gives the interval.
    */
   ostr << "float\n" << function_name
        << "(in uint intervals_location, in float total_distance,\n"
@@ -297,65 +285,91 @@ compute_interval(c_string function_name, unsigned int data_alignment)
        << "\tout int interval_ID,\n"
        << "\tout float interval_begin, out float interval_end)\n"
        << "{\n"
-       << "\tint loc;\n"
-       << "\tfloat d, lastd, ff, fd;\n";
-
-  if (data_alignment == 1 || data_alignment == 3)
-    {
-      ostr << "\tfloat s = 1.0;\n";
-    }
-
-  ostr << "\n"
+       << "\tuint node, leaf, number_leaves, leaf_offset, level_size, c, k;\n"
+       << "\tfloat d, ff, fd;\n"
+       << "\t" << itypes[data_alignment - 1] << " V;\n"
+       << "\t" << ftypes[data_alignment - 1] << " fV;\n"
+       << "\n"
        << "\tfd = floor(in_distance / total_distance);\n"
        << "\tff = total_distance * fd;\n"
        << "\td = in_distance - ff;\n"
-       << "\tlastd = first_interval_start;\n"
-       << "\tloc = 0;\n"
        << "\tinterval_begin = 0.0;\n"
        << "\tinterval_end = 0.0;\n"
        << "\tinterval_ID = -1;\n"
-       << "\n\n"
-       << "\tdo\n"
+       << "\n"
+       << "\tnumber_leaves = (number_intervals + uint(" << data_alignment - 1 << ")) / uint(" << data_alignment << ");\n"
+       << "\tleaf_offset = 0u;\n"
+       << "\tfor (level_size = 1u; level_size < number_leaves; level_size *= uint(" << data_alignment + 1 << "))\n"
        << "\t{\n"
-       << "\t\t" << itypes[data_alignment - 1] << " V;\n"
-       << "\t\t" << ftypes[data_alignment - 1] << " fV;\n"
-       << "\t\tV = fastuidraw_fetch_data(loc + int(intervals_location))." << extract_swizzle[data_alignment - 1] << ";\n"
+       << "\t\tleaf_offset += level_size;\n"
+       << "\t}\n"
+       << "\n"
+       << "\tfor (node = 0u; node < leaf_offset;)\n"
+       << "\t{\n"
+       << "\t\tV = fastuidraw_fetch_data(node + intervals_location)." << extract_swizzle[data_alignment - 1] << ";\n"
        << "\t\tfV = uintBitsToFloat(V);\n";
-  for(unsigned int i = 0; i < data_alignment; ++i)
+
+  if (data_alignment == 1)
     {
-      ostr << "\t\t";
-      if (i != 0)
-        {
-          ostr << "else ";
-        }
-      ostr << "if (d < fV." << xyzw[i] << ")\n"
-           << "\t\t{\n"
-           << "\t\t\tinterval_begin = ff + " << start_interval[i] << ";\n"
-           << "\t\t\tinterval_end = ff + " << end_interval[i] << ";\n"
-           << "\t\t\tinterval_ID = int(" << data_alignment << ") * loc "
-           << "+ int(" << i << ") + int(fd) * int(number_intervals);\n";
-      if (data_alignment == 1 || data_alignment == 3)
-        {
-          ostr << "\t\t\treturn s * " << return_signs[i] << ";\n";
-        }
-      else
-        {
-          ostr << "\t\t\treturn " << return_signs[i] << ";\n";
-        }
-      ostr << "\t\t\tlastd = 2.0 * total_distance + 1.0;\n"
-           << "\t\t}\n";
+      ostr << "\t\tc = uint(step(fV, d));\n";
+    }
+  else
+    {
+      ostr << "\t\tc = uint(dot(step(fV, " << ftypes[data_alignment - 1] << "(d)), "
+           << ftypes[data_alignment - 1] << "(1.0)));\n";
+    }
+
+  ostr << "\t\tnode = node * uint(" << data_alignment + 1 << ") + 1u + c;\n"
+       << "\t}\n"
+       << "\n"
+       << "\tleaf = node - leaf_offset;\n"
+       << "\tif (leaf >= number_leaves)\n"
+       << "\t{\n"
+       << "\t\treturn -1.0;\n"
+       << "\t}\n"
+       << "\n"
+       << "\tV = fastuidraw_fetch_data(node + intervals_location)." << extract_swizzle[data_alignment - 1] << ";\n"
+       << "\tfV = uintBitsToFloat(V);\n";
+
+  if (data_alignment == 1)
+    {
+      ostr << "\tc = uint(step(fV, d));\n";
+    }
+  else
+    {
+      ostr << "\tc = uint(dot(step(fV, " << ftypes[data_alignment - 1] << "(d)), "
+           << ftypes[data_alignment - 1] << "(1.0)));\n";
     }
-  ostr << "\t\tlastd = fV." << xyzw[data_alignment - 1] << ";\n"
-       << "\t\t++loc;\n";
 
-  if (data_alignment == 1 || data_alignment == 3)
+  ostr << "\n"
+       << "\tif (c == 0u)\n"
+       << "\t{\n"
+       << "\t\tinterval_begin = (leaf == 0u) ?\n"
+       << "\t\t\tfirst_interval_start :\n"
+       << "\t\t\tuintBitsToFloat(fastuidraw_fetch_data(node - 1u + intervals_location)."
+       << "xyzw"[data_alignment - 1] << ");\n"
+       << "\t\tinterval_end = " << elements[0] << ";\n"
+       << "\t}\n";
+
+  for(unsigned int i = 1; i < data_alignment; ++i)
     {
-      ostr << "\t\ts *= -1.0;\n";
+      ostr << "\telse if (c == " << i << "u)\n"
+           << "\t{\n"
+           << "\t\tinterval_begin = " << elements[i - 1] << ";\n"
+           << "\t\tinterval_end = " << elements[i] << ";\n"
+           << "\t}\n";
     }
 
-  ostr << "\t}\n"
-       << "\twhile(lastd < total_distance);\n"
-       << "\treturn -1.0;\n"
+  ostr << "\telse\n"
+       << "\t{\n"
+       << "\t\treturn -1.0;\n"
+       << "\t}\n"
+       << "\n"
+       << "\tk = leaf * uint(" << data_alignment << ") + c;\n"
+       << "\tinterval_begin += ff;\n"
+       << "\tinterval_end += ff;\n"
+       << "\tinterval_ID = int(k) + int(fd) * int(number_intervals);\n"
+       << "\treturn ((k & 1u) == 0u) ? 1.0 : -1.0;\n"
        << "}";
 
   return_value
@@ -35,7 +35,9 @@ FASTUIDRAW_RESOURCE_STRING += $(call filelist, \
 	fastuidraw_painter_fill.vert.glsl.resource_string \
 	fastuidraw_painter_fill.frag.glsl.resource_string \
 	fastuidraw_painter_fill_aa_fuzz.vert.glsl.resource_string \
-	fastuidraw_painter_fill_aa_fuzz.frag.glsl.resource_string)
+	fastuidraw_painter_fill_aa_fuzz.frag.glsl.resource_string \
+	fastuidraw_painter_fill_aa_analytic.vert.glsl.resource_string \
+	fastuidraw_painter_fill_aa_analytic.frag.glsl.resource_string)
 
 # Begin standard footer
 d		:= $(dirstack_$(sp))
@@ -18,11 +18,13 @@
 
 
 #include <list>
+#include <limits>
 #include <map>
 #include <mutex>
 #include <fastuidraw/image.hpp>
 #include "private/array3d.hpp"
 #include "private/util_private.hpp"
+#include "private/block_compress.hpp"
 
 
 namespace
@@ -167,18 +169,25 @@ namespace
   class BackingStorePrivate
   {
   public:
-    BackingStorePrivate(fastuidraw::ivec3 whl, bool presizable):
+    BackingStorePrivate(fastuidraw::ivec3 whl, bool presizable,
+                        enum fastuidraw::AtlasColorBackingStoreBase::compression_t
+                        pcompression = fastuidraw::AtlasColorBackingStoreBase::uncompressed):
       m_dimensions(whl),
-      m_resizeable(presizable)
+      m_resizeable(presizable),
+      m_compression(pcompression)
     {}
 
     BackingStorePrivate(int w, int h, int num_layers, bool presizable):
       m_dimensions(w, h, num_layers),
-      m_resizeable(presizable)
+      m_resizeable(presizable),
+      m_compression(fastuidraw::AtlasColorBackingStoreBase::uncompressed)
     {}
 
     fastuidraw::ivec3 m_dimensions;
     bool m_resizeable;
+
+    /* only meaningful for AtlasColorBackingStoreBase */
+    enum fastuidraw::AtlasColorBackingStoreBase::compression_t m_compression;
   };
 
   class inited_bool
@@ -243,6 +252,8 @@ namespace
     #endif
   };
 
+  class ImagePrivate;
+
   class ImageAtlasPrivate
   {
   public:
@@ -253,10 +264,42 @@ namespace
       m_color_tiles(pcolor_tile_size, pcolor_store->dimensions()),
       m_index_store(pindex_store),
       m_index_tiles(pindex_tile_size, pindex_store->dimensions()),
-      m_resizeable(m_color_store->resizeable() && m_index_store->resizeable())
+      m_resizeable(m_color_store->resizeable() && m_index_store->resizeable()),
+      m_color_levels(compute_color_levels(m_color_store.get(), pcolor_tile_size)),
+      m_color_tile_budget(0),
+      m_evictable_color_tiles(0),
+      m_frame(0)
     {}
 
-    std::mutex m_mutex;
+    /* evict the color tiles of the least recently used images
+     * until num_tiles more color tiles fit within the budget;
+     * the caller must hold m_mutex.
+     */
+    void
+    enforce_budget(int num_tiles);
+
+    /* a compressed color store only holds the base mipmap
+     * level, since the levels of a tile would quickly fall
+     * below the 4x4 block size.
+     */
+    static
+    int
+    compute_color_levels(const fastuidraw::AtlasColorBackingStoreBase *store,
+                         int color_tile_size)
+    {
+      if (store->compression() == fastuidraw::AtlasColorBackingStoreBase::uncompressed)
+        {
+          return std::numeric_limits<int>::max();
+        }
+      FASTUIDRAWassert(color_tile_size % 4 == 0);
+      FASTUIDRAWunused(color_tile_size);
+      return 1;
+    }
+
+    /* recursive because the residency management (which
+     * runs locked) calls the public methods of ImageAtlas
+     */
+    std::recursive_mutex m_mutex;
 
     fastuidraw::reference_counted_ptr<fastuidraw::AtlasColorBackingStoreBase> m_color_store;
     tile_allocator m_color_tiles;
@@ -265,13 +308,24 @@ namespace
     tile_allocator m_index_tiles;
 
     bool m_resizeable;
+    int m_color_levels;
+
+    /* residency management: m_lru holds the resident images
+     * that can be evicted, least recently used first; m_frame
+     * is incremented each time tile freeing is undelayed.
+     */
+    int m_color_tile_budget;
+    int m_evictable_color_tiles;
+    uint64_t m_frame;
+    std::list<ImagePrivate*> m_lru;
   };
 
   class per_color_tile
   {
   public:
-    per_color_tile(const fastuidraw::ivec3 t, bool b):
-      m_tile(t), m_non_repeat_color(b)
+    per_color_tile(const fastuidraw::ivec3 t, bool b,
+                   fastuidraw::u8vec4 c = fastuidraw::u8vec4(0, 0, 0, 0)):
+      m_tile(t), m_non_repeat_color(b), m_color(c)
     {}
 
     operator fastuidraw::ivec3() const
@@ -281,26 +335,98 @@ namespace
 
     fastuidraw::ivec3 m_tile;
     bool m_non_repeat_color;
+
+    /* color of the tile if m_non_repeat_color is false */
+    fastuidraw::u8vec4 m_color;
+  };
+
+  /* ImageSourceBase over the host-side copy of a single color
+   * tile; the texels of each mipmap level are stored one after
+   * the other.
+   */
+  class cached_color_tile:public fastuidraw::ImageSourceBase
+  {
+  public:
+    cached_color_tile(int tile_size, unsigned int num_levels,
+                      fastuidraw::c_array<const fastuidraw::u8vec4> texels):
+      m_tile_size(tile_size),
+      m_num_levels(num_levels),
+      m_texels(texels)
+    {}
+
+    static
+    unsigned int
+    level_offset(int tile_size, unsigned int level)
+    {
+      unsigned int return_value(0);
+      for (unsigned int l = 0; l < level; ++l, tile_size /= 2)
+        {
+          return_value += tile_size * tile_size;
+        }
+      return return_value;
+    }
+
+    virtual
+    bool
+    all_same_color(fastuidraw::ivec2, int, fastuidraw::u8vec4*) const
+    {
+      return false;
+    }
+
+    virtual
+    unsigned int
+    num_mipmap_levels(void) const
+    {
+      return m_num_levels;
+    }
+
+    virtual
+    void
+    fetch_texels(unsigned int mipmap_level, fastuidraw::ivec2 location,
+                 unsigned int w, unsigned int h,
+                 fastuidraw::c_array<fastuidraw::u8vec4> dst) const
+    {
+      int sz(m_tile_size >> mipmap_level);
+      unsigned int offset(level_offset(m_tile_size, mipmap_level));
+
+      FASTUIDRAWassert(mipmap_level < m_num_levels);
+      copy_sub_data(dst, w, h, m_texels.sub_array(offset, sz * sz),
+                    location.x(), location.y(), fastuidraw::ivec2(sz, sz));
+    }
+
+  private:
+    int m_tile_size;
+    unsigned int m_num_levels;
+    fastuidraw::c_array<const fastuidraw::u8vec4> m_texels;
   };
 
   class ImagePrivate
   {
   public:
     ImagePrivate(fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas> patlas,
+                 ImageAtlasPrivate *patlas_private,
                  int w, int h,
                  const fastuidraw::ImageSourceBase &image_data,
-                 unsigned int pslack);
+                 unsigned int pslack,
+                 enum fastuidraw::Image::format_t fmt);
 
-    ImagePrivate(int w, int h, unsigned int m, fastuidraw::Image::type_t t, uint64_t handle):
+    ImagePrivate(int w, int h, unsigned int m, fastuidraw::Image::type_t t, uint64_t handle,
+                 enum fastuidraw::Image::format_t fmt):
       m_dimensions(w, h),
       m_num_mipmap_levels(m),
       m_type(t),
+      m_format(fmt),
       m_slack(~0u),
       m_num_color_tiles(-1, -1),
       m_master_index_tile(-1, -1, -1),
       m_master_index_tile_dims(-1.0f, -1.0f),
       m_number_index_lookups(0),
       m_dimensions_index_divisor(-1.0f),
+      m_atlas_private(nullptr),
+      m_evictable(false),
+      m_resident(true),
+      m_last_use(0),
+      m_num_non_repeat_color_tiles(0),
       m_bindless_handle(handle)
     {}
 
@@ -309,6 +435,30 @@ namespace
     void
     create_color_tiles(const fastuidraw::ImageSourceBase &image_data);
 
+    fastuidraw::ivec3
+    add_cached_color_tile(fastuidraw::ivec2 src_xy,
+                          const fastuidraw::ImageSourceBase &image_data);
+
+    /* number of color tiles the image has on the atlas when resident */
+    int
+    number_allocated_color_tiles(void) const
+    {
+      return m_num_non_repeat_color_tiles + m_repeated_tiles.size();
+    }
+
+    /* evict and restore the color tiles; the caller
+     * must hold the mutex of the atlas.
+     */
+    void
+    evict(void);
+
+    void
+    restore(void);
+
+    /* rewrite the index tiles that refer to color tiles */
+    void
+    rewrite_color_index_tiles(void);
+
     void
     create_index_tiles(void);
 
@@ -323,6 +473,7 @@ namespace
     int m_num_mipmap_levels;
 
     enum fastuidraw::Image::type_t m_type;
+    enum fastuidraw::Image::format_t m_format;
 
     /* Data for when the image has type on_atlas */
     unsigned int m_slack;
@@ -335,47 +486,110 @@ namespace
     unsigned int m_number_index_lookups;
     float m_dimensions_index_divisor;
 
+    /* residency management for when the image is on an atlas
+     * that had a color tile budget when the image was created;
+     * m_tile_cache[i] holds the texels of the color tile
+     * m_color_tiles[i] if it is not a repeated color tile.
+     */
+    ImageAtlasPrivate *m_atlas_private;
+    bool m_evictable, m_resident;
+    uint64_t m_last_use;
+    int m_num_non_repeat_color_tiles;
+    std::vector<std::vector<fastuidraw::u8vec4> > m_tile_cache;
+    std::list<ImagePrivate*>::iterator m_lru_location;
+
     /* data for when image has different type than on_atlas */
     uint64_t m_bindless_handle;
   };
 }
 
+/////////////////////////////////////////////
+// ImageAtlasPrivate methods
+void
+ImageAtlasPrivate::
+enforce_budget(int num_tiles)
+{
+  if (m_color_tile_budget <= 0)
+    {
+      return;
+    }
+
+  /* only evict those images not used since the last
+   * time tile freeing was undelayed; draws using the
+   * other images may still be pending.
+   */
+  while (!m_lru.empty()
+         && m_evictable_color_tiles + num_tiles > m_color_tile_budget
+         && m_lru.front()->m_last_use < m_frame)
+    {
+      m_lru.front()->evict();
+    }
+}
+
 /////////////////////////////////////////////
 //ImagePrivate methods
 ImagePrivate::
 ImagePrivate(fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas> patlas,
+             ImageAtlasPrivate *patlas_private,
              int w, int h,
              const fastuidraw::ImageSourceBase &image_data,
-             unsigned int pslack):
+             unsigned int pslack,
+             enum fastuidraw::Image::format_t fmt):
   m_atlas(patlas),
   m_dimensions(w, h),
   m_num_mipmap_levels(image_data.num_mipmap_levels()),
   m_type(fastuidraw::Image::on_atlas),
+  m_format(fmt),
   m_slack(pslack),
+  m_atlas_private(patlas_private),
+  m_evictable(false),
+  m_resident(true),
+  m_last_use(0),
+  m_num_non_repeat_color_tiles(0),
   m_bindless_handle(-1)
 {
   FASTUIDRAWassert(m_dimensions.x() > 0);
   FASTUIDRAWassert(m_dimensions.y() > 0);
   FASTUIDRAWassert(m_atlas);
 
+  std::lock_guard<std::recursive_mutex> M(m_atlas_private->m_mutex);
+  m_evictable = (m_atlas_private->m_color_tile_budget > 0);
   create_color_tiles(image_data);
   create_index_tiles();
+
+  if (m_evictable)
+    {
+      m_last_use = m_atlas_private->m_frame;
+      m_atlas_private->m_evictable_color_tiles += number_allocated_color_tiles();
+      m_lru_location = m_atlas_private->m_lru.insert(m_atlas_private->m_lru.end(), this);
+    }
 }
 
 ImagePrivate::
 ~ImagePrivate()
 {
-  for(const per_color_tile &C : m_color_tiles)
+  if (m_evictable)
     {
-      if (C.m_non_repeat_color)
+      std::lock_guard<std::recursive_mutex> M(m_atlas_private->m_mutex);
+      if (m_resident)
         {
-          m_atlas->delete_color_tile(C.m_tile);
+          evict();
         }
     }
-
-  for(const auto &C : m_repeated_tiles)
+  else
     {
-      m_atlas->delete_color_tile(C.second);
+      for(const per_color_tile &C : m_color_tiles)
+        {
+          if (C.m_non_repeat_color)
+            {
+              m_atlas->delete_color_tile(C.m_tile);
+            }
+        }
+
+      for(const auto &C : m_repeated_tiles)
+        {
+          m_atlas->delete_color_tile(C.second);
+        }
     }
 
   for(const auto &tile_array: m_index_tiles)
@@ -397,6 +611,11 @@ create_color_tiles(const fastuidraw::ImageSourceBase &image_data)
   color_tile_size = m_atlas->color_tile_size();
   tile_interior_size = color_tile_size - 2 * m_slack;
   m_num_color_tiles = divide_up(m_dimensions, tile_interior_size);
+  if (m_evictable)
+    {
+      m_tile_cache.resize(m_num_color_tiles.x() * m_num_color_tiles.y());
+      m_atlas_private->enforce_budget(m_num_color_tiles.x() * m_num_color_tiles.y());
+    }
   m_master_index_tile_dims = fastuidraw::vec2(m_dimensions) / static_cast<float>(tile_interior_size);
   m_dimensions_index_divisor = static_cast<float>(tile_interior_size);
 
@@ -432,12 +651,18 @@ create_color_tiles(const fastuidraw::ImageSourceBase &image_data)
                   m_repeated_tiles[same_color_value] = new_tile;
                 }
             }
+          else if (m_evictable)
+            {
+              new_tile = add_cached_color_tile(src_xy, image_data);
+              ++m_num_non_repeat_color_tiles;
+            }
           else
             {
               new_tile = m_atlas->add_color_tile(src_xy, image_data);
+              ++m_num_non_repeat_color_tiles;
             }
 
-          m_color_tiles.push_back(per_color_tile(new_tile, !all_same_color) );
+          m_color_tiles.push_back(per_color_tile(new_tile, !all_same_color, same_color_value));
         }
     }
 
@@ -447,6 +672,153 @@ create_color_tiles(const fastuidraw::ImageSourceBase &image_data)
   //        << " tiles from repeat color magicks\n";
 }
 
+fastuidraw::ivec3
+ImagePrivate::
+add_cached_color_tile(fastuidraw::ivec2 src_xy,
+                      const fastuidraw::ImageSourceBase &image_data)
+{
+  std::vector<fastuidraw::u8vec4> &texels(m_tile_cache[m_color_tiles.size()]);
+  int sz(m_atlas->color_tile_size());
+  unsigned int level, num_levels;
+
+  /* walk the levels exactly as ImageAtlas::add_color_tile() does */
+  num_levels = fastuidraw::t_min(image_data.num_mipmap_levels(),
+                                 static_cast<unsigned int>(m_atlas_private->m_color_levels));
+  texels.resize(cached_color_tile::level_offset(sz, num_levels));
+  for (level = 0; level < num_levels && sz > 0; ++level, sz /= 2, src_xy /= 2)
+    {
+      fastuidraw::c_array<fastuidraw::u8vec4> dst;
+
+      dst = fastuidraw::make_c_array(texels).sub_array(cached_color_tile::level_offset(m_atlas->color_tile_size(), level), sz * sz);
+      image_data.fetch_texels(level, src_xy, sz, sz, dst);
+    }
+  texels.resize(cached_color_tile::level_offset(m_atlas->color_tile_size(), level));
+
+  cached_color_tile tile(m_atlas->color_tile_size(), level,
+                         fastuidraw::make_c_array(texels));
+  return m_atlas->add_color_tile(fastuidraw::ivec2(0, 0), tile);
+}
+
+void
+ImagePrivate::
+evict(void)
+{
+  FASTUIDRAWassert(m_evictable);
+  FASTUIDRAWassert(m_resident);
+
+  for(const per_color_tile &C : m_color_tiles)
+    {
+      if (C.m_non_repeat_color)
+        {
+          m_atlas->delete_color_tile(C.m_tile);
+        }
+    }
+
+  for(const auto &C : m_repeated_tiles)
+    {
+      m_atlas->delete_color_tile(C.second);
+    }
+
+  /* the index tiles are left as-is; they are rewritten
+   * by restore() before the image is used again.
+   */
+  m_resident = false;
+  m_atlas_private->m_evictable_color_tiles -= number_allocated_color_tiles();
+  m_atlas_private->m_lru.erase(m_lru_location);
+}
+
+void
+ImagePrivate::
+restore(void)
+{
+  int needed;
+
+  FASTUIDRAWassert(m_evictable);
+  FASTUIDRAWassert(!m_resident);
+
+  needed = number_allocated_color_tiles();
+  m_atlas_private->enforce_budget(needed);
+  if (needed > m_atlas->number_free_color_tiles())
+    {
+      if (!m_atlas->resizeable())
+        {
+          FASTUIDRAWassert(!"Unable to restore evicted Image color tiles");
+          return;
+        }
+      m_atlas->resize_to_fit(needed, 0);
+    }
+
+  for (auto &C : m_repeated_tiles)
+    {
+      C.second = m_atlas->add_color_tile(C.first);
+    }
+
+  for (unsigned int i = 0, endi = m_color_tiles.size(); i < endi; ++i)
+    {
+      per_color_tile &C(m_color_tiles[i]);
+      if (C.m_non_repeat_color)
+        {
+          const std::vector<fastuidraw::u8vec4> &texels(m_tile_cache[i]);
+          int sz(m_atlas->color_tile_size());
+          unsigned int num_levels(0);
+
+          for (unsigned int offset = 0; offset < texels.size(); offset += sz * sz, sz /= 2)
+            {
+              ++num_levels;
+            }
+
+          cached_color_tile tile(m_atlas->color_tile_size(), num_levels,
+                                 fastuidraw::make_c_array(texels));
+          C.m_tile = m_atlas->add_color_tile(fastuidraw::ivec2(0, 0), tile);
+        }
+      else
+        {
+          C.m_tile = m_repeated_tiles[C.m_color];
+        }
+    }
+
+  rewrite_color_index_tiles();
+  m_resident = true;
+  m_atlas_private->m_evictable_color_tiles += needed;
+  m_lru_location = m_atlas_private->m_lru.insert(m_atlas_private->m_lru.end(), this);
+}
+
+void
+ImagePrivate::
+rewrite_color_index_tiles(void)
+{
+  int index_tile_size(m_atlas->index_tile_size());
+  std::vector<fastuidraw::ivec3> vtile_data(index_tile_size * index_tile_size);
+  fastuidraw::c_array<fastuidraw::ivec3> tile_data;
+  fastuidraw::c_array<const per_color_tile> src_tiles;
+  const std::vector<fastuidraw::ivec3> &index_tiles(m_index_tiles.front());
+  unsigned int i(0);
+
+  tile_data = fastuidraw::make_c_array(vtile_data);
+  src_tiles = fastuidraw::make_c_array(m_color_tiles);
+
+  /* same walk as create_index_layer() for the first layer */
+  for(int source_y = 0; source_y < m_num_color_tiles.y(); source_y += index_tile_size)
+    {
+      for(int source_x = 0; source_x < m_num_color_tiles.x(); source_x += index_tile_size, ++i)
+        {
+          fastuidraw::ivec3 tile(index_tiles[i]);
+
+          copy_sub_data<fastuidraw::ivec3, per_color_tile>(tile_data, index_tile_size, index_tile_size,
+                                                           src_tiles, source_x, source_y,
+                                                           m_num_color_tiles);
+          m_atlas_private->m_index_store->set_data(tile.x() * index_tile_size,
+                                                   tile.y() * index_tile_size,
+                                                   tile.z(),
+                                                   index_tile_size,
+                                                   index_tile_size,
+                                                   tile_data,
+                                                   m_slack,
+                                                   m_atlas_private->m_color_store.get(),
+                                                   m_atlas_private->m_color_tiles.tile_size());
+        }
+    }
+}
 
 /*
  * returns the number of index tiles needed to
@@ -502,6 +874,21 @@ create_index_tiles(void)
   int level(2);
   float findex_tile_size;
 
+  /* An image that fits within a single color tile is
+   * direct-mapped: the brush samples the color tile
+   * without walking any index tiles. Images that can
+   * be evicted keep their index tile because their
+   * color tile moves when it is restored.
+   */
+  if (m_num_color_tiles == fastuidraw::ivec2(1, 1) && !m_evictable)
+    {
+      m_master_index_tile = m_color_tiles.front().m_tile;
+      m_master_index_tile_dims = fastuidraw::vec2(m_dimensions);
+      m_dimensions_index_divisor = 1.0f;
+      m_number_index_lookups = 0;
+      return;
+    }
+
   findex_tile_size = static_cast<float>(m_atlas->index_tile_size());
   num_index_tiles = create_index_layer<per_color_tile>(fastuidraw::make_c_array(m_color_tiles),
                                                        m_num_color_tiles,
@@ -772,6 +1159,13 @@ AtlasColorBackingStoreBase(int w, int h, int num_layers, bool presizable)
   m_d = FASTUIDRAWnew BackingStorePrivate(w, h, num_layers, presizable);
 }
 
+fastuidraw::AtlasColorBackingStoreBase::
+AtlasColorBackingStoreBase(ivec3 whl, bool presizable,
+                           enum compression_t pcompression)
+{
+  m_d = FASTUIDRAWnew BackingStorePrivate(whl, presizable, pcompression);
+}
+
 fastuidraw::AtlasColorBackingStoreBase::
 ~AtlasColorBackingStoreBase()
 {
@@ -799,6 +1193,31 @@ resizeable(void) const
   return d->m_resizeable;
 }
 
+enum fastuidraw::AtlasColorBackingStoreBase::compression_t
+fastuidraw::AtlasColorBackingStoreBase::
+compression(void) const
+{
+  BackingStorePrivate *d;
+  d = static_cast<BackingStorePrivate*>(m_d);
+  return d->m_compression;
+}
+
+unsigned int
+fastuidraw::AtlasColorBackingStoreBase::
+compressed_block_bytes(void) const
+{
+  return detail::block_compression_bytes_per_block(compression());
+}
+
+void
+fastuidraw::AtlasColorBackingStoreBase::
+compress_texels(int w, int h, c_array<const u8vec4> texels,
+                c_array<uint8_t> dst) const
+{
+  FASTUIDRAWassert(compression() != uncompressed);
+  detail::block_compress(compression(), w, h, texels, dst);
+}
+
 void
 fastuidraw::AtlasColorBackingStoreBase::
 resize(int new_num_layers)
@@ -895,7 +1314,7 @@ delay_tile_freeing(void)
   ImageAtlasPrivate *d;
   d = static_cast<ImageAtlasPrivate*>(m_d);
 
-  std::lock_guard<std::mutex> M(d->m_mutex);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
   d->m_color_tiles.delay_tile_freeing();
   d->m_index_tiles.delay_tile_freeing();
 }
@@ -907,9 +1326,10 @@ undelay_tile_freeing(void)
   ImageAtlasPrivate *d;
   d = static_cast<ImageAtlasPrivate*>(m_d);
 
-  std::lock_guard<std::mutex> M(d->m_mutex);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
   d->m_color_tiles.undelay_tile_freeing();
   d->m_index_tiles.undelay_tile_freeing();
+  ++d->m_frame;
 }
 
 int
@@ -936,7 +1356,7 @@ number_free_index_tiles(void) const
 {
   ImageAtlasPrivate *d;
   d = static_cast<ImageAtlasPrivate*>(m_d);
-  std::lock_guard<std::mutex> M(d->m_mutex);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
   return d->m_index_tiles.number_free();
 }
 
@@ -948,7 +1368,7 @@ add_index_tile(fastuidraw::c_array<const fastuidraw::ivec3> data, int slack)
   d = static_cast<ImageAtlasPrivate*>(m_d);
 
   ivec3 return_value;
-  std::lock_guard<std::mutex> M(d->m_mutex);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
 
   /* TODO:
    *   have the idea of sub-index tiles (which are squares)but size is
@@ -979,7 +1399,7 @@ add_index_tile_index_data(fastuidraw::c_array<const fastuidraw::ivec3> data)
   d = static_cast<ImageAtlasPrivate*>(m_d);
 
   ivec3 return_value;
-  std::lock_guard<std::mutex> M(d->m_mutex);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
 
   return_value = d->m_index_tiles.allocate_tile();
   d->m_index_store->set_data(return_value.x() * d->m_index_tiles.tile_size(),
@@ -998,7 +1418,7 @@ delete_index_tile(fastuidraw::ivec3 tile)
 {
   ImageAtlasPrivate *d;
   d = static_cast<ImageAtlasPrivate*>(m_d);
-  std::lock_guard<std::mutex> M(d->m_mutex);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
   d->m_index_tiles.delete_tile(tile);
 }
 
@@ -1008,7 +1428,7 @@ number_free_color_tiles(void) const
 {
   ImageAtlasPrivate *d;
   d = static_cast<ImageAtlasPrivate*>(m_d);
-  std::lock_guard<std::mutex> M(d->m_mutex);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
   return d->m_color_tiles.number_free();
 }
 
@@ -1020,7 +1440,7 @@ add_color_tile(u8vec4 color_data)
   d = static_cast<ImageAtlasPrivate*>(m_d);
 
   ivec3 return_value;
-  std::lock_guard<std::mutex> M(d->m_mutex);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
   ivec2 dst_xy;
   int sz;
 
@@ -1029,7 +1449,7 @@ add_color_tile(u8vec4 color_data)
   dst_xy.y() = return_value.y() * d->m_color_tiles.tile_size();
   sz = d->m_color_tiles.tile_size();
 
-  for (int level = 0; sz > 0; ++level, sz /= 2, dst_xy /= 2)
+  for (int level = 0; sz > 0 && level < d->m_color_levels; ++level, sz /= 2, dst_xy /= 2)
     {
       d->m_color_store->set_data(level, dst_xy, return_value.z(),
                                  sz, color_data);
@@ -1045,7 +1465,7 @@ add_color_tile(ivec2 src_xy, const ImageSourceBase &image_data)
   ImageAtlasPrivate *d;
   d = static_cast<ImageAtlasPrivate*>(m_d);
   ivec3 return_value;
-  std::lock_guard<std::mutex> M(d->m_mutex);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
   ivec2 dst_xy;
   int sz, level, last_level;
 
@@ -1053,14 +1473,14 @@ add_color_tile(ivec2 src_xy, const ImageSourceBase &image_data)
   dst_xy.x() = return_value.x() * d->m_color_tiles.tile_size();
   dst_xy.y() = return_value.y() * d->m_color_tiles.tile_size();
   sz = d->m_color_tiles.tile_size();
-  last_level = image_data.num_mipmap_levels();
+  last_level = t_min(static_cast<int>(image_data.num_mipmap_levels()), d->m_color_levels);
 
   for (level = 0; level < last_level && sz > 0; ++level, sz /= 2, dst_xy /= 2, src_xy /= 2)
     {
       d->m_color_store->set_data(level, dst_xy, return_value.z(), src_xy, sz, image_data);
     }
 
-  for (; sz > 0; ++level, sz /= 2, dst_xy /= 2, src_xy /= 2, sz /= 2)
+  for (; sz > 0 && level < d->m_color_levels; ++level, sz /= 2, dst_xy /= 2, src_xy /= 2, sz /= 2)
     {
       d->m_color_store->set_data(level, dst_xy, return_value.z(), sz,
                                  u8vec4(255u, 255u, 0u, 255u));
@@ -1075,7 +1495,7 @@ delete_color_tile(fastuidraw::ivec3 tile)
 {
   ImageAtlasPrivate *d;
   d = static_cast<ImageAtlasPrivate*>(m_d);
-  std::lock_guard<std::mutex> M(d->m_mutex);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
   d->m_color_tiles.delete_tile(tile);
 }
 
@@ -1085,7 +1505,7 @@ flush(void) const
 {
   ImageAtlasPrivate *d;
   d = static_cast<ImageAtlasPrivate*>(m_d);
-  std::lock_guard<std::mutex> M(d->m_mutex);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
   d->m_index_store->flush();
   d->m_color_store->flush();
 }
@@ -1134,13 +1554,44 @@ resize_to_fit(int num_color_tiles, int num_index_tiles)
     }
 }
 
+void
+fastuidraw::ImageAtlas::
+color_tile_budget(int v)
+{
+  ImageAtlasPrivate *d;
+  d = static_cast<ImageAtlasPrivate*>(m_d);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
+  d->m_color_tile_budget = t_max(0, v);
+  d->enforce_budget(0);
+}
+
+int
+fastuidraw::ImageAtlas::
+color_tile_budget(void) const
+{
+  ImageAtlasPrivate *d;
+  d = static_cast<ImageAtlasPrivate*>(m_d);
+  return d->m_color_tile_budget;
+}
+
+int
+fastuidraw::ImageAtlas::
+number_evictable_resident_color_tiles(void) const
+{
+  ImageAtlasPrivate *d;
+  d = static_cast<ImageAtlasPrivate*>(m_d);
+  std::lock_guard<std::recursive_mutex> M(d->m_mutex);
+  return d->m_evictable_color_tiles;
+}
+
 
 //////////////////////////////////////
 // fastuidraw::Image methods
 fastuidraw::reference_counted_ptr<fastuidraw::Image>
 fastuidraw::Image::
 create(reference_counted_ptr<ImageAtlas> atlas, int w, int h,
-       c_array<const u8vec4> image_data, unsigned int pslack)
+       c_array<const u8vec4> image_data, unsigned int pslack,
+       enum format_t fmt)
 {
   if (w <= 0 || h <= 0)
     {
@@ -1148,13 +1599,14 @@ create(reference_counted_ptr<ImageAtlas> atlas, int w, int h,
     }
 
   c_array<const c_array<const u8vec4> > data(&image_data, 1);
-  return create(atlas, w, h, ImageSourceCArray(uvec2(w, h), data), pslack);
+  return create(atlas, w, h, ImageSourceCArray(uvec2(w, h), data), pslack, fmt);
 }
 
 fastuidraw::reference_counted_ptr<fastuidraw::Image>
 fastuidraw::Image::
 create(reference_counted_ptr<ImageAtlas> atlas, int w, int h,
-       const ImageSourceBase &image_data, unsigned int pslack)
+       const ImageSourceBase &image_data, unsigned int pslack,
+       enum format_t fmt)
 {
   int tile_interior_size;
   int color_tile_size;
@@ -1193,34 +1645,39 @@ create(reference_counted_ptr<ImageAtlas> atlas, int w, int h,
         }
     }
 
-  return FASTUIDRAWnew Image(atlas, w, h, image_data, pslack);
+  return FASTUIDRAWnew Image(atlas, w, h, image_data, pslack, fmt);
 }
 
 fastuidraw::reference_counted_ptr<fastuidraw::Image>
 fastuidraw::Image::
-create_bindless(int w, int h, unsigned int m, enum type_t type, uint64_t handle)
+create_bindless(int w, int h, unsigned int m, enum type_t type, uint64_t handle,
+                enum format_t fmt)
 {
   Image *p(nullptr);
   if (type != on_atlas)
     {
-      p = FASTUIDRAWnew Image(w, h, m, type, handle);
+      p = FASTUIDRAWnew Image(w, h, m, type, handle, fmt);
     }
   return p;
 }
 
 fastuidraw::Image::
-Image(int w, int h, unsigned int m, enum type_t type, uint64_t handle)
+Image(int w, int h, unsigned int m, enum type_t type, uint64_t handle,
+      enum format_t fmt)
 {
-  m_d = FASTUIDRAWnew ImagePrivate(w, h, m, type, handle);
+  m_d = FASTUIDRAWnew ImagePrivate(w, h, m, type, handle, fmt);
 }
 
 fastuidraw::Image::
 Image(reference_counted_ptr<ImageAtlas> patlas,
       int w, int h,
       const ImageSourceBase &image_data,
-      unsigned int pslack)
+      unsigned int pslack,
+      enum format_t fmt)
 {
-  m_d = FASTUIDRAWnew ImagePrivate(patlas, w, h, image_data, pslack);
+  ImageAtlasPrivate *atlas_private;
+  atlas_private = static_cast<ImageAtlasPrivate*>(patlas->m_d);
+  m_d = FASTUIDRAWnew ImagePrivate(patlas, atlas_private, w, h, image_data, pslack, fmt);
 }
 
 fastuidraw::Image::
@@ -1305,6 +1762,15 @@ type(void) const
   return d->m_type;
 }
 
+enum fastuidraw::Image::format_t
+fastuidraw::Image::
+format(void) const
+{
+  ImagePrivate *d;
+  d = static_cast<ImagePrivate*>(m_d);
+  return d->m_format;
+}
+
 uint64_t
 fastuidraw::Image::
 bindless_handle(void) const
@@ -1314,6 +1780,53 @@ bindless_handle(void) const
   return d->m_bindless_handle;
 }
 
+bool
+fastuidraw::Image::
+resident(void) const
+{
+  ImagePrivate *d;
+  d = static_cast<ImagePrivate*>(m_d);
+  if (!d->m_evictable)
+    {
+      return true;
+    }
+
+  std::lock_guard<std::recursive_mutex> M(d->m_atlas_private->m_mutex);
+  return d->m_resident;
+}
+
+void
+fastuidraw::Image::
+make_resident(void) const
+{
+  ImagePrivate *d;
+  d = static_cast<ImagePrivate*>(m_d);
+  if (!d->m_evictable)
+    {
+      return;
+    }
+
+  ImageAtlasPrivate *atlas_private(d->m_atlas_private);
+  std::lock_guard<std::recursive_mutex> M(atlas_private->m_mutex);
+
+  d->m_last_use = atlas_private->m_frame;
+  if (d->m_resident)
+    {
+      atlas_private->m_lru.splice(atlas_private->m_lru.end(),
+                                  atlas_private->m_lru,
+                                  d->m_lru_location);
+
+      /* the budget may have been exceeded by images
+       * that could not be evicted when they were created
+       */
+      atlas_private->enforce_budget(0);
+    }
+  else
+    {
+      d->restore();
+    }
+}
+
 const fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>&
 fastuidraw::Image::
 atlas(void) const
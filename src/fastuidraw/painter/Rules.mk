@@ -13,7 +13,8 @@ FASTUIDRAW_SOURCES += $(call filelist, fill_rule.cpp \
 	painter_attribute_data_filler_glyphs.cpp \
 	painter_brush.cpp painter_stroke_params.cpp \
 	painter_dashed_stroke_params.cpp \
-	painter.cpp painter_enums.cpp \
+	painter.cpp painter_command_list.cpp painter_layer.cpp \
+	painter_enums.cpp \
 	painter_shader_data.cpp \
 	painter_clip_equations.cpp \
 	painter_item_matrix.cpp painter_header.cpp \
@@ -22,7 +23,7 @@ FASTUIDRAW_SOURCES += $(call filelist, fill_rule.cpp \
 	painter_glyph_shader.cpp painter_blend_shader_set.cpp \
 	painter_fill_shader.cpp \
 	stroked_caps_joins.cpp stroked_point.cpp \
-	stroked_path.cpp filled_path.cpp \
+	stroked_path.cpp filled_path.cpp path_boolean.cpp \
 	arc_stroked_point.cpp)
 
 # Begin standard footer
@@ -33,7 +33,7 @@
 #include "../private/util_private.hpp"
 #include "../private/util_private_ostream.hpp"
 #include "../private/bounding_box.hpp"
-#include "../private/clip.hpp"
+#include "../private/box_hierarchy.hpp"
 #include "../../3rd_party/glu-tess/glu-tess.hpp"
 
 /* Actual triangulation is handled by GLU-tess.
@@ -746,10 +746,32 @@ namespace
       return iter->second->m_aa_fuzz;
     }
 
+    /* Returns true if the edge [a, b] is an anti-aliased edge
+     * of the boundary of the region with winding number w;
+     * if so, writes to out_w the winding number of the region
+     * on the other side of the edge.
+     */
+    bool
+    neighbor_winding(unsigned int a, unsigned int b, int w, int *out_w) const;
+
   private:
+    typedef std::pair<unsigned int, unsigned int> EdgeKey;
+
+    static
+    EdgeKey
+    edge_key(unsigned int a, unsigned int b)
+    {
+      return (a < b) ? EdgeKey(a, b) : EdgeKey(b, a);
+    }
+
     PerWindingComponentData m_hoard;
     PointHoard m_points;
     bool m_failed;
+
+    /* for each drawn edge of the AAFuzz boundaries,
+     * the winding numbers of the regions it bounds.
+     */
+    std::map<EdgeKey, std::vector<int> > m_edge_windings;
   };
 
   class AttributeDataMerger:public fastuidraw::PainterAttributeDataFiller
@@ -949,15 +971,111 @@ namespace
 
       return dst;
     }
+
+  protected:
+    virtual
+    unsigned int
+    attribute_count(void) const
+    {
+      return m_points.size();
+    }
+
+    virtual
+    void
+    generate_attributes(fastuidraw::c_array<fastuidraw::PainterAttribute> dst) const
+    {
+      std::transform(m_points.begin(), m_points.end(), dst.begin(),
+                     FillAttributeDataFiller::generate_attribute);
+    }
+  };
+
+  /* An AnalyticFillAttributeDataFiller packs the triangles of a
+   * FillAttributeDataFiller that have an edge on the boundary
+   * between regions of different winding numbers, with the same
+   * index chunks. Each such triangle has its own three vertices
+   * that carry the winding numbers of the regions across its edges
+   * and a z-offset that decreases in the order the triangles are
+   * drawn, see FilledPath::Subset::aa_analytic_painter_data().
+   */
+  class AnalyticFillAttributeDataFiller:public FillAttributeDataFiller
+  {
+  public:
+    AnalyticFillAttributeDataFiller(const FillAttributeDataFiller &src,
+                                    const builder &B);
+
+    virtual
+    void
+    compute_sizes(unsigned int &number_attributes,
+                  unsigned int &number_indices,
+                  unsigned int &number_attribute_chunks,
+                  unsigned int &number_index_chunks,
+                  unsigned int &number_z_ranges) const;
+    virtual
+    void
+    fill_data(fastuidraw::c_array<fastuidraw::PainterAttribute> attributes,
+              fastuidraw::c_array<fastuidraw::PainterIndex> indices,
+              fastuidraw::c_array<fastuidraw::c_array<const fastuidraw::PainterAttribute> > attrib_chunks,
+              fastuidraw::c_array<fastuidraw::c_array<const fastuidraw::PainterIndex> > index_chunks,
+              fastuidraw::c_array<fastuidraw::range_type<int> > zranges,
+              fastuidraw::c_array<int> index_adjusts) const;
+
+    std::vector<fastuidraw::PainterAttribute> m_attributes;
+
+  protected:
+    virtual
+    unsigned int
+    attribute_count(void) const
+    {
+      return m_attributes.size();
+    }
+
+    virtual
+    void
+    generate_attributes(fastuidraw::c_array<fastuidraw::PainterAttribute> dst) const
+    {
+      std::copy(m_attributes.begin(), m_attributes.end(), dst.begin());
+    }
+
+  private:
+    fastuidraw::c_array<const unsigned int>
+    remap_range(const std::map<unsigned int, unsigned int> &offsets,
+                const FillAttributeDataFiller &src,
+                fastuidraw::c_array<const unsigned int> range) const;
+
+    void
+    add_triangle(const FillAttributeDataFiller &src, const builder &B,
+                 int winding, const unsigned int *tri);
+  };
+
+  /* An AnalyticAttributeDataMerger merges the data of two
+   * AnalyticFillAttributeDataFiller's; the triangles of a
+   * are drawn first and thus are placed above those of b.
+   */
+  class AnalyticAttributeDataMerger:public AttributeDataMerger
+  {
+  public:
+    AnalyticAttributeDataMerger(const fastuidraw::PainterAttributeData &a,
+                                const fastuidraw::PainterAttributeData &b):
+      AttributeDataMerger(a, b, true)
+    {}
+
+  protected:
+    virtual
+    void
+    post_process_attributes(unsigned int chunk,
+                            fastuidraw::c_array<fastuidraw::PainterAttribute> dst_from_a,
+                            fastuidraw::c_array<fastuidraw::PainterAttribute> dst_from_b) const;
+
+    virtual
+    fastuidraw::range_type<int>
+    compute_z_range(unsigned int chunk) const;
   };
 
   class ScratchSpacePrivate
   {
   public:
     std::vector<fastuidraw::vec3> m_adjusted_clip_eqs;
-    std::vector<fastuidraw::vec2> m_clipped_rect;
-
-    fastuidraw::vecN<std::vector<fastuidraw::vec2>, 2> m_clip_scratch_vec2s;
+    fastuidraw::detail::BoxHierarchy::Query m_box_query;
   };
 
   class SubsetPrivate
@@ -965,13 +1083,13 @@ namespace
   public:
     ~SubsetPrivate(void);
 
-    unsigned int
-    select_subsets(ScratchSpacePrivate &scratch,
-                   fastuidraw::c_array<const fastuidraw::vec3> clip_equations,
-                   const fastuidraw::float3x3 &clip_matrix_local,
-                   unsigned int max_attribute_cnt,
-                   unsigned int max_index_cnt,
-                   fastuidraw::c_array<unsigned int> dst);
+    /* add the bounding boxes of this SubsetPrivate and
+     * its descendants to a BoxHierarchy; the index of
+     * each box in the BoxHierarchy is the same as the
+     * value of m_ID.
+     */
+    void
+    build_box_hierarchy(fastuidraw::detail::BoxHierarchy &dst) const;
 
     void
     select_subsets_all_unculled(fastuidraw::c_array<unsigned int> dst,
@@ -1009,6 +1127,13 @@ namespace
       return *m_fuzz_painter_data;
     }
 
+    const fastuidraw::PainterAttributeData&
+    analytic_painter_data(void)
+    {
+      FASTUIDRAWassert(m_analytic_painter_data != nullptr);
+      return *m_analytic_painter_data;
+    }
+
     bool
     have_children(void) const
     {
@@ -1025,13 +1150,6 @@ namespace
     SubsetPrivate(SubPath *P, int max_recursion,
                   std::vector<SubsetPrivate*> &out_value);
 
-    void
-    select_subsets_implement(ScratchSpacePrivate &scratch,
-                             fastuidraw::c_array<unsigned int> dst,
-                             unsigned int max_attribute_cnt,
-                             unsigned int max_index_cnt,
-                             unsigned int &current);
-
     void
     make_ready_from_children(void);
 
@@ -1075,6 +1193,7 @@ namespace
     std::vector<int> m_winding_numbers;
 
     fastuidraw::PainterAttributeData *m_fuzz_painter_data;
+    fastuidraw::PainterAttributeData *m_analytic_painter_data;
 
     bool m_sizes_ready;
     unsigned int m_num_attributes;
@@ -1100,8 +1219,21 @@ namespace
 
     ~FilledPathPrivate();
 
+    unsigned int
+    select_subsets(ScratchSpacePrivate &scratch,
+                   fastuidraw::c_array<const fastuidraw::vec3> clip_equations,
+                   const fastuidraw::float3x3 &clip_matrix_local,
+                   unsigned int max_attribute_cnt,
+                   unsigned int max_index_cnt,
+                   fastuidraw::c_array<unsigned int> dst);
+
     SubsetPrivate *m_root;
     std::vector<SubsetPrivate*> m_subsets;
+
+    /* the bounding boxes of m_subsets, used to cull
+     * in select_subsets().
+     */
+    fastuidraw::detail::BoxHierarchy m_boxes;
   };
 }
 
@@ -1242,20 +1374,16 @@ SubPath::
 copy_contour(SubContour &dst,
              const fastuidraw::TessellatedPath &src, unsigned int C)
 {
-  for(unsigned int e = 0, ende = src.number_edges(C); e < ende; ++e)
-    {
-      fastuidraw::range_type<unsigned int> R;
+  fastuidraw::c_array<const fastuidraw::vec2> pts(src.contour_points(C));
 
-      R = src.edge_range(C, e);
-
-      FASTUIDRAWassert(src.segment_data()[R.m_begin].m_type == fastuidraw::TessellatedPath::line_segment);
-      dst.push_back(SubContourPoint(src.segment_data()[R.m_begin].m_start_pt, 0u));
-      for(unsigned int v = R.m_begin + 1; v < R.m_end; ++v)
-        {
-          FASTUIDRAWassert(src.segment_data()[v].m_type == fastuidraw::TessellatedPath::line_segment);
-          SubContourPoint pt(src.segment_data()[v].m_start_pt, 0u);
-          dst.push_back(pt);
-        }
+  /* the last point is the end of the closing edge,
+   * which is the start of the contour.
+   */
+  FASTUIDRAWassert(!src.has_arcs());
+  dst.reserve(dst.size() + pts.size() - 1);
+  for(unsigned int v = 0, endv = pts.size() - 1; v < endv; ++v)
+    {
+      dst.push_back(SubContourPoint(pts[v], 0u));
     }
 }
 
@@ -2145,6 +2273,23 @@ builder(const SubPath &P, std::vector<fastuidraw::dvec2> &points):
 
   m_failed = T.triangulation_failed();
 
+  /* record the windings on each side of the drawn edges
+   * before removing those windings without triangles.
+   */
+  for (const auto &e : m_hoard)
+    {
+      for (const AAFuzz::Contour &C : e.second->m_aa_fuzz.contours())
+        {
+          for (const AAEdge &E : C)
+            {
+              if (E.m_draw_edge)
+                {
+                  m_edge_windings[edge_key(E.m_start, E.m_end)].push_back(e.first);
+                }
+            }
+        }
+    }
+
   for (auto iter = m_hoard.begin(); iter != m_hoard.end(); )
     {
       auto prev_iter(iter);
@@ -2176,6 +2321,29 @@ builder::
 {
 }
 
+bool
+builder::
+neighbor_winding(unsigned int a, unsigned int b, int w, int *out_w) const
+{
+  std::map<EdgeKey, std::vector<int> >::const_iterator iter;
+
+  iter = m_edge_windings.find(edge_key(a, b));
+  if (iter == m_edge_windings.end())
+    {
+      return false;
+    }
+
+  for (int v : iter->second)
+    {
+      if (v != w)
+        {
+          *out_w = v;
+          return true;
+        }
+    }
+  return false;
+}
+
 void
 builder::
 fill_indices(std::vector<unsigned int> &indices,
@@ -2617,7 +2785,7 @@ compute_sizes(unsigned int &number_attributes,
       number_index_chunks = 0;
       return;
     }
-  number_attributes = m_points.size();
+  number_attributes = attribute_count();
   number_attribute_chunks = 1;
 
   number_indices = m_odd_winding_indices.size()
@@ -2657,14 +2825,13 @@ fill_data(fastuidraw::c_array<fastuidraw::PainterAttribute> attributes,
     {
       return;
     }
-  FASTUIDRAWassert(attributes.size() == m_points.size());
+  FASTUIDRAWassert(attributes.size() == attribute_count());
   FASTUIDRAWassert(attrib_chunks.size() == 1);
   FASTUIDRAWassert(zranges.empty());
   FASTUIDRAWunused(zranges);
 
   /* generate attribute data */
-  std::transform(m_points.begin(), m_points.end(), attributes.begin(),
-                 FillAttributeDataFiller::generate_attribute);
+  generate_attributes(attributes);
   attrib_chunks[0] = attributes;
   std::fill(index_adjusts.begin(), index_adjusts.end(), 0);
 
@@ -2708,6 +2875,205 @@ fill_data(fastuidraw::c_array<fastuidraw::PainterAttribute> attributes,
     }
 }
 
+////////////////////////////////////////////
+// AnalyticFillAttributeDataFiller methods
+AnalyticFillAttributeDataFiller::
+AnalyticFillAttributeDataFiller(const FillAttributeDataFiller &src,
+                                const builder &B)
+{
+  using namespace fastuidraw;
+
+  /* the ranges of src are each a union of the ranges of
+   * its winding numbers, thus the triangles are added in
+   * the order of the ranges of the winding numbers and
+   * offsets records where each such range starts in
+   * m_indices.
+   */
+  std::map<unsigned int, int> windings;
+  std::map<unsigned int, unsigned int> offsets;
+
+  for (const auto &e : src.m_per_fill)
+    {
+      windings[e.second.c_ptr() - &src.m_indices[0]] = e.first;
+    }
+
+  for (const auto &e : windings)
+    {
+      c_array<const unsigned int> range;
+
+      range = src.m_per_fill.find(e.second)->second;
+      FASTUIDRAWassert(range.size() % 3 == 0);
+      offsets[e.first] = m_indices.size();
+      for (unsigned int t = 0; t < range.size(); t += 3)
+        {
+          add_triangle(src, B, e.second, &range[t]);
+        }
+    }
+  offsets[src.m_indices.size()] = m_indices.size();
+
+  for (const auto &e : src.m_per_fill)
+    {
+      m_per_fill[e.first] = remap_range(offsets, src, e.second);
+    }
+  m_odd_winding_indices = remap_range(offsets, src, src.m_odd_winding_indices);
+  m_nonzero_winding_indices = remap_range(offsets, src, src.m_nonzero_winding_indices);
+  m_even_winding_indices = remap_range(offsets, src, src.m_even_winding_indices);
+  m_zero_winding_indices = remap_range(offsets, src, src.m_zero_winding_indices);
+
+  /* the z-offset of a triangle is its index so far; the
+   * triangles are to be drawn in the order of m_indices,
+   * thus the first triangle is to be on top.
+   */
+  int num_triangles(m_indices.size() / 3);
+  for (PainterAttribute &A : m_attributes)
+    {
+      A.m_attrib2.z() = num_triangles - 1 - A.m_attrib2.z();
+    }
+}
+
+fastuidraw::c_array<const unsigned int>
+AnalyticFillAttributeDataFiller::
+remap_range(const std::map<unsigned int, unsigned int> &offsets,
+            const FillAttributeDataFiller &src,
+            fastuidraw::c_array<const unsigned int> range) const
+{
+  if (range.empty())
+    {
+      return fastuidraw::c_array<const unsigned int>();
+    }
+
+  unsigned int begin, end;
+
+  begin = range.c_ptr() - &src.m_indices[0];
+  end = begin + range.size();
+  FASTUIDRAWassert(offsets.find(begin) != offsets.end());
+  FASTUIDRAWassert(offsets.find(end) != offsets.end());
+  begin = offsets.find(begin)->second;
+  end = offsets.find(end)->second;
+
+  return fastuidraw::make_c_array(m_indices).sub_array(begin, end - begin);
+}
+
+void
+AnalyticFillAttributeDataFiller::
+add_triangle(const FillAttributeDataFiller &src, const builder &B,
+             int winding, const unsigned int *tri)
+{
+  using namespace fastuidraw;
+
+  /* edge i of the triangle is the edge opposite to corner i */
+  uvec4 edge_data(0u, 0u, 0u, 0u);
+  uint32_t edge_mask(0u), z;
+
+  for (unsigned int i = 0; i < 3; ++i)
+    {
+      int neighbor;
+
+      if (B.neighbor_winding(tri[(i + 1) % 3], tri[(i + 2) % 3], winding, &neighbor))
+        {
+          edge_data[i] = static_cast<uint32_t>(neighbor);
+          edge_mask |= (1u << i);
+        }
+    }
+
+  if (edge_mask == 0u)
+    {
+      /* the triangle is within the solid fill drawn
+       * before the anti-aliased triangles.
+       */
+      return;
+    }
+
+  z = m_indices.size() / 3;
+  for (unsigned int i = 0; i < 3; ++i)
+    {
+      const dvec2 &next(src.m_points[tri[(i + 1) % 3]]);
+      const dvec2 &prev(src.m_points[tri[(i + 2) % 3]]);
+      PainterAttribute A;
+
+      A = generate_attribute(src.m_points[tri[i]]);
+      A.m_attrib0.z() = pack_float(next.x());
+      A.m_attrib0.w() = pack_float(next.y());
+      A.m_attrib1 = edge_data;
+      A.m_attrib1.w() = i | (edge_mask << 2u);
+      A.m_attrib2.x() = pack_float(prev.x());
+      A.m_attrib2.y() = pack_float(prev.y());
+      A.m_attrib2.z() = z;
+
+      m_indices.push_back(m_attributes.size());
+      m_attributes.push_back(A);
+    }
+}
+
+void
+AnalyticFillAttributeDataFiller::
+compute_sizes(unsigned int &number_attributes,
+              unsigned int &number_indices,
+              unsigned int &number_attribute_chunks,
+              unsigned int &number_index_chunks,
+              unsigned int &number_z_ranges) const
+{
+  FillAttributeDataFiller::compute_sizes(number_attributes, number_indices,
+                                         number_attribute_chunks, number_index_chunks,
+                                         number_z_ranges);
+  number_z_ranges = 1;
+}
+
+void
+AnalyticFillAttributeDataFiller::
+fill_data(fastuidraw::c_array<fastuidraw::PainterAttribute> attributes,
+          fastuidraw::c_array<fastuidraw::PainterIndex> indices,
+          fastuidraw::c_array<fastuidraw::c_array<const fastuidraw::PainterAttribute> > attrib_chunks,
+          fastuidraw::c_array<fastuidraw::c_array<const fastuidraw::PainterIndex> > index_chunks,
+          fastuidraw::c_array<fastuidraw::range_type<int> > zranges,
+          fastuidraw::c_array<int> index_adjusts) const
+{
+  FASTUIDRAWassert(zranges.size() == 1);
+  FillAttributeDataFiller::fill_data(attributes, indices,
+                                     attrib_chunks, index_chunks,
+                                     fastuidraw::c_array<fastuidraw::range_type<int> >(),
+                                     index_adjusts);
+
+  /* every index chunk uses the same z-offsets */
+  zranges[0].m_begin = 0;
+  zranges[0].m_end = m_indices.size() / 3;
+}
+
+////////////////////////////////////////
+// AnalyticAttributeDataMerger methods
+void
+AnalyticAttributeDataMerger::
+post_process_attributes(unsigned int chunk,
+                        fastuidraw::c_array<fastuidraw::PainterAttribute> dst_from_a,
+                        fastuidraw::c_array<fastuidraw::PainterAttribute> dst_from_b) const
+{
+  FASTUIDRAWunused(chunk);
+  FASTUIDRAWunused(dst_from_b);
+
+  /* the order of drawing is a then b, thus
+   * we want to increment the elements of a
+   * so they are on top of all elements of b
+   */
+  int add_z(m_b.z_range(0).m_end);
+  for(fastuidraw::PainterAttribute &A : dst_from_a)
+    {
+      A.m_attrib2.z() += add_z;
+    }
+}
+
+fastuidraw::range_type<int>
+AnalyticAttributeDataMerger::
+compute_z_range(unsigned int chunk) const
+{
+  fastuidraw::range_type<int> R;
+
+  FASTUIDRAWunused(chunk);
+  FASTUIDRAWassert(chunk == 0);
+  R.m_begin = 0;
+  R.m_end = m_a.z_range(0).m_end + m_b.z_range(0).m_end;
+  return R;
+}
+
 /////////////////////////////////
 // SubsetPrivate methods
 SubsetPrivate::
@@ -2719,6 +3085,7 @@ SubsetPrivate(SubPath *Q, int max_recursion,
              fastuidraw::vec2(m_bounds.max_point())),
   m_painter_data(nullptr),
   m_fuzz_painter_data(nullptr),
+  m_analytic_painter_data(nullptr),
   m_sizes_ready(false),
   m_sub_path(Q),
   m_children(nullptr, nullptr),
@@ -2763,6 +3130,7 @@ SubsetPrivate::
     {
       FASTUIDRAWassert(m_painter_data == nullptr);
       FASTUIDRAWassert(m_fuzz_painter_data == nullptr);
+      FASTUIDRAWassert(m_analytic_painter_data == nullptr);
       FASTUIDRAWassert(m_children[0] == nullptr);
       FASTUIDRAWassert(m_children[1] == nullptr);
       FASTUIDRAWdelete(m_sub_path);
@@ -2772,8 +3140,10 @@ SubsetPrivate::
     {
       FASTUIDRAWassert(m_sub_path == nullptr);
       FASTUIDRAWassert(m_fuzz_painter_data != nullptr);
+      FASTUIDRAWassert(m_analytic_painter_data != nullptr);
       FASTUIDRAWdelete(m_painter_data);
       FASTUIDRAWdelete(m_fuzz_painter_data);
+      FASTUIDRAWdelete(m_analytic_painter_data);
     }
 
   if (m_children[0] != nullptr)
@@ -2794,64 +3164,20 @@ create_root_subset(SubPath *P, std::vector<SubsetPrivate*> &out_values)
   return root;
 }
 
-unsigned int
-SubsetPrivate::
-select_subsets(ScratchSpacePrivate &scratch,
-               fastuidraw::c_array<const fastuidraw::vec3> clip_equations,
-               const fastuidraw::float3x3 &clip_matrix_local,
-               unsigned int max_attribute_cnt,
-               unsigned int max_index_cnt,
-               fastuidraw::c_array<unsigned int> dst)
-{
-  unsigned int return_value(0u);
-
-  scratch.m_adjusted_clip_eqs.resize(clip_equations.size());
-  for(unsigned int i = 0; i < clip_equations.size(); ++i)
-    {
-      /* transform clip equations from clip coordinates to
-       * local coordinates.
-       */
-      scratch.m_adjusted_clip_eqs[i] = clip_equations[i] * clip_matrix_local;
-    }
-
-  select_subsets_implement(scratch, dst, max_attribute_cnt, max_index_cnt, return_value);
-  return return_value;
-}
-
 void
 SubsetPrivate::
-select_subsets_implement(ScratchSpacePrivate &scratch,
-                         fastuidraw::c_array<unsigned int> dst,
-                         unsigned int max_attribute_cnt,
-                         unsigned int max_index_cnt,
-                         unsigned int &current)
+build_box_hierarchy(fastuidraw::detail::BoxHierarchy &dst) const
 {
-  using namespace fastuidraw;
-  using namespace fastuidraw::detail;
+  unsigned int node;
 
-  vecN<vec2, 4> bb;
-  bool unclipped;
-
-  m_bounds_f.inflated_polygon(bb, 0.0f);
-  unclipped = clip_against_planes(make_c_array(scratch.m_adjusted_clip_eqs),
-                                  bb, scratch.m_clipped_rect,
-                                  scratch.m_clip_scratch_vec2s);
-
-  //completely clipped
-  if (scratch.m_clipped_rect.empty())
-    {
-      return;
-    }
-
-  //completely unclipped or no children
-  if (unclipped || !have_children())
+  node = dst.add_node(m_bounds_f);
+  FASTUIDRAWassert(node == m_ID);
+  if (have_children())
     {
-      select_subsets_all_unculled(dst, max_attribute_cnt, max_index_cnt, current);
-      return;
+      m_children[0]->build_box_hierarchy(dst);
+      m_children[1]->build_box_hierarchy(dst);
     }
-
-  m_children[0]->select_subsets_implement(scratch, dst, max_attribute_cnt, max_index_cnt, current);
-  m_children[1]->select_subsets_implement(scratch, dst, max_attribute_cnt, max_index_cnt, current);
+  dst.end_node(node);
 }
 
 void
@@ -2978,12 +3304,21 @@ make_ready_from_children(void)
                                       m_children[1]->fuzz_painter_data());
   m_fuzz_painter_data->set_data(fuzz_merger);
 
+  m_analytic_painter_data = FASTUIDRAWnew fastuidraw::PainterAttributeData();
+  AnalyticAttributeDataMerger analytic_merger(m_children[0]->analytic_painter_data(),
+                                              m_children[1]->analytic_painter_data());
+  m_analytic_painter_data->set_data(analytic_merger);
+
   /* overwrite size values to be precise */
   m_sizes_ready = true;
   m_num_attributes = m_painter_data->largest_attribute_chunk();
   m_largest_index_block = m_painter_data->largest_index_chunk();
-  m_aa_largest_attribute_block = m_fuzz_painter_data->largest_attribute_chunk();
-  m_aa_largest_index_block = m_fuzz_painter_data->largest_index_chunk();
+  m_aa_largest_attribute_block =
+    fastuidraw::t_max(m_fuzz_painter_data->largest_attribute_chunk(),
+                      m_analytic_painter_data->largest_attribute_chunk());
+  m_aa_largest_index_block =
+    fastuidraw::t_max(m_fuzz_painter_data->largest_index_chunk(),
+                      m_analytic_painter_data->largest_index_chunk());
 }
 
 void
@@ -3031,6 +3366,8 @@ make_ready_from_sub_path(void)
 
   /* fill m_fuzz_painter_data */
   m_fuzz_painter_data = FASTUIDRAWnew fastuidraw::PainterAttributeData();
+  m_aa_largest_attribute_block = 0;
+  m_aa_largest_index_block = 0;
   if (!m_winding_numbers.empty())
     {
       AAFuzzAttributeDataFiller edge_filler(fastuidraw::make_c_array(m_winding_numbers),
@@ -3040,6 +3377,23 @@ make_ready_from_sub_path(void)
       m_aa_largest_index_block = m_fuzz_painter_data->largest_index_chunk();
     }
 
+  /* fill m_analytic_painter_data; it has the same index
+   * chunks as m_painter_data, restricted to the triangles
+   * on the boundary.
+   */
+  m_analytic_painter_data = FASTUIDRAWnew fastuidraw::PainterAttributeData();
+  if (!m_winding_numbers.empty())
+    {
+      AnalyticFillAttributeDataFiller analytic_filler(filler, B);
+      m_analytic_painter_data->set_data(analytic_filler);
+      m_aa_largest_attribute_block =
+        fastuidraw::t_max(m_aa_largest_attribute_block,
+                          m_analytic_painter_data->largest_attribute_chunk());
+      m_aa_largest_index_block =
+        fastuidraw::t_max(m_aa_largest_index_block,
+                          m_analytic_painter_data->largest_index_chunk());
+    }
+
   FASTUIDRAWdelete(m_sub_path);
   m_sub_path = nullptr;
 
@@ -3066,6 +3420,7 @@ FilledPathPrivate(const fastuidraw::TessellatedPath &P)
   SubPath *q;
   q = FASTUIDRAWnew SubPath(P);
   m_root = SubsetPrivate::create_root_subset(q, m_subsets);
+  m_root->build_box_hierarchy(m_boxes);
 }
 
 FilledPathPrivate::
@@ -3074,6 +3429,56 @@ FilledPathPrivate::
   FASTUIDRAWdelete(m_root);
 }
 
+unsigned int
+FilledPathPrivate::
+select_subsets(ScratchSpacePrivate &scratch,
+               fastuidraw::c_array<const fastuidraw::vec3> clip_equations,
+               const fastuidraw::float3x3 &clip_matrix_local,
+               unsigned int max_attribute_cnt,
+               unsigned int max_index_cnt,
+               fastuidraw::c_array<unsigned int> dst)
+{
+  using namespace fastuidraw::detail;
+  unsigned int return_value(0u);
+
+  scratch.m_adjusted_clip_eqs.resize(clip_equations.size());
+  for(unsigned int i = 0; i < clip_equations.size(); ++i)
+    {
+      /* transform clip equations from clip coordinates to
+       * local coordinates.
+       */
+      scratch.m_adjusted_clip_eqs[i] = clip_equations[i] * clip_matrix_local;
+    }
+
+  /* walk the hierarchy in the pre-order of m_subsets, skipping
+   * the subtree of a SubsetPrivate that is culled or that is
+   * taken in its entirety.
+   */
+  scratch.m_box_query.begin(m_boxes, fastuidraw::make_c_array(scratch.m_adjusted_clip_eqs), 0.0f);
+  for(unsigned int i = 0; i < m_subsets.size();)
+    {
+      enum BoxHierarchy::visibility_t v;
+      SubsetPrivate *subset(m_subsets[i]);
+
+      v = scratch.m_box_query.visibility(i);
+      if (v == BoxHierarchy::box_culled)
+        {
+          i = m_boxes.subtree_end(i);
+        }
+      else if (v == BoxHierarchy::box_unclipped || !subset->have_children())
+        {
+          subset->select_subsets_all_unculled(dst, max_attribute_cnt, max_index_cnt, return_value);
+          i = m_boxes.subtree_end(i);
+        }
+      else
+        {
+          ++i;
+        }
+    }
+
+  return return_value;
+}
+
 ///////////////////////////////
 //fastuidraw::FilledPath::ScratchSpace methods
 fastuidraw::FilledPath::ScratchSpace::
@@ -3117,6 +3522,15 @@ aa_fuzz_painter_data(void) const
   return d->fuzz_painter_data();
 }
 
+const fastuidraw::PainterAttributeData&
+fastuidraw::FilledPath::Subset::
+aa_analytic_painter_data(void) const
+{
+  SubsetPrivate *d;
+  d = static_cast<SubsetPrivate*>(m_d);
+  return d->analytic_painter_data();
+}
+
 fastuidraw::c_array<const int>
 fastuidraw::FilledPath::Subset::
 winding_numbers(void) const
@@ -3246,9 +3660,9 @@ select_subsets(ScratchSpace &work_room,
    *     thread safe (with regards to the SubsetPrivate
    *     being made ready via make_ready()).
    */
-  return_value = d->m_root->select_subsets(*static_cast<ScratchSpacePrivate*>(work_room.m_d),
-                                           clip_equations, clip_matrix_local,
-                                           max_attribute_cnt, max_index_cnt, dst);
+  return_value = d->select_subsets(*static_cast<ScratchSpacePrivate*>(work_room.m_d),
+                                   clip_equations, clip_matrix_local,
+                                   max_attribute_cnt, max_index_cnt, dst);
 
   return return_value;
 }
@@ -17,6 +17,7 @@
  */
 
 
+#include <algorithm>
 #include <fastuidraw/painter/packing/painter_backend.hpp>
 #include "../../private/util_private.hpp"
 
@@ -144,6 +145,27 @@ setget_implement(fastuidraw::PainterBackend::ConfigurationBase,
                  ConfigurationPrivate,
                  bool, supports_bindless_texturing)
 
+///////////////////////////////////////////////////
+// fastuidraw::PainterBackend::Surface methods
+void
+fastuidraw::PainterBackend::Surface::
+convert_to_image_texels(ivec2 dimensions,
+                        c_array<const u8vec4> src,
+                        c_array<u8vec4> dst)
+{
+  FASTUIDRAWassert(src.size() == dst.size());
+  FASTUIDRAWassert(src.size() == static_cast<unsigned int>(dimensions.x() * dimensions.y()));
+  for (int y = 0; y < dimensions.y(); ++y)
+    {
+      c_array<const u8vec4> src_row;
+      c_array<u8vec4> dst_row;
+
+      src_row = src.sub_array(y * dimensions.x(), dimensions.x());
+      dst_row = dst.sub_array((dimensions.y() - 1 - y) * dimensions.x(), dimensions.x());
+      std::copy(src_row.begin(), src_row.end(), dst_row.begin());
+    }
+}
+
 ////////////////////////////////////
 // fastuidraw::PainterBackend methods
 fastuidraw::PainterBackend::
@@ -611,6 +611,7 @@ namespace
 
     fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend::Surface> m_surface;
     bool m_clear_color_buffer;
+    fastuidraw::PainterBackend::Surface::Viewport m_damage_rect;
     std::vector<per_draw_command> m_accumulated_draws;
     fastuidraw::PainterPacker *m_p;
 
@@ -815,6 +816,15 @@ PainterPackerPrivate::
 upload_draw_state(const fastuidraw::PainterPackerData &draw_state)
 {
   unsigned int needed_room;
+  const fastuidraw::PainterBrush &brush(fetch_value(draw_state.m_brush));
+
+  /* the color tiles of the image may have been evicted
+   * from the atlas, see ImageAtlas::color_tile_budget()
+   */
+  if (brush.image())
+    {
+      brush.image()->make_resident();
+    }
 
   FASTUIDRAWassert(!m_accumulated_draws.empty());
   needed_room = compute_room_needed_for_packing(draw_state);
@@ -1018,6 +1028,17 @@ fastuidraw::PainterPacker::
 begin(const reference_counted_ptr<PainterBackend::Surface> &surface,
       bool clear_color_buffer)
 {
+  begin(surface, surface->viewport(), clear_color_buffer);
+}
+
+void
+fastuidraw::PainterPacker::
+begin(const reference_counted_ptr<PainterBackend::Surface> &surface,
+      const PainterBackend::Surface::Viewport &damage_rect,
+      bool clear_color_buffer)
+{
+  PainterBackend::Surface::Viewport vwp(surface->viewport());
+  ivec2 pmin, pmax;
   PainterPackerPrivate *d;
   d = static_cast<PainterPackerPrivate*>(m_d);
 
@@ -1027,6 +1048,16 @@ begin(const reference_counted_ptr<PainterBackend::Surface> &surface,
   std::fill(d->m_stats.begin(), d->m_stats.end(), 0u);
   d->m_surface = surface;
   d->m_clear_color_buffer = clear_color_buffer;
+
+  pmin.x() = t_max(vwp.m_origin.x(), damage_rect.m_origin.x());
+  pmin.y() = t_max(vwp.m_origin.y(), damage_rect.m_origin.y());
+  pmax.x() = t_min(vwp.m_origin.x() + vwp.m_dimensions.x(),
+                   damage_rect.m_origin.x() + damage_rect.m_dimensions.x());
+  pmax.y() = t_min(vwp.m_origin.y() + vwp.m_dimensions.y(),
+                   damage_rect.m_origin.y() + damage_rect.m_dimensions.y());
+  d->m_damage_rect.m_origin = pmin;
+  d->m_damage_rect.m_dimensions.x() = t_max(0, pmax.x() - pmin.x());
+  d->m_damage_rect.m_dimensions.y() = t_max(0, pmax.y() - pmin.y());
   d->start_new_command();
   ++d->m_number_begins;
 }
@@ -1068,7 +1099,7 @@ end(void)
       c.unmap();
     }
 
-  d->m_backend->on_pre_draw(d->m_surface, d->m_clear_color_buffer);
+  d->m_backend->on_pre_draw(d->m_surface, d->m_clear_color_buffer, d->m_damage_rect);
   for(per_draw_command &cmd : d->m_accumulated_draws)
     {
       FASTUIDRAWassert(cmd.m_draw_command->unmapped());
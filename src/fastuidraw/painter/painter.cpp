@@ -28,6 +28,8 @@
 #include "../private/util_private.hpp"
 #include "../private/util_private_ostream.hpp"
 #include "../private/clip.hpp"
+#include "private/painter_command_list_private.hpp"
+#include "private/painter_layer_private.hpp"
 
 namespace
 {
@@ -223,6 +225,18 @@ namespace
       && cl.z() <= 0.0f;
   }
 
+  /* the attribute of a point for PainterFillShader::item_shader() */
+  fastuidraw::PainterAttribute
+  polygon_attribute(const fastuidraw::vec2 &p)
+  {
+    fastuidraw::PainterAttribute return_value;
+
+    return_value.m_attrib0 = fastuidraw::pack_vec4(p.x(), p.y(), 0.0f, 0.0f);
+    return_value.m_attrib1 = fastuidraw::uvec4(0u, 0u, 0u, 0u);
+    return_value.m_attrib2 = fastuidraw::uvec4(0u, 0u, 0u, 0u);
+    return return_value;
+  }
+
   void
   draw_half_plane_complement(const fastuidraw::PainterData &draw,
                              fastuidraw::Painter *painter,
@@ -463,10 +477,9 @@ namespace
       return m_item_matrix_transition_tricky;
     }
 
-    void
+    fastuidraw::c_array<const fastuidraw::vec2>
     clip_polygon(fastuidraw::c_array<const fastuidraw::vec2> pts,
-                 std::vector<fastuidraw::vec2> &out_pts,
-                 std::vector<fastuidraw::vec2> &work_vec2s);
+                 fastuidraw::detail::ClipWorkRoom &work_room);
 
     bool
     rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh);
@@ -600,17 +613,22 @@ namespace
     }
 
     /* @param (input) clip_matrix_local transformation from local to clip coordinates
-     * @param (input) in_out_pts[0] convex polygon to clip
-     * @return what index into in_out_pts that holds polygon clipped
+     * @param (input) pts convex polygon to clip
+     * @param work_room scratch space for clipping
+     * @return polygon clipped, backed by pts or work_room
      */
-    unsigned int
+    fastuidraw::c_array<const fastuidraw::vec2>
     clip_against_current(const fastuidraw::float3x3 &clip_matrix_local,
-                         fastuidraw::vecN<std::vector<fastuidraw::vec2>, 2> &in_out_pts);
+                         fastuidraw::c_array<const fastuidraw::vec2> pts,
+                         fastuidraw::detail::ClipWorkRoom &work_room);
 
   private:
     std::vector<fastuidraw::vec3> m_store;
     std::vector<unsigned int> m_sz;
     std::vector<fastuidraw::vec3> m_current;
+
+    /* m_current transformed to local coordinates */
+    std::vector<fastuidraw::vec3> m_current_local;
   };
 
   class StrokingItem
@@ -698,11 +716,9 @@ namespace
   class PainterWorkRoom
   {
   public:
-    fastuidraw::vecN<std::vector<fastuidraw::vec2>, 2> m_pts_update_clip_series;
-    fastuidraw::vecN<std::vector<fastuidraw::vec2>, 2> m_clipper_vec2s;
+    fastuidraw::detail::ClipWorkRoom m_clipper;
 
     // work room for drawing polygons
-    std::vector<fastuidraw::vec2> m_pts_draw_convex_polygon;
     std::vector<fastuidraw::PainterIndex> m_polygon_indices;
     std::vector<fastuidraw::PainterAttribute> m_polygon_attribs;
 
@@ -735,6 +751,20 @@ namespace
     std::vector<int> m_fill_aa_fuzz_index_adjusts;
     std::vector<int> m_fill_aa_fuzz_start_zs;
     std::vector<int> m_fill_aa_fuzz_z_increments;
+
+    // work room for stencil-then-cover fill
+    std::vector<fastuidraw::PainterAttribute> m_stencil_fan_attribs;
+    std::vector<fastuidraw::PainterIndex> m_stencil_fan_indices;
+    std::vector<fastuidraw::range_type<unsigned int> > m_stencil_fan_attrib_ranges;
+    std::vector<fastuidraw::range_type<unsigned int> > m_stencil_fan_index_ranges;
+    std::vector<fastuidraw::c_array<const fastuidraw::PainterAttribute> > m_stencil_fan_attrib_chunks;
+    std::vector<fastuidraw::c_array<const fastuidraw::PainterIndex> > m_stencil_fan_index_chunks;
+    std::vector<int> m_stencil_fan_index_adjusts;
+    std::vector<fastuidraw::vec2> m_stencil_cover_pts;
+
+    // work room for drawing command lists
+    std::vector<fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix> > m_command_list_matrices;
+    std::vector<unsigned int> m_command_list_matrix_stack;
   };
 
   class PainterPrivate
@@ -760,6 +790,12 @@ namespace
                  int z,
                  const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
 
+    void
+    draw_break(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> &action);
+
+    fastuidraw::PainterData
+    packed_painter_data(const fastuidraw::PainterData &draw);
+
     int
     pre_draw_anti_alias_fuzz(const fastuidraw::FilledPath &filled_path, fastuidraw::c_array<const unsigned int> subsets,
                              const WindingSet &wset,
@@ -769,6 +805,15 @@ namespace
                              std::vector<int> &index_adjusts,
                              std::vector<int> &start_zs);
 
+    int
+    pre_draw_anti_alias_analytic(const fastuidraw::FilledPath &filled_path, fastuidraw::c_array<const unsigned int> subsets,
+                                 enum fastuidraw::PainterEnums::fill_rule_t fill_rule,
+                                 std::vector<int> &z_increments,
+                                 std::vector<fastuidraw::c_array<const fastuidraw::PainterAttribute> > &attrib_chunks,
+                                 std::vector<fastuidraw::c_array<const fastuidraw::PainterIndex> > &index_chunks,
+                                 std::vector<int> &index_adjusts,
+                                 std::vector<int> &start_zs);
+
     void
     draw_generic_z_layered(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
                            const fastuidraw::PainterData &draw,
@@ -837,9 +882,28 @@ namespace
                         const fastuidraw::PainterData &draw,
                         float &out_thresh);
 
+    const fastuidraw::TessellatedPath&
+    select_tessellated_path(const fastuidraw::Path &path);
+
     const fastuidraw::FilledPath&
     select_filled_path(const fastuidraw::Path &path);
 
+    /* Fills m_work_room.m_stencil_fan_attrib_chunks and
+     * m_work_room.m_stencil_fan_index_chunks with the
+     * triangle fans of the contours of tess, split so that
+     * each chunk fits within a single PainterDraw.
+     */
+    void
+    build_stencil_fans(const fastuidraw::TessellatedPath &tess);
+
+    /* Fills m_work_room.m_stencil_cover_pts with the polygon
+     * to cover for stencil-then-cover filling; returns false
+     * if the polygon cannot be computed.
+     */
+    bool
+    build_stencil_cover(const fastuidraw::TessellatedPath &tess,
+                        enum fastuidraw::PainterEnums::fill_rule_t fill_rule);
+
     fastuidraw::vec2 m_resolution;
     fastuidraw::vec2 m_one_pixel_width;
     float m_curve_flatness;
@@ -856,6 +920,19 @@ namespace
     ClipEquationStore m_clip_store;
     PainterWorkRoom m_work_room;
     unsigned int m_max_attribs_per_block, m_max_indices_per_block;
+
+    /* recording state for begin_command_list(); m_recording is
+     * nullptr when a PainterCommandList is not being recorded.
+     */
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterCommandList> m_recording_list;
+    fastuidraw::detail::PainterCommandListPrivate *m_recording;
+    unsigned int m_recording_state_stack_size;
+    int m_recording_z;
+
+    /* the layer being rendered between begin_layer()
+     * and end_layer().
+     */
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterLayer> m_layer;
   };
 }
 
@@ -1026,14 +1103,15 @@ set_clip_equations_to_clip_rect(const fastuidraw::PainterPackedValue<fastuidraw:
   return return_value;
 }
 
-void
+fastuidraw::c_array<const fastuidraw::vec2>
 clip_rect_state::
 clip_polygon(fastuidraw::c_array<const fastuidraw::vec2> pts,
-             std::vector<fastuidraw::vec2> &out_pts,
-             std::vector<fastuidraw::vec2> &work_vec2s)
+             fastuidraw::detail::ClipWorkRoom &work_room)
 {
   const fastuidraw::PainterClipEquations &eqs(m_clip_equations);
   const fastuidraw::float3x3 &m(item_matrix());
+  fastuidraw::vecN<fastuidraw::vec3, 4> local_eqs;
+  fastuidraw::c_array<const fastuidraw::vec2> return_value;
 
   /* Clip planes are in clip coordinates, i.e.
    *   ClipDistance[i] = dot(M * p, clip_equation[i])
@@ -1042,20 +1120,12 @@ clip_polygon(fastuidraw::c_array<const fastuidraw::vec2> pts,
    * the transpose of m_item_matrix to the clip planes
    * which is the same as post-multiplying the matrix.
    */
-  fastuidraw::detail::clip_against_plane(eqs.m_clip_equations[0] * m, pts,
-                                         work_vec2s);
-
-  fastuidraw::detail::clip_against_plane(eqs.m_clip_equations[1] * m,
-                                         fastuidraw::make_c_array(work_vec2s),
-                                         out_pts);
-
-  fastuidraw::detail::clip_against_plane(eqs.m_clip_equations[2] * m,
-                                         fastuidraw::make_c_array(out_pts),
-                                         work_vec2s);
-
-  fastuidraw::detail::clip_against_plane(eqs.m_clip_equations[3] * m,
-                                         fastuidraw::make_c_array(work_vec2s),
-                                         out_pts);
+  for(unsigned int i = 0; i < 4; ++i)
+    {
+      local_eqs[i] = eqs.m_clip_equations[i] * m;
+    }
+  fastuidraw::detail::clip_against_planes(local_eqs, pts, &return_value, work_room);
+  return return_value;
 }
 
 bool
@@ -1074,42 +1144,31 @@ rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh)
   pts[2] = m_item_matrix.m_item_matrix * fastuidraw::vec3(pmax.x(), pmax.y(), 1.0f);
   pts[3] = m_item_matrix.m_item_matrix * fastuidraw::vec3(pmax.x(), pmin.y(), 1.0f);
 
-  if (m_clip_rect.m_enabled)
-    {
-      /* use equations from clip state
-       */
-      return all_pts_culled_by_one_half_plane(pts, m_clip_equations);
-    }
-  else
-    {
-      fastuidraw::PainterClipEquations clip_eq;
-      clip_eq.m_clip_equations[0] = fastuidraw::vec3( 1.0f,  0.0f, 1.0f);
-      clip_eq.m_clip_equations[1] = fastuidraw::vec3(-1.0f,  0.0f, 1.0f);
-      clip_eq.m_clip_equations[2] = fastuidraw::vec3( 0.0f,  1.0f, 1.0f);
-      clip_eq.m_clip_equations[3] = fastuidraw::vec3( 0.0f, -1.0f, 1.0f);
-      return all_pts_culled_by_one_half_plane(pts, clip_eq);
-    }
+  /* use equations from clip state; when no clip rect is
+   * enabled, these are the equations of the viewport or
+   * of the damage rect passed to Painter::begin().
+   */
+  return all_pts_culled_by_one_half_plane(pts, m_clip_equations);
 }
 
 /////////////////////////////////
 //ClipEquationStore methods
-unsigned int
+fastuidraw::c_array<const fastuidraw::vec2>
 ClipEquationStore::
 clip_against_current(const fastuidraw::float3x3 &clip_matrix_local,
-                     fastuidraw::vecN<std::vector<fastuidraw::vec2>, 2> &in_out_pts)
+                     fastuidraw::c_array<const fastuidraw::vec2> pts,
+                     fastuidraw::detail::ClipWorkRoom &work_room)
 {
-  fastuidraw::c_array<const fastuidraw::vec3> clips(current());
-  unsigned int src, dst, i;
-  for(i = 0, src = 0, dst = 1; i < clips.size(); ++i, std::swap(src, dst))
-    {
-      fastuidraw::vec3 nc;
-      fastuidraw::c_array<const fastuidraw::vec2> in;
+  fastuidraw::c_array<const fastuidraw::vec2> return_value;
 
-      nc = clips[i] * clip_matrix_local;
-      in = fastuidraw::make_c_array(in_out_pts[src]);
-      fastuidraw::detail::clip_against_plane(nc, in, in_out_pts[dst]);
+  m_current_local.resize(m_current.size());
+  for(unsigned int i = 0; i < m_current.size(); ++i)
+    {
+      m_current_local[i] = m_current[i] * clip_matrix_local;
     }
-  return src;
+  fastuidraw::detail::clip_against_planes(fastuidraw::make_c_array(m_current_local),
+                                          pts, &return_value, work_room);
+  return return_value;
 }
 
 //////////////////////////////////
@@ -1121,7 +1180,10 @@ PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> bac
   m_curve_flatness(1.0f),
   m_stroke_arc_path(false),
   m_linearize_from_arc_path(false),
-  m_pool(backend->configuration_base().alignment())
+  m_pool(backend->configuration_base().alignment()),
+  m_recording(nullptr),
+  m_recording_state_stack_size(0),
+  m_recording_z(0)
 {
   m_core = FASTUIDRAWnew fastuidraw::PainterPacker(backend);
   m_reset_brush = m_pool.create_packed_value(fastuidraw::PainterBrush());
@@ -1139,21 +1201,19 @@ update_clip_equation_series(const fastuidraw::vec2 &pmin,
                             const fastuidraw::vec2 &pmax)
 {
   fastuidraw::vec2 center(0.0f, 0.0f);
-  unsigned int src;
+  fastuidraw::vecN<fastuidraw::vec2, 4> rect;
 
-  m_work_room.m_pts_update_clip_series[0].resize(4);
-  m_work_room.m_pts_update_clip_series[0][0] = pmin;
-  m_work_room.m_pts_update_clip_series[0][1] = fastuidraw::vec2(pmin.x(), pmax.y());
-  m_work_room.m_pts_update_clip_series[0][2] = pmax;
-  m_work_room.m_pts_update_clip_series[0][3] = fastuidraw::vec2(pmax.x(), pmin.y());
-  src = m_clip_store.clip_against_current(m_clip_rect_state.item_matrix(),
-                                          m_work_room.m_pts_update_clip_series);
+  rect[0] = pmin;
+  rect[1] = fastuidraw::vec2(pmin.x(), pmax.y());
+  rect[2] = pmax;
+  rect[3] = fastuidraw::vec2(pmax.x(), pmin.y());
 
   /* the input rectangle clipped to the previous clipping equation
-   * array is now stored in m_work_room.m_pts_update_clip_series[src]
+   * array is backed by rect or m_work_room.m_clipper
    */
   fastuidraw::c_array<const fastuidraw::vec2> poly;
-  poly = fastuidraw::make_c_array(m_work_room.m_pts_update_clip_series[src]);
+  poly = m_clip_store.clip_against_current(m_clip_rect_state.item_matrix(),
+                                           rect, m_work_room.m_clipper);
 
   m_clip_store.clear_current();
 
@@ -1246,8 +1306,8 @@ compute_path_magnification_perspective(const fastuidraw::Path &path)
    * clipped.
    */
   fastuidraw::vec2 bb_min, bb_max;
+  fastuidraw::vecN<fastuidraw::vec2, 4> bb;
   bool r;
-  unsigned int src;
 
   r = path.approximate_bounding_box(&bb_min, &bb_max);
   if (!r)
@@ -1259,11 +1319,10 @@ compute_path_magnification_perspective(const fastuidraw::Path &path)
        */
       return -1.0f;
     }
-  m_work_room.m_clipper_vec2s[0].resize(4);
-  m_work_room.m_clipper_vec2s[0][0] = bb_min;
-  m_work_room.m_clipper_vec2s[0][1] = fastuidraw::vec2(bb_min.x(), bb_max.y());
-  m_work_room.m_clipper_vec2s[0][2] = bb_max;
-  m_work_room.m_clipper_vec2s[0][3] = fastuidraw::vec2(bb_max.x(), bb_min.y());
+  bb[0] = bb_min;
+  bb[1] = fastuidraw::vec2(bb_min.x(), bb_max.y());
+  bb[2] = bb_max;
+  bb[3] = fastuidraw::vec2(bb_max.x(), bb_min.y());
 
   /* TODO: for stroking, it might be that although the
    * original path is completely clipped, the stroke of
@@ -1272,11 +1331,8 @@ compute_path_magnification_perspective(const fastuidraw::Path &path)
    * require.
    */
   const fastuidraw::float3x3 &m(m_clip_rect_state.item_matrix());
-  src = m_clip_store.clip_against_current(m,
-                                          m_work_room.m_clipper_vec2s);
-
   fastuidraw::c_array<const fastuidraw::vec2> poly;
-  poly = make_c_array(m_work_room.m_clipper_vec2s[src]);
+  poly = m_clip_store.clip_against_current(m, bb, m_work_room.m_clipper);
 
   if (poly.empty())
     {
@@ -1385,9 +1441,9 @@ select_stroked_path(const fastuidraw::Path &path,
   return tess->stroked().get();
 }
 
-const fastuidraw::FilledPath&
+const fastuidraw::TessellatedPath&
 PainterPrivate::
-select_filled_path(const fastuidraw::Path &path)
+select_tessellated_path(const fastuidraw::Path &path)
 {
   using namespace fastuidraw;
   float mag, thresh;
@@ -1404,7 +1460,141 @@ select_filled_path(const fastuidraw::Path &path)
       tess = path.tessellation(thresh).get();
     }
 
-  return *tess->filled();
+  return *tess;
+}
+
+const fastuidraw::FilledPath&
+PainterPrivate::
+select_filled_path(const fastuidraw::Path &path)
+{
+  return *select_tessellated_path(path).filled();
+}
+
+void
+PainterPrivate::
+build_stencil_fans(const fastuidraw::TessellatedPath &tess)
+{
+  using namespace fastuidraw;
+  unsigned int max_pts;
+  PainterWorkRoom &wr(m_work_room);
+
+  /* a chunk is the fan pivot followed by count points,
+   * giving count - 1 triangles.
+   */
+  max_pts = t_min(m_max_attribs_per_block - 1u, m_max_indices_per_block / 3u + 1u);
+  FASTUIDRAWassert(max_pts >= 2u);
+  FASTUIDRAWassert(!tess.has_arcs());
+
+  wr.m_stencil_fan_attribs.clear();
+  wr.m_stencil_fan_indices.clear();
+  wr.m_stencil_fan_attrib_ranges.clear();
+  wr.m_stencil_fan_index_ranges.clear();
+  for (unsigned int c = 0, endc = tess.number_contours(); c < endc; ++c)
+    {
+      c_array<const vec2> pts(tess.contour_points(c));
+      unsigned int count;
+
+      for (unsigned int start = 1; start + 1 < pts.size(); start += count - 1)
+        {
+          range_type<unsigned int> attrib_range, index_range;
+
+          count = t_min(max_pts, static_cast<unsigned int>(pts.size()) - start);
+          attrib_range.m_begin = wr.m_stencil_fan_attribs.size();
+          index_range.m_begin = wr.m_stencil_fan_indices.size();
+
+          wr.m_stencil_fan_attribs.push_back(polygon_attribute(pts[0]));
+          for (unsigned int i = 0; i < count; ++i)
+            {
+              wr.m_stencil_fan_attribs.push_back(polygon_attribute(pts[start + i]));
+            }
+
+          for (unsigned int i = 1; i < count; ++i)
+            {
+              wr.m_stencil_fan_indices.push_back(0);
+              wr.m_stencil_fan_indices.push_back(i);
+              wr.m_stencil_fan_indices.push_back(i + 1);
+            }
+
+          attrib_range.m_end = wr.m_stencil_fan_attribs.size();
+          index_range.m_end = wr.m_stencil_fan_indices.size();
+          wr.m_stencil_fan_attrib_ranges.push_back(attrib_range);
+          wr.m_stencil_fan_index_ranges.push_back(index_range);
+        }
+    }
+
+  /* make the chunks only after the vectors are done
+   * growing so that the c_array values stay valid.
+   */
+  wr.m_stencil_fan_attrib_chunks.clear();
+  wr.m_stencil_fan_index_chunks.clear();
+  wr.m_stencil_fan_index_adjusts.clear();
+  for (unsigned int i = 0, endi = wr.m_stencil_fan_attrib_ranges.size(); i < endi; ++i)
+    {
+      wr.m_stencil_fan_attrib_chunks.push_back(make_c_array(wr.m_stencil_fan_attribs).sub_array(wr.m_stencil_fan_attrib_ranges[i]));
+      wr.m_stencil_fan_index_chunks.push_back(make_c_array(wr.m_stencil_fan_indices).sub_array(wr.m_stencil_fan_index_ranges[i]));
+      wr.m_stencil_fan_index_adjusts.push_back(0);
+    }
+}
+
+bool
+PainterPrivate::
+build_stencil_cover(const fastuidraw::TessellatedPath &tess,
+                    enum fastuidraw::PainterEnums::fill_rule_t fill_rule)
+{
+  using namespace fastuidraw;
+  std::vector<vec2> &pts(m_work_room.m_stencil_cover_pts);
+
+  pts.clear();
+  if (fill_rule == PainterEnums::odd_even_fill_rule
+      || fill_rule == PainterEnums::nonzero_fill_rule)
+    {
+      /* the triangle fans are within the bounding box of
+       * tess, so covering it both draws the fill and
+       * resets the stencil buffer touched by the fans.
+       */
+      vec2 pmin(tess.bounding_box_min()), pmax(tess.bounding_box_max());
+
+      pts.push_back(vec2(pmin.x(), pmin.y()));
+      pts.push_back(vec2(pmin.x(), pmax.y()));
+      pts.push_back(vec2(pmax.x(), pmax.y()));
+      pts.push_back(vec2(pmax.x(), pmin.y()));
+      return true;
+    }
+
+  /* The complement fill rules are unbounded, so cover the
+   * pre-image under the item matrix of the 3D API clip-region
+   * [-1, 1]x[-1, 1]. The pre-image is a bounded quadrilateral
+   * only if the line mapped to infinity by the inverse matrix
+   * misses the clip-region, i.e. the corners all map with the
+   * same sign of w. A command list is replayed with different
+   * item matrices, so the pre-image cannot be computed when
+   * recording.
+   */
+  const float3x3 &m(m_clip_rect_state.item_matrix());
+  const vecN<vec2, 4> corners(vec2(-1.0f, -1.0f), vec2(-1.0f, +1.0f),
+                              vec2(+1.0f, +1.0f), vec2(+1.0f, -1.0f));
+  float3x3 inverse;
+  float sign(0.0f);
+
+  if (m_recording || m.determinate() == 0.0f)
+    {
+      return false;
+    }
+
+  m.inverse(inverse);
+  for (const vec2 &c : corners)
+    {
+      vec3 q;
+
+      q = inverse * vec3(c.x(), c.y(), 1.0f);
+      if (q.z() == 0.0f || q.z() * sign < 0.0f)
+        {
+          return false;
+        }
+      sign = q.z();
+      pts.push_back(vec2(q.x(), q.y()) / q.z());
+    }
+  return true;
 }
 
 void
@@ -1418,6 +1608,16 @@ draw_generic(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShad
              int z,
              const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
 {
+  if (m_recording)
+    {
+      m_recording->add_draw(shader, packed_painter_data(draw),
+                            m_core->blend_shader(), m_core->blend_mode(),
+                            m_clip_rect_state.item_matrix(), z, m_current_z,
+                            attrib_chunks, index_chunks, index_adjusts,
+                            attrib_chunk_selector, call_back);
+      return;
+    }
+
   fastuidraw::PainterPackerData p(draw);
 
   p.m_clip = m_clip_rect_state.clip_equations_state(m_pool);
@@ -1433,12 +1633,50 @@ draw_generic(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShad
              int z,
              const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
 {
+  if (m_recording)
+    {
+      m_recording->add_draw(shader, packed_painter_data(draw),
+                            m_core->blend_shader(), m_core->blend_mode(),
+                            m_clip_rect_state.item_matrix(), z, m_current_z,
+                            src, call_back);
+      return;
+    }
+
   fastuidraw::PainterPackerData p(draw);
   p.m_clip = m_clip_rect_state.clip_equations_state(m_pool);
   p.m_matrix = m_clip_rect_state.current_item_marix_state(m_pool);
   m_core->draw_generic(shader, p, src, z, call_back);
 }
 
+void
+PainterPrivate::
+draw_break(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> &action)
+{
+  if (m_recording)
+    {
+      m_recording->add_action(action, m_current_z);
+    }
+  else
+    {
+      m_core->draw_break(action);
+    }
+}
+
+fastuidraw::PainterData
+PainterPrivate::
+packed_painter_data(const fastuidraw::PainterData &draw)
+{
+  /* a recorded draw is replayed after the values pointed
+   * to by draw are gone, thus the values must be packed.
+   */
+  fastuidraw::PainterData return_value(draw);
+
+  return_value.m_brush.make_packed(m_pool);
+  return_value.m_item_shader_data.make_packed(m_pool);
+  return_value.m_blend_shader_data.make_packed(m_pool);
+  return return_value;
+}
+
 int
 PainterPrivate::
 pre_draw_anti_alias_fuzz(const fastuidraw::FilledPath &filled_path,
@@ -1488,6 +1726,48 @@ pre_draw_anti_alias_fuzz(const fastuidraw::FilledPath &filled_path,
   return return_value;
 }
 
+int
+PainterPrivate::
+pre_draw_anti_alias_analytic(const fastuidraw::FilledPath &filled_path,
+                             fastuidraw::c_array<const unsigned int> subsets,
+                             enum fastuidraw::PainterEnums::fill_rule_t fill_rule,
+                             std::vector<int> &z_increments,
+                             std::vector<fastuidraw::c_array<const fastuidraw::PainterAttribute> > &attrib_chunks,
+                             std::vector<fastuidraw::c_array<const fastuidraw::PainterIndex> > &index_chunks,
+                             std::vector<int> &index_adjusts,
+                             std::vector<int> &start_zs)
+{
+  int return_value(0);
+  unsigned int ch;
+
+  z_increments.clear();
+  attrib_chunks.clear();
+  index_chunks.clear();
+  index_adjusts.clear();
+  start_zs.clear();
+  ch = fastuidraw::FilledPath::Subset::fill_chunk_from_fill_rule(fill_rule);
+  for(unsigned int s : subsets)
+    {
+      fastuidraw::FilledPath::Subset subset(filled_path.subset(s));
+      const fastuidraw::PainterAttributeData &data(subset.aa_analytic_painter_data());
+      fastuidraw::range_type<int> R;
+
+      /* all index chunks of the data share the z-range 0 */
+      R = data.z_range(0);
+
+      attrib_chunks.push_back(data.attribute_data_chunk(0));
+      index_chunks.push_back(data.index_data_chunk(ch));
+      index_adjusts.push_back(data.index_adjust_chunk(ch));
+
+      z_increments.push_back(R.difference());
+      start_zs.push_back(R.m_begin);
+
+      return_value += z_increments.back();
+    }
+
+  return return_value;
+}
+
 void
 PainterPrivate::
 draw_generic_z_layered(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
@@ -1642,6 +1922,27 @@ stroke_path_common(const fastuidraw::PainterStrokeShader &shader,
   float pixels_additional_room(0.0f), item_space_additional_room(0.0f);
   shader.stroking_data_selector()->stroking_distances(raw_data, &pixels_additional_room, &item_space_additional_room);
 
+  /* Culling by distance along the contours (i.e. by the
+   * skip intervals of a dash pattern) needs the length of a
+   * pixel in local coordinates; that length is only uniform
+   * when the item matrix has no perspective.
+   */
+  const StrokingDataSelectorBase *distance_culler(nullptr);
+  float one_pixel_distance(0.0f);
+  const float3x3 &m(m_clip_rect_state.item_matrix());
+
+  if (m(2, 0) == 0.0f && m(2, 1) == 0.0f)
+    {
+      float mag;
+
+      mag = compute_path_magnification_non_perspective();
+      if (mag > 0.0f)
+        {
+          distance_culler = shader.stroking_data_selector().get();
+          one_pixel_distance = 1.0f / mag;
+        }
+    }
+
   unsigned int subset_count;
   m_work_room.m_stroked_subsets.resize(path.number_subsets());
 
@@ -1651,6 +1952,8 @@ stroke_path_common(const fastuidraw::PainterStrokeShader &shader,
                                      m_one_pixel_width,
                                      pixels_additional_room,
                                      item_space_additional_room,
+                                     distance_culler, raw_data,
+                                     one_pixel_distance,
                                      m_max_attribs_per_block,
                                      m_max_indices_per_block,
                                      make_c_array(m_work_room.m_stroked_subsets));
@@ -1834,7 +2137,7 @@ stroke_path_raw(const fastuidraw::PainterStrokeShader &shader,
           old_blend = m_core->blend_shader();
           old_blend_mode = m_core->blend_mode();
           m_core->blend_shader(shader_set.shader(m), shader_set.blend_mode(m));
-          m_core->draw_break(shader.aa_action_pass1());
+          draw_break(shader.aa_action_pass1());
         }
     }
 
@@ -1864,7 +2167,7 @@ stroke_path_raw(const fastuidraw::PainterStrokeShader &shader,
       if (aa_type == PainterStrokeShader::cover_then_draw)
         {
           m_core->blend_shader(old_blend, old_blend_mode);
-          m_core->draw_break(shader.aa_action_pass2());
+          draw_break(shader.aa_action_pass2());
         }
 
       if (modify_z)
@@ -1923,18 +2226,82 @@ void
 fastuidraw::Painter::
 begin(const reference_counted_ptr<PainterBackend::Surface> &surface,
       bool clear_color_buffer)
+{
+  PainterBackend::Surface::Viewport vwp(surface->viewport());
+  begin(surface, c_array<const PainterBackend::Surface::Viewport>(&vwp, 1),
+        clear_color_buffer);
+}
+
+void
+fastuidraw::Painter::
+begin(const reference_counted_ptr<PainterBackend::Surface> &surface,
+      c_array<const PainterBackend::Surface::Viewport> damage,
+      bool clear_color_buffer)
 {
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
-  d->m_core->begin(surface, clear_color_buffer);
-  d->m_resolution = vec2(surface->viewport().m_dimensions);
+  PainterBackend::Surface::Viewport vwp(surface->viewport());
+  ivec2 pmin(vwp.m_origin + vwp.m_dimensions), pmax(vwp.m_origin);
+  PainterBackend::Surface::Viewport damage_rect;
+
+  for (const PainterBackend::Surface::Viewport &r : damage)
+    {
+      if (r.m_dimensions.x() > 0 && r.m_dimensions.y() > 0)
+        {
+          pmin.x() = t_min(pmin.x(), r.m_origin.x());
+          pmin.y() = t_min(pmin.y(), r.m_origin.y());
+          pmax.x() = t_max(pmax.x(), r.m_origin.x() + r.m_dimensions.x());
+          pmax.y() = t_max(pmax.y(), r.m_origin.y() + r.m_dimensions.y());
+        }
+    }
+  pmin.x() = t_max(pmin.x(), vwp.m_origin.x());
+  pmin.y() = t_max(pmin.y(), vwp.m_origin.y());
+  pmax.x() = t_min(pmax.x(), vwp.m_origin.x() + vwp.m_dimensions.x());
+  pmax.y() = t_min(pmax.y(), vwp.m_origin.y() + vwp.m_dimensions.y());
+
+  damage_rect.m_origin = pmin;
+  damage_rect.m_dimensions.x() = t_max(0, pmax.x() - pmin.x());
+  damage_rect.m_dimensions.y() = t_max(0, pmax.y() - pmin.y());
+
+  d->m_core->begin(surface, damage_rect, clear_color_buffer);
+  d->m_resolution = vec2(vwp.m_dimensions);
   d->m_resolution.x() = std::max(1.0f, d->m_resolution.x());
   d->m_resolution.y() = std::max(1.0f, d->m_resolution.y());
   d->m_one_pixel_width = 1.0f / d->m_resolution;
 
   d->m_current_z = 1;
   d->m_clip_rect_state.reset();
+  if (damage_rect.m_dimensions.x() == 0 || damage_rect.m_dimensions.y() == 0)
+    {
+      d->m_clip_rect_state.m_all_content_culled = true;
+    }
+  else if (damage_rect.m_origin != vwp.m_origin
+           || damage_rect.m_dimensions != vwp.m_dimensions)
+    {
+      /* The damage rect in normalized device coordinates is
+       * [min_x, max_x]x[min_y, max_y] which gives the clip
+       * equations (see clip_rect_state::set_clip_equations_to_clip_rect()):
+       *     x - w * min_x >= 0  --> ( 1,  0, -min_x)
+       *    -x + w * max_x >= 0  --> (-1,  0, max_x)
+       *     y - w * min_y >= 0  --> ( 0,  1, -min_y)
+       *    -y + w * max_y >= 0  --> ( 0, -1, max_y)
+       * Having these as the starting clip equations makes the
+       * culling of the Painter (rect_is_culled() and the subset
+       * selection of filling and stroking) reject all content
+       * outside of the damage rect.
+       */
+      PainterClipEquations clip_eq;
+      vec2 ndc_min, ndc_max;
+
+      ndc_min = 2.0f * vec2(pmin - vwp.m_origin) * d->m_one_pixel_width - vec2(1.0f);
+      ndc_max = 2.0f * vec2(pmax - vwp.m_origin) * d->m_one_pixel_width - vec2(1.0f);
+      clip_eq.m_clip_equations[0] = vec3( 1.0f,  0.0f, -ndc_min.x());
+      clip_eq.m_clip_equations[1] = vec3(-1.0f,  0.0f,  ndc_max.x());
+      clip_eq.m_clip_equations[2] = vec3( 0.0f,  1.0f, -ndc_min.y());
+      clip_eq.m_clip_equations[3] = vec3( 0.0f, -1.0f,  ndc_max.y());
+      d->m_clip_rect_state.clip_equations(clip_eq);
+    }
   d->m_clip_store.set_current(d->m_clip_rect_state.clip_equations().m_clip_equations);
   blend_shader(PainterEnums::blend_porter_duff_src_over);
 }
@@ -2015,7 +2382,291 @@ queue_action(const reference_counted_ptr<const PainterDraw::Action> &action)
 {
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
-  d->m_core->draw_break(action);
+  d->draw_break(action);
+}
+
+void
+fastuidraw::Painter::
+begin_command_list(const reference_counted_ptr<PainterCommandList> &list)
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+
+  FASTUIDRAWassert(!d->m_recording);
+  FASTUIDRAWassert(list && !list->recording());
+
+  save();
+  d->m_recording_state_stack_size = d->m_state_stack.size();
+  d->m_recording_z = d->m_current_z;
+  d->m_recording_list = list;
+  d->m_recording = static_cast<detail::PainterCommandListPrivate*>(list->m_d);
+  d->m_recording->begin_recording(d->m_clip_rect_state.item_matrix(), d->m_current_z);
+
+  /* the recording is to be replayed under a different clipping,
+   * so remove all clipping to prevent any culling while recording;
+   * an equation of (0, 0, 1) only requires that w >= 0.
+   */
+  PainterClipEquations no_clip;
+  for (unsigned int i = 0; i < 4; ++i)
+    {
+      no_clip.m_clip_equations[i] = vec3(0.0f, 0.0f, 1.0f);
+    }
+  d->m_clip_rect_state.m_clip_rect = clip_rect();
+  d->m_clip_rect_state.m_all_content_culled = false;
+  d->m_clip_rect_state.clip_equations(no_clip);
+  d->m_clip_store.clear_current();
+}
+
+void
+fastuidraw::Painter::
+end_command_list(void)
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+
+  FASTUIDRAWassert(d->m_recording);
+  FASTUIDRAWassert(d->m_state_stack.size() == d->m_recording_state_stack_size);
+
+  d->m_recording->end_recording(d->m_current_z);
+  d->m_recording = nullptr;
+  d->m_recording_list.clear();
+  d->m_current_z = d->m_recording_z;
+  restore();
+}
+
+bool
+fastuidraw::Painter::
+recording_command_list(void) const
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  return d->m_recording != nullptr;
+}
+
+void
+fastuidraw::Painter::
+draw_command_list(const PainterCommandList &list)
+{
+  typedef detail::PainterCommandListPrivate L;
+
+  PainterPrivate *d;
+  const L *cmds;
+
+  d = static_cast<PainterPrivate*>(m_d);
+  cmds = static_cast<const L*>(list.m_d);
+
+  FASTUIDRAWassert(!cmds->m_recording);
+  if (cmds->m_commands.empty())
+    {
+      return;
+    }
+
+  /* The transformation of the Painter is only changed for
+   * the clipping commands, it is tracked as an index into
+   * L::m_matrices, with the value ~0u meaning the matrix
+   * at the start, i.e. identity relative to the recording.
+   */
+  const unsigned int start_matrix(~0u);
+  std::vector<PainterPackedValue<PainterItemMatrix> > &packed_matrices(d->m_work_room.m_command_list_matrices);
+  std::vector<unsigned int> &matrix_stack(d->m_work_room.m_command_list_matrix_stack);
+  unsigned int current_matrix(start_matrix);
+  float3x3 base_matrix;
+
+  save();
+  base_matrix = d->m_clip_rect_state.item_matrix();
+  packed_matrices.clear();
+  packed_matrices.resize(cmds->m_matrices.size());
+  matrix_stack.clear();
+
+  for (const L::command &cmd : cmds->m_commands)
+    {
+      d->m_current_z += cmd.m_z_advance;
+      switch (cmd.m_type)
+        {
+        case L::draw_command:
+          {
+            const L::draw_entry &D(cmds->m_draws[cmd.m_index]);
+            c_array<const unsigned int> selector;
+
+            if (d->m_clip_rect_state.m_all_content_culled)
+              {
+                break;
+              }
+
+            selector = make_c_array(cmds->m_attribute_chunk_selectors).sub_array(D.m_selectors);
+            if (!packed_matrices[D.m_matrix])
+              {
+                PainterItemMatrix M(base_matrix * cmds->m_matrices[D.m_matrix]);
+                packed_matrices[D.m_matrix] = d->m_pool.create_packed_value(M);
+              }
+
+            d->m_core->blend_shader(D.m_blend_shader, D.m_blend_mode);
+            if (d->m_recording)
+              {
+                /* drawing a command list into a command list,
+                 * the recording needs the transformation set.
+                 */
+                d->m_clip_rect_state.item_matrix_state(packed_matrices[D.m_matrix], true);
+                current_matrix = D.m_matrix;
+                d->draw_generic(D.m_shader, D.m_data,
+                                make_c_array(cmds->m_attribute_chunks).sub_array(D.m_attribute_chunks),
+                                make_c_array(cmds->m_index_chunks).sub_array(D.m_index_chunks),
+                                make_c_array(cmds->m_index_adjusts).sub_array(D.m_index_chunks),
+                                selector, d->m_current_z + D.m_z_offset, D.m_call_back);
+              }
+            else
+              {
+                PainterPackerData p(D.m_data);
+
+                p.m_clip = d->m_clip_rect_state.clip_equations_state(d->m_pool);
+                p.m_matrix = packed_matrices[D.m_matrix];
+                d->m_core->draw_generic(D.m_shader, p,
+                                        make_c_array(cmds->m_attribute_chunks).sub_array(D.m_attribute_chunks),
+                                        make_c_array(cmds->m_index_chunks).sub_array(D.m_index_chunks),
+                                        make_c_array(cmds->m_index_adjusts).sub_array(D.m_index_chunks),
+                                        selector, d->m_current_z + D.m_z_offset, D.m_call_back);
+              }
+          }
+          break;
+
+        case L::action_command:
+          d->draw_break(cmds->m_actions[cmd.m_index]);
+          break;
+
+        case L::save_command:
+          save();
+          matrix_stack.push_back(current_matrix);
+          break;
+
+        case L::restore_command:
+          FASTUIDRAWassert(!matrix_stack.empty());
+          restore();
+          current_matrix = matrix_stack.back();
+          matrix_stack.pop_back();
+          break;
+
+        case L::clip_in_rect_command:
+        case L::clip_out_path_command:
+        case L::clip_in_path_command:
+          {
+            const L::clip_entry &C(cmds->m_clips[cmd.m_index]);
+
+            /* change the transformation by concatenating the
+             * difference so that the Painter can keep using
+             * its clip-rect when the difference maps rects
+             * to rects.
+             */
+            if (current_matrix != C.m_matrix)
+              {
+                float3x3 delta;
+
+                if (current_matrix == start_matrix)
+                  {
+                    delta = cmds->m_matrices[C.m_matrix];
+                  }
+                else
+                  {
+                    float3x3 inverse_current;
+
+                    cmds->m_matrices[current_matrix].inverse(inverse_current);
+                    delta = inverse_current * cmds->m_matrices[C.m_matrix];
+                  }
+                concat(delta);
+                current_matrix = C.m_matrix;
+              }
+
+            if (cmd.m_type == L::clip_in_rect_command)
+              {
+                clipInRect(C.m_min, C.m_wh);
+              }
+            else if (C.m_custom_fill_rule)
+              {
+                L::recorded_fill_rule R(C);
+                if (cmd.m_type == L::clip_in_path_command)
+                  {
+                    clipInPath(C.m_path, R);
+                  }
+                else
+                  {
+                    clipOutPath(C.m_path, R);
+                  }
+              }
+            else
+              {
+                if (cmd.m_type == L::clip_in_path_command)
+                  {
+                    clipInPath(C.m_path, C.m_fill_rule);
+                  }
+                else
+                  {
+                    clipOutPath(C.m_path, C.m_fill_rule);
+                  }
+              }
+          }
+          break;
+        }
+    }
+
+  d->m_current_z += cmds->m_z_advance_end;
+  restore();
+}
+
+void
+fastuidraw::Painter::
+begin_layer(const reference_counted_ptr<PainterLayer> &layer)
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+
+  FASTUIDRAWassert(layer);
+  FASTUIDRAWassert(!d->m_layer);
+
+  ivec2 dims(layer->dimensions());
+  float_orthogonal_projection_params proj(0.0f, dims.x(), dims.y(), 0.0f);
+
+  d->m_layer = layer;
+  layer->invalidate();
+  begin(layer->surface(), true);
+  transformation(float3x3(proj));
+}
+
+bool
+fastuidraw::Painter::
+end_layer(void)
+{
+  PainterPrivate *d;
+  detail::PainterLayerPrivate *layer;
+
+  d = static_cast<PainterPrivate*>(m_d);
+  FASTUIDRAWassert(d->m_layer);
+
+  end();
+  layer = static_cast<detail::PainterLayerPrivate*>(d->m_layer->m_d);
+  layer->m_image = layer->m_surface->image(d->m_core->image_atlas());
+  d->m_layer.clear();
+
+  return layer->m_image;
+}
+
+void
+fastuidraw::Painter::
+draw_layer(const PainterLayer &layer, const vec2 &p,
+           enum PainterBrush::image_filter f)
+{
+  if (!layer.valid())
+    {
+      return;
+    }
+
+  /* the brush samples the image at the item coordinate
+   * added with the brush translation, thus translate
+   * by -p so that p is the top-left corner of the image.
+   */
+  PainterBrush brush;
+  brush
+    .image(layer.image(), f)
+    .transformation_translate(-p);
+  draw_rect(PainterData(&brush), p, vec2(layer.image()->dimensions()));
 }
 
 void
@@ -2034,9 +2685,7 @@ draw_convex_polygon(const PainterFillShader &shader,
 
   if (!d->m_core->hints().clipping_via_hw_clip_planes())
     {
-      d->m_clip_rect_state.clip_polygon(pts, d->m_work_room.m_pts_draw_convex_polygon,
-                                        d->m_work_room.m_clipper_vec2s[0]);
-      pts = make_c_array(d->m_work_room.m_pts_draw_convex_polygon);
+      pts = d->m_clip_rect_state.clip_polygon(pts, d->m_work_room.m_clipper);
       if (pts.size() < 3)
         {
           return;
@@ -2217,6 +2866,7 @@ fill_path(const PainterFillShader &shader, const PainterData &draw,
 {
   PainterPrivate *d;
   unsigned int idx_chunk, atr_chunk, num_subsets, incr_z;
+  bool analytic_aa;
 
   d = static_cast<PainterPrivate*>(m_d);
   if (d->m_clip_rect_state.m_all_content_culled)
@@ -2224,6 +2874,12 @@ fill_path(const PainterFillShader &shader, const PainterData &draw,
       return;
     }
 
+  /* with analytic anti-aliasing, the triangles on the boundary
+   * of the fill are drawn below the fill instead of the fuzz
+   * and compute their coverage in the fragment shader.
+   */
+  analytic_aa = with_anti_aliasing && shader.aa_analytic_shader(fill_rule);
+
   idx_chunk = FilledPath::Subset::fill_chunk_from_fill_rule(fill_rule);
   atr_chunk = 0;
 
@@ -2256,7 +2912,16 @@ fill_path(const PainterFillShader &shader, const PainterData &draw,
       d->m_work_room.m_fill_index_adjusts.push_back(data.index_adjust_chunk(idx_chunk));
     }
 
-  if (with_anti_aliasing)
+  if (analytic_aa)
+    {
+      incr_z = d->pre_draw_anti_alias_analytic(filled_path, subset_list, fill_rule,
+                                               d->m_work_room.m_fill_aa_fuzz_z_increments,
+                                               d->m_work_room.m_fill_aa_fuzz_attrib_chunks,
+                                               d->m_work_room.m_fill_aa_fuzz_index_chunks,
+                                               d->m_work_room.m_fill_aa_fuzz_index_adjusts,
+                                               d->m_work_room.m_fill_aa_fuzz_start_zs);
+    }
+  else if (with_anti_aliasing)
     {
       d->m_work_room.m_fill_ws.set(filled_path, subset_list,
                                    CustomFillRuleFunction(fill_rule));
@@ -2282,7 +2947,8 @@ fill_path(const PainterFillShader &shader, const PainterData &draw,
 
   if (with_anti_aliasing)
     {
-      d->draw_generic_z_layered(shader.aa_fuzz_shader(), draw,
+      d->draw_generic_z_layered((analytic_aa) ? shader.aa_analytic_shader(fill_rule) : shader.aa_fuzz_shader(),
+                                draw,
                                 fastuidraw::make_c_array(d->m_work_room.m_fill_aa_fuzz_z_increments), incr_z,
                                 fastuidraw::make_c_array(d->m_work_room.m_fill_aa_fuzz_attrib_chunks),
                                 fastuidraw::make_c_array(d->m_work_room.m_fill_aa_fuzz_index_chunks),
@@ -2456,6 +3122,88 @@ fill_path(const PainterData &draw, const Path &path, const CustomFillRuleBase &f
             with_anti_aliasing, call_back);
 }
 
+void
+fastuidraw::Painter::
+fill_path_stencil_cover(const PainterFillShader &shader, const PainterData &draw,
+                        const Path &path, enum PainterEnums::fill_rule_t fill_rule,
+                        const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+
+  if (d->m_clip_rect_state.m_all_content_culled)
+    {
+      return;
+    }
+
+  const TessellatedPath &tess(d->select_tessellated_path(path));
+  if (!shader.supports_stencil_cover() || !d->build_stencil_cover(tess, fill_rule))
+    {
+      fill_path(shader, draw, *tess.filled(), fill_rule, false, call_back);
+      return;
+    }
+
+  d->build_stencil_fans(tess);
+  if (d->m_work_room.m_stencil_fan_attrib_chunks.empty()
+      && (fill_rule == PainterEnums::odd_even_fill_rule
+          || fill_rule == PainterEnums::nonzero_fill_rule))
+    {
+      return;
+    }
+
+  /* the fans and cover share the item and brush data,
+   * so pack it to have it written only once.
+   */
+  PainterData packed_draw(draw);
+  packed_draw.make_packed(d->m_pool);
+
+  /* accumulate the winding numbers in the stencil buffer */
+  d->draw_break(shader.stencil_action());
+  d->draw_generic(shader.item_shader(), packed_draw,
+                  make_c_array(d->m_work_room.m_stencil_fan_attrib_chunks),
+                  make_c_array(d->m_work_room.m_stencil_fan_index_chunks),
+                  make_c_array(d->m_work_room.m_stencil_fan_index_adjusts),
+                  c_array<const unsigned int>(),
+                  d->m_current_z, call_back);
+
+  /* draw the cover where the stencil passes the fill rule;
+   * the cover is not clipped on the CPU (as draw_convex_polygon()
+   * does) so that it resets all of the stencil buffer that
+   * the fans touched.
+   */
+  const std::vector<vec2> &pts(d->m_work_room.m_stencil_cover_pts);
+  d->m_work_room.m_polygon_attribs.clear();
+  d->m_work_room.m_polygon_indices.clear();
+  for(unsigned int i = 0; i < pts.size(); ++i)
+    {
+      d->m_work_room.m_polygon_attribs.push_back(polygon_attribute(pts[i]));
+    }
+  for(unsigned int i = 2; i < pts.size(); ++i)
+    {
+      d->m_work_room.m_polygon_indices.push_back(0);
+      d->m_work_room.m_polygon_indices.push_back(i - 1);
+      d->m_work_room.m_polygon_indices.push_back(i);
+    }
+
+  d->draw_break(shader.cover_action(fill_rule));
+  draw_generic(shader.item_shader(), packed_draw,
+               make_c_array(d->m_work_room.m_polygon_attribs),
+               make_c_array(d->m_work_room.m_polygon_indices),
+               0,
+               call_back);
+  d->draw_break(shader.end_cover_action());
+}
+
+void
+fastuidraw::Painter::
+fill_path_stencil_cover(const PainterData &draw, const Path &path,
+                        enum PainterEnums::fill_rule_t fill_rule,
+                        const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  fill_path_stencil_cover(default_shaders().fill_shader(), draw, path,
+                          fill_rule, call_back);
+}
+
 void
 fastuidraw::Painter::
 draw_glyphs(const PainterGlyphShader &shader, const PainterData &draw,
@@ -2684,6 +3432,11 @@ save(void)
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
+  if (d->m_recording)
+    {
+      d->m_recording->add_save(d->m_current_z);
+    }
+
   state_stack_entry st;
   st.m_occluder_stack_position = d->m_occluder_stack.size();
   st.m_blend = d->m_core->blend_shader();
@@ -2703,6 +3456,12 @@ restore(void)
   d = static_cast<PainterPrivate*>(m_d);
 
   FASTUIDRAWassert(!d->m_state_stack.empty());
+  if (d->m_recording)
+    {
+      FASTUIDRAWassert(d->m_state_stack.size() > d->m_recording_state_stack_size);
+      d->m_recording->add_restore(d->m_current_z);
+    }
+
   const state_stack_entry &st(d->m_state_stack.back());
 
   d->m_clip_rect_state = st.m_clip_rect_state;
@@ -2749,6 +3508,14 @@ clipOutPath(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
+  if (d->m_recording)
+    {
+      d->m_recording->add_clip_path(detail::PainterCommandListPrivate::clip_out_path_command,
+                                    d->m_clip_rect_state.item_matrix(), d->m_current_z,
+                                    path, fill_rule);
+      return;
+    }
+
   if (d->m_clip_rect_state.m_all_content_culled)
     {
       /* everything is clipped anyways, adding more clipping does not matter
@@ -2783,6 +3550,14 @@ clipOutPath(const Path &path, const CustomFillRuleBase &fill_rule)
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
+  if (d->m_recording)
+    {
+      d->m_recording->add_clip_path(detail::PainterCommandListPrivate::clip_out_path_command,
+                                    d->m_clip_rect_state.item_matrix(), d->m_current_z,
+                                    path, fill_rule);
+      return;
+    }
+
   if (d->m_clip_rect_state.m_all_content_culled)
     {
       /* everything is clipped anyways, adding more clipping does not matter
@@ -2817,6 +3592,14 @@ clipInPath(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
+  if (d->m_recording)
+    {
+      d->m_recording->add_clip_path(detail::PainterCommandListPrivate::clip_in_path_command,
+                                    d->m_clip_rect_state.item_matrix(), d->m_current_z,
+                                    path, fill_rule);
+      return;
+    }
+
   if (d->m_clip_rect_state.m_all_content_culled)
     {
       /* everything is clipped anyways, adding more clipping does not matter
@@ -2838,6 +3621,14 @@ clipInPath(const Path &path, const CustomFillRuleBase &fill_rule)
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
+  if (d->m_recording)
+    {
+      d->m_recording->add_clip_path(detail::PainterCommandListPrivate::clip_in_path_command,
+                                    d->m_clip_rect_state.item_matrix(), d->m_current_z,
+                                    path, fill_rule);
+      return;
+    }
+
   if (d->m_clip_rect_state.m_all_content_culled)
     {
       /* everything is clipped anyways, adding more clipping does not matter
@@ -2852,6 +3643,32 @@ clipInPath(const Path &path, const CustomFillRuleBase &fill_rule)
   clipOutPath(path, ComplementFillRule(&fill_rule));
 }
 
+void
+fastuidraw::Painter::
+clipInPath(const PathBoolean &region)
+{
+  if (region.complement())
+    {
+      /* the region is the complement of the fill of
+       * region.path(), i.e. clip-out by region.path();
+       * if region.path() is empty, the region is the
+       * entire plane and there is nothing to clip.
+       */
+      if (region.path().number_contours() > 0)
+        {
+          clipOutPath(region.path(), PainterEnums::nonzero_fill_rule);
+        }
+    }
+  else if (region.empty())
+    {
+      clipInRect(vec2(0.0f, 0.0f), vec2(0.0f, 0.0f));
+    }
+  else
+    {
+      clipInPath(region.path(), PainterEnums::nonzero_fill_rule);
+    }
+}
+
 void
 fastuidraw::Painter::
 clipInRect(const vec2 &pmin, const vec2 &wh)
@@ -2859,6 +3676,13 @@ clipInRect(const vec2 &pmin, const vec2 &wh)
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
+  if (d->m_recording)
+    {
+      d->m_recording->add_clip_in_rect(d->m_clip_rect_state.item_matrix(),
+                                       d->m_current_z, pmin, wh);
+      return;
+    }
+
   vec2 pmax(pmin + wh);
 
   d->m_clip_rect_state.m_all_content_culled =
@@ -229,6 +229,10 @@ sub_image(const reference_counted_ptr<const Image> &im,
   m_data.m_shader_raw &= ~image_type_mask;
   m_data.m_shader_raw |= pack_bits(image_type_bit0, image_type_num_bits, type_bits);
 
+  m_data.m_shader_raw = apply_bit_flag(m_data.m_shader_raw,
+                                       im && im->format() == Image::premultiplied_rgba_format,
+                                       image_format_mask);
+
   m_data.m_shader_raw &= ~image_mipmap_mask;
   m_data.m_shader_raw |= pack_bits(image_mipmap_bit0, image_mipmap_num_bits, mip_bits);
 
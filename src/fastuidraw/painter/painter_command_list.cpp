@@ -0,0 +1,414 @@
+/*!
+ * \file painter_command_list.cpp
+ * \brief file painter_command_list.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <algorithm>
+#include <fastuidraw/tessellated_path.hpp>
+#include <fastuidraw/painter/filled_path.hpp>
+#include <fastuidraw/painter/painter_command_list.hpp>
+#include "../private/util_private.hpp"
+#include "private/painter_command_list_private.hpp"
+
+/////////////////////////////////////////////////
+// fastuidraw::detail::PainterCommandListPrivate::recorded_fill_rule methods
+bool
+fastuidraw::detail::PainterCommandListPrivate::recorded_fill_rule::
+operator()(int winding_number) const
+{
+  return std::binary_search(m_windings.begin(), m_windings.end(), winding_number);
+}
+
+/////////////////////////////////////////////////
+// fastuidraw::detail::PainterCommandListPrivate methods
+fastuidraw::detail::PainterCommandListPrivate::
+PainterCommandListPrivate(void):
+  m_recording(false),
+  m_z_advance_end(0),
+  m_last_matrix_valid(false),
+  m_last_z(0)
+{}
+
+bool
+fastuidraw::detail::PainterCommandListPrivate::
+same_matrix(const float3x3 &a, const float3x3 &b)
+{
+  for (unsigned int i = 0; i < 9; ++i)
+    {
+      if (a.c_ptr()[i] != b.c_ptr()[i])
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+fastuidraw::detail::PainterCommandListPrivate::
+clear(void)
+{
+  FASTUIDRAWassert(!m_recording);
+  m_commands.clear();
+  m_draws.clear();
+  m_clips.clear();
+  m_actions.clear();
+  m_matrices.clear();
+  m_z_advance_end = 0;
+  m_attributes.clear();
+  m_indices.clear();
+  m_attribute_ranges.clear();
+  m_index_ranges.clear();
+  m_attribute_chunks.clear();
+  m_index_chunks.clear();
+  m_index_adjusts.clear();
+  m_attribute_chunk_selectors.clear();
+}
+
+void
+fastuidraw::detail::PainterCommandListPrivate::
+begin_recording(const float3x3 &base_matrix, int z)
+{
+  FASTUIDRAWassert(!m_recording);
+
+  clear();
+  m_recording = true;
+  base_matrix.inverse(m_inverse_base_matrix);
+  m_last_matrix_valid = false;
+  m_last_z = z;
+}
+
+void
+fastuidraw::detail::PainterCommandListPrivate::
+end_recording(int z)
+{
+  FASTUIDRAWassert(m_recording);
+
+  m_recording = false;
+  m_z_advance_end = z - m_last_z;
+
+  /* the chunks are only realized once the recording ends
+   * because m_attributes and m_indices are resized as
+   * draws are added.
+   */
+  m_attribute_chunks.resize(m_attribute_ranges.size());
+  for (unsigned int i = 0; i < m_attribute_ranges.size(); ++i)
+    {
+      m_attribute_chunks[i] = make_c_array(m_attributes).sub_array(m_attribute_ranges[i]);
+    }
+
+  m_index_chunks.resize(m_index_ranges.size());
+  for (unsigned int i = 0; i < m_index_ranges.size(); ++i)
+    {
+      m_index_chunks[i] = make_c_array(m_indices).sub_array(m_index_ranges[i]);
+    }
+}
+
+unsigned int
+fastuidraw::detail::PainterCommandListPrivate::
+matrix_index(const float3x3 &matrix)
+{
+  /* typically many draws in a row have the same matrix,
+   * so only compare against the last matrix added.
+   */
+  if (!m_last_matrix_valid || !same_matrix(matrix, m_last_matrix))
+    {
+      m_last_matrix = matrix;
+      m_last_matrix_valid = true;
+      m_matrices.push_back(m_inverse_base_matrix * matrix);
+    }
+  return m_matrices.size() - 1;
+}
+
+void
+fastuidraw::detail::PainterCommandListPrivate::
+add_command(enum command_t tp, unsigned int idx, int z)
+{
+  command C;
+
+  FASTUIDRAWassert(m_recording);
+  C.m_type = tp;
+  C.m_index = idx;
+  C.m_z_advance = z - m_last_z;
+  m_last_z = z;
+  m_commands.push_back(C);
+}
+
+fastuidraw::detail::PainterCommandListPrivate::draw_entry&
+fastuidraw::detail::PainterCommandListPrivate::
+add_draw_entry(const reference_counted_ptr<PainterItemShader> &shader,
+               const PainterData &data,
+               const reference_counted_ptr<PainterBlendShader> &blend_shader,
+               BlendMode::packed_value blend_mode,
+               const float3x3 &matrix, int draw_z, int z,
+               const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  add_command(draw_command, m_draws.size(), z);
+  m_draws.push_back(draw_entry());
+
+  draw_entry &D(m_draws.back());
+  D.m_shader = shader;
+  D.m_blend_shader = blend_shader;
+  D.m_blend_mode = blend_mode;
+  D.m_call_back = call_back;
+  D.m_data = data;
+  D.m_matrix = matrix_index(matrix);
+  D.m_z_offset = draw_z - z;
+  D.m_attribute_chunks.m_begin = D.m_attribute_chunks.m_end = m_attribute_ranges.size();
+  D.m_index_chunks.m_begin = D.m_index_chunks.m_end = m_index_ranges.size();
+  D.m_selectors.m_begin = D.m_selectors.m_end = m_attribute_chunk_selectors.size();
+
+  return D;
+}
+
+void
+fastuidraw::detail::PainterCommandListPrivate::
+add_draw(const reference_counted_ptr<PainterItemShader> &shader,
+         const PainterData &data,
+         const reference_counted_ptr<PainterBlendShader> &blend_shader,
+         BlendMode::packed_value blend_mode,
+         const float3x3 &matrix, int draw_z, int z,
+         c_array<const c_array<const PainterAttribute> > attrib_chunks,
+         c_array<const c_array<const PainterIndex> > index_chunks,
+         c_array<const int> index_adjusts,
+         c_array<const unsigned int> attrib_chunk_selector,
+         const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  draw_entry &D(add_draw_entry(shader, data, blend_shader, blend_mode,
+                               matrix, draw_z, z, call_back));
+
+  for (c_array<const PainterAttribute> src : attrib_chunks)
+    {
+      range_type<unsigned int> R(m_attributes.size(), m_attributes.size() + src.size());
+
+      m_attributes.resize(R.m_end);
+      std::copy(src.begin(), src.end(), m_attributes.begin() + R.m_begin);
+      m_attribute_ranges.push_back(R);
+    }
+  D.m_attribute_chunks.m_end = m_attribute_ranges.size();
+
+  for (c_array<const PainterIndex> src : index_chunks)
+    {
+      range_type<unsigned int> R(m_indices.size(), m_indices.size() + src.size());
+
+      m_indices.resize(R.m_end);
+      std::copy(src.begin(), src.end(), m_indices.begin() + R.m_begin);
+      m_index_ranges.push_back(R);
+    }
+  D.m_index_chunks.m_end = m_index_ranges.size();
+
+  m_index_adjusts.insert(m_index_adjusts.end(), index_adjusts.begin(), index_adjusts.end());
+  m_attribute_chunk_selectors.insert(m_attribute_chunk_selectors.end(),
+                                     attrib_chunk_selector.begin(),
+                                     attrib_chunk_selector.end());
+  D.m_selectors.m_end = m_attribute_chunk_selectors.size();
+}
+
+void
+fastuidraw::detail::PainterCommandListPrivate::
+add_draw(const reference_counted_ptr<PainterItemShader> &shader,
+         const PainterData &data,
+         const reference_counted_ptr<PainterBlendShader> &blend_shader,
+         BlendMode::packed_value blend_mode,
+         const float3x3 &matrix, int draw_z, int z,
+         const PainterPacker::DataWriter &src,
+         const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  draw_entry &D(add_draw_entry(shader, data, blend_shader, blend_mode,
+                               matrix, draw_z, z, call_back));
+
+  for (unsigned int c = 0, endc = src.number_attribute_chunks(); c < endc; ++c)
+    {
+      range_type<unsigned int> R(m_attributes.size(), m_attributes.size() + src.number_attributes(c));
+
+      m_attributes.resize(R.m_end);
+      src.write_attributes(make_c_array(m_attributes).sub_array(R), c);
+      m_attribute_ranges.push_back(R);
+    }
+  D.m_attribute_chunks.m_end = m_attribute_ranges.size();
+
+  /* the indices are written with an offset of 0, this makes
+   * them relative to the start of the attribute chunk which
+   * is exactly what PainterPacker expects of index chunks.
+   */
+  for (unsigned int c = 0, endc = src.number_index_chunks(); c < endc; ++c)
+    {
+      range_type<unsigned int> R(m_indices.size(), m_indices.size() + src.number_indices(c));
+
+      m_indices.resize(R.m_end);
+      src.write_indices(make_c_array(m_indices).sub_array(R), 0, c);
+      m_index_ranges.push_back(R);
+      m_index_adjusts.push_back(0);
+      m_attribute_chunk_selectors.push_back(src.attribute_chunk_selection(c));
+    }
+  D.m_index_chunks.m_end = m_index_ranges.size();
+  D.m_selectors.m_end = m_attribute_chunk_selectors.size();
+}
+
+void
+fastuidraw::detail::PainterCommandListPrivate::
+add_action(const reference_counted_ptr<const PainterDraw::Action> &action, int z)
+{
+  add_command(action_command, m_actions.size(), z);
+  m_actions.push_back(action);
+}
+
+void
+fastuidraw::detail::PainterCommandListPrivate::
+add_save(int z)
+{
+  add_command(save_command, 0, z);
+}
+
+void
+fastuidraw::detail::PainterCommandListPrivate::
+add_restore(int z)
+{
+  add_command(restore_command, 0, z);
+}
+
+void
+fastuidraw::detail::PainterCommandListPrivate::
+add_clip_in_rect(const float3x3 &matrix, int z,
+                 const vec2 &pmin, const vec2 &wh)
+{
+  add_command(clip_in_rect_command, m_clips.size(), z);
+  m_clips.push_back(clip_entry());
+
+  clip_entry &C(m_clips.back());
+  C.m_matrix = matrix_index(matrix);
+  C.m_min = pmin;
+  C.m_wh = wh;
+  C.m_custom_fill_rule = false;
+}
+
+void
+fastuidraw::detail::PainterCommandListPrivate::
+add_clip_path(enum command_t tp, const float3x3 &matrix, int z,
+              const Path &path, enum PainterEnums::fill_rule_t fill_rule)
+{
+  FASTUIDRAWassert(tp == clip_out_path_command || tp == clip_in_path_command);
+  add_command(tp, m_clips.size(), z);
+  m_clips.push_back(clip_entry());
+
+  clip_entry &C(m_clips.back());
+  C.m_matrix = matrix_index(matrix);
+  C.m_path = path;
+  C.m_fill_rule = fill_rule;
+  C.m_custom_fill_rule = false;
+}
+
+void
+fastuidraw::detail::PainterCommandListPrivate::
+add_clip_path(enum command_t tp, const float3x3 &matrix, int z,
+              const Path &path, const CustomFillRuleBase &fill_rule)
+{
+  FASTUIDRAWassert(tp == clip_out_path_command || tp == clip_in_path_command);
+  add_command(tp, m_clips.size(), z);
+  m_clips.push_back(clip_entry());
+
+  clip_entry &C(m_clips.back());
+  C.m_matrix = matrix_index(matrix);
+  C.m_path = path;
+  C.m_fill_rule = PainterEnums::nonzero_fill_rule;
+  C.m_custom_fill_rule = true;
+
+  /* the custom fill rule object is not owned by us, so we
+   * save its value on each winding number the path has;
+   * the root subset of the FilledPath lists them all.
+   */
+  c_array<const int> windings;
+  windings = path.tessellation()->filled()->subset(0).winding_numbers();
+  for (int w : windings)
+    {
+      if (fill_rule(w))
+        {
+          C.m_accepted_windings.push_back(w);
+        }
+    }
+  std::sort(C.m_accepted_windings.begin(), C.m_accepted_windings.end());
+}
+
+/////////////////////////////////////////
+// fastuidraw::PainterCommandList methods
+fastuidraw::PainterCommandList::
+PainterCommandList(void)
+{
+  m_d = FASTUIDRAWnew detail::PainterCommandListPrivate();
+}
+
+fastuidraw::PainterCommandList::
+~PainterCommandList()
+{
+  detail::PainterCommandListPrivate *d;
+  d = static_cast<detail::PainterCommandListPrivate*>(m_d);
+  FASTUIDRAWassert(!d->m_recording);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+void
+fastuidraw::PainterCommandList::
+clear(void)
+{
+  detail::PainterCommandListPrivate *d;
+  d = static_cast<detail::PainterCommandListPrivate*>(m_d);
+  d->clear();
+}
+
+bool
+fastuidraw::PainterCommandList::
+empty(void) const
+{
+  detail::PainterCommandListPrivate *d;
+  d = static_cast<detail::PainterCommandListPrivate*>(m_d);
+  return d->m_commands.empty();
+}
+
+bool
+fastuidraw::PainterCommandList::
+recording(void) const
+{
+  detail::PainterCommandListPrivate *d;
+  d = static_cast<detail::PainterCommandListPrivate*>(m_d);
+  return d->m_recording;
+}
+
+unsigned int
+fastuidraw::PainterCommandList::
+number_draws(void) const
+{
+  detail::PainterCommandListPrivate *d;
+  d = static_cast<detail::PainterCommandListPrivate*>(m_d);
+  return d->m_draws.size();
+}
+
+unsigned int
+fastuidraw::PainterCommandList::
+number_attributes(void) const
+{
+  detail::PainterCommandListPrivate *d;
+  d = static_cast<detail::PainterCommandListPrivate*>(m_d);
+  return d->m_attributes.size();
+}
+
+unsigned int
+fastuidraw::PainterCommandList::
+number_indices(void) const
+{
+  detail::PainterCommandListPrivate *d;
+  d = static_cast<detail::PainterCommandListPrivate*>(m_d);
+  return d->m_indices.size();
+}
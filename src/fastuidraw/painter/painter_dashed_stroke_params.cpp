@@ -55,6 +55,246 @@ namespace
     std::vector<fastuidraw::PainterDashedStrokeParams::DashPatternElement> m_dash_pattern;
     std::vector<fastuidraw::generic_data> m_dash_pattern_packed;
   };
+
+  /* Describes the shape of the search tree in which the interval
+   * end points are packed; the tree is a complete (A + 1)-ary tree
+   * of blocks where A is the alignment whose leaves hold the interval
+   * end points and whose non-leaf nodes hold the largest value of
+   * each of the first A children of the node. Only the leaves that
+   * hold values are present, i.e. the last level is not complete.
+   */
+  class DashPatternTree
+  {
+  public:
+    DashPatternTree(unsigned int number_intervals, unsigned int alignment);
+
+    unsigned int
+    number_blocks(void) const
+    {
+      return m_leaf_offset + m_number_leaves;
+    }
+
+    void
+    pack(const std::vector<fastuidraw::generic_data> &intervals,
+         float pad_value,
+         fastuidraw::c_array<fastuidraw::generic_data> dst) const;
+
+  private:
+    unsigned int m_alignment;
+    unsigned int m_number_leaves;
+
+    /* the number of levels above the leaves */
+    unsigned int m_depth;
+
+    /* the block of the first leaf, which is also
+     * the number of non-leaf nodes.
+     */
+    unsigned int m_leaf_offset;
+  };
+
+  class DashedStrokingDataSelector:public fastuidraw::StrokingDataSelectorBase
+  {
+  public:
+    DashedStrokingDataSelector(void):
+      m_base(fastuidraw::PainterStrokeParams::stroking_data_selector())
+    {}
+
+    virtual
+    float
+    compute_thresh(const fastuidraw::PainterShaderData::DataBase *data,
+                   float path_magnification,
+                   float curve_flatness) const
+    {
+      return m_base->compute_thresh(data, path_magnification, curve_flatness);
+    }
+
+    virtual
+    void
+    stroking_distances(const fastuidraw::PainterShaderData::DataBase *data,
+                       float *out_pixel_distance,
+                       float *out_item_space_distance) const
+    {
+      m_base->stroking_distances(data, out_pixel_distance, out_item_space_distance);
+    }
+
+    virtual
+    bool
+    has_distance_culling(const fastuidraw::PainterShaderData::DataBase *data,
+                         float one_pixel_distance) const;
+
+    virtual
+    bool
+    distance_range_culled(const fastuidraw::PainterShaderData::DataBase *data,
+                          float one_pixel_distance,
+                          fastuidraw::range_type<float> distances) const;
+
+  private:
+    static
+    float
+    cull_margin(const PainterDashedStrokeParamsData *d, float one_pixel_distance);
+
+    /* PainterDashedStrokeParamsData begins with the same fields
+     * as the data of PainterStrokeParams, so the computations
+     * for LOD and culling against clip-equations are the same.
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::StrokingDataSelectorBase> m_base;
+  };
+}
+
+/////////////////////////////////
+// DashPatternTree methods
+DashPatternTree::
+DashPatternTree(unsigned int number_intervals, unsigned int alignment):
+  m_alignment(alignment),
+  m_number_leaves((number_intervals + alignment - 1) / alignment),
+  m_depth(0),
+  m_leaf_offset(0)
+{
+  /* find the smallest depth so that (A + 1)^depth
+   * is atleast the number of leaves, the nodes
+   * at each level above the leaves come first.
+   */
+  for(unsigned int level_size = 1; level_size < m_number_leaves; level_size *= (m_alignment + 1))
+    {
+      m_leaf_offset += level_size;
+      ++m_depth;
+    }
+}
+
+void
+DashPatternTree::
+pack(const std::vector<fastuidraw::generic_data> &intervals,
+     float pad_value,
+     fastuidraw::c_array<fastuidraw::generic_data> dst) const
+{
+  unsigned int level_begin(0), level_size(1), leaves_per_child(1);
+
+  FASTUIDRAWassert(dst.size() >= number_blocks() * m_alignment);
+  for(unsigned int i = 0; i < m_depth; ++i)
+    {
+      leaves_per_child *= (m_alignment + 1);
+    }
+
+  /* non-leaf nodes: entry c of a node is the last value
+   * of the last leaf under child c of the node.
+   */
+  for(unsigned int level = 0; level < m_depth; ++level)
+    {
+      leaves_per_child /= (m_alignment + 1);
+      for(unsigned int p = 0; p < level_size; ++p)
+        {
+          for(unsigned int c = 0; c < m_alignment; ++c)
+            {
+              unsigned int last_leaf_end, src;
+
+              last_leaf_end = (p * (m_alignment + 1) + c + 1) * leaves_per_child;
+              src = last_leaf_end * m_alignment - 1;
+              dst[(level_begin + p) * m_alignment + c].f = (src < intervals.size()) ?
+                intervals[src].f :
+                pad_value;
+            }
+        }
+      level_begin += level_size;
+      level_size *= (m_alignment + 1);
+    }
+
+  FASTUIDRAWassert(level_begin == m_leaf_offset);
+  for(unsigned int i = 0, endi = m_number_leaves * m_alignment; i < endi; ++i)
+    {
+      dst[m_leaf_offset * m_alignment + i].f = (i < intervals.size()) ?
+        intervals[i].f :
+        pad_value;
+    }
+}
+
+/////////////////////////////////////////
+// DashedStrokingDataSelector methods
+float
+DashedStrokingDataSelector::
+cull_margin(const PainterDashedStrokeParamsData *d, float one_pixel_distance)
+{
+  /* The caps of the dashes extend by the stroking radius
+   * along the path, and anti-aliasing extends by a pixel.
+   * When stroking in pixel units, the stroking radius is
+   * in pixels.
+   */
+  float r(d->m_radius);
+
+  if (d->m_stroking_units == fastuidraw::PainterStrokeParams::pixel_stroking_units)
+    {
+      r *= fastuidraw::t_max(1.0f, one_pixel_distance);
+    }
+  return r + one_pixel_distance;
+}
+
+bool
+DashedStrokingDataSelector::
+has_distance_culling(const fastuidraw::PainterShaderData::DataBase *data,
+                     float one_pixel_distance) const
+{
+  const PainterDashedStrokeParamsData *d;
+  float margin;
+
+  d = static_cast<const PainterDashedStrokeParamsData*>(data);
+  margin = cull_margin(d, one_pixel_distance);
+  for(const auto &e : d->m_dash_pattern)
+    {
+      if (e.m_space_length > 2.0f * margin)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+bool
+DashedStrokingDataSelector::
+distance_range_culled(const fastuidraw::PainterShaderData::DataBase *data,
+                      float one_pixel_distance,
+                      fastuidraw::range_type<float> distances) const
+{
+  const PainterDashedStrokeParamsData *d;
+  float margin, b, e, f;
+
+  d = static_cast<const PainterDashedStrokeParamsData*>(data);
+  if (d->m_dash_pattern_packed.empty() || !(d->m_total_length > 0.0f))
+    {
+      return false;
+    }
+
+  margin = cull_margin(d, one_pixel_distance);
+  b = distances.m_begin + d->m_dash_offset - margin;
+  e = distances.m_end + d->m_dash_offset + margin;
+  if (!(e - b < d->m_total_length))
+    {
+      return false;
+    }
+
+  f = d->m_total_length * std::floor(b / d->m_total_length);
+  b -= f;
+  e -= f;
+
+  /* find the first interval end point greater than b,
+   * if it is the end of a skip interval (i.e. odd index)
+   * and is greater than e, then the entire range is
+   * within that skip interval.
+   */
+  std::vector<fastuidraw::generic_data>::const_iterator iter;
+  unsigned int k;
+
+  iter = std::upper_bound(d->m_dash_pattern_packed.begin(),
+                          d->m_dash_pattern_packed.end(), b,
+                          [](float v, const fastuidraw::generic_data &g)
+                          {
+                            return v < g.f;
+                          });
+  if (iter == d->m_dash_pattern_packed.end())
+    {
+      return false;
+    }
+
+  k = iter - d->m_dash_pattern_packed.begin();
+  return (k & 1u) != 0u && e < iter->f;
 }
 
 //////////////////////////////////////
@@ -83,7 +323,7 @@ data_size(unsigned int alignment) const
 {
   using namespace fastuidraw;
   return round_up_to_multiple(PainterDashedStrokeParams::stroke_static_data_size, alignment)
-    + round_up_to_multiple(2 * m_dash_pattern.size(), alignment);
+    + DashPatternTree(m_dash_pattern_packed.size(), alignment).number_blocks() * alignment;
 }
 
 void
@@ -111,13 +351,13 @@ pack_data(unsigned int alignment, fastuidraw::c_array<fastuidraw::generic_data>
     {
       c_array<generic_data> dst_pattern;
       dst_pattern = dst.sub_array(round_up_to_multiple(PainterDashedStrokeParams::stroke_static_data_size, alignment));
-      std::copy(m_dash_pattern_packed.begin(), m_dash_pattern_packed.end(), dst_pattern.begin());
-      for(unsigned int i = m_dash_pattern_packed.size(), endi = dst_pattern.size(); i < endi; ++i)
-        {
-          //make the last entry larger than the total length so a
-          //shader can use that to know when it has reached the end.
-          dst_pattern[i].f = m_total_length * 2.0f + 1.0f;
-        }
+
+      /* pad with a value larger than the total length so that a
+       * shader never selects a padding entry.
+       */
+      DashPatternTree(m_dash_pattern_packed.size(), alignment).pack(m_dash_pattern_packed,
+                                                                    m_total_length * 2.0f + 1.0f,
+                                                                    dst_pattern);
     }
 }
 
@@ -344,5 +584,5 @@ fastuidraw::reference_counted_ptr<const fastuidraw::StrokingDataSelectorBase>
 fastuidraw::PainterDashedStrokeParams::
 stroking_data_selector(void)
 {
-  return PainterStrokeParams::stroking_data_selector();
+  return FASTUIDRAWnew DashedStrokingDataSelector();
 }
@@ -27,6 +27,12 @@ namespace
   public:
     fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> m_item_shader;
     fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> m_aa_fuzz_shader;
+    fastuidraw::vecN<fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader>,
+                     fastuidraw::PainterEnums::fill_rule_data_count> m_aa_analytic_shaders;
+    fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> m_stencil_action;
+    fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> m_end_cover_action;
+    fastuidraw::vecN<fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action>,
+                     fastuidraw::PainterEnums::fill_rule_data_count> m_cover_actions;
   };
 }
 
@@ -60,3 +66,73 @@ setget_implement(fastuidraw::PainterFillShader, PainterFillShaderPrivate,
                  const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader>&, item_shader)
 setget_implement(fastuidraw::PainterFillShader, PainterFillShaderPrivate,
                  const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader>&, aa_fuzz_shader)
+setget_implement(fastuidraw::PainterFillShader, PainterFillShaderPrivate,
+                 const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action>&, stencil_action)
+setget_implement(fastuidraw::PainterFillShader, PainterFillShaderPrivate,
+                 const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action>&, end_cover_action)
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action>&
+fastuidraw::PainterFillShader::
+cover_action(enum PainterEnums::fill_rule_t fill_rule) const
+{
+  PainterFillShaderPrivate *d;
+  d = static_cast<PainterFillShaderPrivate*>(m_d);
+  FASTUIDRAWassert(fill_rule < PainterEnums::fill_rule_data_count);
+  return d->m_cover_actions[fill_rule];
+}
+
+fastuidraw::PainterFillShader&
+fastuidraw::PainterFillShader::
+cover_action(enum PainterEnums::fill_rule_t fill_rule,
+             const reference_counted_ptr<const PainterDraw::Action> &a)
+{
+  PainterFillShaderPrivate *d;
+  d = static_cast<PainterFillShaderPrivate*>(m_d);
+  FASTUIDRAWassert(fill_rule < PainterEnums::fill_rule_data_count);
+  d->m_cover_actions[fill_rule] = a;
+  return *this;
+}
+
+const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader>&
+fastuidraw::PainterFillShader::
+aa_analytic_shader(enum PainterEnums::fill_rule_t fill_rule) const
+{
+  PainterFillShaderPrivate *d;
+  d = static_cast<PainterFillShaderPrivate*>(m_d);
+  FASTUIDRAWassert(fill_rule < PainterEnums::fill_rule_data_count);
+  return d->m_aa_analytic_shaders[fill_rule];
+}
+
+fastuidraw::PainterFillShader&
+fastuidraw::PainterFillShader::
+aa_analytic_shader(enum PainterEnums::fill_rule_t fill_rule,
+                   const reference_counted_ptr<PainterItemShader> &sh)
+{
+  PainterFillShaderPrivate *d;
+  d = static_cast<PainterFillShaderPrivate*>(m_d);
+  FASTUIDRAWassert(fill_rule < PainterEnums::fill_rule_data_count);
+  d->m_aa_analytic_shaders[fill_rule] = sh;
+  return *this;
+}
+
+bool
+fastuidraw::PainterFillShader::
+supports_stencil_cover(void) const
+{
+  PainterFillShaderPrivate *d;
+  d = static_cast<PainterFillShaderPrivate*>(m_d);
+
+  if (!d->m_stencil_action || !d->m_end_cover_action)
+    {
+      return false;
+    }
+
+  for (const auto &a : d->m_cover_actions)
+    {
+      if (!a)
+        {
+          return false;
+        }
+    }
+  return true;
+}
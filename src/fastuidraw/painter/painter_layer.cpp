@@ -0,0 +1,83 @@
+/*!
+ * \file painter_layer.cpp
+ * \brief file painter_layer.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <fastuidraw/painter/painter_layer.hpp>
+#include "private/painter_layer_private.hpp"
+
+////////////////////////////////////
+// fastuidraw::PainterLayer methods
+fastuidraw::PainterLayer::
+PainterLayer(const reference_counted_ptr<PainterBackend::Surface> &surface)
+{
+  FASTUIDRAWassert(surface);
+  m_d = FASTUIDRAWnew detail::PainterLayerPrivate(surface);
+}
+
+fastuidraw::PainterLayer::
+~PainterLayer()
+{
+  detail::PainterLayerPrivate *d;
+  d = static_cast<detail::PainterLayerPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+const fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend::Surface>&
+fastuidraw::PainterLayer::
+surface(void) const
+{
+  detail::PainterLayerPrivate *d;
+  d = static_cast<detail::PainterLayerPrivate*>(m_d);
+  return d->m_surface;
+}
+
+fastuidraw::ivec2
+fastuidraw::PainterLayer::
+dimensions(void) const
+{
+  detail::PainterLayerPrivate *d;
+  d = static_cast<detail::PainterLayerPrivate*>(m_d);
+  return d->m_surface->viewport().m_dimensions;
+}
+
+bool
+fastuidraw::PainterLayer::
+valid(void) const
+{
+  detail::PainterLayerPrivate *d;
+  d = static_cast<detail::PainterLayerPrivate*>(m_d);
+  return d->m_image;
+}
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::Image>&
+fastuidraw::PainterLayer::
+image(void) const
+{
+  detail::PainterLayerPrivate *d;
+  d = static_cast<detail::PainterLayerPrivate*>(m_d);
+  return d->m_image;
+}
+
+void
+fastuidraw::PainterLayer::
+invalidate(void)
+{
+  detail::PainterLayerPrivate *d;
+  d = static_cast<detail::PainterLayerPrivate*>(m_d);
+  d->m_image.clear();
+}
@@ -0,0 +1,661 @@
+/*!
+ * \file path_boolean.cpp
+ * \brief file path_boolean.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <algorithm>
+#include <fastuidraw/tessellated_path.hpp>
+#include <fastuidraw/painter/path_boolean.hpp>
+#include "../private/util_private.hpp"
+#include "../../3rd_party/glu-tess/glu-tess.hpp"
+
+namespace
+{
+  typedef std::vector<fastuidraw::dvec2> Loop;
+  typedef std::vector<Loop> Loops;
+
+  /* A region is stored as a set of closed polygons whose
+   * winding number is 0 or 1 everywhere, i.e. each region
+   * is the union of disjoint faces with outer boundaries
+   * running counter-clockwise and holes clockwise. If
+   * m_complement is true, the region is the complement
+   * of the faces.
+   */
+  class Region
+  {
+  public:
+    Region(void):
+      m_complement(false)
+    {}
+
+    Loops m_loops;
+    bool m_complement;
+  };
+
+  class ComplementFillRule:public fastuidraw::CustomFillRuleBase
+  {
+  public:
+    explicit
+    ComplementFillRule(const fastuidraw::CustomFillRuleBase *p):
+      m_p(p)
+    {
+      FASTUIDRAWassert(m_p);
+    }
+
+    bool
+    operator()(int w) const
+    {
+      return !m_p->operator()(w);
+    }
+
+  private:
+    const fastuidraw::CustomFillRuleBase *m_p;
+  };
+
+  /* Fill rules used to combine two regions whose
+   * winding numbers are each 0 or 1.
+   */
+  class AtLeastFillRule:public fastuidraw::CustomFillRuleBase
+  {
+  public:
+    explicit
+    AtLeastFillRule(int v):
+      m_v(v)
+    {}
+
+    bool
+    operator()(int w) const
+    {
+      return w >= m_v;
+    }
+
+  private:
+    int m_v;
+  };
+
+  class OddFillRule:public fastuidraw::CustomFillRuleBase
+  {
+  public:
+    bool
+    operator()(int w) const
+    {
+      return (w & 1) != 0;
+    }
+  };
+
+  /* Feeds loops to the GLU tessellator and collects the
+   * boundaries of the faces whose winding number passes
+   * a fill rule as loops with winding number 1.
+   */
+  class BoundaryExtractor:fastuidraw::noncopyable
+  {
+  public:
+    explicit
+    BoundaryExtractor(const fastuidraw::CustomFillRuleBase &fill_rule);
+
+    ~BoundaryExtractor();
+
+    void
+    add_loops(const Loops &loops, bool reverse);
+
+    void
+    extract(Loops *out);
+
+  private:
+    static
+    void
+    begin_callBack(FASTUIDRAW_GLUenum type, int winding_number, void *tess);
+
+    static
+    void
+    vertex_callBack(unsigned int vertex_id, void *tess);
+
+    static
+    void
+    combine_callback(double x, double y, unsigned int data[4],
+                     double weight[4],  unsigned int *outData,
+                     void *tess);
+
+    static
+    FASTUIDRAW_GLUboolean
+    winding_callBack(int winding_number, void *tess);
+
+    static
+    void
+    emitboundary_callback(int winding, const unsigned int vertex_ids[],
+                          unsigned int count, void *tess);
+
+    const fastuidraw::CustomFillRuleBase &m_fill_rule;
+    fastuidraw_GLUtesselator *m_tess;
+    std::vector<fastuidraw::dvec2> m_points;
+    Loops *m_out;
+  };
+
+  class PathBooleanPrivate
+  {
+  public:
+    explicit
+    PathBooleanPrivate(float max_distance):
+      m_max_distance(max_distance),
+      m_path_ready(false)
+    {
+      m_region.m_complement = true;
+    }
+
+    void
+    fetch_region(const fastuidraw::Path &path,
+                 const fastuidraw::CustomFillRuleBase &fill_rule,
+                 Region *out) const;
+
+    void
+    combine(enum fastuidraw::PathBoolean::operation_t op, const Region &b);
+
+    void
+    set_region(Region &R)
+    {
+      std::swap(m_region.m_loops, R.m_loops);
+      m_region.m_complement = R.m_complement;
+      m_path_ready = false;
+    }
+
+    const fastuidraw::Path&
+    path(void);
+
+    float m_max_distance;
+    Region m_region;
+
+    bool m_path_ready;
+    fastuidraw::Path m_path;
+  };
+}
+
+/////////////////////////////////
+// BoundaryExtractor methods
+BoundaryExtractor::
+BoundaryExtractor(const fastuidraw::CustomFillRuleBase &fill_rule):
+  m_fill_rule(fill_rule),
+  m_out(nullptr)
+{
+  m_tess = fastuidraw_gluNewTess;
+  fastuidraw_gluTessCallbackBegin(m_tess, &begin_callBack);
+  fastuidraw_gluTessCallbackVertex(m_tess, &vertex_callBack);
+  fastuidraw_gluTessCallbackCombine(m_tess, &combine_callback);
+  fastuidraw_gluTessCallbackFillRule(m_tess, &winding_callBack);
+  fastuidraw_gluTessCallbackEmitBoundary(m_tess, &emitboundary_callback);
+  fastuidraw_gluTessBeginPolygon(m_tess, this);
+}
+
+BoundaryExtractor::
+~BoundaryExtractor()
+{
+  fastuidraw_gluDeleteTess(m_tess);
+}
+
+void
+BoundaryExtractor::
+add_loops(const Loops &loops, bool reverse)
+{
+  for (const Loop &L : loops)
+    {
+      FASTUIDRAWassert(L.size() >= 3);
+      fastuidraw_gluTessBeginContour(m_tess, FASTUIDRAW_GLU_TRUE);
+      for (unsigned int i = 0, endi = L.size(); i < endi; ++i)
+        {
+          const fastuidraw::dvec2 &p(L[reverse ? endi - 1 - i : i]);
+          fastuidraw_gluTessVertex(m_tess, p.x(), p.y(), m_points.size());
+          m_points.push_back(p);
+        }
+      fastuidraw_gluTessEndContour(m_tess);
+    }
+}
+
+void
+BoundaryExtractor::
+extract(Loops *out)
+{
+  out->clear();
+  m_out = out;
+  fastuidraw_gluTessEndPolygon(m_tess);
+  m_out = nullptr;
+}
+
+void
+BoundaryExtractor::
+begin_callBack(FASTUIDRAW_GLUenum type, int winding_number, void *tess)
+{
+  FASTUIDRAWunused(type);
+  FASTUIDRAWunused(winding_number);
+  FASTUIDRAWunused(tess);
+}
+
+void
+BoundaryExtractor::
+vertex_callBack(unsigned int vertex_id, void *tess)
+{
+  FASTUIDRAWunused(vertex_id);
+  FASTUIDRAWunused(tess);
+}
+
+void
+BoundaryExtractor::
+combine_callback(double x, double y, unsigned int data[4],
+                 double weight[4],  unsigned int *outData,
+                 void *tess)
+{
+  BoundaryExtractor *p;
+
+  FASTUIDRAWunused(data);
+  FASTUIDRAWunused(weight);
+  p = static_cast<BoundaryExtractor*>(tess);
+  *outData = p->m_points.size();
+  p->m_points.push_back(fastuidraw::dvec2(x, y));
+}
+
+FASTUIDRAW_GLUboolean
+BoundaryExtractor::
+winding_callBack(int winding_number, void *tess)
+{
+  BoundaryExtractor *p;
+
+  p = static_cast<BoundaryExtractor*>(tess);
+  return p->m_fill_rule(winding_number) ?
+    FASTUIDRAW_GLU_TRUE :
+    FASTUIDRAW_GLU_FALSE;
+}
+
+void
+BoundaryExtractor::
+emitboundary_callback(int winding, const unsigned int vertex_ids[],
+                      unsigned int count, void *tess)
+{
+  BoundaryExtractor *p;
+
+  p = static_cast<BoundaryExtractor*>(tess);
+  if (count < 3 || !p->m_fill_rule(winding))
+    {
+      return;
+    }
+
+  p->m_out->push_back(Loop());
+  Loop &L(p->m_out->back());
+  L.reserve(count);
+  for (unsigned int i = 0; i < count; ++i)
+    {
+      FASTUIDRAWassert(vertex_ids[i] < p->m_points.size());
+      L.push_back(p->m_points[vertex_ids[i]]);
+    }
+}
+
+////////////////////////////////////
+// simple region operations, i.e. operations on
+// regions that are not complemented
+static
+void
+simple_union(const Loops &a, const Loops &b, Loops *out)
+{
+  AtLeastFillRule fill_rule(1);
+  BoundaryExtractor T(fill_rule);
+
+  T.add_loops(a, false);
+  T.add_loops(b, false);
+  T.extract(out);
+}
+
+static
+void
+simple_intersection(const Loops &a, const Loops &b, Loops *out)
+{
+  AtLeastFillRule fill_rule(2);
+  BoundaryExtractor T(fill_rule);
+
+  if (a.empty() || b.empty())
+    {
+      out->clear();
+      return;
+    }
+
+  T.add_loops(a, false);
+  T.add_loops(b, false);
+  T.extract(out);
+}
+
+static
+void
+simple_difference(const Loops &a, const Loops &b, Loops *out)
+{
+  AtLeastFillRule fill_rule(1);
+  BoundaryExtractor T(fill_rule);
+
+  if (a.empty())
+    {
+      out->clear();
+      return;
+    }
+
+  /* reversing the loops of b makes its winding number
+   * -1 within b, so a point of a inside of b gets winding
+   * number 0.
+   */
+  T.add_loops(a, false);
+  T.add_loops(b, true);
+  T.extract(out);
+}
+
+static
+void
+simple_xor(const Loops &a, const Loops &b, Loops *out)
+{
+  OddFillRule fill_rule;
+  BoundaryExtractor T(fill_rule);
+
+  T.add_loops(a, false);
+  T.add_loops(b, false);
+  T.extract(out);
+}
+
+//////////////////////////////////
+// PathBooleanPrivate methods
+void
+PathBooleanPrivate::
+fetch_region(const fastuidraw::Path &path,
+             const fastuidraw::CustomFillRuleBase &fill_rule,
+             Region *out) const
+{
+  const fastuidraw::TessellatedPath &T(*path.tessellation(m_max_distance));
+  ComplementFillRule complement_fill_rule(&fill_rule);
+  const fastuidraw::CustomFillRuleBase *use_fill_rule(&fill_rule);
+  Loops loops;
+
+  /* the tessellator never fills the unbounded region, so
+   * a fill rule that draws winding number 0 is realized as
+   * the complement of the complement fill rule.
+   */
+  out->m_complement = fill_rule(0);
+  if (out->m_complement)
+    {
+      use_fill_rule = &complement_fill_rule;
+    }
+
+  for (unsigned int c = 0, endc = T.number_contours(); c < endc; ++c)
+    {
+      fastuidraw::c_array<const fastuidraw::vec2> pts;
+      Loop L;
+
+      pts = T.contour_points(c);
+      for (const fastuidraw::vec2 &pt : pts)
+        {
+          fastuidraw::dvec2 p(pt.x(), pt.y());
+          if (L.empty() || p != L.back())
+            {
+              L.push_back(p);
+            }
+        }
+
+      while (L.size() > 1 && L.back() == L.front())
+        {
+          L.pop_back();
+        }
+
+      if (L.size() >= 3)
+        {
+          loops.push_back(Loop());
+          std::swap(loops.back(), L);
+        }
+    }
+
+  if (loops.empty())
+    {
+      out->m_loops.clear();
+      return;
+    }
+
+  BoundaryExtractor B(*use_fill_rule);
+  B.add_loops(loops, false);
+  B.extract(&out->m_loops);
+}
+
+void
+PathBooleanPrivate::
+combine(enum fastuidraw::PathBoolean::operation_t op, const Region &b)
+{
+  const Region &a(m_region);
+  Region R;
+
+  if (op == fastuidraw::PathBoolean::difference_operation)
+    {
+      /* A \ B = A intersect complement(B) */
+      Region nb;
+
+      nb.m_loops = b.m_loops;
+      nb.m_complement = !b.m_complement;
+      combine(fastuidraw::PathBoolean::intersect_operation, nb);
+      return;
+    }
+
+  switch (op)
+    {
+    case fastuidraw::PathBoolean::union_operation:
+      if (!a.m_complement && !b.m_complement)
+        {
+          simple_union(a.m_loops, b.m_loops, &R.m_loops);
+          R.m_complement = false;
+        }
+      else if (a.m_complement && !b.m_complement)
+        {
+          /* ~a U b = ~(a \ b) */
+          simple_difference(a.m_loops, b.m_loops, &R.m_loops);
+          R.m_complement = true;
+        }
+      else if (!a.m_complement && b.m_complement)
+        {
+          /* a U ~b = ~(b \ a) */
+          simple_difference(b.m_loops, a.m_loops, &R.m_loops);
+          R.m_complement = true;
+        }
+      else
+        {
+          /* ~a U ~b = ~(a intersect b) */
+          simple_intersection(a.m_loops, b.m_loops, &R.m_loops);
+          R.m_complement = true;
+        }
+      break;
+
+    case fastuidraw::PathBoolean::intersect_operation:
+      if (!a.m_complement && !b.m_complement)
+        {
+          simple_intersection(a.m_loops, b.m_loops, &R.m_loops);
+          R.m_complement = false;
+        }
+      else if (a.m_complement && !b.m_complement)
+        {
+          /* ~a intersect b = b \ a */
+          simple_difference(b.m_loops, a.m_loops, &R.m_loops);
+          R.m_complement = false;
+        }
+      else if (!a.m_complement && b.m_complement)
+        {
+          /* a intersect ~b = a \ b */
+          simple_difference(a.m_loops, b.m_loops, &R.m_loops);
+          R.m_complement = false;
+        }
+      else
+        {
+          /* ~a intersect ~b = ~(a U b) */
+          simple_union(a.m_loops, b.m_loops, &R.m_loops);
+          R.m_complement = true;
+        }
+      break;
+
+    case fastuidraw::PathBoolean::xor_operation:
+      /* ~a xor b = ~(a xor b) and ~a xor ~b = a xor b */
+      simple_xor(a.m_loops, b.m_loops, &R.m_loops);
+      R.m_complement = (a.m_complement != b.m_complement);
+      break;
+
+    default:
+      FASTUIDRAWassert(!"Invalid PathBoolean::operation_t");
+      return;
+    }
+
+  set_region(R);
+}
+
+const fastuidraw::Path&
+PathBooleanPrivate::
+path(void)
+{
+  if (!m_path_ready)
+    {
+      m_path.clear();
+      for (const Loop &L : m_region.m_loops)
+        {
+          FASTUIDRAWassert(L.size() >= 3);
+          m_path.move(fastuidraw::vec2(L[0].x(), L[0].y()));
+          for (unsigned int i = 1, endi = L.size(); i < endi; ++i)
+            {
+              m_path.line_to(fastuidraw::vec2(L[i].x(), L[i].y()));
+            }
+        }
+
+      if (!m_region.m_loops.empty())
+        {
+          m_path.end_contour();
+        }
+      m_path_ready = true;
+    }
+  return m_path;
+}
+
+//////////////////////////////////////
+// fastuidraw::PathBoolean methods
+fastuidraw::PathBoolean::
+PathBoolean(float max_distance)
+{
+  m_d = FASTUIDRAWnew PathBooleanPrivate(max_distance);
+}
+
+fastuidraw::PathBoolean::
+~PathBoolean()
+{
+  PathBooleanPrivate *d;
+  d = static_cast<PathBooleanPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+fastuidraw::PathBoolean&
+fastuidraw::PathBoolean::
+clear(void)
+{
+  PathBooleanPrivate *d;
+  Region R;
+
+  d = static_cast<PathBooleanPrivate*>(m_d);
+  R.m_complement = true;
+  d->set_region(R);
+  return *this;
+}
+
+fastuidraw::PathBoolean&
+fastuidraw::PathBoolean::
+set(const Path &path, const CustomFillRuleBase &fill_rule)
+{
+  PathBooleanPrivate *d;
+  Region R;
+
+  d = static_cast<PathBooleanPrivate*>(m_d);
+  d->fetch_region(path, fill_rule, &R);
+  d->set_region(R);
+  return *this;
+}
+
+fastuidraw::PathBoolean&
+fastuidraw::PathBoolean::
+set(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
+{
+  return set(path, CustomFillRuleFunction(fill_rule));
+}
+
+fastuidraw::PathBoolean&
+fastuidraw::PathBoolean::
+combine(enum operation_t op, const Path &path,
+        const CustomFillRuleBase &fill_rule)
+{
+  PathBooleanPrivate *d;
+  Region R;
+
+  d = static_cast<PathBooleanPrivate*>(m_d);
+  d->fetch_region(path, fill_rule, &R);
+  d->combine(op, R);
+  return *this;
+}
+
+fastuidraw::PathBoolean&
+fastuidraw::PathBoolean::
+combine(enum operation_t op, const Path &path,
+        enum PainterEnums::fill_rule_t fill_rule)
+{
+  return combine(op, path, CustomFillRuleFunction(fill_rule));
+}
+
+fastuidraw::PathBoolean&
+fastuidraw::PathBoolean::
+combine(enum operation_t op, const PathBoolean &obj)
+{
+  PathBooleanPrivate *d, *obj_d;
+
+  d = static_cast<PathBooleanPrivate*>(m_d);
+  obj_d = static_cast<PathBooleanPrivate*>(obj.m_d);
+  d->combine(op, obj_d->m_region);
+  return *this;
+}
+
+bool
+fastuidraw::PathBoolean::
+complement(void) const
+{
+  PathBooleanPrivate *d;
+  d = static_cast<PathBooleanPrivate*>(m_d);
+  return d->m_region.m_complement;
+}
+
+bool
+fastuidraw::PathBoolean::
+empty(void) const
+{
+  PathBooleanPrivate *d;
+  d = static_cast<PathBooleanPrivate*>(m_d);
+  return !d->m_region.m_complement && d->m_region.m_loops.empty();
+}
+
+const fastuidraw::Path&
+fastuidraw::PathBoolean::
+path(void) const
+{
+  PathBooleanPrivate *d;
+  d = static_cast<PathBooleanPrivate*>(m_d);
+  return d->path();
+}
+
+enum fastuidraw::PainterEnums::fill_rule_t
+fastuidraw::PathBoolean::
+fill_rule(void) const
+{
+  return complement() ?
+    PainterEnums::complement_nonzero_fill_rule :
+    PainterEnums::nonzero_fill_rule;
+}
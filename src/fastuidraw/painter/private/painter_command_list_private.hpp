@@ -0,0 +1,242 @@
+/*!
+ * \file painter_command_list_private.hpp
+ * \brief file painter_command_list_private.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/matrix.hpp>
+#include <fastuidraw/util/blend_mode.hpp>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/painter/fill_rule.hpp>
+#include <fastuidraw/painter/painter_data.hpp>
+#include <fastuidraw/painter/painter_enums.hpp>
+#include <fastuidraw/painter/painter_attribute.hpp>
+#include <fastuidraw/painter/painter_item_shader.hpp>
+#include <fastuidraw/painter/painter_blend_shader.hpp>
+#include <fastuidraw/painter/packing/painter_draw.hpp>
+#include <fastuidraw/painter/packing/painter_packer.hpp>
+
+namespace fastuidraw { namespace detail {
+
+/* Storage behind a PainterCommandList. The commands are stored
+ * in the order recorded; the recording is done by Painter (see
+ * Painter::begin_command_list()) and the replay is done by
+ * Painter::draw_command_list().
+ *
+ * Matrices are stored relative to the transformation of the
+ * Painter when the recording started, z-values are stored
+ * relative to the z-value of the Painter when the command
+ * is issued and each command also stores by how much the
+ * z-value of the Painter advanced since the previous command.
+ */
+class PainterCommandListPrivate:noncopyable
+{
+public:
+  enum command_t
+    {
+      draw_command,
+      action_command,
+      save_command,
+      restore_command,
+      clip_in_rect_command,
+      clip_out_path_command,
+      clip_in_path_command,
+    };
+
+  class command
+  {
+  public:
+    enum command_t m_type;
+
+    /* index into the array holding the data of the
+     * command, which array is determined by m_type.
+     */
+    unsigned int m_index;
+
+    /* amount by which the z-value advanced since
+     * the previous command.
+     */
+    int m_z_advance;
+  };
+
+  class draw_entry
+  {
+  public:
+    reference_counted_ptr<PainterItemShader> m_shader;
+    reference_counted_ptr<PainterBlendShader> m_blend_shader;
+    BlendMode::packed_value m_blend_mode;
+    reference_counted_ptr<PainterPacker::DataCallBack> m_call_back;
+
+    /* the brush, item and blend shader data, all packed */
+    PainterData m_data;
+
+    /* index into m_matrices */
+    unsigned int m_matrix;
+
+    /* z of the draw minus the z of the Painter */
+    int m_z_offset;
+
+    /* ranges into m_attribute_chunks, m_index_chunks and
+     * m_attribute_chunk_selectors; the range of the selector
+     * is empty if the draw did not have a selector.
+     */
+    range_type<unsigned int> m_attribute_chunks;
+    range_type<unsigned int> m_index_chunks;
+    range_type<unsigned int> m_selectors;
+  };
+
+  class clip_entry
+  {
+  public:
+    unsigned int m_matrix;
+    vec2 m_min, m_wh;
+    Path m_path;
+    enum PainterEnums::fill_rule_t m_fill_rule;
+
+    /* if m_custom_fill_rule is true, the fill rule is given by
+     * the sorted list of winding numbers of m_accepted_windings.
+     */
+    bool m_custom_fill_rule;
+    std::vector<int> m_accepted_windings;
+  };
+
+  /* A CustomFillRuleBase realized from a clip_entry */
+  class recorded_fill_rule:public CustomFillRuleBase
+  {
+  public:
+    explicit
+    recorded_fill_rule(const clip_entry &e):
+      m_windings(e.m_accepted_windings)
+    {}
+
+    virtual
+    bool
+    operator()(int winding_number) const;
+
+  private:
+    const std::vector<int> &m_windings;
+  };
+
+  PainterCommandListPrivate(void);
+
+  static
+  bool
+  same_matrix(const float3x3 &a, const float3x3 &b);
+
+  void
+  clear(void);
+
+  void
+  begin_recording(const float3x3 &base_matrix, int z);
+
+  void
+  end_recording(int z);
+
+  void
+  add_draw(const reference_counted_ptr<PainterItemShader> &shader,
+           const PainterData &data,
+           const reference_counted_ptr<PainterBlendShader> &blend_shader,
+           BlendMode::packed_value blend_mode,
+           const float3x3 &matrix, int draw_z, int z,
+           c_array<const c_array<const PainterAttribute> > attrib_chunks,
+           c_array<const c_array<const PainterIndex> > index_chunks,
+           c_array<const int> index_adjusts,
+           c_array<const unsigned int> attrib_chunk_selector,
+           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back);
+
+  void
+  add_draw(const reference_counted_ptr<PainterItemShader> &shader,
+           const PainterData &data,
+           const reference_counted_ptr<PainterBlendShader> &blend_shader,
+           BlendMode::packed_value blend_mode,
+           const float3x3 &matrix, int draw_z, int z,
+           const PainterPacker::DataWriter &src,
+           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back);
+
+  void
+  add_action(const reference_counted_ptr<const PainterDraw::Action> &action, int z);
+
+  void
+  add_save(int z);
+
+  void
+  add_restore(int z);
+
+  void
+  add_clip_in_rect(const float3x3 &matrix, int z,
+                   const vec2 &pmin, const vec2 &wh);
+
+  void
+  add_clip_path(enum command_t tp, const float3x3 &matrix, int z,
+                const Path &path, enum PainterEnums::fill_rule_t fill_rule);
+
+  void
+  add_clip_path(enum command_t tp, const float3x3 &matrix, int z,
+                const Path &path, const CustomFillRuleBase &fill_rule);
+
+  bool m_recording;
+
+  std::vector<command> m_commands;
+  std::vector<draw_entry> m_draws;
+  std::vector<clip_entry> m_clips;
+  std::vector<reference_counted_ptr<const PainterDraw::Action> > m_actions;
+
+  /* matrices relative to the matrix at the start of recording */
+  std::vector<float3x3> m_matrices;
+
+  /* amount by which z advanced after the last command */
+  int m_z_advance_end;
+
+  /* backing of the attribute and index data of the draws */
+  std::vector<PainterAttribute> m_attributes;
+  std::vector<PainterIndex> m_indices;
+  std::vector<range_type<unsigned int> > m_attribute_ranges;
+  std::vector<range_type<unsigned int> > m_index_ranges;
+
+  /* the chunks of all draws, made from m_attribute_ranges
+   * and m_index_ranges when the recording ends
+   */
+  std::vector<c_array<const PainterAttribute> > m_attribute_chunks;
+  std::vector<c_array<const PainterIndex> > m_index_chunks;
+  std::vector<int> m_index_adjusts;
+  std::vector<unsigned int> m_attribute_chunk_selectors;
+
+private:
+  unsigned int
+  matrix_index(const float3x3 &matrix);
+
+  void
+  add_command(enum command_t tp, unsigned int idx, int z);
+
+  draw_entry&
+  add_draw_entry(const reference_counted_ptr<PainterItemShader> &shader,
+                 const PainterData &data,
+                 const reference_counted_ptr<PainterBlendShader> &blend_shader,
+                 BlendMode::packed_value blend_mode,
+                 const float3x3 &matrix, int draw_z, int z,
+                 const reference_counted_ptr<PainterPacker::DataCallBack> &call_back);
+
+  float3x3 m_inverse_base_matrix;
+  float3x3 m_last_matrix;
+  bool m_last_matrix_valid;
+  int m_last_z;
+  std::vector<unsigned int> m_attribute_chunk_location;
+};
+
+}}
@@ -0,0 +1,42 @@
+/*!
+ * \file painter_layer_private.hpp
+ * \brief file painter_layer_private.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/image.hpp>
+#include <fastuidraw/painter/packing/painter_backend.hpp>
+
+namespace fastuidraw { namespace detail {
+
+/* Storage behind a PainterLayer; m_image is set by
+ * Painter::end_layer() and cleared by invalidate().
+ */
+class PainterLayerPrivate:noncopyable
+{
+public:
+  explicit
+  PainterLayerPrivate(const reference_counted_ptr<PainterBackend::Surface> &surface):
+    m_surface(surface)
+  {}
+
+  reference_counted_ptr<PainterBackend::Surface> m_surface;
+  reference_counted_ptr<const Image> m_image;
+};
+
+}}
@@ -382,9 +382,7 @@ namespace
   {
   public:
     std::vector<fastuidraw::vec3> m_adjusted_clip_eqs;
-    std::vector<fastuidraw::vec2> m_clipped_rect;
-
-    fastuidraw::vecN<std::vector<fastuidraw::vec2>, 2> m_clip_scratch_vec2s;
+    fastuidraw::detail::ClipWorkRoom m_clip_work_room;
   };
 
   class RangeAndChunk
@@ -1714,12 +1712,12 @@ compute_chunks_implement(bool include_closing_edge,
 
   /* clip the bounding box of this SubsetPrivate */
   vecN<vec2, 4> bb;
+  c_array<const vec2> clipped_rect;
   bool unclipped;
 
   m_bb.inflated_polygon(bb, item_space_additional_room);
   unclipped = clip_against_planes(make_c_array(scratch.m_adjusted_clip_eqs),
-                                  bb, scratch.m_clipped_rect,
-                                  scratch.m_clip_scratch_vec2s);
+                                  bb, &clipped_rect, scratch.m_clip_work_room);
   //completely unclipped.
   if (unclipped || !have_children())
     {
@@ -1728,7 +1726,7 @@ compute_chunks_implement(bool include_closing_edge,
     }
 
   //completely clipped
-  if (scratch.m_clipped_rect.empty())
+  if (clipped_rect.empty())
     {
       return;
     }
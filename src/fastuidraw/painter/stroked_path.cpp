@@ -27,12 +27,13 @@
 #include <fastuidraw/painter/painter_attribute_data.hpp>
 #include <fastuidraw/painter/painter_attribute_data_filler.hpp>
 #include <fastuidraw/painter/painter_dashed_stroke_shader_set.hpp>
+#include <fastuidraw/painter/painter_stroke_shader.hpp>
 #include "../private/util_private.hpp"
 #include "../private/util_private_ostream.hpp"
 #include "../private/bounding_box.hpp"
 #include "../private/path_util_private.hpp"
 #include "../private/point_attribute_data_merger.hpp"
-#include "../private/clip.hpp"
+#include "../private/box_hierarchy.hpp"
 
 namespace
 {
@@ -197,7 +198,7 @@ namespace
 
     void
     process_edge(const fastuidraw::TessellatedPath &P,
-                 fastuidraw::range_type<unsigned int> R,
+                 unsigned int contour, unsigned int edge,
                  const SingleSubEdge *prev,
                  std::vector<SingleSubEdge> &dst);
 
@@ -226,10 +227,21 @@ namespace
   class ScratchSpacePrivate:fastuidraw::noncopyable
   {
   public:
+    ScratchSpacePrivate(void):
+      m_distance_culler(nullptr),
+      m_distance_culler_data(nullptr),
+      m_one_pixel_distance(0.0f)
+    {}
+
     std::vector<fastuidraw::vec3> m_adjusted_clip_eqs;
-    std::vector<fastuidraw::vec2> m_clipped_rect;
+    fastuidraw::detail::BoxHierarchy::Query m_box_query;
 
-    fastuidraw::vecN<std::vector<fastuidraw::vec2>, 2> m_clip_scratch_vec2s;
+    /* if non-null, used to cull Subsets by the distances
+     * from the contour start of their edges.
+     */
+    const fastuidraw::StrokingDataSelectorBase *m_distance_culler;
+    const fastuidraw::PainterShaderData::DataBase *m_distance_culler_data;
+    float m_one_pixel_distance;
   };
 
   class SubsetPrivate:fastuidraw::noncopyable
@@ -237,16 +249,16 @@ namespace
   public:
     ~SubsetPrivate();
 
-    unsigned int
-    select_subsets(ScratchSpacePrivate &scratch,
-                   fastuidraw::c_array<const fastuidraw::vec3> clip_equations,
-                   const fastuidraw::float3x3 &clip_matrix_local,
-                   const fastuidraw::vec2 &recip_dimensions,
-                   float pixels_additional_room,
-                   float item_space_additional_room,
-                   unsigned int max_attribute_cnt,
-                   unsigned int max_index_cnt,
-                   fastuidraw::c_array<unsigned int> dst);
+    /* add the bounding boxes of this SubsetPrivate and
+     * its descendants to a BoxHierarchy; the index of
+     * each box in the BoxHierarchy is the same as the
+     * value of m_ID.
+     */
+    void
+    build_box_hierarchy(fastuidraw::detail::BoxHierarchy &dst) const;
+
+    bool
+    distance_culled(const ScratchSpacePrivate &scratch) const;
 
     void
     select_subsets_all_unculled(fastuidraw::c_array<unsigned int> dst,
@@ -294,14 +306,6 @@ namespace
     SubsetPrivate(int recursion_depth, SubPath *data,
                   std::vector<SubsetPrivate*> &out_values);
 
-    void
-    select_subsets_implement(ScratchSpacePrivate &scratch,
-                             fastuidraw::c_array<unsigned int> dst,
-                             float item_space_additional_room,
-                             unsigned int max_attribute_cnt,
-                             unsigned int max_index_cnt,
-                             unsigned int &current);
-
     void
     make_ready_from_children(void);
 
@@ -311,6 +315,15 @@ namespace
     void
     ready_sizes_from_children(void);
 
+    static
+    void
+    add_distance_ranges(fastuidraw::c_array<const SingleSubEdge> edges,
+                        std::vector<fastuidraw::range_type<float> > &dst);
+
+    static
+    void
+    merge_distance_ranges(std::vector<fastuidraw::range_type<float> > &ranges);
+
     unsigned int m_ID;
     fastuidraw::vecN<SubsetPrivate*, 2> m_children;
     fastuidraw::BoundingBox<float> m_bounding_box;
@@ -319,6 +332,11 @@ namespace
     unsigned int m_num_attributes, m_num_indices;
     bool m_sizes_ready, m_ready, m_has_arcs;
     SubPath *m_sub_path;
+
+    /* the union of the ranges of the distances from the
+     * contour start of the sub-edges, sorted and merged.
+     */
+    std::vector<fastuidraw::range_type<float> > m_distance_ranges;
   };
 
   class EdgeAttributeFillerBase:public fastuidraw::PainterAttributeDataFiller
@@ -465,10 +483,26 @@ namespace
                           unsigned int contour,
                           fastuidraw::StrokedCapsJoins::Builder &b);
 
+    unsigned int
+    select_subsets(ScratchSpacePrivate &scratch,
+                   fastuidraw::c_array<const fastuidraw::vec3> clip_equations,
+                   const fastuidraw::float3x3 &clip_matrix_local,
+                   const fastuidraw::vec2 &recip_dimensions,
+                   float pixels_additional_room,
+                   float item_space_additional_room,
+                   unsigned int max_attribute_cnt,
+                   unsigned int max_index_cnt,
+                   fastuidraw::c_array<unsigned int> dst);
+
     bool m_has_arcs;
     fastuidraw::StrokedCapsJoins m_caps_joins;
     SubsetPrivate* m_root;
     std::vector<SubsetPrivate*> m_subsets;
+
+    /* the bounding boxes of m_subsets, used to cull
+     * in select_subsets().
+     */
+    fastuidraw::detail::BoxHierarchy m_boxes;
   };
 
 }
@@ -763,15 +797,13 @@ SubPath(const fastuidraw::TessellatedPath &P):
       for(unsigned int e = 0; e < closing_edge_start[o]; ++e)
         {
           const SingleSubEdge *prev(nullptr);
-          fastuidraw::range_type<unsigned int> R;
 
-          R = P.edge_range(o, e);
           if (e != 0 && P.edge_type(o, e) != PathEnums::starts_new_edge)
             {
               prev = &m_non_closing_edges.back();
             }
 
-          process_edge(P, R, prev, m_non_closing_edges);
+          process_edge(P, o, e, prev, m_non_closing_edges);
         }
     }
 
@@ -779,16 +811,14 @@ SubPath(const fastuidraw::TessellatedPath &P):
     {
       for (unsigned int e = closing_edge_start[o], ende = P.number_edges(o); e < ende; ++e)
         {
-          fastuidraw::range_type<unsigned int> R;
           const SingleSubEdge *prev(nullptr);
 
-          R = P.edge_range(o, e);
           if (e != closing_edge_start[o]
               && P.edge_type(o, e) != PathEnums::starts_new_edge)
             {
               prev = &m_closing_edges.back();
             }
-          process_edge(P, R, prev, m_closing_edges);
+          process_edge(P, o, e, prev, m_closing_edges);
         }
     }
 }
@@ -796,13 +826,13 @@ SubPath(const fastuidraw::TessellatedPath &P):
 void
 SubPath::
 process_edge(const fastuidraw::TessellatedPath &P,
-             fastuidraw::range_type<unsigned int> R,
+             unsigned int contour, unsigned int edge,
              const SingleSubEdge *prev,
              std::vector<SingleSubEdge> &dst)
 {
   using namespace fastuidraw;
 
-  c_array<const TessellatedPath::segment> src_segments(P.segment_data());
+  range_type<unsigned int> R(P.edge_range(contour, edge));
   bool has_arcs(P.has_arcs());
 
   FASTUIDRAWassert(R.m_end >= R.m_begin);
@@ -820,7 +850,7 @@ process_edge(const fastuidraw::TessellatedPath &P,
           flags |= SingleSubEdge::last_segment_of_edge;
         }
 
-      SingleSubEdge::add_sub_edge(prev, src_segments[i],
+      SingleSubEdge::add_sub_edge(prev, P.segment_at(contour, edge, i),
                                   &dst == &m_closing_edges,
                                   dst, m_bounding_box, flags);
       prev = &dst.back();
@@ -1013,6 +1043,10 @@ SubsetPrivate(int recursion_depth, SubPath *data,
   int splitting_coordinate(-1);
   float splitting_value;
 
+  add_distance_ranges(data->non_closing_edges(), m_distance_ranges);
+  add_distance_ranges(data->closing_edges(), m_distance_ranges);
+  merge_distance_ranges(m_distance_ranges);
+
   out_values.push_back(this);
   if (recursion_depth < max_recursion_depth)
     {
@@ -1194,95 +1228,83 @@ ready_sizes_from_children(void)
   m_num_indices = m_children[0]->m_num_indices + m_children[1]->m_num_indices;
 }
 
-unsigned int
+void
 SubsetPrivate::
-select_subsets(ScratchSpacePrivate &scratch,
-               fastuidraw::c_array<const fastuidraw::vec3> clip_equations,
-               const fastuidraw::float3x3 &clip_matrix_local,
-               const fastuidraw::vec2 &recip_dimensions,
-               float pixels_additional_room,
-               float item_space_additional_room,
-               unsigned int max_attribute_cnt,
-               unsigned int max_index_cnt,
-               fastuidraw::c_array<unsigned int> dst)
+add_distance_ranges(fastuidraw::c_array<const SingleSubEdge> edges,
+                    std::vector<fastuidraw::range_type<float> > &dst)
 {
-  using namespace fastuidraw;
-
-  scratch.m_adjusted_clip_eqs.resize(clip_equations.size());
-  for(unsigned int i = 0; i < clip_equations.size(); ++i)
+  for(const SingleSubEdge &E : edges)
     {
-      vec3 c(clip_equations[i]);
-      float f;
-
-      /* make "w" larger by the named number of pixels.
-       */
-      f = t_abs(c.x()) * recip_dimensions.x()
-        + t_abs(c.y()) * recip_dimensions.y();
-
-      c.z() += pixels_additional_room * f;
-
-      /* transform clip equations from clip coordinates to
-       * local coordinates.
-       */
-      scratch.m_adjusted_clip_eqs[i] = c * clip_matrix_local;
+      dst.push_back(fastuidraw::range_type<float>(E.m_distance_from_contour_start,
+                                                  E.m_distance_from_contour_start + E.m_sub_edge_length));
     }
-
-  unsigned int return_value(0);
-
-  select_subsets_implement(scratch, dst,
-                           item_space_additional_room,
-                           max_attribute_cnt, max_index_cnt,
-                           return_value);
-
-  return return_value;
 }
 
 void
 SubsetPrivate::
-select_subsets_implement(ScratchSpacePrivate &scratch,
-                         fastuidraw::c_array<unsigned int> dst,
-                         float item_space_additional_room,
-                         unsigned int max_attribute_cnt,
-                         unsigned int max_index_cnt,
-                         unsigned int &current)
+merge_distance_ranges(std::vector<fastuidraw::range_type<float> > &ranges)
 {
-  using namespace fastuidraw;
+  unsigned int current(0);
 
-  if (m_bounding_box.empty())
+  if (ranges.empty())
     {
       return;
     }
 
-  /* clip the bounding box of this StrokedPathSubset */
-  vecN<vec2, 4> bb;
-  bool unclipped;
-
-  m_bounding_box.inflated_polygon(bb, item_space_additional_room);
-  unclipped = detail::clip_against_planes(make_c_array(scratch.m_adjusted_clip_eqs),
-                                          bb, scratch.m_clipped_rect,
-                                          scratch.m_clip_scratch_vec2s);
+  std::sort(ranges.begin(), ranges.end(),
+            [](const fastuidraw::range_type<float> &a,
+               const fastuidraw::range_type<float> &b)
+            {
+              return a.m_begin < b.m_begin;
+            });
 
-  //completely clipped
-  if (scratch.m_clipped_rect.empty())
+  for(unsigned int i = 1, endi = ranges.size(); i < endi; ++i)
     {
-      return;
+      if (ranges[i].m_begin <= ranges[current].m_end)
+        {
+          ranges[current].m_end = fastuidraw::t_max(ranges[current].m_end, ranges[i].m_end);
+        }
+      else
+        {
+          ++current;
+          ranges[current] = ranges[i];
+        }
     }
+  ranges.resize(current + 1);
+  ranges.shrink_to_fit();
+}
 
-  //completely unclipped.
-  if (unclipped || !have_children())
+bool
+SubsetPrivate::
+distance_culled(const ScratchSpacePrivate &scratch) const
+{
+  FASTUIDRAWassert(scratch.m_distance_culler);
+  for(const fastuidraw::range_type<float> &R : m_distance_ranges)
     {
-      select_subsets_all_unculled(dst, max_attribute_cnt, max_index_cnt, current);
-      return;
+      if (!scratch.m_distance_culler->distance_range_culled(scratch.m_distance_culler_data,
+                                                            scratch.m_one_pixel_distance,
+                                                            R))
+        {
+          return false;
+        }
     }
+  return true;
+}
 
-  FASTUIDRAWassert(m_children[0] != nullptr);
-  FASTUIDRAWassert(m_children[1] != nullptr);
-  m_children[0]->select_subsets_implement(scratch, dst, item_space_additional_room,
-                                          max_attribute_cnt, max_index_cnt,
-                                          current);
-  m_children[1]->select_subsets_implement(scratch, dst, item_space_additional_room,
-                                          max_attribute_cnt, max_index_cnt,
-                                          current);
+void
+SubsetPrivate::
+build_box_hierarchy(fastuidraw::detail::BoxHierarchy &dst) const
+{
+  unsigned int node;
+
+  node = dst.add_node(m_bounding_box);
+  FASTUIDRAWassert(node == m_ID);
+  if (have_children())
+    {
+      m_children[0]->build_box_hierarchy(dst);
+      m_children[1]->build_box_hierarchy(dst);
+    }
+  dst.end_node(node);
 }
 
 void
@@ -2032,9 +2054,10 @@ StrokedPathPrivate(const fastuidraw::TessellatedPath &P,
   m_caps_joins(b),
   m_root(nullptr)
 {
-  if (!P.segment_data().empty())
+  if (P.number_segments() > 0)
     {
       m_root = SubsetPrivate::create_root_subset(P, m_subsets);
+      m_root->build_box_hierarchy(m_boxes);
     }
 }
 
@@ -2047,6 +2070,80 @@ StrokedPathPrivate::
     }
 }
 
+unsigned int
+StrokedPathPrivate::
+select_subsets(ScratchSpacePrivate &scratch,
+               fastuidraw::c_array<const fastuidraw::vec3> clip_equations,
+               const fastuidraw::float3x3 &clip_matrix_local,
+               const fastuidraw::vec2 &recip_dimensions,
+               float pixels_additional_room,
+               float item_space_additional_room,
+               unsigned int max_attribute_cnt,
+               unsigned int max_index_cnt,
+               fastuidraw::c_array<unsigned int> dst)
+{
+  using namespace fastuidraw;
+  using namespace fastuidraw::detail;
+
+  scratch.m_adjusted_clip_eqs.resize(clip_equations.size());
+  for(unsigned int i = 0; i < clip_equations.size(); ++i)
+    {
+      vec3 c(clip_equations[i]);
+      float f;
+
+      /* make "w" larger by the named number of pixels.
+       */
+      f = t_abs(c.x()) * recip_dimensions.x()
+        + t_abs(c.y()) * recip_dimensions.y();
+
+      c.z() += pixels_additional_room * f;
+
+      /* transform clip equations from clip coordinates to
+       * local coordinates.
+       */
+      scratch.m_adjusted_clip_eqs[i] = c * clip_matrix_local;
+    }
+
+  unsigned int return_value(0);
+
+  /* walk the hierarchy in the pre-order of m_subsets, skipping
+   * the subtree of a SubsetPrivate that is culled or that is
+   * taken in its entirety.
+   */
+  scratch.m_box_query.begin(m_boxes, make_c_array(scratch.m_adjusted_clip_eqs),
+                            item_space_additional_room);
+  for(unsigned int i = 0; i < m_subsets.size();)
+    {
+      enum BoxHierarchy::visibility_t v;
+      SubsetPrivate *subset(m_subsets[i]);
+
+      v = scratch.m_box_query.visibility(i);
+
+      //completely clipped, or completely culled by distance,
+      //e.g. within a dash pattern skip interval
+      if (v == BoxHierarchy::box_culled
+          || (scratch.m_distance_culler && subset->distance_culled(scratch)))
+        {
+          i = m_boxes.subtree_end(i);
+        }
+      /* completely unclipped; when culling by distance, a child
+       * may still be culled, so walk to the children.
+       */
+      else if ((v == BoxHierarchy::box_unclipped && !scratch.m_distance_culler)
+               || !subset->have_children())
+        {
+          subset->select_subsets_all_unculled(dst, max_attribute_cnt, max_index_cnt, return_value);
+          i = m_boxes.subtree_end(i);
+        }
+      else
+        {
+          ++i;
+        }
+    }
+
+  return return_value;
+}
+
 void
 StrokedPathPrivate::
 ready_builder(const fastuidraw::TessellatedPath *tess,
@@ -2064,38 +2161,43 @@ ready_builder_contour(const fastuidraw::TessellatedPath *tess,
                       unsigned int c,
                       fastuidraw::StrokedCapsJoins::Builder &b)
 {
-  fastuidraw::c_array<const fastuidraw::TessellatedPath::segment> last_segs;
+  fastuidraw::TessellatedPath::segment last_seg;
   float distance_accumulated(0.0f);
 
-  last_segs = tess->edge_segment_data(c, 0);
-  b.begin_contour(last_segs.front().m_start_pt,
-                  last_segs.front().m_enter_segment_unit_vector);
+  /* only the first and last segment of each edge
+   * are needed, fetch just those.
+   */
+  last_seg = tess->segment_at(c, 0, tess->edge_range(c, 0).m_begin);
+  b.begin_contour(last_seg.m_start_pt,
+                  last_seg.m_enter_segment_unit_vector);
+  last_seg = tess->segment_at(c, 0, tess->edge_range(c, 0).m_end - 1);
 
   for(unsigned int e = 1, ende = tess->number_edges(c); e < ende; ++e)
     {
-      fastuidraw::c_array<const fastuidraw::TessellatedPath::segment> segs;
+      fastuidraw::TessellatedPath::segment first_seg;
+      fastuidraw::range_type<unsigned int> R(tess->edge_range(c, e));
       fastuidraw::vec2 delta_into, delta_leaving;
 
-      segs = tess->edge_segment_data(c, e);
+      first_seg = tess->segment_at(c, e, R.m_begin);
       /* Leaving the previous segment is entering the join;
        * Entering the segment is leaving the join
        */
-      delta_into = last_segs.back().m_leaving_segment_unit_vector;
-      delta_leaving = segs.front().m_enter_segment_unit_vector;
-      distance_accumulated += last_segs.back().m_edge_length;
+      delta_into = last_seg.m_leaving_segment_unit_vector;
+      delta_leaving = first_seg.m_enter_segment_unit_vector;
+      distance_accumulated += last_seg.m_edge_length;
 
       if (tess->edge_type(c, e) == fastuidraw::PathEnums::starts_new_edge)
         {
-          b.add_join(segs.front().m_start_pt,
+          b.add_join(first_seg.m_start_pt,
                      distance_accumulated,
                      delta_into, delta_leaving);
           distance_accumulated = 0.0f;
         }
-      last_segs = segs;
+      last_seg = tess->segment_at(c, e, R.m_end - 1);
     }
 
-  b.end_contour(last_segs.back().m_edge_length + distance_accumulated,
-                last_segs.back().m_leaving_segment_unit_vector);
+  b.end_contour(last_seg.m_edge_length + distance_accumulated,
+                last_seg.m_leaving_segment_unit_vector);
 }
 
 //////////////////////////////////////////////
@@ -2204,6 +2306,28 @@ select_subsets(ScratchSpace &scratch_space,
                unsigned int max_attribute_cnt,
                unsigned int max_index_cnt,
                c_array<unsigned int> dst) const
+{
+  return select_subsets(scratch_space, clip_equations, clip_matrix_local,
+                        recip_dimensions, pixels_additional_room,
+                        item_space_additional_room,
+                        nullptr, nullptr, 0.0f,
+                        max_attribute_cnt, max_index_cnt, dst);
+}
+
+unsigned int
+fastuidraw::StrokedPath::
+select_subsets(ScratchSpace &scratch_space,
+               c_array<const vec3> clip_equations,
+               const float3x3 &clip_matrix_local,
+               const vec2 &recip_dimensions,
+               float pixels_additional_room,
+               float item_space_additional_room,
+               const StrokingDataSelectorBase *distance_culler,
+               const PainterShaderData::DataBase *distance_culler_data,
+               float one_pixel_distance,
+               unsigned int max_attribute_cnt,
+               unsigned int max_index_cnt,
+               c_array<unsigned int> dst) const
 {
   StrokedPathPrivate *d;
   ScratchSpacePrivate *scratch_space_ptr;
@@ -2213,15 +2337,28 @@ select_subsets(ScratchSpace &scratch_space,
   FASTUIDRAWassert(dst.size() >= d->m_subsets.size());
   scratch_space_ptr = static_cast<ScratchSpacePrivate*>(scratch_space.m_d);
 
-  return_value =  d->m_root->select_subsets(*scratch_space_ptr,
-                                            clip_equations,
-                                            clip_matrix_local,
-                                            recip_dimensions,
-                                            pixels_additional_room,
-                                            item_space_additional_room,
-                                            max_attribute_cnt,
-                                            max_index_cnt,
-                                            dst);
+  if (distance_culler
+      && distance_culler->has_distance_culling(distance_culler_data, one_pixel_distance))
+    {
+      scratch_space_ptr->m_distance_culler = distance_culler;
+      scratch_space_ptr->m_distance_culler_data = distance_culler_data;
+      scratch_space_ptr->m_one_pixel_distance = one_pixel_distance;
+    }
+  else
+    {
+      scratch_space_ptr->m_distance_culler = nullptr;
+      scratch_space_ptr->m_distance_culler_data = nullptr;
+    }
+
+  return_value = d->select_subsets(*scratch_space_ptr,
+                                   clip_equations,
+                                   clip_matrix_local,
+                                   recip_dimensions,
+                                   pixels_additional_room,
+                                   item_space_additional_room,
+                                   max_attribute_cnt,
+                                   max_index_cnt,
+                                   dst);
   return return_value;
 }
 
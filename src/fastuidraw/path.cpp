@@ -20,12 +20,16 @@
 #include <algorithm>
 #include <cmath>
 #include <vector>
+#include <map>
+#include <typeindex>
 #include <fastuidraw/path.hpp>
 #include <fastuidraw/tessellated_path.hpp>
+#include <fastuidraw/shared_path_geometry.hpp>
 #include "private/util_private.hpp"
 #include "private/path_util_private.hpp"
 #include "private/util_private_ostream.hpp"
 #include "private/bounding_box.hpp"
+#include "private/tessellated_path_cache_private.hpp"
 
 namespace
 {
@@ -42,7 +46,13 @@ namespace
        * a 23-bit significand; arc-tessellation needs more
        * accuracy to not produce garbage.
        */
-      MAX_ARC_REFINE_RECURSION_LIMIT = 16
+      MAX_ARC_REFINE_RECURSION_LIMIT = 16,
+
+      /* A simplified level of detail is only kept if it
+       * has at most 1/MIN_SIMPLIFY_REDUCTION of the
+       * segments of the coarsest level of detail.
+       */
+      MIN_SIMPLIFY_REDUCTION = 2
     };
 
   inline
@@ -428,51 +438,186 @@ namespace
 
   class PathPrivate;
 
-  class TessellatedPathList
+  /* A TessellatedPathList holds the levels of detail of the
+   * tessellation of a Path. Each level of detail is accounted
+   * by the TessellatedPathCache; the coarsest level is pinned
+   * and the finer levels may be evicted by the cache. The cache
+   * only marks an evicted level as unlinked; the list drops the
+   * unlinked levels at the start of its next tessellation() and
+   * regenerates them when requested again. For linear
+   * tessellations, requests coarser than the coarsest level are
+   * served by levels made by simplifying the coarsest level
+   * (see TessellatedPath::create_simplified()); these levels
+   * are also evictable.
+   */
+  class TessellatedPathList:public fastuidraw::detail::TessellatedPathCacheClient
   {
   public:
     typedef fastuidraw::TessellatedPath TessellatedPath;
     typedef typename TessellatedPath::TessellationParams TessellationParams;
     typedef fastuidraw::reference_counted_ptr<const TessellatedPath> TessellatedPathRef;
+    typedef fastuidraw::detail::TessellatedPathCacheEntry CacheEntry;
+    typedef fastuidraw::detail::TessellatedPathCacheAccess CacheAccess;
 
     explicit
     TessellatedPathList(bool allow_arcs):
       m_allow_arcs(allow_arcs),
-      m_done(false)
+      m_done(false),
+      m_simplify_floor(0.0f)
     {}
 
+    TessellatedPathList(const TessellatedPathList &obj);
+
+    ~TessellatedPathList();
+
     const TessellatedPathRef&
     tessellation(const fastuidraw::Path &path, float max_distance);
 
     void
-    clear(void)
-    {
-      m_data.clear();
-      m_refiner = nullptr;
-      m_done = false;
-    }
+    clear(void);
+
+    uint64_t
+    memory_consumption(void) const;
 
   private:
+    class Element
+    {
+    public:
+      TessellatedPathRef m_tess;
+      CacheEntry *m_entry;
+    };
+
     class reverse_compare_max_distance
     {
     public:
       bool
-      operator()(const TessellatedPathRef &lhs, float rhs) const
+      operator()(const Element &lhs, float rhs) const
       {
-        return lhs->max_distance() > rhs;
+        return lhs.m_tess->max_distance() > rhs;
       }
 
       bool
-      operator()(const TessellatedPathRef &lhs,
-                 const TessellatedPathRef &rhs) const
+      operator()(const Element &lhs,
+                 const Element &rhs) const
       {
-        return lhs->max_distance() > rhs->max_distance();
+        return lhs.m_tess->max_distance() > rhs.m_tess->max_distance();
       }
     };
 
+    void
+    add_element(const TessellatedPathRef &tess);
+
+    /* marks the element as most recently used and
+     * returns its TessellatedPath
+     */
+    const TessellatedPathRef&
+    touch_element(const Element &E);
+
+    /* drop the elements whose entries the cache unlinked */
+    void
+    drop_unlinked(void);
+
+    void
+    create_refiner(const fastuidraw::Path &path);
+
+    /* returns the simplified level of detail for max_distance,
+     * creating it if necessary, or nullptr if simplifying does
+     * not reduce the number of segments enough.
+     */
+    const TessellatedPathRef*
+    simplified_tessellation(float max_distance);
+
     bool m_allow_arcs, m_done;
     fastuidraw::reference_counted_ptr<TessellatedPath::Refiner> m_refiner;
-    std::vector<TessellatedPathRef> m_data;
+    std::vector<Element> m_data;
+
+    /* simplified levels of detail sorted by increasing
+     * max_distance; m_simplify_floor is the largest
+     * tolerance for which simplifying was not worthwhile.
+     */
+    std::vector<Element> m_simplified;
+    float m_simplify_floor;
+  };
+
+  /* The key of the geometry of a Path, i.e. for each contour
+   * the number of interpolators and for each interpolator its
+   * type, edge type, end points and the values from
+   * PathContour::interpolator_base::add_to_geometry_key().
+   */
+  class SharedGeometryKey
+  {
+  public:
+    SharedGeometryKey(void):
+      m_hash(0u)
+    {}
+
+    /* returns false if an interpolator cannot describe its geometry */
+    bool
+    set(const std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PathContour> > &contours);
+
+    bool
+    operator<(const SharedGeometryKey &rhs) const;
+
+    uint32_t m_hash;
+    std::vector<std::type_index> m_types;
+    std::vector<uint32_t> m_values;
+  };
+
+  class SharedGeometry;
+  typedef std::map<SharedGeometryKey, SharedGeometry*> SharedGeometryMap;
+
+  /* The tessellations of a geometry shared by Path objects */
+  class SharedGeometry:fastuidraw::noncopyable
+  {
+  public:
+    SharedGeometry(void):
+      m_tess_list(false),
+      m_arc_tess_list(true),
+      m_number_paths(0)
+    {}
+
+    TessellatedPathList m_tess_list;
+    TessellatedPathList m_arc_tess_list;
+
+    /* number of Path objects using this SharedGeometry */
+    unsigned int m_number_paths;
+
+    /* location within SharedPathGeometryPrivate::m_geometries */
+    SharedGeometryMap::iterator m_location;
+  };
+
+  /* The SharedPathGeometry and the Path objects using it are
+   * used from only one thread at a time, so there is no lock.
+   */
+  class SharedPathGeometryPrivate:fastuidraw::noncopyable
+  {
+  public:
+    ~SharedPathGeometryPrivate()
+    {
+      /* each Path using a SharedGeometry holds a
+       * reference to the SharedPathGeometry
+       */
+      FASTUIDRAWassert(m_geometries.empty());
+    }
+
+    /* returns the SharedGeometry of the named key,
+     * creating it if necessary, and increments its
+     * number of users.
+     */
+    SharedGeometry*
+    acquire(const SharedGeometryKey &key);
+
+    void
+    acquire(SharedGeometry *p);
+
+    void
+    release(SharedGeometry *p);
+
+    fastuidraw::SharedPathGeometry::Statistics
+    statistics(void) const;
+
+  private:
+    SharedGeometryMap m_geometries;
   };
 
   class PathPrivate:fastuidraw::noncopyable
@@ -483,6 +628,14 @@ namespace
 
     PathPrivate(fastuidraw::Path *p, const PathPrivate &obj);
 
+    ~PathPrivate();
+
+    /* returns the TessellatedPathList to use, which is
+     * that of the SharedGeometry if the geometry is shared.
+     */
+    TessellatedPathList&
+    tess_list(bool allow_arcs);
+
     const fastuidraw::reference_counted_ptr<fastuidraw::PathContour>&
     current_contour(void)
     {
@@ -506,6 +659,14 @@ namespace
     TessellatedPathList m_tess_list;
     TessellatedPathList m_arc_tess_list;
 
+    /* m_share_group_d is the private data of m_share_group;
+     * m_shared is non-null only if m_share_group is non-null
+     * and a tessellation was requested since the last change.
+     */
+    fastuidraw::reference_counted_ptr<fastuidraw::SharedPathGeometry> m_share_group;
+    SharedPathGeometryPrivate *m_share_group_d;
+    SharedGeometry *m_shared;
+
     /* m_start_check_bb gives the index into m_contours that
      * have not had their bounding box absorbed m_bb
      */
@@ -1170,6 +1331,21 @@ deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const
   return FASTUIDRAWnew bezier(*this, prev);
 }
 
+bool
+fastuidraw::PathContour::bezier::
+add_to_geometry_key(GeometryKey *key) const
+{
+  BezierPrivate *d;
+  d = static_cast<BezierPrivate*>(m_d);
+
+  key->add(static_cast<float>(d->m_start_region->pts().size()));
+  for (const vec2 &pt : d->m_start_region->pts())
+    {
+      key->add(pt);
+    }
+  return true;
+}
+
 unsigned int
 fastuidraw::PathContour::bezier::
 minimum_tessellation_recursion(void) const
@@ -1209,6 +1385,15 @@ deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const
   return FASTUIDRAWnew flat(prev, end_pt(), edge_type());
 }
 
+bool
+fastuidraw::PathContour::flat::
+add_to_geometry_key(GeometryKey *key) const
+{
+  /* a flat edge is determined by its end points */
+  FASTUIDRAWunused(key);
+  return true;
+}
+
 void
 fastuidraw::PathContour::flat::
 approximate_bounding_box(vec2 *out_min_bb, vec2 *out_max_bb) const
@@ -1439,6 +1624,66 @@ deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const
   return FASTUIDRAWnew arc(*this, prev);
 }
 
+bool
+fastuidraw::PathContour::arc::
+add_to_geometry_key(GeometryKey *key) const
+{
+  ArcPrivate *d;
+  d = static_cast<ArcPrivate*>(m_d);
+
+  key->add(d->m_center)
+    .add(d->m_radius)
+    .add(d->m_start_angle)
+    .add(d->m_angle_speed);
+  return true;
+}
+
+//////////////////////////////////////////////
+// fastuidraw::PathContour::GeometryKey methods
+fastuidraw::PathContour::GeometryKey::
+GeometryKey(void)
+{
+  m_d = FASTUIDRAWnew std::vector<generic_data>();
+}
+
+fastuidraw::PathContour::GeometryKey::
+~GeometryKey()
+{
+  std::vector<generic_data> *d;
+  d = static_cast<std::vector<generic_data>*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+fastuidraw::PathContour::GeometryKey&
+fastuidraw::PathContour::GeometryKey::
+add(float v)
+{
+  std::vector<generic_data> *d;
+  generic_data g;
+
+  d = static_cast<std::vector<generic_data>*>(m_d);
+  g.f = v;
+  d->push_back(g);
+  return *this;
+}
+
+fastuidraw::PathContour::GeometryKey&
+fastuidraw::PathContour::GeometryKey::
+add(const vec2 &pt)
+{
+  return add(pt.x()).add(pt.y());
+}
+
+fastuidraw::c_array<const fastuidraw::generic_data>
+fastuidraw::PathContour::GeometryKey::
+values(void) const
+{
+  std::vector<generic_data> *d;
+  d = static_cast<std::vector<generic_data>*>(m_d);
+  return make_c_array(*d);
+}
+
 ///////////////////////////////////
 // fastuidraw::PathContour methods
 fastuidraw::PathContour::
@@ -1761,6 +2006,154 @@ approximate_bounding_box(vec2 *out_min_bb, vec2 *out_max_bb) const
 
 /////////////////////////////////
 // TessellatedPathList methods
+TessellatedPathList::
+TessellatedPathList(const TessellatedPathList &obj):
+  fastuidraw::detail::TessellatedPathCacheClient(obj),
+  m_allow_arcs(obj.m_allow_arcs),
+  m_done(obj.m_done),
+  m_refiner(obj.m_refiner),
+  m_simplify_floor(obj.m_simplify_floor)
+{
+  m_data.reserve(obj.m_data.size());
+  for (const Element &e : obj.m_data)
+    {
+      add_element(e.m_tess);
+    }
+
+  /* the simplified levels of detail are not copied,
+   * they are made again when requested.
+   */
+}
+
+TessellatedPathList::
+~TessellatedPathList()
+{
+  clear();
+}
+
+void
+TessellatedPathList::
+clear(void)
+{
+  for (const Element &e : m_data)
+    {
+      CacheAccess::remove(e.m_entry);
+    }
+  for (const Element &e : m_simplified)
+    {
+      CacheAccess::remove(e.m_entry);
+    }
+  m_data.clear();
+  m_simplified.clear();
+  m_refiner = nullptr;
+  m_done = false;
+  m_simplify_floor = 0.0f;
+}
+
+void
+TessellatedPathList::
+add_element(const TessellatedPathRef &tess)
+{
+  Element E;
+
+  /* the coarsest level of detail is never evicted */
+  E.m_tess = tess;
+  E.m_entry = CacheAccess::add(this, tess.get(), m_data.empty());
+  m_data.push_back(E);
+}
+
+uint64_t
+TessellatedPathList::
+memory_consumption(void) const
+{
+  uint64_t return_value(0);
+  for (const Element &e : m_data)
+    {
+      return_value += e.m_tess->memory_consumption();
+    }
+  for (const Element &e : m_simplified)
+    {
+      return_value += e.m_tess->memory_consumption();
+    }
+  return return_value;
+}
+
+const typename TessellatedPathList::TessellatedPathRef&
+TessellatedPathList::
+touch_element(const Element &E)
+{
+  CacheAccess::touch(E.m_entry);
+  return E.m_tess;
+}
+
+void
+TessellatedPathList::
+drop_unlinked(void)
+{
+  if (!CacheAccess::take_unlinked(this))
+    {
+      return;
+    }
+
+  /* the coarsest level of detail is pinned, so it is never unlinked */
+  for (auto iter = m_data.begin() + 1; iter != m_data.end();)
+    {
+      if (CacheAccess::is_unlinked(iter->m_entry))
+        {
+          /* if the Refiner holds the evicted TessellatedPath,
+           * drop the Refiner as well so that the memory is
+           * released; it is created anew if a finer level of
+           * detail is requested.
+           */
+          if (m_refiner && m_refiner->tessellated_path() == iter->m_tess)
+            {
+              m_refiner = nullptr;
+            }
+
+          /* the finest level of detail may be the one evicted,
+           * so refinement may be needed again.
+           */
+          m_done = false;
+          CacheAccess::remove(iter->m_entry);
+          iter = m_data.erase(iter);
+        }
+      else
+        {
+          ++iter;
+        }
+    }
+
+  for (auto iter = m_simplified.begin(); iter != m_simplified.end();)
+    {
+      if (CacheAccess::is_unlinked(iter->m_entry))
+        {
+          CacheAccess::remove(iter->m_entry);
+          iter = m_simplified.erase(iter);
+        }
+      else
+        {
+          ++iter;
+        }
+    }
+}
+
+void
+TessellatedPathList::
+create_refiner(const fastuidraw::Path &path)
+{
+  using namespace fastuidraw;
+
+  TessellationParams params;
+  reference_counted_ptr<TessellatedPath> tess;
+
+  params.allow_arcs(m_allow_arcs);
+  tess = FASTUIDRAWnew TessellatedPath(path, params, &m_refiner);
+  if (m_data.empty())
+    {
+      add_element(tess);
+    }
+}
+
 const typename TessellatedPathList::TessellatedPathRef&
 TessellatedPathList::
 tessellation(const fastuidraw::Path &path, float max_distance)
@@ -1769,34 +2162,51 @@ tessellation(const fastuidraw::Path &path, float max_distance)
 
   if (m_data.empty())
     {
-      TessellationParams params;
+      create_refiner(path);
+    }
+  else
+    {
+      drop_unlinked();
+    }
 
-      params.allow_arcs(m_allow_arcs);
-      m_data.push_back(FASTUIDRAWnew TessellatedPath(path, params, &m_refiner));
+  if (max_distance <= 0.0)
+    {
+      return touch_element(m_data.front());
     }
 
-  if (max_distance <= 0.0 || path.is_flat())
+  if (!m_allow_arcs && max_distance > m_data.front().m_tess->max_distance())
     {
-      return m_data.front();
+      const TessellatedPathRef *p;
+
+      p = simplified_tessellation(max_distance);
+      if (p)
+        {
+          return *p;
+        }
     }
 
-  if (m_data.back()->max_distance() <= max_distance)
+  if (path.is_flat())
     {
-      typename std::vector<TessellatedPathRef>::const_iterator iter;
+      return touch_element(m_data.front());
+    }
+
+  if (m_data.back().m_tess->max_distance() <= max_distance)
+    {
+      typename std::vector<Element>::const_iterator iter;
       iter = std::lower_bound(m_data.begin(),
                               m_data.end(),
                               max_distance,
                               reverse_compare_max_distance());
 
       FASTUIDRAWassert(iter != m_data.end());
-      FASTUIDRAWassert(*iter);
-      FASTUIDRAWassert((*iter)->max_distance() <= max_distance);
-      return *iter;
+      FASTUIDRAWassert(iter->m_tess);
+      FASTUIDRAWassert(iter->m_tess->max_distance() <= max_distance);
+      return touch_element(*iter);
     }
 
   if (m_done)
     {
-      return m_data.back();
+      return touch_element(m_data.back());
     }
 
   unsigned int max_refine_recursion_limit;
@@ -1806,15 +2216,23 @@ tessellation(const fastuidraw::Path &path, float max_distance)
     MAX_ARC_REFINE_RECURSION_LIMIT :
     MAX_LINEAR_REFINE_RECURSION_LIMIT;
 
-  current_max_distance = m_data.back()->max_distance();
+  current_max_distance = m_data.back().m_tess->max_distance();
 
-  while(!m_done && m_data.back()->max_distance() > max_distance)
+  while(!m_done && m_data.back().m_tess->max_distance() > max_distance)
     {
       current_max_distance *= 0.5f;
-      while(!m_done && m_data.back()->max_distance() > current_max_distance)
+      while(!m_done && m_data.back().m_tess->max_distance() > current_max_distance)
         {
           TessellatedPathRef ref;
 
+          /* the Refiner is dropped when the cache evicts
+           * the TessellatedPath it holds.
+           */
+          if (!m_refiner)
+            {
+              create_refiner(path);
+            }
+
           m_refiner->refine_tessellation(current_max_distance, 1);
           ref = m_refiner->tessellated_path();
 
@@ -1823,7 +2241,7 @@ tessellation(const fastuidraw::Path &path, float max_distance)
            * (especially with arc-tessellation) more refinement can make
            * the tessellation improve.
            */
-          if (m_data.back()->max_distance() > ref->max_distance())
+          if (m_data.back().m_tess->max_distance() > ref->max_distance())
             {
               /**
               std::cout << "added on allow arcs = " << m_allow_arcs
@@ -1832,7 +2250,7 @@ tessellation(const fastuidraw::Path &path, float max_distance)
                         << ", max_recursion = " << ref->max_recursion()
                         << ")\n";
               **/
-              m_data.push_back(ref);
+              add_element(ref);
             }
 
           /* We set an absolute abort at max_refine_recursion_limit
@@ -1855,7 +2273,179 @@ tessellation(const fastuidraw::Path &path, float max_distance)
         }
     }
 
-  return m_data.back();
+  return touch_element(m_data.back());
+}
+
+const typename TessellatedPathList::TessellatedPathRef*
+TessellatedPathList::
+simplified_tessellation(float max_distance)
+{
+  const TessellatedPathRef &base(m_data.front().m_tess);
+  float tolerance, simplified_max_distance;
+  typename std::vector<Element>::iterator iter;
+  TessellatedPathRef ref;
+  int e;
+
+  /* Use the largest power of 2 not exceeding the allowed
+   * error as the tolerance so that the levels are shared
+   * across nearby requests.
+   */
+  std::frexp(max_distance - base->max_distance(), &e);
+  tolerance = std::ldexp(1.0f, e - 1);
+  if (tolerance <= m_simplify_floor)
+    {
+      return nullptr;
+    }
+
+  simplified_max_distance = base->max_distance() + tolerance;
+  for (iter = m_simplified.begin(); iter != m_simplified.end()
+         && iter->m_tess->max_distance() < simplified_max_distance; ++iter)
+    {}
+
+  if (iter != m_simplified.end() && iter->m_tess->max_distance() == simplified_max_distance)
+    {
+      return &touch_element(*iter);
+    }
+
+  ref = base->create_simplified(tolerance);
+  if (!ref || MIN_SIMPLIFY_REDUCTION * ref->number_segments() > base->number_segments())
+    {
+      m_simplify_floor = tolerance;
+      return nullptr;
+    }
+
+  Element E;
+
+  E.m_tess = ref;
+  E.m_entry = CacheAccess::add(this, ref.get(), false);
+  iter = m_simplified.insert(iter, E);
+  return &iter->m_tess;
+}
+
+/////////////////////////////////
+// SharedGeometryKey methods
+bool
+SharedGeometryKey::
+set(const std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PathContour> > &contours)
+{
+  using namespace fastuidraw;
+
+  PathContour::GeometryKey key;
+
+  m_types.clear();
+  for (const auto &contour : contours)
+    {
+      FASTUIDRAWassert(contour->ended());
+      key.add(static_cast<float>(contour->number_points()));
+      for (unsigned int i = 0, endi = contour->number_points(); i < endi; ++i)
+        {
+          const reference_counted_ptr<const PathContour::interpolator_base> &h(contour->interpolator(i));
+
+          key.add(h->start_pt())
+            .add(h->end_pt())
+            .add(static_cast<float>(h->edge_type()));
+          if (!h->add_to_geometry_key(&key))
+            {
+              return false;
+            }
+          m_types.push_back(std::type_index(typeid(*h)));
+        }
+    }
+
+  /* FNV-1a over the bits of the values and the types */
+  m_hash = 2166136261u;
+  m_values.resize(key.values().size());
+  for (unsigned int i = 0, endi = m_values.size(); i < endi; ++i)
+    {
+      m_values[i] = key.values()[i].u;
+      m_hash = (m_hash ^ m_values[i]) * 16777619u;
+    }
+  for (const std::type_index &t : m_types)
+    {
+      m_hash = (m_hash ^ static_cast<uint32_t>(t.hash_code())) * 16777619u;
+    }
+
+  return true;
+}
+
+bool
+SharedGeometryKey::
+operator<(const SharedGeometryKey &rhs) const
+{
+  /* compare by hash first so that comparisons of
+   * different geometries are almost always fast.
+   */
+  if (m_hash != rhs.m_hash)
+    {
+      return m_hash < rhs.m_hash;
+    }
+
+  if (m_values != rhs.m_values)
+    {
+      return m_values < rhs.m_values;
+    }
+
+  return m_types < rhs.m_types;
+}
+
+/////////////////////////////////
+// SharedPathGeometryPrivate methods
+SharedGeometry*
+SharedPathGeometryPrivate::
+acquire(const SharedGeometryKey &key)
+{
+  std::pair<SharedGeometryMap::iterator, bool> iter;
+
+  iter = m_geometries.insert(SharedGeometryMap::value_type(key, nullptr));
+  if (iter.second)
+    {
+      iter.first->second = FASTUIDRAWnew SharedGeometry();
+      iter.first->second->m_location = iter.first;
+    }
+  ++iter.first->second->m_number_paths;
+  return iter.first->second;
+}
+
+void
+SharedPathGeometryPrivate::
+acquire(SharedGeometry *p)
+{
+  FASTUIDRAWassert(p->m_number_paths > 0);
+  ++p->m_number_paths;
+}
+
+void
+SharedPathGeometryPrivate::
+release(SharedGeometry *p)
+{
+  FASTUIDRAWassert(p->m_number_paths > 0);
+  --p->m_number_paths;
+  if (p->m_number_paths == 0)
+    {
+      m_geometries.erase(p->m_location);
+      FASTUIDRAWdelete(p);
+    }
+}
+
+fastuidraw::SharedPathGeometry::Statistics
+SharedPathGeometryPrivate::
+statistics(void) const
+{
+  fastuidraw::SharedPathGeometry::Statistics return_value;
+
+  for (const auto &e : m_geometries)
+    {
+      uint64_t bytes;
+
+      bytes = e.second->m_tess_list.memory_consumption()
+        + e.second->m_arc_tess_list.memory_consumption();
+
+      ++return_value.m_number_geometries;
+      return_value.m_number_paths += e.second->m_number_paths;
+      return_value.m_bytes += bytes;
+      return_value.m_shared_bytes += bytes * (e.second->m_number_paths - 1u);
+    }
+  return return_value;
 }
 
 /////////////////////////////////
@@ -1865,6 +2455,8 @@ PathPrivate(fastuidraw::Path *p):
   m_next_edge_type(fastuidraw::PathEnums::starts_new_edge),
   m_tess_list(false),
   m_arc_tess_list(true),
+  m_share_group_d(nullptr),
+  m_shared(nullptr),
   m_start_check_bb(0),
   m_is_flat(true),
   m_p(p)
@@ -1877,11 +2469,19 @@ PathPrivate(fastuidraw::Path *p, const PathPrivate &obj):
   m_next_edge_type(obj.m_next_edge_type),
   m_tess_list(obj.m_tess_list),
   m_arc_tess_list(obj.m_arc_tess_list),
+  m_share_group(obj.m_share_group),
+  m_share_group_d(obj.m_share_group_d),
+  m_shared(obj.m_shared),
   m_start_check_bb(obj.m_start_check_bb),
   m_bb(obj.m_bb),
   m_is_flat(obj.m_is_flat),
   m_p(p)
 {
+  if (m_shared)
+    {
+      m_share_group_d->acquire(m_shared);
+    }
+
   /* if the last contour is not ended, we need to do a
    * deep copy on it.
    */
@@ -1892,6 +2492,40 @@ PathPrivate(fastuidraw::Path *p, const PathPrivate &obj):
     }
 }
 
+PathPrivate::
+~PathPrivate()
+{
+  if (m_shared)
+    {
+      m_share_group_d->release(m_shared);
+    }
+}
+
+TessellatedPathList&
+PathPrivate::
+tess_list(bool allow_arcs)
+{
+  if (m_share_group_d && !m_shared && !m_contours.empty())
+    {
+      SharedGeometryKey key;
+      if (key.set(m_contours))
+        {
+          /* the geometry is now held by the SharedGeometry,
+           * so drop the tessellations of this Path.
+           */
+          m_shared = m_share_group_d->acquire(key);
+          m_tess_list.clear();
+          m_arc_tess_list.clear();
+        }
+    }
+
+  if (m_shared)
+    {
+      return (allow_arcs) ? m_shared->m_arc_tess_list : m_shared->m_tess_list;
+    }
+  return (allow_arcs) ? m_arc_tess_list : m_tess_list;
+}
+
 void
 PathPrivate::
 close_back_contour(void)
@@ -1921,6 +2555,11 @@ clear_tesses(void)
 {
   m_tess_list.clear();
   m_arc_tess_list.clear();
+  if (m_shared)
+    {
+      m_share_group_d->release(m_shared);
+      m_shared = nullptr;
+    }
 }
 
 /////////////////////////////////////////
@@ -1994,6 +2633,32 @@ clear(void)
   d->m_start_check_bb = 0u;
 }
 
+fastuidraw::Path&
+fastuidraw::Path::
+share_geometry(const reference_counted_ptr<SharedPathGeometry> &v)
+{
+  PathPrivate *d;
+  d = static_cast<PathPrivate*>(m_d);
+  if (v != d->m_share_group)
+    {
+      d->clear_tesses();
+      d->m_share_group = v;
+      d->m_share_group_d = (v) ?
+        static_cast<SharedPathGeometryPrivate*>(v->m_d) :
+        nullptr;
+    }
+  return *this;
+}
+
+const fastuidraw::reference_counted_ptr<fastuidraw::SharedPathGeometry>&
+fastuidraw::Path::
+share_geometry(void) const
+{
+  PathPrivate *d;
+  d = static_cast<PathPrivate*>(m_d);
+  return d->m_share_group;
+}
+
 fastuidraw::Path&
 fastuidraw::Path::
 add_contour(const reference_counted_ptr<const PathContour> &pcontour)
@@ -2142,7 +2807,7 @@ tessellation(float max_distance) const
   PathPrivate *d;
   d = static_cast<PathPrivate*>(m_d);
   d->close_back_contour();
-  return d->m_tess_list.tessellation(*this, max_distance);
+  return d->tess_list(false).tessellation(*this, max_distance);
 }
 
 const fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>&
@@ -2159,7 +2824,7 @@ arc_tessellation(float max_distance) const
   PathPrivate *d;
   d = static_cast<PathPrivate*>(m_d);
   d->close_back_contour();
-  return d->m_arc_tess_list.tessellation(*this, max_distance);
+  return d->tess_list(true).tessellation(*this, max_distance);
 }
 
 bool
@@ -2443,3 +3108,29 @@ contour(unsigned int i) const
   d = static_cast<PathPrivate*>(m_d);
   return d->m_contours[i];
 }
+
+////////////////////////////////////////////
+// fastuidraw::SharedPathGeometry methods
+fastuidraw::SharedPathGeometry::
+SharedPathGeometry(void)
+{
+  m_d = FASTUIDRAWnew SharedPathGeometryPrivate();
+}
+
+fastuidraw::SharedPathGeometry::
+~SharedPathGeometry()
+{
+  SharedPathGeometryPrivate *d;
+  d = static_cast<SharedPathGeometryPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+fastuidraw::SharedPathGeometry::Statistics
+fastuidraw::SharedPathGeometry::
+statistics(void) const
+{
+  SharedPathGeometryPrivate *d;
+  d = static_cast<SharedPathGeometryPrivate*>(m_d);
+  return d->statistics();
+}
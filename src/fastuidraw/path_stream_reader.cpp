@@ -0,0 +1,700 @@
+/*!
+ * \file path_stream_reader.cpp
+ * \brief file path_stream_reader.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <thread>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/path_stream_reader.hpp>
+#include "private/util_private.hpp"
+
+namespace
+{
+  typedef fastuidraw::range_type<const uint8_t*> TextRange;
+
+  enum token_type_t
+    {
+      token_contour_start,
+      token_reverse_contour_start,
+      token_contour_end,
+      token_control_points_start,
+      token_control_points_end,
+      token_arc,
+      token_number,
+      token_unknown,
+    };
+
+  inline
+  bool
+  is_delimiter(uint8_t c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r'
+      || c == '\v' || c == '\f' || c == '(' || c == ')' || c == ',';
+  }
+
+  inline
+  bool
+  is_digit(uint8_t c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  /* Walks the tokens of a range of text without copying them. */
+  class Tokenizer
+  {
+  public:
+    Tokenizer(const uint8_t *begin, const uint8_t *end):
+      m_current(begin),
+      m_end(end)
+    {}
+
+    /* Returns false if there are no more tokens,
+     * otherwise writes the next token to out_token.
+     */
+    bool
+    next(TextRange *out_token)
+    {
+      while (m_current != m_end && is_delimiter(*m_current))
+        {
+          ++m_current;
+        }
+
+      if (m_current == m_end)
+        {
+          return false;
+        }
+
+      out_token->m_begin = m_current;
+      while (m_current != m_end && !is_delimiter(*m_current))
+        {
+          ++m_current;
+        }
+      out_token->m_end = m_current;
+      return true;
+    }
+
+  private:
+    const uint8_t *m_current, *m_end;
+  };
+
+  double
+  power_of_ten(int e)
+  {
+    static const double exact[] =
+      {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+        1e20, 1e21, 1e22
+      };
+
+    FASTUIDRAWassert(e >= 0);
+    if (e < int(sizeof(exact) / sizeof(exact[0])))
+      {
+        return exact[e];
+      }
+    return std::pow(10.0, e);
+  }
+
+  /* Parses a decimal floating point value from the start of
+   * a token in the same way as operator>> of std::istream,
+   * i.e. characters after the value are ignored. Returns
+   * false if the token does not start with a value.
+   */
+  bool
+  parse_float(TextRange token, float *out_value)
+  {
+    /* the mantissa holds at most 18 digits, digits past
+     * that are dropped since they are beyond the precision
+     * of a double anyways.
+     */
+    const uint64_t mantissa_limit(100000000000000000ull);
+    const uint8_t *p(token.m_begin), *end(token.m_end);
+    uint64_t mantissa(0u);
+    int exponent(0);
+    bool negative(false), have_digits(false);
+    double value;
+
+    if (p != end && (*p == '+' || *p == '-'))
+      {
+        negative = (*p == '-');
+        ++p;
+      }
+
+    for (; p != end && is_digit(*p); ++p)
+      {
+        have_digits = true;
+        if (mantissa < mantissa_limit)
+          {
+            mantissa = 10u * mantissa + (*p - '0');
+          }
+        else
+          {
+            ++exponent;
+          }
+      }
+
+    if (p != end && *p == '.')
+      {
+        for (++p; p != end && is_digit(*p); ++p)
+          {
+            have_digits = true;
+            if (mantissa < mantissa_limit)
+              {
+                mantissa = 10u * mantissa + (*p - '0');
+                --exponent;
+              }
+          }
+      }
+
+    if (!have_digits)
+      {
+        return false;
+      }
+
+    if (p != end && (*p == 'e' || *p == 'E'))
+      {
+        const uint8_t *q(p + 1);
+        bool negative_exponent(false);
+        int e(0);
+
+        if (q != end && (*q == '+' || *q == '-'))
+          {
+            negative_exponent = (*q == '-');
+            ++q;
+          }
+
+        if (q != end && is_digit(*q))
+          {
+            for (; q != end && is_digit(*q); ++q)
+              {
+                /* clamp to avoid overflow, the value is
+                 * zero or infinity by then anyways.
+                 */
+                e = fastuidraw::t_min(10 * e + (*q - '0'), 100000);
+              }
+            exponent += (negative_exponent) ? -e : e;
+          }
+      }
+
+    /* a zero mantissa is zero whatever the exponent; this
+     * avoids 0 * inf = NaN from a huge exponent.
+     */
+    value = static_cast<double>(mantissa);
+    if (mantissa != 0u && exponent > 0)
+      {
+        value *= power_of_ten(exponent);
+      }
+    else if (mantissa != 0u && exponent < 0)
+      {
+        value /= power_of_ten(-exponent);
+      }
+
+    /* like operator>>, a value too large for a float
+     * is not a number.
+     */
+    if (!(value <= static_cast<double>(std::numeric_limits<float>::max())))
+      {
+        return false;
+      }
+
+    *out_value = static_cast<float>((negative) ? -value : value);
+    return true;
+  }
+
+  enum token_type_t
+  classify_token(TextRange token, float *out_value)
+  {
+    unsigned int length(token.m_end - token.m_begin);
+    const uint8_t *p(token.m_begin);
+
+    if (length == 1 && p[0] == '[')
+      {
+        return token_contour_start;
+      }
+    else if (length == 1 && p[0] == ']')
+      {
+        return token_contour_end;
+      }
+    else if (length == 2 && p[0] == 'R' && p[1] == '[')
+      {
+        return token_reverse_contour_start;
+      }
+    else if (length == 2 && p[0] == '[' && p[1] == '[')
+      {
+        return token_control_points_start;
+      }
+    else if (length == 2 && p[0] == ']' && p[1] == ']')
+      {
+        return token_control_points_end;
+      }
+    else if (length == 3 && p[0] == 'a' && p[1] == 'r' && p[2] == 'c')
+      {
+        return token_arc;
+      }
+    else if (parse_float(token, out_value))
+      {
+        return token_number;
+      }
+    return token_unknown;
+  }
+
+  inline
+  bool
+  is_contour_start(TextRange token)
+  {
+    unsigned int length(token.m_end - token.m_begin);
+    const uint8_t *p(token.m_begin);
+
+    return (length == 1 && p[0] == '[')
+      || (length == 2 && p[0] == 'R' && p[1] == '[');
+  }
+
+  class Edge
+  {
+  public:
+    explicit
+    Edge(const fastuidraw::vec2 &pt):
+      m_pt(pt),
+      m_is_arc(false),
+      m_angle(0.0f)
+    {}
+
+    /* m_pt is the starting point of the edge and the
+     * rest of the data describe how to interpolate -to-
+     * the next point.
+     */
+    fastuidraw::vec2 m_pt;
+    std::vector<fastuidraw::vec2> m_control_pts;
+    bool m_is_arc;
+    float m_angle;
+  };
+
+  /* Parses the text of a single contour, the text starts
+   * with the token starting the contour and runs up to
+   * the token starting the next contour.
+   */
+  class ContourParser:fastuidraw::noncopyable
+  {
+  public:
+    fastuidraw::reference_counted_ptr<fastuidraw::PathContour>
+    parse(TextRange text);
+
+  private:
+    void
+    parse_edges(TextRange text);
+
+    fastuidraw::reference_counted_ptr<fastuidraw::PathContour>
+    build_contour(void) const;
+
+    std::vector<Edge> m_edges;
+  };
+
+  class PathStreamReaderPrivate:fastuidraw::noncopyable
+  {
+  public:
+    PathStreamReaderPrivate(const fastuidraw::reference_counted_ptr<const fastuidraw::DataBufferBase> &buffer,
+                            fastuidraw::c_array<const uint8_t> text):
+      m_buffer(buffer),
+      m_current(text.c_ptr()),
+      m_end(text.c_ptr() + text.size()),
+      m_number_threads(1)
+    {
+      if (text.empty())
+        {
+          m_current = m_end = nullptr;
+        }
+      skip_to_contour_start();
+    }
+
+    unsigned int
+    read_contours(fastuidraw::Path &dst, unsigned int max_contours);
+
+    fastuidraw::reference_counted_ptr<const fastuidraw::DataBufferBase> m_buffer;
+
+    /* m_current is at the start of the next contour to read */
+    const uint8_t *m_current, *m_end;
+    unsigned int m_number_threads;
+
+  private:
+    void
+    skip_to_contour_start(void);
+
+    void
+    find_contours(unsigned int max_contours);
+
+    static
+    void
+    parse_contours(fastuidraw::c_array<const TextRange> text,
+                   fastuidraw::c_array<fastuidraw::reference_counted_ptr<fastuidraw::PathContour> > dst);
+
+    std::vector<TextRange> m_contour_text;
+    std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PathContour> > m_contours;
+  };
+}
+
+//////////////////////////////////
+// ContourParser methods
+fastuidraw::reference_counted_ptr<fastuidraw::PathContour>
+ContourParser::
+parse(TextRange text)
+{
+  m_edges.clear();
+  parse_edges(text);
+  return build_contour();
+}
+
+void
+ContourParser::
+parse_edges(TextRange text)
+{
+  Tokenizer tokens(text.m_begin, text.m_end);
+  TextRange token;
+  bool reverse(false), adding_control_pts(false), arc_pending(false);
+  fastuidraw::vec2 current_value;
+  int current_slot(0);
+
+  while (tokens.next(&token))
+    {
+      float number;
+
+      switch (classify_token(token, &number))
+        {
+        case token_contour_start:
+          reverse = false;
+          break;
+
+        case token_reverse_contour_start:
+          reverse = true;
+          break;
+
+        case token_contour_end:
+          if (reverse)
+            {
+              std::reverse(m_edges.begin(), m_edges.end());
+              reverse = false;
+            }
+          break;
+
+        case token_control_points_start:
+          adding_control_pts = true;
+          break;
+
+        case token_control_points_end:
+          adding_control_pts = false;
+          break;
+
+        case token_arc:
+          arc_pending = true;
+          break;
+
+        case token_number:
+          if (arc_pending)
+            {
+              if (!m_edges.empty())
+                {
+                  m_edges.back().m_angle = number;
+                  m_edges.back().m_is_arc = true;
+                }
+              arc_pending = false;
+            }
+          else
+            {
+              current_value[current_slot] = number;
+              if (current_slot == 1)
+                {
+                  /* just finished reading a vec2 */
+                  current_slot = 0;
+                  if (!adding_control_pts)
+                    {
+                      m_edges.push_back(Edge(current_value));
+                    }
+                  else if (!m_edges.empty())
+                    {
+                      m_edges.back().m_control_pts.push_back(current_value);
+                    }
+                }
+              else
+                {
+                  current_slot = 1;
+                }
+            }
+          break;
+
+        default:
+          break;
+        }
+    }
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::PathContour>
+ContourParser::
+build_contour(void) const
+{
+  using namespace fastuidraw;
+
+  reference_counted_ptr<PathContour> C;
+  if (m_edges.empty())
+    {
+      return C;
+    }
+
+  C = FASTUIDRAWnew PathContour();
+  C->start(m_edges[0].m_pt);
+  for (unsigned int i = 0; i + 1 < m_edges.size(); ++i)
+    {
+      const Edge &current_edge(m_edges[i]);
+      const Edge &next_edge(m_edges[i + 1]);
+
+      if (!current_edge.m_is_arc)
+        {
+          for (const vec2 &ct : current_edge.m_control_pts)
+            {
+              C->add_control_point(ct);
+            }
+          C->to_point(next_edge.m_pt, PathEnums::starts_new_edge);
+        }
+      else
+        {
+          C->to_arc(current_edge.m_angle * float(M_PI) / 180.0f,
+                    next_edge.m_pt, PathEnums::starts_new_edge);
+        }
+    }
+
+  const Edge &current_edge(m_edges.back());
+  if (!current_edge.m_is_arc)
+    {
+      for (const vec2 &ct : current_edge.m_control_pts)
+        {
+          C->add_control_point(ct);
+        }
+      C->end(PathEnums::starts_new_edge);
+    }
+  else
+    {
+      C->end_arc(current_edge.m_angle * float(M_PI) / 180.0f,
+                 PathEnums::starts_new_edge);
+    }
+
+  return C;
+}
+
+///////////////////////////////////////////
+// PathStreamReaderPrivate methods
+void
+PathStreamReaderPrivate::
+skip_to_contour_start(void)
+{
+  Tokenizer tokens(m_current, m_end);
+  TextRange token;
+
+  while (tokens.next(&token))
+    {
+      if (is_contour_start(token))
+        {
+          m_current = token.m_begin;
+          return;
+        }
+    }
+  m_current = m_end;
+}
+
+void
+PathStreamReaderPrivate::
+find_contours(unsigned int max_contours)
+{
+  /* only walk the token boundaries to find where each
+   * contour starts, the values are parsed afterwards,
+   * possibly across several threads.
+   */
+  m_contour_text.clear();
+  while (m_current != m_end && m_contour_text.size() < max_contours)
+    {
+      Tokenizer tokens(m_current, m_end);
+      TextRange token, contour(m_current, m_end);
+
+      /* skip the token that starts the contour */
+      tokens.next(&token);
+      FASTUIDRAWassert(is_contour_start(token));
+
+      while (tokens.next(&token))
+        {
+          if (is_contour_start(token))
+            {
+              contour.m_end = token.m_begin;
+              break;
+            }
+        }
+
+      m_contour_text.push_back(contour);
+      m_current = contour.m_end;
+    }
+}
+
+void
+PathStreamReaderPrivate::
+parse_contours(fastuidraw::c_array<const TextRange> text,
+               fastuidraw::c_array<fastuidraw::reference_counted_ptr<fastuidraw::PathContour> > dst)
+{
+  ContourParser parser;
+
+  FASTUIDRAWassert(text.size() == dst.size());
+  for (unsigned int i = 0; i < text.size(); ++i)
+    {
+      dst[i] = parser.parse(text[i]);
+    }
+}
+
+unsigned int
+PathStreamReaderPrivate::
+read_contours(fastuidraw::Path &dst, unsigned int max_contours)
+{
+  using namespace fastuidraw;
+
+  unsigned int num_threads, num_contours;
+  std::vector<std::thread> threads;
+
+  find_contours(max_contours);
+  num_contours = m_contour_text.size();
+  m_contours.clear();
+  m_contours.resize(num_contours);
+
+  /* the contours are independent of each other, so they
+   * can be built in parallel; each thread builds a range
+   * of contours and the contours are added to dst in
+   * order once all the threads are done. PathContour
+   * objects are not reference counted atomically, but
+   * each is only touched by a single thread until the
+   * threads are joined.
+   */
+  num_threads = t_min(m_number_threads, num_contours);
+  for (unsigned int t = 1; t < num_threads; ++t)
+    {
+      unsigned int begin, end;
+
+      begin = (t * num_contours) / num_threads;
+      end = ((t + 1) * num_contours) / num_threads;
+      threads.push_back(std::thread(parse_contours,
+                                    make_c_array(m_contour_text).sub_array(begin, end - begin),
+                                    make_c_array(m_contours).sub_array(begin, end - begin)));
+    }
+
+  if (num_contours > 0)
+    {
+      unsigned int end;
+
+      end = (num_threads > 1) ? num_contours / num_threads : num_contours;
+      parse_contours(make_c_array(m_contour_text).sub_array(0, end),
+                     make_c_array(m_contours).sub_array(0, end));
+    }
+
+  for (std::thread &th : threads)
+    {
+      th.join();
+    }
+
+  for (const reference_counted_ptr<PathContour> &C : m_contours)
+    {
+      if (C)
+        {
+          dst.add_contour(C);
+        }
+    }
+  m_contours.clear();
+
+  return num_contours;
+}
+
+///////////////////////////////////////
+// fastuidraw::PathStreamReader methods
+fastuidraw::PathStreamReader::
+PathStreamReader(const reference_counted_ptr<const DataBufferBase> &buffer)
+{
+  m_d = FASTUIDRAWnew PathStreamReaderPrivate(buffer, buffer->data_ro());
+}
+
+fastuidraw::PathStreamReader::
+PathStreamReader(c_array<const uint8_t> text)
+{
+  m_d = FASTUIDRAWnew PathStreamReaderPrivate(nullptr, text);
+}
+
+fastuidraw::PathStreamReader::
+~PathStreamReader()
+{
+  PathStreamReaderPrivate *d;
+  d = static_cast<PathStreamReaderPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+unsigned int
+fastuidraw::PathStreamReader::
+number_threads(void) const
+{
+  PathStreamReaderPrivate *d;
+  d = static_cast<PathStreamReaderPrivate*>(m_d);
+  return d->m_number_threads;
+}
+
+fastuidraw::PathStreamReader&
+fastuidraw::PathStreamReader::
+number_threads(unsigned int n)
+{
+  PathStreamReaderPrivate *d;
+  d = static_cast<PathStreamReaderPrivate*>(m_d);
+  d->m_number_threads = t_max(n, 1u);
+  return *this;
+}
+
+unsigned int
+fastuidraw::PathStreamReader::
+read_contours(Path &dst, unsigned int max_contours)
+{
+  PathStreamReaderPrivate *d;
+  d = static_cast<PathStreamReaderPrivate*>(m_d);
+  return d->read_contours(dst, max_contours);
+}
+
+bool
+fastuidraw::PathStreamReader::
+at_end(void) const
+{
+  PathStreamReaderPrivate *d;
+  d = static_cast<PathStreamReaderPrivate*>(m_d);
+  return d->m_current == d->m_end;
+}
+
+void
+fastuidraw::PathStreamReader::
+read_path(Path &dst, c_array<const uint8_t> text,
+          unsigned int number_threads)
+{
+  PathStreamReader reader(text);
+
+  reader.number_threads(number_threads);
+  while (!reader.at_end())
+    {
+      /* read in chunks so that the list of contour text
+       * ranges does not get large.
+       */
+      reader.read_contours(dst, 4096);
+    }
+}
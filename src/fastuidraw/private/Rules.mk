@@ -4,7 +4,10 @@ dirstack_$(sp)	:= $(d)
 d		:= $(dir)
 # End standard header
 
-FASTUIDRAW_PRIVATE_SOURCES += $(call filelist, interval_allocator.cpp path_util_private.cpp clip.cpp int_path.cpp)
+FASTUIDRAW_PRIVATE_SOURCES += $(call filelist, interval_allocator.cpp path_util_private.cpp clip.cpp int_path.cpp \
+	box_hierarchy.cpp \
+	segregated_interval_allocator.cpp \
+	block_compress.cpp)
 
 # Begin standard footer
 d		:= $(dirstack_$(sp))
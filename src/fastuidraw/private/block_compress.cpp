@@ -0,0 +1,379 @@
+/*!
+ * \file block_compress.cpp
+ * \brief file block_compress.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <algorithm>
+#include "block_compress.hpp"
+
+namespace
+{
+  inline
+  uint16_t
+  pack_565(fastuidraw::ivec3 c)
+  {
+    return ((c.x() >> 3) << 11) | ((c.y() >> 2) << 5) | (c.z() >> 3);
+  }
+
+  inline
+  fastuidraw::ivec3
+  unpack_565(uint16_t v)
+  {
+    int r((v >> 11) & 31), g((v >> 5) & 63), b(v & 31);
+    return fastuidraw::ivec3((r << 3) | (r >> 2),
+                             (g << 2) | (g >> 4),
+                             (b << 3) | (b >> 2));
+  }
+
+  inline
+  uint16_t
+  read_uint16(const uint8_t *src)
+  {
+    return uint16_t(src[0]) | (uint16_t(src[1]) << 8u);
+  }
+
+  inline
+  void
+  write_uint16(uint8_t *dst, uint16_t v)
+  {
+    dst[0] = v & 0xFF;
+    dst[1] = v >> 8u;
+  }
+
+  inline
+  int
+  dot3(fastuidraw::ivec3 a, fastuidraw::ivec3 b)
+  {
+    return a.x() * b.x() + a.y() * b.y() + a.z() * b.z();
+  }
+
+  /* Encode the 8-byte color portion of a block; if
+   * allow_transparent is true, then texels with alpha
+   * less than 128 are encoded as transparent using the
+   * 3-color mode of BC1.
+   */
+  void
+  encode_color_block(const fastuidraw::u8vec4 *texels, bool allow_transparent,
+                     uint8_t *dst)
+  {
+    using namespace fastuidraw;
+
+    ivec3 mn(255, 255, 255), mx(0, 0, 0), inset, center, cov;
+    unsigned int major;
+    bool has_transparent(false), has_opaque(false);
+    uint32_t indices(0u);
+    uint16_t c0, c1;
+
+    for (unsigned int i = 0; i < 16; ++i)
+      {
+        if (allow_transparent && texels[i].w() < 128u)
+          {
+            has_transparent = true;
+            continue;
+          }
+
+        has_opaque = true;
+        for (unsigned int c = 0; c < 3; ++c)
+          {
+            mn[c] = t_min(mn[c], int(texels[i][c]));
+            mx[c] = t_max(mx[c], int(texels[i][c]));
+          }
+      }
+
+    if (!has_opaque)
+      {
+        /* c0 <= c1 gives 3-color mode where index 3 is transparent */
+        write_uint16(dst, 0u);
+        write_uint16(dst + 2, 0u);
+        dst[4] = dst[5] = dst[6] = dst[7] = 0xFF;
+        return;
+      }
+
+    /* pull the end points in by 1/16 of the range, which
+     * reduces the error from the extremes of the box
+     */
+    inset = (mx - mn) / 16;
+    mn += inset;
+    mx -= inset;
+
+    /* the box diagonal from mn to mx only fits colors whose
+     * channels increase together; flip a channel against the
+     * channel of largest range when they are anti-correlated.
+     */
+    major = 0;
+    for (unsigned int c = 1; c < 3; ++c)
+      {
+        if (mx[c] - mn[c] > mx[major] - mn[major])
+          {
+            major = c;
+          }
+      }
+
+    center = (mn + mx) / 2;
+    cov = ivec3(0, 0, 0);
+    for (unsigned int i = 0; i < 16; ++i)
+      {
+        if (allow_transparent && texels[i].w() < 128u)
+          {
+            continue;
+          }
+        for (unsigned int c = 0; c < 3; ++c)
+          {
+            cov[c] += (int(texels[i][major]) - center[major]) * (int(texels[i][c]) - center[c]);
+          }
+      }
+
+    for (unsigned int c = 0; c < 3; ++c)
+      {
+        if (cov[c] < 0)
+          {
+            std::swap(mn[c], mx[c]);
+          }
+      }
+
+    c0 = pack_565(mx);
+    c1 = pack_565(mn);
+
+    /* 3-color mode requires c0 <= c1, 4-color mode c0 > c1 */
+    if (has_transparent != (c0 <= c1))
+      {
+        std::swap(c0, c1);
+      }
+
+    ivec3 e0(unpack_565(c0)), e1(unpack_565(c1)), d(e1 - e0);
+    int dd(dot3(d, d));
+
+    for (unsigned int i = 0; i < 16; ++i)
+      {
+        uint32_t idx(0u);
+
+        if (has_transparent && texels[i].w() < 128u)
+          {
+            idx = 3u;
+          }
+        else if (dd > 0)
+          {
+            ivec3 p(texels[i].x(), texels[i].y(), texels[i].z());
+            int num(dot3(p - e0, d));
+
+            if (has_transparent)
+              {
+                /* palette: e0, e1, (e0 + e1) / 2 */
+                num *= 4;
+                idx = (num < dd) ? 0u : (num < 3 * dd) ? 2u : 1u;
+              }
+            else
+              {
+                /* palette: e0, e1, (2e0 + e1) / 3, (e0 + 2e1) / 3 */
+                num *= 6;
+                idx = (num < dd) ? 0u : (num < 3 * dd) ? 2u : (num < 5 * dd) ? 3u : 1u;
+              }
+          }
+        indices |= (idx << (2u * i));
+      }
+
+    write_uint16(dst, c0);
+    write_uint16(dst + 2, c1);
+    write_uint16(dst + 4, indices & 0xFFFF);
+    write_uint16(dst + 6, indices >> 16u);
+  }
+
+  /* Encode the 8-byte alpha portion of a BC3 block
+   * using the 8-value mode (a0 > a1).
+   */
+  void
+  encode_alpha_block(const fastuidraw::u8vec4 *texels, uint8_t *dst)
+  {
+    int a_min(255), a_max(0), range;
+    uint64_t indices(0u);
+
+    for (unsigned int i = 0; i < 16; ++i)
+      {
+        a_min = std::min(a_min, int(texels[i].w()));
+        a_max = std::max(a_max, int(texels[i].w()));
+      }
+
+    dst[0] = a_max;
+    dst[1] = a_min;
+    range = a_max - a_min;
+    if (range > 0)
+      {
+        for (unsigned int i = 0; i < 16; ++i)
+          {
+            uint64_t step, idx;
+
+            /* step 0 is a_max, step 7 is a_min */
+            step = ((a_max - int(texels[i].w())) * 7 + range / 2) / range;
+            idx = (step == 0u) ? 0u : (step == 7u) ? 1u : step + 1u;
+            indices |= (idx << (3u * i));
+          }
+      }
+
+    for (unsigned int i = 0; i < 6; ++i)
+      {
+        dst[2 + i] = (indices >> (8u * i)) & 0xFF;
+      }
+  }
+
+  fastuidraw::u8vec4
+  decode_color_texel(const uint8_t *block, bool force_four_color, unsigned int i)
+  {
+    using namespace fastuidraw;
+
+    uint16_t c0(read_uint16(block)), c1(read_uint16(block + 2));
+    uint32_t indices, idx;
+    ivec3 e0(unpack_565(c0)), e1(unpack_565(c1)), c;
+
+    indices = uint32_t(read_uint16(block + 4)) | (uint32_t(read_uint16(block + 6)) << 16u);
+    idx = (indices >> (2u * i)) & 3u;
+    switch (idx)
+      {
+      case 0:
+        c = e0;
+        break;
+      case 1:
+        c = e1;
+        break;
+      case 2:
+        c = (force_four_color || c0 > c1) ?
+          (2 * e0 + e1) / 3 :
+          (e0 + e1) / 2;
+        break;
+      default:
+        if (!force_four_color && c0 <= c1)
+          {
+            return u8vec4(0, 0, 0, 0);
+          }
+        c = (e0 + 2 * e1) / 3;
+      }
+
+    return u8vec4(c.x(), c.y(), c.z(), 255);
+  }
+
+  uint8_t
+  decode_alpha_texel(const uint8_t *block, unsigned int i)
+  {
+    int a0(block[0]), a1(block[1]);
+    uint64_t indices(0u);
+    unsigned int idx;
+
+    for (unsigned int b = 0; b < 6; ++b)
+      {
+        indices |= (uint64_t(block[2 + b]) << (8u * b));
+      }
+    idx = (indices >> (3u * i)) & 7u;
+
+    if (idx == 0u)
+      {
+        return a0;
+      }
+
+    if (idx == 1u)
+      {
+        return a1;
+      }
+
+    if (a0 > a1)
+      {
+        return ((8 - idx) * a0 + (idx - 1) * a1) / 7;
+      }
+
+    if (idx < 6u)
+      {
+        return ((6 - idx) * a0 + (idx - 1) * a1) / 5;
+      }
+
+    return (idx == 6u) ? 0u : 255u;
+  }
+}
+
+unsigned int
+fastuidraw::detail::
+block_compression_bytes_per_block(enum AtlasColorBackingStoreBase::compression_t tp)
+{
+  switch (tp)
+    {
+    case AtlasColorBackingStoreBase::bc1_compression:
+      return 8;
+    case AtlasColorBackingStoreBase::bc3_compression:
+      return 16;
+    default:
+      return 0;
+    }
+}
+
+void
+fastuidraw::detail::
+block_compress(enum AtlasColorBackingStoreBase::compression_t tp,
+               int w, int h, c_array<const u8vec4> texels,
+               c_array<uint8_t> dst)
+{
+  unsigned int bytes_per_block(block_compression_bytes_per_block(tp));
+  uint8_t *block;
+  u8vec4 block_texels[16];
+
+  FASTUIDRAWassert(bytes_per_block != 0);
+  FASTUIDRAWassert(w % 4 == 0 && h % 4 == 0);
+  FASTUIDRAWassert(texels.size() >= static_cast<unsigned int>(w * h));
+  FASTUIDRAWassert(dst.size() >= bytes_per_block * (w / 4) * (h / 4));
+
+  block = dst.c_ptr();
+  for (int by = 0; by < h; by += 4)
+    {
+      for (int bx = 0; bx < w; bx += 4, block += bytes_per_block)
+        {
+          for (int y = 0; y < 4; ++y)
+            {
+              for (int x = 0; x < 4; ++x)
+                {
+                  block_texels[x + 4 * y] = texels[bx + x + (by + y) * w];
+                }
+            }
+
+          if (tp == AtlasColorBackingStoreBase::bc3_compression)
+            {
+              encode_alpha_block(block_texels, block);
+              encode_color_block(block_texels, false, block + 8);
+            }
+          else
+            {
+              encode_color_block(block_texels, true, block);
+            }
+        }
+    }
+}
+
+fastuidraw::u8vec4
+fastuidraw::detail::
+block_decompress_texel(enum AtlasColorBackingStoreBase::compression_t tp,
+                       const uint8_t *block, int x, int y)
+{
+  unsigned int i(x + 4 * y);
+
+  FASTUIDRAWassert(x >= 0 && x < 4 && y >= 0 && y < 4);
+  if (tp == AtlasColorBackingStoreBase::bc3_compression)
+    {
+      u8vec4 return_value;
+
+      /* the color block of BC3 is always in 4-color mode */
+      return_value = decode_color_texel(block + 8, true, i);
+      return_value.w() = decode_alpha_texel(block, i);
+      return return_value;
+    }
+
+  FASTUIDRAWassert(tp == AtlasColorBackingStoreBase::bc1_compression);
+  return decode_color_texel(block, false, i);
+}
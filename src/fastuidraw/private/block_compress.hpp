@@ -0,0 +1,58 @@
+/*!
+ * \file block_compress.hpp
+ * \brief file block_compress.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/image.hpp>
+
+namespace fastuidraw
+{
+  namespace detail
+  {
+    /* Returns the number of bytes of a single 4x4 block
+     * for the named compression; returns 0 for
+     * AtlasColorBackingStoreBase::uncompressed.
+     */
+    unsigned int
+    block_compression_bytes_per_block(enum AtlasColorBackingStoreBase::compression_t tp);
+
+    /* Compress a w-by-h region of texels (row major, w and h
+     * multiples of 4) into blocks written row-major to dst.
+     * The encoder is the fast bounding box encoder: the end
+     * points of each block are the corners of the (inset)
+     * bounding box of the colors of the block and each texel
+     * takes the closest palette entry along the diagonal. For
+     * BC1, a block with any texel with alpha less than 128 is
+     * encoded in 3-color mode with such texels transparent.
+     */
+    void
+    block_compress(enum AtlasColorBackingStoreBase::compression_t tp,
+                   int w, int h, c_array<const u8vec4> texels,
+                   c_array<uint8_t> dst);
+
+    /* Decode the texel at (x, y), 0 <= x, y < 4, of a
+     * single compressed block.
+     */
+    u8vec4
+    block_decompress_texel(enum AtlasColorBackingStoreBase::compression_t tp,
+                           const uint8_t *block, int x, int y);
+  }
+}
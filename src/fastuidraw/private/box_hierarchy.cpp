@@ -0,0 +1,225 @@
+/*!
+ * \file box_hierarchy.cpp
+ * \brief file box_hierarchy.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+#include "box_hierarchy.hpp"
+#include "util_private.hpp"
+
+//////////////////////////////////////////
+// fastuidraw::detail::BoxHierarchy methods
+unsigned int
+fastuidraw::detail::BoxHierarchy::
+add_node(const BoundingBox<float> &box)
+{
+  unsigned int return_value(m_subtree_end.size());
+
+  if (return_value % group_size == 0)
+    {
+      unsigned int sz(return_value + group_size);
+
+      m_min_x.resize(sz, 0.0f);
+      m_min_y.resize(sz, 0.0f);
+      m_max_x.resize(sz, 0.0f);
+      m_max_y.resize(sz, 0.0f);
+      m_empty.resize(sz, 1u);
+    }
+
+  if (!box.empty())
+    {
+      m_min_x[return_value] = box.min_point().x();
+      m_min_y[return_value] = box.min_point().y();
+      m_max_x[return_value] = box.max_point().x();
+      m_max_y[return_value] = box.max_point().y();
+      m_empty[return_value] = 0u;
+    }
+  m_subtree_end.push_back(return_value + 1);
+
+  return return_value;
+}
+
+void
+fastuidraw::detail::BoxHierarchy::
+end_node(unsigned int node)
+{
+  FASTUIDRAWassert(node < m_subtree_end.size());
+  m_subtree_end[node] = m_subtree_end.size();
+}
+
+void
+fastuidraw::detail::BoxHierarchy::
+classify(c_array<const vec3> clip_eq, float rad, unsigned int group,
+         vecN<enum visibility_t, group_size> &dst) const
+{
+  unsigned int begin(group * group_size);
+  int all_in_mask, any_out_mask;
+
+  FASTUIDRAWassert(begin + group_size <= m_min_x.size());
+
+  /* For each clip equation, the corner of a box with the
+   * smallest clip distance is the one whose coordinates are
+   * the minimum where the coefficient of the equation is
+   * positive and the maximum where it is negative; the corner
+   * with the largest clip distance is the opposite corner. The
+   * box is unclipped if the smallest distance is non-negative
+   * for every equation and is culled if the largest distance
+   * is negative for some equation. The clip distances are
+   * computed with the same operations as detail::clip_against_planes()
+   * so that the results agree with clipping the box.
+   */
+#if defined(__SSE__)
+  {
+    __m128 r, zero, min_x, min_y, max_x, max_y, all_in, any_out;
+
+    r = _mm_set1_ps(rad);
+    zero = _mm_setzero_ps();
+    min_x = _mm_sub_ps(_mm_loadu_ps(&m_min_x[begin]), r);
+    min_y = _mm_sub_ps(_mm_loadu_ps(&m_min_y[begin]), r);
+    max_x = _mm_add_ps(_mm_loadu_ps(&m_max_x[begin]), r);
+    max_y = _mm_add_ps(_mm_loadu_ps(&m_max_y[begin]), r);
+    all_in = _mm_cmpeq_ps(zero, zero);
+    any_out = zero;
+
+    for(const vec3 &eq : clip_eq)
+      {
+        __m128 a, b, c, near_x, near_y, far_x, far_y, d_near, d_far;
+
+        a = _mm_set1_ps(eq.x());
+        b = _mm_set1_ps(eq.y());
+        c = _mm_set1_ps(eq.z());
+        near_x = (eq.x() >= 0.0f) ? min_x : max_x;
+        far_x = (eq.x() >= 0.0f) ? max_x : min_x;
+        near_y = (eq.y() >= 0.0f) ? min_y : max_y;
+        far_y = (eq.y() >= 0.0f) ? max_y : min_y;
+
+        d_near = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, near_x), _mm_mul_ps(b, near_y)), c);
+        d_far = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, far_x), _mm_mul_ps(b, far_y)), c);
+        all_in = _mm_and_ps(all_in, _mm_cmpge_ps(d_near, zero));
+        any_out = _mm_or_ps(any_out, _mm_cmplt_ps(d_far, zero));
+      }
+
+    all_in_mask = _mm_movemask_ps(all_in);
+    any_out_mask = _mm_movemask_ps(any_out);
+  }
+#else
+  {
+    all_in_mask = (1 << group_size) - 1;
+    any_out_mask = 0;
+    for(unsigned int k = 0; k < group_size; ++k)
+      {
+        float min_x(m_min_x[begin + k] - rad), min_y(m_min_y[begin + k] - rad);
+        float max_x(m_max_x[begin + k] + rad), max_y(m_max_y[begin + k] + rad);
+
+        for(const vec3 &eq : clip_eq)
+          {
+            float near_x, near_y, far_x, far_y, d_near, d_far;
+
+            near_x = (eq.x() >= 0.0f) ? min_x : max_x;
+            far_x = (eq.x() >= 0.0f) ? max_x : min_x;
+            near_y = (eq.y() >= 0.0f) ? min_y : max_y;
+            far_y = (eq.y() >= 0.0f) ? max_y : min_y;
+
+            d_near = eq.x() * near_x + eq.y() * near_y + eq.z();
+            d_far = eq.x() * far_x + eq.y() * far_y + eq.z();
+            if (!(d_near >= 0.0f))
+              {
+                all_in_mask &= ~(1 << k);
+              }
+            if (d_far < 0.0f)
+              {
+                any_out_mask |= (1 << k);
+              }
+          }
+      }
+  }
+#endif
+
+  for(unsigned int k = 0; k < group_size; ++k)
+    {
+      if (m_empty[begin + k] || (any_out_mask & (1 << k)))
+        {
+          dst[k] = box_culled;
+        }
+      else if (all_in_mask & (1 << k))
+        {
+          dst[k] = box_unclipped;
+        }
+      else
+        {
+          dst[k] = box_clipped;
+        }
+    }
+}
+
+/////////////////////////////////////////////////
+// fastuidraw::detail::BoxHierarchy::Query methods
+void
+fastuidraw::detail::BoxHierarchy::Query::
+begin(const BoxHierarchy &hierarchy, c_array<const vec3> clip_eq, float rad)
+{
+  m_hierarchy = &hierarchy;
+  m_clip_eq = clip_eq;
+  m_rad = rad;
+  m_group = ~0u;
+}
+
+enum fastuidraw::detail::BoxHierarchy::visibility_t
+fastuidraw::detail::BoxHierarchy::Query::
+visibility(unsigned int node)
+{
+  unsigned int group(node / group_size), k(node % group_size);
+
+  FASTUIDRAWassert(m_hierarchy);
+  FASTUIDRAWassert(node < m_hierarchy->size());
+  if (group != m_group)
+    {
+      m_hierarchy->classify(m_clip_eq, m_rad, group, m_group_visibility);
+      m_group = group;
+    }
+
+  if (m_group_visibility[k] == box_clipped)
+    {
+      /* the box is neither completely inside nor completely
+       * outside of any one clip equation; it may still be
+       * culled by several clip equations together.
+       */
+      vecN<vec2, 4> bb;
+      c_array<const vec2> clipped;
+      float min_x(m_hierarchy->m_min_x[node] - m_rad), min_y(m_hierarchy->m_min_y[node] - m_rad);
+      float max_x(m_hierarchy->m_max_x[node] + m_rad), max_y(m_hierarchy->m_max_y[node] + m_rad);
+      bool unclipped;
+
+      bb[0] = vec2(min_x, min_y);
+      bb[1] = vec2(max_x, min_y);
+      bb[2] = vec2(max_x, max_y);
+      bb[3] = vec2(min_x, max_y);
+      unclipped = clip_against_planes(m_clip_eq, bb, &clipped, m_clip_work_room);
+      if (clipped.empty())
+        {
+          m_group_visibility[k] = box_culled;
+        }
+      else if (unclipped)
+        {
+          m_group_visibility[k] = box_unclipped;
+        }
+    }
+
+  return m_group_visibility[k];
+}
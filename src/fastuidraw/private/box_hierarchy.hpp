@@ -0,0 +1,137 @@
+/*!
+ * \file box_hierarchy.hpp
+ * \brief file box_hierarchy.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include "bounding_box.hpp"
+#include "clip.hpp"
+
+namespace fastuidraw
+{
+  namespace detail
+  {
+    /* A BoxHierarchy is the bounding boxes of a binary hierarchy
+     * flattened into arrays in pre-order, i.e. a node is followed
+     * by the nodes of the subtree of its first child and then by
+     * the nodes of the subtree of its second child. The boxes are
+     * stored as separate arrays of their coordinates so that the
+     * visibility of several boxes is computed at once.
+     */
+    class BoxHierarchy
+    {
+    public:
+      enum visibility_t
+        {
+          box_culled,
+          box_unclipped,
+          box_clipped,
+        };
+
+      /* Number of boxes whose visibility is computed at once */
+      enum
+        {
+          group_size = 4
+        };
+
+      /* Add a node; nodes must be added in pre-order and the
+       * return value is the index of the node, i.e. the number
+       * of nodes added before it. An empty box is always culled.
+       */
+      unsigned int
+      add_node(const BoundingBox<float> &box);
+
+      /* Mark that all the nodes of the subtree of the named
+       * node have been added.
+       */
+      void
+      end_node(unsigned int node);
+
+      unsigned int
+      size(void) const
+      {
+        return m_subtree_end.size();
+      }
+
+      /* Returns the index of the node after the subtree of
+       * the named node.
+       */
+      unsigned int
+      subtree_end(unsigned int node) const
+      {
+        return m_subtree_end[node];
+      }
+
+      /* A Query computes the visibility of the boxes of a
+       * BoxHierarchy against a set of clip equations in the
+       * same coordinate system as the boxes, where each box
+       * is first inflated by a fixed amount.
+       */
+      class Query
+      {
+      public:
+        Query(void):
+          m_hierarchy(nullptr),
+          m_rad(0.0f),
+          m_group(~0u)
+        {}
+
+        /* Start a query; the clip equations are NOT copied,
+         * so they must stay valid for the duration of the
+         * query.
+         */
+        void
+        begin(const BoxHierarchy &hierarchy, c_array<const vec3> clip_eq,
+              float rad);
+
+        /* Returns the visibility of the named node. The visibility
+         * of the nodes is computed a group at a time with SIMD by
+         * comparing the nearest and furthest corners of each box
+         * against each clip equation; only those boxes that are
+         * neither unclipped nor outside of a single clip equation
+         * are clipped against the clip equations to determine
+         * if they are culled.
+         */
+        enum visibility_t
+        visibility(unsigned int node);
+
+      private:
+        const BoxHierarchy *m_hierarchy;
+        c_array<const vec3> m_clip_eq;
+        float m_rad;
+        unsigned int m_group;
+        vecN<enum visibility_t, group_size> m_group_visibility;
+        ClipWorkRoom m_clip_work_room;
+      };
+
+    private:
+      void
+      classify(c_array<const vec3> clip_eq, float rad, unsigned int group,
+               vecN<enum visibility_t, group_size> &dst) const;
+
+      /* the arrays of coordinates are padded to a multiple of group_size */
+      std::vector<float> m_min_x, m_min_y, m_max_x, m_max_y;
+      std::vector<uint8_t> m_empty;
+      std::vector<unsigned int> m_subtree_end;
+    };
+  }
+}
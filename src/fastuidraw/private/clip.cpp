@@ -16,6 +16,10 @@
  *
  */
 
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
 #include "clip.hpp"
 #include "util_private.hpp"
 
@@ -39,6 +43,37 @@ namespace
     t = d0 / (d0 - d1);
     return (1.0 - t) * p0 + t * p1;
   }
+
+  /* Clip the polygon pts against a plane where dists[i] is the
+   * clip distance of pts[i], writing the clipped polygon to dst.
+   */
+  void
+  clip_against_plane_dists(fastuidraw::c_array<const fastuidraw::vec2> pts,
+                           fastuidraw::c_array<const float> dists,
+                           fastuidraw::vec2 *dst)
+  {
+    unsigned int prev(pts.size() - 1);
+    bool prev_in(dists[prev] >= 0.0f);
+
+    for(unsigned int i = 0; i < pts.size(); prev = i, ++i)
+      {
+        bool current_in(dists[i] >= 0.0f);
+
+        if (current_in != prev_in)
+          {
+            *dst = compute_intersection(pts[prev], dists[prev],
+                                        pts[i], dists[i]);
+            ++dst;
+          }
+
+        if (current_in)
+          {
+            *dst = pts[i];
+            ++dst;
+          }
+        prev_in = current_in;
+      }
+  }
 }
 
 bool
@@ -106,3 +141,119 @@ clip_against_planes(c_array<const vec3> clip_eq, c_array<const vec2> in_pts,
   std::swap(out_pts, scratch_space_vec2s[src]);
   return unclipped;
 }
+
+void
+fastuidraw::detail::
+compute_clip_distances(const vec3 &clip_eq, c_array<const vec2> pts,
+                       c_array<float> dst)
+{
+  unsigned int i(0);
+
+  FASTUIDRAWassert(dst.size() >= pts.size());
+
+#if defined(__SSE__)
+  {
+    /* the points are packed as x0, y0, x1, y1, ..., so two
+     * loads give four points that are then shuffled into
+     * a register of x-coordinates and a register of
+     * y-coordinates.
+     */
+    const float *src(reinterpret_cast<const float*>(pts.c_ptr()));
+    __m128 a(_mm_set1_ps(clip_eq.x()));
+    __m128 b(_mm_set1_ps(clip_eq.y()));
+    __m128 c(_mm_set1_ps(clip_eq.z()));
+
+    for(; i + 4 <= pts.size(); i += 4)
+      {
+        __m128 p01, p23, x, y, d;
+
+        p01 = _mm_loadu_ps(src + 2 * i);
+        p23 = _mm_loadu_ps(src + 2 * i + 4);
+        x = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+        y = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+        d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y)), c);
+        _mm_storeu_ps(dst.c_ptr() + i, d);
+      }
+  }
+#endif
+
+  for(; i < pts.size(); ++i)
+    {
+      dst[i] = compute_clip_dist(clip_eq, pts[i]);
+    }
+}
+
+bool
+fastuidraw::detail::
+clip_against_planes(c_array<const vec3> clip_eq, c_array<const vec2> in_pts,
+                    c_array<const vec2> *out_pts, ClipWorkRoom &work_room)
+{
+  c_array<const vec2> current(in_pts);
+  unsigned int dst(0), i;
+  bool unclipped(true);
+
+  for(i = 0; i < clip_eq.size() && !current.empty(); ++i)
+    {
+      unsigned int num_in(0), num_crossings(0), num_out;
+      c_array<float> dists;
+      bool prev_in;
+
+      if (current.size() > ClipWorkRoom::max_points)
+        {
+          break;
+        }
+
+      dists = c_array<float>(work_room.m_dists.c_ptr(), current.size());
+      compute_clip_distances(clip_eq[i], current, dists);
+
+      prev_in = (dists.back() >= 0.0f);
+      for(float d : dists)
+        {
+          bool in(d >= 0.0f);
+
+          num_in += (in) ? 1u : 0u;
+          num_crossings += (in != prev_in) ? 1u : 0u;
+          prev_in = in;
+        }
+
+      if (num_in == current.size())
+        {
+          continue;
+        }
+
+      unclipped = false;
+      if (num_in == 0)
+        {
+          current = c_array<const vec2>();
+          break;
+        }
+
+      num_out = num_in + num_crossings;
+      if (num_out > ClipWorkRoom::max_points)
+        {
+          break;
+        }
+
+      clip_against_plane_dists(current, dists, work_room.m_pts[dst].c_ptr());
+      current = c_array<const vec2>(work_room.m_pts[dst].c_ptr(), num_out);
+      dst = 1 - dst;
+    }
+
+  if (i < clip_eq.size() && !current.empty())
+    {
+      /* the polygon has too many points for the fixed
+       * capacity storage, finish with the std::vector
+       * based clipping.
+       */
+      bool r;
+
+      r = clip_against_planes(clip_eq.sub_array(i), current,
+                              work_room.m_fallback_pts,
+                              work_room.m_fallback_scratch);
+      unclipped = unclipped && r;
+      current = make_c_array(work_room.m_fallback_pts);
+    }
+
+  *out_pts = current;
+  return unclipped;
+}
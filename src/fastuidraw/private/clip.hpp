@@ -45,5 +45,49 @@ namespace fastuidraw
     clip_against_planes(c_array<const vec3> clip_eq, c_array<const vec2> in_pts,
                         std::vector<vec2> &out_pts,
                         vecN<std::vector<vec2>, 2> &scratch_space_vec2s);
+
+    /* Fixed capacity scratch space for the batched clipping
+     * below; a polygon with more than max_points points at any
+     * stage of the clipping is handled by the std::vector based
+     * clip_against_planes() using m_fallback_pts and
+     * m_fallback_scratch.
+     */
+    class ClipWorkRoom
+    {
+    public:
+      enum
+        {
+          max_points = 32
+        };
+
+      vecN<vecN<vec2, max_points>, 2> m_pts;
+      vecN<float, max_points> m_dists;
+
+      std::vector<vec2> m_fallback_pts;
+      vecN<std::vector<vec2>, 2> m_fallback_scratch;
+    };
+
+    /* Compute the clip distance of each point of pts against
+     * clip_eq, i.e. dst[i] = dot(clip_eq, vec3(pts[i], 1)).
+     * Uses SSE when available to evaluate four points at a
+     * time. dst must be at least as large as pts.
+     */
+    void
+    compute_clip_distances(const vec3 &clip_eq, c_array<const vec2> pts,
+                           c_array<float> dst);
+
+    /* Batched variant of clip_against_planes(); the clip distances
+     * against each plane are computed for all points at once with
+     * compute_clip_distances() and the clipped polygon is written
+     * to the fixed capacity storage of work_room. A plane that does
+     * not clip the polygon is skipped without copying points and
+     * clipping stops at the first plane that clips all of it. On
+     * return, *out_pts is backed either by in_pts or by work_room,
+     * so it is only valid until work_room is used again. Returns
+     * true if the polygon is completely unclipped.
+     */
+    bool
+    clip_against_planes(c_array<const vec3> clip_eq, c_array<const vec2> in_pts,
+                        c_array<const vec2> *out_pts, ClipWorkRoom &work_room);
   }
 }
@@ -0,0 +1,430 @@
+/*!
+ * \file segregated_interval_allocator.cpp
+ * \brief file segregated_interval_allocator.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <algorithm>
+#include "segregated_interval_allocator.hpp"
+
+namespace
+{
+  /* index of the lowest and highest bit up of a non-zero value */
+  inline
+  int
+  lowest_bit(uint32_t v)
+  {
+    FASTUIDRAWassert(v != 0u);
+    #if defined(__GNUC__)
+      {
+        return __builtin_ctz(v);
+      }
+    #else
+      {
+        int r(0);
+        for (; (v & 1u) == 0u; v >>= 1u, ++r)
+          {}
+        return r;
+      }
+    #endif
+  }
+
+  inline
+  int
+  highest_bit(uint32_t v)
+  {
+    FASTUIDRAWassert(v != 0u);
+    #if defined(__GNUC__)
+      {
+        return 31 - __builtin_clz(v);
+      }
+    #else
+      {
+        int r(0);
+        for (; v >>= 1u; ++r)
+          {}
+        return r;
+      }
+    #endif
+  }
+
+  inline
+  int
+  count_bits(uint64_t v)
+  {
+    #if defined(__GNUC__)
+      {
+        return __builtin_popcountll(v);
+      }
+    #else
+      {
+        int r(0);
+        for (; v != 0u; v &= v - 1u, ++r)
+          {}
+        return r;
+      }
+    #endif
+  }
+
+  /* mask of the bits [begin, end) of a 64-bit word, 0 <= begin < end <= 64 */
+  inline
+  uint64_t
+  bit_range(int begin, int end)
+  {
+    uint64_t hi;
+
+    hi = (end == 64) ? ~uint64_t(0) : ((uint64_t(1) << end) - 1u);
+    return hi & ~((uint64_t(1) << begin) - 1u);
+  }
+}
+
+fastuidraw::segregated_interval_allocator::
+segregated_interval_allocator(int size)
+{
+  reset(size);
+}
+
+void
+fastuidraw::segregated_interval_allocator::
+reset(int size)
+{
+  FASTUIDRAWassert(size >= 0);
+
+  m_size = std::max(0, size);
+  m_blocks.clear();
+  m_unused_slots = -1;
+  m_tag.assign(m_size, -1);
+  m_free_bits.assign((m_size + 63) / 64, 0u);
+  for (unsigned int fl = 0; fl < number_classes; ++fl)
+    {
+      m_heads[fl] = vecN<int, number_sub_classes>(-1);
+      m_sub_class_bits[fl] = 0u;
+    }
+  m_class_bits = 0u;
+
+  if (m_size > 0)
+    {
+      mark_free_bits(0, m_size, true);
+      insert_block(0, m_size);
+    }
+}
+
+void
+fastuidraw::segregated_interval_allocator::
+resize(int size)
+{
+  FASTUIDRAWassert(size >= m_size);
+  if (size > m_size)
+    {
+      int old_size(m_size);
+
+      m_size = size;
+      m_tag.resize(m_size, -1);
+      m_free_bits.resize((m_size + 63) / 64, 0u);
+      free_interval(old_size, size - old_size);
+    }
+}
+
+void
+fastuidraw::segregated_interval_allocator::
+size_class(int size, int *fl, int *sl)
+{
+  FASTUIDRAWassert(size > 0);
+  if (size < number_sub_classes)
+    {
+      /* the first class holds the sizes below
+       * number_sub_classes, one size per list
+       */
+      *fl = 0;
+      *sl = size;
+    }
+  else
+    {
+      int l(highest_bit(size));
+
+      *fl = l - sub_class_log2 + 1;
+      *sl = (size >> (l - sub_class_log2)) - number_sub_classes;
+    }
+  FASTUIDRAWassert(*fl < number_classes);
+  FASTUIDRAWassert(*sl < number_sub_classes);
+}
+
+void
+fastuidraw::segregated_interval_allocator::
+insert_block(int begin, int end)
+{
+  int b, fl, sl;
+
+  FASTUIDRAWassert(begin < end);
+  if (m_unused_slots != -1)
+    {
+      b = m_unused_slots;
+      m_unused_slots = m_blocks[b].m_next;
+    }
+  else
+    {
+      b = m_blocks.size();
+      m_blocks.push_back(free_block());
+    }
+
+  size_class(end - begin, &fl, &sl);
+
+  free_block &B(m_blocks[b]);
+  B.m_begin = begin;
+  B.m_end = end;
+  B.m_prev = -1;
+  B.m_next = m_heads[fl][sl];
+  if (B.m_next != -1)
+    {
+      m_blocks[B.m_next].m_prev = b;
+    }
+  m_heads[fl][sl] = b;
+  m_sub_class_bits[fl] |= (1u << sl);
+  m_class_bits |= (1u << fl);
+
+  m_tag[begin] = b;
+  m_tag[end - 1] = b;
+}
+
+void
+fastuidraw::segregated_interval_allocator::
+remove_block(int b)
+{
+  free_block &B(m_blocks[b]);
+  int fl, sl;
+
+  size_class(B.m_end - B.m_begin, &fl, &sl);
+  if (B.m_prev != -1)
+    {
+      m_blocks[B.m_prev].m_next = B.m_next;
+    }
+  else
+    {
+      FASTUIDRAWassert(m_heads[fl][sl] == b);
+      m_heads[fl][sl] = B.m_next;
+      if (B.m_next == -1)
+        {
+          m_sub_class_bits[fl] &= ~(1u << sl);
+          if (m_sub_class_bits[fl] == 0u)
+            {
+              m_class_bits &= ~(1u << fl);
+            }
+        }
+    }
+
+  if (B.m_next != -1)
+    {
+      m_blocks[B.m_next].m_prev = B.m_prev;
+    }
+
+  m_tag[B.m_begin] = -1;
+  m_tag[B.m_end - 1] = -1;
+
+  B.m_next = m_unused_slots;
+  m_unused_slots = b;
+}
+
+int
+fastuidraw::segregated_interval_allocator::
+find_block(int sz) const
+{
+  int fl, sl;
+  uint32_t bits;
+
+  /* Round sz up to the start of the next class so that
+   * every block of the class found is large enough.
+   */
+  if (sz >= number_sub_classes)
+    {
+      int64_t rounded;
+
+      rounded = int64_t(sz) + (int64_t(1) << (highest_bit(sz) - sub_class_log2)) - 1;
+      rounded = std::min(rounded, int64_t(0x7FFFFFFF));
+      size_class(static_cast<int>(rounded), &fl, &sl);
+    }
+  else
+    {
+      size_class(sz, &fl, &sl);
+    }
+
+  bits = m_sub_class_bits[fl] & (~0u << sl);
+  if (bits == 0u && fl + 1 < number_classes)
+    {
+      uint32_t class_bits;
+
+      class_bits = m_class_bits & (~0u << (fl + 1));
+      if (class_bits != 0u)
+        {
+          fl = lowest_bit(class_bits);
+          bits = m_sub_class_bits[fl];
+        }
+    }
+
+  if (bits != 0u)
+    {
+      return m_heads[fl][lowest_bit(bits)];
+    }
+
+  /* the only blocks left that may be large enough
+   * are those in the class of sz itself
+   */
+  size_class(sz, &fl, &sl);
+  for (int b = m_heads[fl][sl]; b != -1; b = m_blocks[b].m_next)
+    {
+      if (m_blocks[b].m_end - m_blocks[b].m_begin >= sz)
+        {
+          return b;
+        }
+    }
+
+  return -1;
+}
+
+int
+fastuidraw::segregated_interval_allocator::
+largest_free_interval(void) const
+{
+  int fl, sl, return_value(0);
+
+  if (m_class_bits == 0u)
+    {
+      return 0;
+    }
+
+  fl = highest_bit(m_class_bits);
+  sl = highest_bit(m_sub_class_bits[fl]);
+  for (int b = m_heads[fl][sl]; b != -1; b = m_blocks[b].m_next)
+    {
+      return_value = std::max(return_value, m_blocks[b].m_end - m_blocks[b].m_begin);
+    }
+  return return_value;
+}
+
+void
+fastuidraw::segregated_interval_allocator::
+mark_free_bits(int begin, int end, bool value)
+{
+  while (begin < end)
+    {
+      int word(begin >> 6), word_end;
+      uint64_t mask;
+
+      word_end = std::min(end, (word + 1) << 6);
+      mask = bit_range(begin & 63, word_end - (word << 6));
+      if (value)
+        {
+          m_free_bits[word] |= mask;
+        }
+      else
+        {
+          m_free_bits[word] &= ~mask;
+        }
+      begin = word_end;
+    }
+}
+
+fastuidraw::segregated_interval_allocator::interval_status_t
+fastuidraw::segregated_interval_allocator::
+interval_status(int begin, int size) const
+{
+  FASTUIDRAWassert(begin >= 0);
+  FASTUIDRAWassert(size > 0);
+
+  int end(begin + size), num_free(0);
+  FASTUIDRAWassert(end <= m_size);
+
+  while (begin < end)
+    {
+      int word(begin >> 6), word_end;
+
+      word_end = std::min(end, (word + 1) << 6);
+      num_free += count_bits(m_free_bits[word] & bit_range(begin & 63, word_end - (word << 6)));
+      begin = word_end;
+    }
+
+  if (num_free == 0)
+    {
+      return completely_allocated;
+    }
+
+  return (num_free == size) ?
+    completely_free :
+    partially_allocated;
+}
+
+int
+fastuidraw::segregated_interval_allocator::
+allocate_interval(int size)
+{
+  int b, begin, end;
+
+  if (size <= 0)
+    {
+      return -1;
+    }
+
+  b = find_block(size);
+  if (b == -1)
+    {
+      return -1;
+    }
+
+  begin = m_blocks[b].m_begin;
+  end = m_blocks[b].m_end;
+  FASTUIDRAWassert(end - begin >= size);
+
+  remove_block(b);
+  if (begin + size < end)
+    {
+      insert_block(begin + size, end);
+    }
+  mark_free_bits(begin, begin + size, false);
+
+  return begin;
+}
+
+void
+fastuidraw::segregated_interval_allocator::
+free_interval(int location, int size)
+{
+  FASTUIDRAWassert(size > 0);
+  FASTUIDRAWassert(interval_status(location, size) == completely_allocated);
+
+  int begin(location), end(location + size);
+
+  mark_free_bits(begin, end, true);
+
+  /* merge with the free block that ends at location */
+  if (begin > 0 && m_tag[begin - 1] != -1)
+    {
+      int b(m_tag[begin - 1]);
+
+      FASTUIDRAWassert(m_blocks[b].m_end == begin);
+      begin = m_blocks[b].m_begin;
+      remove_block(b);
+    }
+
+  /* merge with the free block that starts at end */
+  if (end < m_size && m_tag[end] != -1)
+    {
+      int b(m_tag[end]);
+
+      FASTUIDRAWassert(m_blocks[b].m_begin == end);
+      end = m_blocks[b].m_end;
+      remove_block(b);
+    }
+
+  insert_block(begin, end);
+}
@@ -0,0 +1,201 @@
+/*!
+ * \file segregated_interval_allocator.hpp
+ * \brief file segregated_interval_allocator.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/vecN.hpp>
+
+namespace fastuidraw
+{
+  /*!\class segregated_interval_allocator
+   * A segregated_interval_allocator has the same interface and
+   * semantics as \ref interval_allocator, but keeps its free
+   * intervals in segregated free lists (the two level scheme of
+   * TLSF): a free interval of size S is on the list of the class
+   * of S, where the classes are the powers of two each divided
+   * into 4 sub-ranges. A bitmap per level records which lists
+   * are non-empty, so finding a list that can hold a request is
+   * a pair of bit scans. The free intervals themselves live in a
+   * single array whose slots are recycled, and neighbouring free
+   * intervals are found for coalescing through a per-position
+   * tag array, so the free list work of allocate and free is O(1)
+   * with no allocation of nodes. A bitmap of which positions are
+   * free backs interval_status(); allocate and free update the
+   * bits of the interval, which costs O(length / 64) word writes,
+   * so the total cost of allocate and free is O(1 + length / 64).
+   */
+  class segregated_interval_allocator:fastuidraw::noncopyable
+  {
+  public:
+    /*!\enum interval_status_t
+     */
+    enum interval_status_t
+      {
+        /*!
+         * Indicates interval is completely allocated
+         */
+        completely_allocated,
+
+        /*!
+         * Indicates interval is completely free
+         */
+        completely_free,
+
+        /*!
+         * Indicates the interval is partially allocated
+         * and partially free.
+         */
+        partially_allocated,
+      };
+
+    /*!\fn
+     * Ctor.
+     * \param size gives the size from which to allocate intervals, essentially
+     *             the \ref segregated_interval_allocator is initialized as
+     *             having one free interval that starts at 0 with length
+     *             equal to size
+     */
+    explicit
+    segregated_interval_allocator(int size);
+
+    /*!\fn
+     * Reconstruct the \ref segregated_interval_allocator, i.e. clear all
+     * free intervals
+     * \param size new size for the \ref segregated_interval_allocator
+     */
+    void
+    reset(int size);
+
+    /*!\fn
+     * Resize the \ref segregated_interval_allocator. The new size must
+     * be atleast as large as the old size.
+     * \param size new size to which to size the allocator
+     */
+    void
+    resize(int size);
+
+    /*!\fn
+     * Returns the "size" of the \ref segregated_interval_allocator, i.e.
+     * all intervals allocated are in the range [0, size() ).
+     */
+    int
+    size(void) const
+    {
+      return m_size;
+    }
+
+    /*!\fn
+     * Allocate, returns the "begin" of the interval
+     * allocated. Returns -1 on failure.
+     * \param size length of interval to allocate
+     */
+    int
+    allocate_interval(int size);
+
+    /*!\fn
+     * Free an interval.
+     * \param location start of interval
+     * \param size size of interval
+     */
+    void
+    free_interval(int location, int size);
+
+    /*!\fn
+     * Returns the largest value that can be passed to allocate_interval()
+     * and not fail.
+     */
+    int
+    largest_free_interval(void) const;
+
+    /*!\fn
+     * Returns the allocation status of an interval
+     * \param begin start of interval
+     * \param size length of interval
+     */
+    interval_status_t
+    interval_status(int begin, int size) const;
+
+  private:
+    enum
+      {
+        /* log2 of the number of sub-classes per power of two */
+        sub_class_log2 = 2,
+        number_sub_classes = 1 << sub_class_log2,
+        number_classes = 32,
+      };
+
+    class free_block
+    {
+    public:
+      int m_begin, m_end;
+
+      /* links of the free list of the size class of the
+       * block; for an unused slot, m_next links the slots
+       * available for reuse.
+       */
+      int m_prev, m_next;
+    };
+
+    static
+    void
+    size_class(int size, int *fl, int *sl);
+
+    /* Add [begin, end) as a free block */
+    void
+    insert_block(int begin, int end);
+
+    /* Remove the free block of slot b */
+    void
+    remove_block(int b);
+
+    /* Returns the slot of a free block of size atleast sz
+     * or -1 if there is none.
+     */
+    int
+    find_block(int sz) const;
+
+    void
+    mark_free_bits(int begin, int end, bool value);
+
+    int m_size;
+
+    std::vector<free_block> m_blocks;
+    int m_unused_slots;
+
+    /* m_tag[p] is the slot of the free block that begins
+     * or ends (i.e. has m_end - 1 equal to) at p and is
+     * -1 if there is no such block.
+     */
+    std::vector<int> m_tag;
+
+    /* bit p is up if position p is free */
+    std::vector<uint64_t> m_free_bits;
+
+    /* head of free list of each class and the bitmaps
+     * of which classes have a non-empty list
+     */
+    vecN<vecN<int, number_sub_classes>, number_classes> m_heads;
+    vecN<uint32_t, number_classes> m_sub_class_bits;
+    uint32_t m_class_bits;
+  };
+
+}
@@ -0,0 +1,114 @@
+/*!
+ * \file tessellated_path_cache_private.hpp
+ * \brief file tessellated_path_cache_private.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <fastuidraw/tessellated_path.hpp>
+#include <fastuidraw/tessellated_path_cache.hpp>
+
+namespace fastuidraw
+{
+  namespace detail
+  {
+    class TessellatedPathCacheEntry;
+
+    /* A TessellatedPathCacheClient holds TessellatedPath
+     * objects that are accounted by the TessellatedPathCache.
+     * The cache never calls into a client: evicting an entry
+     * only marks it as unlinked (with the cache lock held)
+     * and the client drops the unlinked entries on its next
+     * access, see TessellatedPathCacheAccess::take_unlinked().
+     */
+    class TessellatedPathCacheClient
+    {
+    public:
+      TessellatedPathCacheClient(void):
+        m_has_unlinked(false)
+      {}
+
+      TessellatedPathCacheClient(const TessellatedPathCacheClient&):
+        m_has_unlinked(false)
+      {}
+
+      virtual
+      ~TessellatedPathCacheClient()
+      {}
+
+      /* set by the cache when it unlinks an entry of the
+       * client, cleared by TessellatedPathCacheAccess::take_unlinked()
+       */
+      std::atomic<bool> m_has_unlinked;
+    };
+
+    class TessellatedPathCacheAccess
+    {
+    public:
+      /* Add a TessellatedPath to the cache; if pinned is true
+       * the entry is never evicted. Adding an entry may evict
+       * other entries; the added entry is not evicted by its
+       * own addition.
+       */
+      static
+      TessellatedPathCacheEntry*
+      add(TessellatedPathCacheClient *client,
+          const TessellatedPath *tess, bool pinned);
+
+      /* Mark an entry as most recently used and update its
+       * byte count if data of the TessellatedPath was made
+       * since the last touch; may evict other entries. Does
+       * not take the cache lock if there is no budget and
+       * the byte count is unchanged.
+       */
+      static
+      void
+      touch(TessellatedPathCacheEntry *entry);
+
+      /* Remove and delete an entry, for when the client
+       * drops the TessellatedPath itself or drops an
+       * unlinked entry; removing an unlinked entry only
+       * deletes it.
+       */
+      static
+      void
+      remove(TessellatedPathCacheEntry *entry);
+
+      /* Returns true if the cache unlinked an entry of the
+       * client since the last call to take_unlinked(); does
+       * not take the cache lock.
+       */
+      static
+      bool
+      take_unlinked(TessellatedPathCacheClient *client);
+
+      /* Returns true if the cache has unlinked (i.e. evicted)
+       * the entry; the client is then to drop its reference
+       * to the TessellatedPath and remove() the entry.
+       */
+      static
+      bool
+      is_unlinked(const TessellatedPathCacheEntry *entry);
+
+      /* Returns the TessellatedPath of an entry */
+      static
+      const TessellatedPath*
+      tessellated_path(const TessellatedPathCacheEntry *entry);
+    };
+  }
+}
@@ -20,10 +20,12 @@
 #include <list>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #include <fastuidraw/tessellated_path.hpp>
 #include <fastuidraw/path.hpp>
 #include <fastuidraw/painter/stroked_path.hpp>
 #include <fastuidraw/painter/filled_path.hpp>
+#include <fastuidraw/painter/painter_attribute.hpp>
 #include "private/util_private.hpp"
 #include "private/bounding_box.hpp"
 
@@ -63,9 +65,8 @@ namespace
     {}
 
     unsigned int m_loc, m_ende;
-    std::list<std::vector<fastuidraw::TessellatedPath::segment> > m_temp;
     float m_contour_length, m_open_contour_length, m_closed_contour_length;
-    std::list<std::vector<fastuidraw::TessellatedPath::segment> >::iterator m_start_contour;
+    fastuidraw::vec2 m_contour_end_pt;
   };
 
   class Edge
@@ -73,8 +74,39 @@ namespace
   public:
     fastuidraw::range_type<unsigned int> m_edge_range;
     enum fastuidraw::PathEnums::edge_type_t m_edge_type;
+    float m_edge_length;
   };
 
+  class Contour
+  {
+  public:
+    Contour(void):
+      m_point_begin(0u),
+      m_open_contour_length(0.0f),
+      m_closed_contour_length(0.0f)
+    {}
+
+    /* location in TessellatedPathPrivate::m_points
+     * of the first point of the contour
+     */
+    unsigned int m_point_begin;
+    float m_open_contour_length, m_closed_contour_length;
+  };
+
+  class Arc
+  {
+  public:
+    fastuidraw::vec2 m_center;
+    float m_radius;
+    fastuidraw::range_type<float> m_arc_angle;
+  };
+
+  enum segment_flag_bits
+    {
+      arc_segment_flag = 1u,
+      tangent_with_predecessor_flag = 2u,
+    };
+
   class TessellatedPathPrivate
   {
   public:
@@ -92,16 +124,50 @@ namespace
              float edge_max_distance, bool is_closing_edge);
 
     void
-    end_contour(TessellatedPathBuildingState &b);
+    end_contour(TessellatedPathBuildingState &b, unsigned int contour);
 
     void
     finalize(TessellatedPathBuildingState &b);
 
     void
-    create_path(void);
+    compute_segment(unsigned int contour, unsigned int edge, unsigned int I,
+                    fastuidraw::TessellatedPath::segment *dst) const;
+
+    void
+    ready_segment_data(void);
 
     std::vector<std::vector<Edge> > m_edges;
+    std::vector<Contour> m_contours;
+
+    /* The segments are stored as a structure of arrays;
+     * the values of TessellatedPath::segment that are not
+     * stored are derived from these when a segment is
+     * fetched:
+     *  - m_points holds for each contour the start point of
+     *    each segment followed by the end point of the last
+     *    segment, so that the end point of a segment is the
+     *    start point of the next.
+     *  - m_segment_flags holds the segment_flag_bits of
+     *    each segment
+     *  - m_distance_from_contour_start holds the value of
+     *    TessellatedPath::segment::m_distance_from_contour_start
+     *    of each segment
+     *  - m_arc_index holds for each segment the index into
+     *    m_arcs of the segment; it is empty if no segment is
+     *    an arc.
+     */
+    std::vector<fastuidraw::vec2> m_points;
+    std::vector<uint8_t> m_segment_flags;
+    std::vector<float> m_distance_from_contour_start;
+    std::vector<uint32_t> m_arc_index;
+    std::vector<Arc> m_arcs;
+
+    /* TessellatedPath::segment values, realized on
+     * the first call that returns them as arrays.
+     */
+    bool m_segment_data_ready;
     std::vector<fastuidraw::TessellatedPath::segment> m_segment_data;
+
     fastuidraw::BoundingBox<float> m_bounding_box;
     fastuidraw::TessellatedPath::TessellationParams m_params;
     float m_max_distance;
@@ -110,8 +176,38 @@ namespace
     fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath> m_stroked;
     fastuidraw::reference_counted_ptr<const fastuidraw::FilledPath> m_filled;
     fastuidraw::Path m_path;
+
+    /* see TessellatedPath::lazy_generation() */
+    std::atomic<unsigned int> m_lazy_generation;
   };
 
+  template<typename T>
+  void
+  shrink_vector(std::vector<T> &v)
+  {
+    std::vector<T>(v.begin(), v.end()).swap(v);
+  }
+
+  template<typename T>
+  size_t
+  vector_bytes(const std::vector<T> &v)
+  {
+    return v.capacity() * sizeof(T);
+  }
+
+  /* Estimates of the bytes a StrokedPath and a FilledPath use
+   * per segment of the TessellatedPath, attribute and index data
+   * for all of their subsets included. A segment of a stroke is
+   * about 6 attributes and 12 indices for the edge plus the same
+   * again for the join; a filled segment is an attribute and 3
+   * indices for the triangulation plus 4 attributes and 6 indices
+   * for its anti-alias fuzz.
+   */
+  const size_t stroked_bytes_per_segment =
+    12 * sizeof(fastuidraw::PainterAttribute) + 24 * sizeof(fastuidraw::PainterIndex);
+  const size_t filled_bytes_per_segment =
+    5 * sizeof(fastuidraw::PainterAttribute) + 9 * sizeof(fastuidraw::PainterIndex);
+
   void
   union_segment(const fastuidraw::TessellatedPath::segment &S,
                 fastuidraw::BoundingBox<float> &BB)
@@ -253,6 +349,71 @@ namespace
           }
       }
   }
+
+  float
+  distance_sq_to_line_segment(fastuidraw::vec2 p,
+                              fastuidraw::vec2 a,
+                              fastuidraw::vec2 b)
+  {
+    using namespace fastuidraw;
+
+    vec2 ab(b - a), ap(p - a);
+    float len_sq, t;
+
+    len_sq = dot(ab, ab);
+    t = (len_sq > 0.0f) ? t_min(1.0f, t_max(0.0f, dot(ap, ab) / len_sq)) : 0.0f;
+    ap -= t * ab;
+    return dot(ap, ap);
+  }
+
+  /* Douglas-Peucker simplification of the polyline given by
+   * the points pts[R.m_begin], ..., pts[R.m_end]; marks in keep
+   * the points retained. The end points of the polyline are
+   * always retained and every point removed is within the
+   * tolerance of the segment of retained points replacing it.
+   * A stack is used instead of recursion because the polyline
+   * of a contour can have very many points.
+   */
+  void
+  douglas_peucker(fastuidraw::c_array<const fastuidraw::vec2> pts,
+                  fastuidraw::range_type<unsigned int> R,
+                  float tolerance, std::vector<bool> &keep)
+  {
+    using namespace fastuidraw;
+
+    std::vector<range_type<unsigned int> > stack;
+    float tolerance_sq(tolerance * tolerance);
+
+    keep[R.m_begin] = true;
+    keep[R.m_end] = true;
+    stack.push_back(R);
+    while (!stack.empty())
+      {
+        range_type<unsigned int> S(stack.back());
+        unsigned int farthest(S.m_begin);
+        float farthest_sq(tolerance_sq);
+
+        stack.pop_back();
+        for (unsigned int i = S.m_begin + 1; i < S.m_end; ++i)
+          {
+            float d;
+
+            d = distance_sq_to_line_segment(pts[i], pts[S.m_begin], pts[S.m_end]);
+            if (d > farthest_sq)
+              {
+                farthest = i;
+                farthest_sq = d;
+              }
+          }
+
+        if (farthest != S.m_begin)
+          {
+            keep[farthest] = true;
+            stack.push_back(range_type<unsigned int>(S.m_begin, farthest));
+            stack.push_back(range_type<unsigned int>(farthest, S.m_end));
+          }
+      }
+  }
 }
 
 //////////////////////////////////////////////
@@ -261,11 +422,14 @@ TessellatedPathPrivate::
 TessellatedPathPrivate(unsigned int num_contours,
                        fastuidraw::TessellatedPath::TessellationParams TP):
   m_edges(num_contours),
+  m_contours(num_contours),
+  m_segment_data_ready(false),
   m_params(TP),
   m_max_distance(0.0f),
   m_has_arcs(false),
   m_max_segments(0u),
-  m_max_recursion(0u)
+  m_max_recursion(0u),
+  m_lazy_generation(0u)
 {
 }
 
@@ -278,6 +442,7 @@ start_contour(TessellatedPathBuildingState &b, unsigned int o, unsigned int num_
   b.m_closed_contour_length = 0.0f;
   b.m_ende = num_edges;
   m_edges[o].resize(num_edges);
+  m_contours[o].m_point_begin = m_points.size();
 }
 
 void
@@ -290,6 +455,7 @@ add_edge(TessellatedPathBuildingState &builder,
   using namespace fastuidraw;
 
   unsigned int needed;
+  float edge_length(0.0f);
 
   needed = work_room.size();
   m_edges[o][e].m_edge_range = range_type<unsigned int>(builder.m_loc, builder.m_loc + needed);
@@ -307,22 +473,47 @@ add_edge(TessellatedPathBuildingState &builder,
 
   for(unsigned int n = 0; n < work_room.size(); ++n)
     {
-      m_has_arcs = m_has_arcs || (work_room[n].m_type == TessellatedPath::arc_segment);
-      union_segment(work_room[n], m_bounding_box);
-      compute_local_segment_values(work_room[n]);
+      TessellatedPath::segment &S(work_room[n]);
+      uint8_t flags(0u);
 
-      if (n != 0)
+      union_segment(S, m_bounding_box);
+      compute_local_segment_values(S);
+
+      if (S.m_type == TessellatedPath::arc_segment)
+        {
+          Arc A;
+
+          /* the first arc makes the arc index of every
+           * segment needed.
+           */
+          if (!m_has_arcs)
+            {
+              m_has_arcs = true;
+              m_arc_index.resize(m_segment_flags.size(), ~0u);
+            }
+
+          A.m_center = S.m_center;
+          A.m_radius = S.m_radius;
+          A.m_arc_angle = S.m_arc_angle;
+          m_arc_index.push_back(m_arcs.size());
+          m_arcs.push_back(A);
+          flags |= arc_segment_flag;
+        }
+      else if (m_has_arcs)
         {
-          work_room[n].m_distance_from_edge_start =
-            work_room[n - 1].m_distance_from_edge_start + work_room[n - 1].m_length;
+          m_arc_index.push_back(~0u);
         }
-      else
+
+      if (S.m_tangent_with_predecessor)
         {
-          work_room[n].m_distance_from_edge_start = 0.0f;
+          flags |= tangent_with_predecessor_flag;
         }
 
-      work_room[n].m_distance_from_contour_start = builder.m_contour_length;
-      builder.m_contour_length += work_room[n].m_length;
+      m_points.push_back(S.m_start_pt);
+      m_segment_flags.push_back(flags);
+      m_distance_from_contour_start.push_back(builder.m_contour_length);
+      builder.m_contour_length += S.m_length;
+      edge_length += S.m_length;
 
       /* all segments but the first segment are marked as continuing */
       if (n != 0)
@@ -331,14 +522,10 @@ add_edge(TessellatedPathBuildingState &builder,
         }
 
       add_segment_to_path(is_closing_edge && n + 1 == work_room.size(),
-                          work_room[n], m_path);
-    }
-
-  for(unsigned int n = 0; n < needed; ++n)
-    {
-      work_room[n].m_edge_length = work_room[needed - 1].m_distance_from_edge_start
-        + work_room[needed - 1].m_length;
+                          S, m_path);
     }
+  m_edges[o][e].m_edge_length = edge_length;
+  builder.m_contour_end_pt = work_room.back().m_end_pt;
 
   if (e + 2 == builder.m_ende)
     {
@@ -349,53 +536,107 @@ add_edge(TessellatedPathBuildingState &builder,
       builder.m_closed_contour_length = builder.m_contour_length;
     }
 
-  /* append the data to temp and clear work_room for the next edge */
-  std::list<std::vector<TessellatedPath::segment> >::iterator t;
-  t = builder.m_temp.insert(builder.m_temp.end(), std::vector<TessellatedPath::segment>());
-  t->swap(work_room);
+  work_room.clear();
+}
 
-  if (e == 0)
+void
+TessellatedPathPrivate::
+end_contour(TessellatedPathBuildingState &builder, unsigned int o)
+{
+  if (m_edges[o].empty())
     {
-      builder.m_start_contour = t;
+      return;
     }
+
+  m_points.push_back(builder.m_contour_end_pt);
+  m_contours[o].m_open_contour_length = builder.m_open_contour_length;
+  m_contours[o].m_closed_contour_length = builder.m_closed_contour_length;
 }
 
 void
 TessellatedPathPrivate::
-end_contour(TessellatedPathBuildingState &builder)
+finalize(TessellatedPathBuildingState &b)
+{
+  FASTUIDRAWunused(b);
+  FASTUIDRAWassert(m_edges.back().back().m_edge_range.m_end == m_segment_flags.size());
+  FASTUIDRAWassert(m_points.size() <= m_segment_flags.size() + m_edges.size());
+
+  /* drop the slack of growing the arrays */
+  shrink_vector(m_points);
+  shrink_vector(m_segment_flags);
+  shrink_vector(m_distance_from_contour_start);
+  shrink_vector(m_arc_index);
+  shrink_vector(m_arcs);
+}
+
+void
+TessellatedPathPrivate::
+compute_segment(unsigned int o, unsigned int e, unsigned int I,
+                fastuidraw::TessellatedPath::segment *dst) const
 {
   using namespace fastuidraw;
 
-  if (builder.m_start_contour == builder.m_temp.end())
+  const Edge &edge(m_edges[o][e]);
+  const Contour &contour(m_contours[o]);
+  unsigned int pt;
+  uint8_t flags;
+
+  FASTUIDRAWassert(edge.m_edge_range.m_begin <= I && I < edge.m_edge_range.m_end);
+  pt = contour.m_point_begin + I - m_edges[o].front().m_edge_range.m_begin;
+  flags = m_segment_flags[I];
+
+  dst->m_start_pt = m_points[pt];
+  dst->m_end_pt = m_points[pt + 1];
+  dst->m_tangent_with_predecessor = (flags & tangent_with_predecessor_flag) != 0u;
+  if (flags & arc_segment_flag)
     {
-      return;
-    }
+      const Arc &A(m_arcs[m_arc_index[I]]);
 
-  for(std::list<std::vector<TessellatedPath::segment> >::iterator
-        t = builder.m_start_contour, endt = builder.m_temp.end(); t != endt; ++t)
+      dst->m_type = TessellatedPath::arc_segment;
+      dst->m_center = A.m_center;
+      dst->m_radius = A.m_radius;
+      dst->m_arc_angle = A.m_arc_angle;
+    }
+  else
     {
-      for(unsigned int e = 0, ende = t->size(); e < ende; ++e)
-        {
-          TessellatedPath::segment &S(t->operator[](e));
-          S.m_open_contour_length = builder.m_open_contour_length;
-          S.m_closed_contour_length = builder.m_closed_contour_length;
-        }
+      dst->m_type = TessellatedPath::line_segment;
+      dst->m_center = vec2(0.0f, 0.0f);
+      dst->m_radius = 0.0f;
+      dst->m_arc_angle = range_type<float>(0.0f, 0.0f);
     }
+
+  compute_local_segment_values(*dst);
+  dst->m_distance_from_contour_start = m_distance_from_contour_start[I];
+  dst->m_distance_from_edge_start = m_distance_from_contour_start[I]
+    - m_distance_from_contour_start[edge.m_edge_range.m_begin];
+  dst->m_edge_length = edge.m_edge_length;
+  dst->m_open_contour_length = contour.m_open_contour_length;
+  dst->m_closed_contour_length = contour.m_closed_contour_length;
 }
 
 void
 TessellatedPathPrivate::
-finalize(TessellatedPathBuildingState &b)
+ready_segment_data(void)
 {
-  unsigned int total_needed;
+  if (m_segment_data_ready)
+    {
+      return;
+    }
 
-  total_needed = m_edges.back().back().m_edge_range.m_end;
-  m_segment_data.reserve(total_needed);
-  for(auto iter = b.m_temp.begin(), end_iter = b.m_temp.end(); iter != end_iter; ++iter)
+  m_segment_data.resize(m_segment_flags.size());
+  for (unsigned int o = 0, endo = m_edges.size(); o < endo; ++o)
     {
-      std::copy(iter->begin(), iter->end(), std::back_inserter(m_segment_data));
+      for (unsigned int e = 0, ende = m_edges[o].size(); e < ende; ++e)
+        {
+          const fastuidraw::range_type<unsigned int> &R(m_edges[o][e].m_edge_range);
+          for (unsigned int I = R.m_begin; I < R.m_end; ++I)
+            {
+              compute_segment(o, e, I, &m_segment_data[I]);
+            }
+        }
     }
-  FASTUIDRAWassert(total_needed == m_segment_data.size());
+  m_segment_data_ready = true;
+  ++m_lazy_generation;
 }
 
 //////////////////////////////////////////////////////////
@@ -590,7 +831,7 @@ TessellatedPath(Refiner *p, float max_distance,
           d->add_edge(builder, o, e, work_room, tmp, e + 1 == contour.m_edges.size());
           d->m_edges[o][e].m_edge_type = edge.m_interpolator->edge_type();
         }
-      d->end_contour(builder);
+      d->end_contour(builder, o);
     }
   d->finalize(builder);
 }
@@ -655,7 +896,97 @@ TessellatedPath(const Path &input,
           d->m_edges[o][e].m_edge_type = interpolator->edge_type();
         }
 
-      d->end_contour(builder);
+      d->end_contour(builder, o);
+    }
+  d->finalize(builder);
+}
+
+fastuidraw::TessellatedPath::
+TessellatedPath(const TessellatedPath &src, float tolerance)
+{
+  TessellatedPathPrivate *d, *src_d;
+
+  src_d = static_cast<TessellatedPathPrivate*>(src.m_d);
+  FASTUIDRAWassert(!src_d->m_has_arcs);
+
+  TessellationParams params(src_d->m_params);
+  params.m_max_distance = src_d->m_max_distance + tolerance;
+
+  m_d = d = FASTUIDRAWnew TessellatedPathPrivate(src_d->m_edges.size(), params);
+  d->m_max_recursion = src_d->m_max_recursion;
+  if (src_d->m_edges.empty())
+    {
+      return;
+    }
+
+  std::vector<segment> work_room;
+  std::vector<bool> keep;
+  std::vector<unsigned int> source_edge;
+  TessellatedPathBuildingState builder;
+
+  for(unsigned int o = 0, endo = src_d->m_edges.size(); o < endo; ++o)
+    {
+      const std::vector<Edge> &src_edges(src_d->m_edges[o]);
+      c_array<const vec2> pts(src.contour_points(o));
+      unsigned int first_segment(src_edges.front().m_edge_range.m_begin);
+      unsigned int closing_begin, num_edges, current_edge, start;
+
+      /* The closing edge of the contour is simplified separately
+       * from the rest of the contour so that it stays the last
+       * edge, as needed for stroking the contour as open. Before
+       * the closing edge, each retained point that starts an edge
+       * of the source starts an edge of the same edge type, the
+       * other retained points continue the current edge.
+       */
+      keep.assign(pts.size(), false);
+      source_edge.assign(pts.size(), ~0u);
+      for (unsigned int e = 0; e < src_edges.size(); ++e)
+        {
+          source_edge[src_edges[e].m_edge_range.m_begin - first_segment] = e;
+        }
+
+      closing_begin = src_edges.back().m_edge_range.m_begin - first_segment;
+      if (closing_begin > 0)
+        {
+          douglas_peucker(pts, range_type<unsigned int>(0, closing_begin), tolerance, keep);
+        }
+      douglas_peucker(pts, range_type<unsigned int>(closing_begin, pts.size() - 1), tolerance, keep);
+
+      num_edges = 1;
+      for (unsigned int p = 1; p <= closing_begin; ++p)
+        {
+          if (keep[p] && source_edge[p] != ~0u)
+            {
+              ++num_edges;
+            }
+        }
+
+      d->start_contour(builder, o, num_edges);
+      current_edge = 0;
+      start = 0;
+      for (unsigned int p = 1, prev = 0; p < pts.size(); ++p)
+        {
+          if (!keep[p])
+            {
+              continue;
+            }
+
+          SegmentStorage segment_storage;
+          segment_storage.m_d = &work_room;
+          segment_storage.add_line_segment(pts[prev], pts[p]);
+          prev = p;
+
+          if (p + 1 == pts.size() || (p <= closing_begin && source_edge[p] != ~0u))
+            {
+              d->add_edge(builder, o, current_edge, work_room,
+                          params.m_max_distance, p + 1 == pts.size());
+              d->m_edges[o][current_edge].m_edge_type = src_edges[source_edge[start]].m_edge_type;
+              ++current_edge;
+              start = p;
+            }
+        }
+      FASTUIDRAWassert(current_edge == num_edges);
+      d->end_contour(builder, o);
     }
   d->finalize(builder);
 }
@@ -713,9 +1044,32 @@ segment_data(void) const
   TessellatedPathPrivate *d;
   d = static_cast<TessellatedPathPrivate*>(m_d);
 
+  d->ready_segment_data();
   return make_c_array(d->m_segment_data);
 }
 
+unsigned int
+fastuidraw::TessellatedPath::
+number_segments(void) const
+{
+  TessellatedPathPrivate *d;
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+
+  return d->m_segment_flags.size();
+}
+
+fastuidraw::TessellatedPath::segment
+fastuidraw::TessellatedPath::
+segment_at(unsigned int contour, unsigned int edge, unsigned int I) const
+{
+  TessellatedPathPrivate *d;
+  segment return_value;
+
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+  d->compute_segment(contour, edge, I, &return_value);
+  return return_value;
+}
+
 unsigned int
 fastuidraw::TessellatedPath::
 number_contours(void) const
@@ -744,9 +1098,23 @@ contour_segment_data(unsigned int contour) const
   TessellatedPathPrivate *d;
   d = static_cast<TessellatedPathPrivate*>(m_d);
 
+  d->ready_segment_data();
   return make_c_array(d->m_segment_data).sub_array(contour_range(contour));
 }
 
+fastuidraw::c_array<const fastuidraw::vec2>
+fastuidraw::TessellatedPath::
+contour_points(unsigned int contour) const
+{
+  TessellatedPathPrivate *d;
+  range_type<unsigned int> R;
+
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+  R = contour_range(contour);
+  return make_c_array(d->m_points).sub_array(d->m_contours[contour].m_point_begin,
+                                             R.m_end - R.m_begin + 1);
+}
+
 unsigned int
 fastuidraw::TessellatedPath::
 number_edges(unsigned int contour) const
@@ -784,6 +1152,7 @@ edge_segment_data(unsigned int contour, unsigned int edge) const
   TessellatedPathPrivate *d;
   d = static_cast<TessellatedPathPrivate*>(m_d);
 
+  d->ready_segment_data();
   return make_c_array(d->m_segment_data).sub_array(edge_range(contour, edge));
 }
 
@@ -827,6 +1196,54 @@ has_arcs(void) const
   return d->m_has_arcs;
 }
 
+size_t
+fastuidraw::TessellatedPath::
+memory_consumption(void) const
+{
+  TessellatedPathPrivate *d;
+  size_t return_value;
+
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+  return_value = sizeof(TessellatedPath) + sizeof(TessellatedPathPrivate)
+    + vector_bytes(d->m_contours)
+    + vector_bytes(d->m_points)
+    + vector_bytes(d->m_segment_flags)
+    + vector_bytes(d->m_distance_from_contour_start)
+    + vector_bytes(d->m_arc_index)
+    + vector_bytes(d->m_arcs)
+    + vector_bytes(d->m_segment_data)
+    /* the Path made from the tessellation has a
+     * point per segment.
+     */
+    + d->m_segment_flags.size() * sizeof(vec2);
+
+  for (const auto &e : d->m_edges)
+    {
+      return_value += vector_bytes(e);
+    }
+
+  if (d->m_stroked)
+    {
+      return_value += d->m_segment_flags.size() * stroked_bytes_per_segment;
+    }
+
+  if (d->m_filled)
+    {
+      return_value += d->m_segment_flags.size() * filled_bytes_per_segment;
+    }
+
+  return return_value;
+}
+
+unsigned int
+fastuidraw::TessellatedPath::
+lazy_generation(void) const
+{
+  TessellatedPathPrivate *d;
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+  return d->m_lazy_generation;
+}
+
 const fastuidraw::Path&
 fastuidraw::TessellatedPath::
 path(void) const
@@ -846,6 +1263,7 @@ stroked(void) const
   if (!d->m_stroked)
     {
       d->m_stroked = FASTUIDRAWnew StrokedPath(*this);
+      ++d->m_lazy_generation;
     }
   return d->m_stroked;
 }
@@ -859,6 +1277,20 @@ filled(void) const
   if (!d->m_filled && !d->m_has_arcs)
     {
       d->m_filled = FASTUIDRAWnew FilledPath(*this);
+      ++d->m_lazy_generation;
     }
   return d->m_filled;
 }
+
+fastuidraw::reference_counted_ptr<fastuidraw::TessellatedPath>
+fastuidraw::TessellatedPath::
+create_simplified(float tolerance) const
+{
+  TessellatedPathPrivate *d;
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+  if (d->m_has_arcs)
+    {
+      return reference_counted_ptr<TessellatedPath>();
+    }
+  return FASTUIDRAWnew TessellatedPath(*this, tolerance);
+}
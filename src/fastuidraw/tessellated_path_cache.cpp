@@ -0,0 +1,319 @@
+/*!
+ * \file tessellated_path_cache.cpp
+ * \brief file tessellated_path_cache.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <fastuidraw/tessellated_path_cache.hpp>
+#include "private/tessellated_path_cache_private.hpp"
+#include "private/util_private.hpp"
+
+namespace fastuidraw
+{
+  namespace detail
+  {
+    class TessellatedPathCacheEntry:fastuidraw::noncopyable
+    {
+    public:
+      TessellatedPathCacheEntry(TessellatedPathCacheClient *client,
+                                const TessellatedPath *tess, bool pinned,
+                                unsigned int lazy_generation):
+        m_client(client),
+        m_tess(tess),
+        m_bytes(tess->memory_consumption()),
+        m_lazy_generation(lazy_generation),
+        m_pinned(pinned),
+        m_unlinked(false)
+      {}
+
+      TessellatedPathCacheClient *m_client;
+      const TessellatedPath *m_tess;
+
+      /* only written with the cache lock held */
+      uint64_t m_bytes;
+
+      /* value of TessellatedPath::lazy_generation() when
+       * m_bytes was computed; only accessed by the client
+       */
+      unsigned int m_lazy_generation;
+      bool m_pinned;
+
+      /* set when the cache evicts the entry, after which the
+       * cache no longer refers to the entry; only accessed with
+       * the cache lock held.
+       */
+      bool m_unlinked;
+
+      /* location in the LRU list, only valid if !m_pinned */
+      std::list<TessellatedPathCacheEntry*>::iterator m_lru_location;
+    };
+  }
+}
+
+namespace
+{
+  typedef fastuidraw::detail::TessellatedPathCacheEntry Entry;
+
+  class CacheHoard:fastuidraw::noncopyable
+  {
+  public:
+    CacheHoard(void):
+      m_budget(0)
+    {}
+
+    /* Unlink entries from the back of m_lru until within
+     * budget, never unlinking keep. An unlinked entry is
+     * only marked; its client drops it on its next access.
+     * The caller must hold m_mutex.
+     */
+    void
+    evict(const Entry *keep);
+
+    void
+    unlink(Entry *entry);
+
+    std::mutex m_mutex;
+
+    /* front is the most recently used */
+    std::list<Entry*> m_lru;
+    fastuidraw::TessellatedPathCache::Statistics m_stats;
+
+    /* only written with m_mutex held, but read without it
+     * by touch() to skip the lock when there is no budget.
+     */
+    std::atomic<uint64_t> m_budget;
+  };
+
+  CacheHoard&
+  hoard(void)
+  {
+    static CacheHoard R;
+    return R;
+  }
+}
+
+//////////////////////////////////
+// CacheHoard methods
+void
+CacheHoard::
+unlink(Entry *entry)
+{
+  FASTUIDRAWassert(!entry->m_unlinked);
+  FASTUIDRAWassert(m_stats.m_bytes_used >= entry->m_bytes);
+  FASTUIDRAWassert(m_stats.m_number_tessellations > 0);
+
+  m_stats.m_bytes_used -= entry->m_bytes;
+  --m_stats.m_number_tessellations;
+  if (entry->m_pinned)
+    {
+      m_stats.m_bytes_pinned -= entry->m_bytes;
+    }
+  else
+    {
+      m_lru.erase(entry->m_lru_location);
+    }
+  entry->m_unlinked = true;
+}
+
+void
+CacheHoard::
+evict(const Entry *keep)
+{
+  uint64_t budget(m_budget);
+
+  if (budget == 0)
+    {
+      return;
+    }
+
+  for (auto iter = m_lru.end(); iter != m_lru.begin()
+         && m_stats.m_bytes_used > budget;)
+    {
+      Entry *e;
+
+      --iter;
+      e = *iter;
+      if (e != keep)
+        {
+          /* unlink() erases iter, so step past it first */
+          auto next(iter);
+          ++next;
+          unlink(e);
+          iter = next;
+
+          ++m_stats.m_number_evicted;
+          m_stats.m_bytes_evicted += e->m_bytes;
+          e->m_client->m_has_unlinked = true;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////
+// fastuidraw::detail::TessellatedPathCacheAccess methods
+fastuidraw::detail::TessellatedPathCacheEntry*
+fastuidraw::detail::TessellatedPathCacheAccess::
+add(TessellatedPathCacheClient *client,
+    const TessellatedPath *tess, bool pinned)
+{
+  Entry *return_value;
+  CacheHoard &H(hoard());
+
+  return_value = FASTUIDRAWnew Entry(client, tess, pinned, tess->lazy_generation());
+
+  std::lock_guard<std::mutex> M(H.m_mutex);
+  H.m_stats.m_bytes_used += return_value->m_bytes;
+  ++H.m_stats.m_number_tessellations;
+  if (pinned)
+    {
+      H.m_stats.m_bytes_pinned += return_value->m_bytes;
+    }
+  else
+    {
+      return_value->m_lru_location = H.m_lru.insert(H.m_lru.begin(), return_value);
+    }
+  H.evict(return_value);
+  return return_value;
+}
+
+void
+fastuidraw::detail::TessellatedPathCacheAccess::
+touch(TessellatedPathCacheEntry *entry)
+{
+  CacheHoard &H(hoard());
+  unsigned int lazy_generation;
+  bool bytes_changed;
+  uint64_t bytes(0);
+
+  /* the StrokedPath and FilledPath of a TessellatedPath are
+   * made lazily, so the bytes change when one of them is
+   * made. If they have not changed, the lock is only needed
+   * to update the LRU order, which is not used if there is
+   * no budget and which pinned entries are not in.
+   */
+  lazy_generation = entry->m_tess->lazy_generation();
+  bytes_changed = (lazy_generation != entry->m_lazy_generation);
+  if (!bytes_changed && (entry->m_pinned || H.m_budget == 0))
+    {
+      return;
+    }
+
+  if (bytes_changed)
+    {
+      entry->m_lazy_generation = lazy_generation;
+      bytes = entry->m_tess->memory_consumption();
+    }
+
+  std::lock_guard<std::mutex> M(H.m_mutex);
+  if (entry->m_unlinked)
+    {
+      /* evicted; the client drops it on its next access */
+      return;
+    }
+
+  if (bytes_changed)
+    {
+      H.m_stats.m_bytes_used += bytes;
+      H.m_stats.m_bytes_used -= entry->m_bytes;
+      if (entry->m_pinned)
+        {
+          H.m_stats.m_bytes_pinned += bytes;
+          H.m_stats.m_bytes_pinned -= entry->m_bytes;
+        }
+      entry->m_bytes = bytes;
+    }
+
+  if (!entry->m_pinned)
+    {
+      H.m_lru.splice(H.m_lru.begin(), H.m_lru, entry->m_lru_location);
+    }
+  H.evict(entry);
+}
+
+void
+fastuidraw::detail::TessellatedPathCacheAccess::
+remove(TessellatedPathCacheEntry *entry)
+{
+  CacheHoard &H(hoard());
+
+  H.m_mutex.lock();
+  if (!entry->m_unlinked)
+    {
+      H.unlink(entry);
+    }
+  H.m_mutex.unlock();
+
+  FASTUIDRAWdelete(entry);
+}
+
+bool
+fastuidraw::detail::TessellatedPathCacheAccess::
+take_unlinked(TessellatedPathCacheClient *client)
+{
+  /* cheap test first so that the common case does not write */
+  return client->m_has_unlinked && client->m_has_unlinked.exchange(false);
+}
+
+bool
+fastuidraw::detail::TessellatedPathCacheAccess::
+is_unlinked(const TessellatedPathCacheEntry *entry)
+{
+  CacheHoard &H(hoard());
+  std::lock_guard<std::mutex> M(H.m_mutex);
+  return entry->m_unlinked;
+}
+
+const fastuidraw::TessellatedPath*
+fastuidraw::detail::TessellatedPathCacheAccess::
+tessellated_path(const TessellatedPathCacheEntry *entry)
+{
+  return entry->m_tess;
+}
+
+//////////////////////////////////////////////
+// fastuidraw::TessellatedPathCache methods
+void
+fastuidraw::TessellatedPathCache::
+budget(uint64_t bytes)
+{
+  CacheHoard &H(hoard());
+  std::lock_guard<std::mutex> M(H.m_mutex);
+
+  H.m_budget = bytes;
+  H.evict(nullptr);
+}
+
+uint64_t
+fastuidraw::TessellatedPathCache::
+budget(void)
+{
+  return hoard().m_budget;
+}
+
+fastuidraw::TessellatedPathCache::Statistics
+fastuidraw::TessellatedPathCache::
+statistics(void)
+{
+  CacheHoard &H(hoard());
+  Statistics return_value;
+
+  std::lock_guard<std::mutex> M(H.m_mutex);
+  return_value = H.m_stats;
+  return_value.m_budget = H.m_budget;
+  return return_value;
+}
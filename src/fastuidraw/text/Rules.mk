@@ -14,7 +14,8 @@ FASTUIDRAW_SOURCES += $(call filelist, glyph_atlas.cpp \
 	glyph_render_data_coverage.cpp \
 	glyph_cache.cpp glyph_selector.cpp \
 	freetype_face.cpp freetype_lib.cpp \
-	font_freetype.cpp font_properties.cpp)
+	font_freetype.cpp font_properties.cpp \
+	freetype_font_registry.cpp character_coverage.cpp)
 
 # Begin standard footer
 d		:= $(dirstack_$(sp))
@@ -0,0 +1,150 @@
+/*!
+ * \file character_coverage.cpp
+ * \brief file character_coverage.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <algorithm>
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/fastuidraw_memory.hpp>
+#include <fastuidraw/text/character_coverage.hpp>
+#include "../private/util_private.hpp"
+
+namespace
+{
+  /* A character code c is stored in the block with key
+   * c >> block_shift at bit (c & 63) of the element
+   * (c & block_mask) >> 6 of the block.
+   */
+  enum
+    {
+      block_shift = 8,
+      block_mask = (1u << block_shift) - 1u,
+    };
+
+  typedef fastuidraw::vecN<uint64_t, (1u << block_shift) / 64u> Block;
+
+  class CharacterCoveragePrivate
+  {
+  public:
+    CharacterCoveragePrivate(void):
+      m_number_characters(0)
+    {}
+
+    /* m_keys is sorted and m_blocks[i] is the block
+     * of the key m_keys[i].
+     */
+    std::vector<uint32_t> m_keys;
+    std::vector<Block> m_blocks;
+    unsigned int m_number_characters;
+  };
+}
+
+//////////////////////////////////////////
+// fastuidraw::CharacterCoverage methods
+fastuidraw::CharacterCoverage::
+CharacterCoverage(void)
+{
+  m_d = FASTUIDRAWnew CharacterCoveragePrivate();
+}
+
+fastuidraw::CharacterCoverage::
+CharacterCoverage(const CharacterCoverage &obj)
+{
+  CharacterCoveragePrivate *obj_d;
+  obj_d = static_cast<CharacterCoveragePrivate*>(obj.m_d);
+  m_d = FASTUIDRAWnew CharacterCoveragePrivate(*obj_d);
+}
+
+fastuidraw::CharacterCoverage::
+~CharacterCoverage()
+{
+  CharacterCoveragePrivate *d;
+  d = static_cast<CharacterCoveragePrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+assign_swap_implement(fastuidraw::CharacterCoverage)
+
+fastuidraw::CharacterCoverage&
+fastuidraw::CharacterCoverage::
+add(uint32_t character_code)
+{
+  CharacterCoveragePrivate *d;
+  d = static_cast<CharacterCoveragePrivate*>(m_d);
+
+  uint32_t key(character_code >> block_shift);
+  unsigned int I, bit(character_code & block_mask);
+  uint64_t mask(uint64_t(1u) << (bit & 63u));
+
+  if (d->m_keys.empty() || d->m_keys.back() < key)
+    {
+      I = d->m_keys.size();
+      d->m_keys.push_back(key);
+      d->m_blocks.push_back(Block(0u));
+    }
+  else
+    {
+      std::vector<uint32_t>::iterator iter;
+
+      iter = std::lower_bound(d->m_keys.begin(), d->m_keys.end(), key);
+      I = iter - d->m_keys.begin();
+      if (*iter != key)
+        {
+          d->m_keys.insert(iter, key);
+          d->m_blocks.insert(d->m_blocks.begin() + I, Block(0u));
+        }
+    }
+
+  if ((d->m_blocks[I][bit >> 6u] & mask) == 0u)
+    {
+      d->m_blocks[I][bit >> 6u] |= mask;
+      ++d->m_number_characters;
+    }
+
+  return *this;
+}
+
+bool
+fastuidraw::CharacterCoverage::
+contains(uint32_t character_code) const
+{
+  CharacterCoveragePrivate *d;
+  d = static_cast<CharacterCoveragePrivate*>(m_d);
+
+  uint32_t key(character_code >> block_shift);
+  unsigned int bit(character_code & block_mask);
+  std::vector<uint32_t>::const_iterator iter;
+
+  iter = std::lower_bound(d->m_keys.begin(), d->m_keys.end(), key);
+  if (iter == d->m_keys.end() || *iter != key)
+    {
+      return false;
+    }
+
+  const Block &B(d->m_blocks[iter - d->m_keys.begin()]);
+  return (B[bit >> 6u] & (uint64_t(1u) << (bit & 63u))) != 0u;
+}
+
+unsigned int
+fastuidraw::CharacterCoverage::
+number_characters(void) const
+{
+  CharacterCoveragePrivate *d;
+  d = static_cast<CharacterCoveragePrivate*>(m_d);
+  return d->m_number_characters;
+}
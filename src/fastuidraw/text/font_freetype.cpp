@@ -17,6 +17,8 @@
  */
 
 #include <sstream>
+#include <mutex>
+#include <vector>
 #include <fastuidraw/text/font_freetype.hpp>
 #include <fastuidraw/text/glyph_layout_data.hpp>
 #include <fastuidraw/text/glyph_render_data.hpp>
@@ -71,12 +73,14 @@ namespace
     RenderParamsPrivate(void):
       m_distance_field_pixel_size(48),
       m_distance_field_max_distance(96.0f),
-      m_curve_pair_pixel_size(32)
+      m_curve_pair_pixel_size(32),
+      m_max_number_faces(8)
     {}
 
     unsigned int m_distance_field_pixel_size;
     float m_distance_field_max_distance;
     unsigned int m_curve_pair_pixel_size;
+    unsigned int m_max_number_faces;
   };
 
   class IntPathCreator
@@ -209,16 +213,30 @@ namespace
                            fastuidraw::GlyphRenderDataCurvePair &output,
                            fastuidraw::Path &path);
 
+    void
+    compute_coverage(void);
+
     fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeFace::GeneratorBase> m_generator;
     fastuidraw::FontFreeType::RenderParams m_render_params;
     fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> m_lib;
     fastuidraw::FontFreeType *m_p;
 
-    /* for now we have a static number of m_faces we use for parallel
-     * glyph generation
+    /* The faces used for parallel glyph generation; a face is
+     * only created when all the faces are in use by other
+     * threads, up to RenderParams::max_number_faces() faces.
+     * The faces are never removed, so a FaceGrabber can use
+     * a face without holding m_faces_mutex.
+     */
+    std::mutex m_faces_mutex;
+    std::vector<fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeFace> > m_faces;
+    bool m_face_creation_failed;
+    unsigned int m_next_wait_face;
+
+    /* the character codes of the face's character map, built
+     * from the character map the first time it is needed.
      */
-    fastuidraw::vecN<fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeFace>, 8> m_faces;
-    bool m_all_faces_null;
+    std::once_flag m_coverage_once;
+    fastuidraw::CharacterCoverage m_coverage;
   };
 }
 
@@ -228,17 +246,46 @@ FontFreeTypePrivate::FaceGrabber::
 FaceGrabber(FontFreeTypePrivate *q):
   m_p(nullptr)
 {
-  while(!m_p && !q->m_all_faces_null)
+  std::unique_lock<std::mutex> lock(q->m_faces_mutex);
+
+  for(const auto &face : q->m_faces)
     {
-      for(unsigned int i = 0; i < q->m_faces.size() && !m_p; ++i)
+      if (face->try_lock())
         {
-          const fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeFace> &face(q->m_faces[i]);
-          if (face && face->try_lock())
-            {
-              m_p = face.get();
-            }
+          m_p = face.get();
+          return;
         }
     }
+
+  /* all faces are in use, create another if allowed */
+  if (!q->m_face_creation_failed
+      && q->m_faces.size() < fastuidraw::t_max(1u, q->m_render_params.max_number_faces()))
+    {
+      fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeFace> face;
+
+      face = q->m_generator->create_face(q->m_lib);
+      if (face && face->face())
+        {
+          FT_Set_Transform(face->face(), nullptr, nullptr);
+          face->lock();
+          q->m_faces.push_back(face);
+          m_p = face.get();
+          return;
+        }
+      q->m_face_creation_failed = true;
+    }
+
+  if (q->m_faces.empty())
+    {
+      return;
+    }
+
+  /* wait for a face to be available, spreading the
+   * waiting threads across the faces.
+   */
+  m_p = q->m_faces[q->m_next_wait_face++ % q->m_faces.size()].get();
+  lock.unlock();
+  m_p->lock();
 }
 
 FontFreeTypePrivate::FaceGrabber::
@@ -261,22 +308,13 @@ FontFreeTypePrivate(fastuidraw::FontFreeType *p,
   m_render_params(render_params),
   m_lib(lib),
   m_p(p),
-  m_all_faces_null(true)
+  m_face_creation_failed(false),
+  m_next_wait_face(0)
 {
   if (!m_lib)
     {
       m_lib = FASTUIDRAWnew fastuidraw::FreeTypeLib();
     }
-
-  for(unsigned int i = 0; i < m_faces.size(); ++i)
-    {
-      m_faces[i] = m_generator->create_face(m_lib);
-      if (m_faces[i] && m_faces[i]->face())
-        {
-          m_all_faces_null = false;
-          FT_Set_Transform(m_faces[i]->face(), nullptr, nullptr);
-        }
-    }
 }
 
 FontFreeTypePrivate::
@@ -507,6 +545,29 @@ compute_rendering_data(uint32_t glyph_code,
                                     &output);
 }
 
+void
+FontFreeTypePrivate::
+compute_coverage(void)
+{
+  FaceGrabber p(this);
+  if (p.m_p && p.m_p->face())
+    {
+      FT_Face face(p.m_p->face());
+      FT_ULong character_code;
+      FT_UInt glyph_code;
+
+      /* FT_Get_Next_Char() walks the character map
+       * in increasing character code order.
+       */
+      for(character_code = FT_Get_First_Char(face, &glyph_code);
+          glyph_code != 0;
+          character_code = FT_Get_Next_Char(face, character_code, &glyph_code))
+        {
+          m_coverage.add(character_code);
+        }
+    }
+}
+
 /////////////////////////////////////////////
 // fastuidraw::FontFreeType::RenderParams methods
 fastuidraw::FontFreeType::RenderParams::
@@ -542,6 +603,9 @@ setget_implement(fastuidraw::FontFreeType::RenderParams,
 setget_implement(fastuidraw::FontFreeType::RenderParams,
                  RenderParamsPrivate,
                  unsigned int, curve_pair_pixel_size)
+setget_implement(fastuidraw::FontFreeType::RenderParams,
+                 RenderParamsPrivate,
+                 unsigned int, max_number_faces)
 
 ///////////////////////////////////////////////////
 // fastuidraw::FontFreeType methods
@@ -594,6 +658,18 @@ glyph_code(uint32_t pcharacter_code) const
   return glyphcode;
 }
 
+const fastuidraw::CharacterCoverage*
+fastuidraw::FontFreeType::
+character_coverage(void) const
+{
+  FontFreeTypePrivate *d;
+  d = static_cast<FontFreeTypePrivate*>(m_d);
+
+  std::call_once(d->m_coverage_once, &FontFreeTypePrivate::compute_coverage, d);
+
+  return &d->m_coverage;
+}
+
 bool
 fastuidraw::FontFreeType::
 can_create_rendering_data(enum glyph_type tp) const
@@ -28,15 +28,40 @@ namespace
   {
   public:
     FreeTypeFacePrivate(FT_Face pface,
-                        const fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> &lib);
+                        const fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> &lib,
+                        const fastuidraw::reference_counted_ptr<const fastuidraw::DataBufferBase> &data);
     ~FreeTypeFacePrivate();
 
     std::mutex m_mutex;
     FT_Face m_face;
     fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> m_lib;
+
+    /* the bytes m_face reads from, if created from memory;
+     * released only after m_face is done.
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::DataBufferBase> m_data;
+  };
+
+  class GeneratorFilePrivate
+  {
+  public:
+    GeneratorFilePrivate(fastuidraw::c_string filename, int face_index):
+      m_filename(filename),
+      m_face_index(face_index)
+    {}
+
+    /* the bytes of the file, mapped on the first face creation
+     * and shared by all the FT_Face objects created after.
+     */
+    const fastuidraw::reference_counted_ptr<const fastuidraw::DataBufferBase>&
+    bytes(void);
+
+    std::string m_filename;
+    int m_face_index;
+    std::mutex m_mutex;
+    fastuidraw::reference_counted_ptr<const fastuidraw::DataBufferBase> m_bytes;
   };
 
-  typedef std::pair<std::string, int> GeneratorFilePrivate;
   typedef std::pair<fastuidraw::reference_counted_ptr<const fastuidraw::DataBufferBase>, int> GeneratorMemoryPrivate;
 }
 
@@ -44,9 +69,11 @@ namespace
 // FreeTypeFacePrivate methods
 FreeTypeFacePrivate::
 FreeTypeFacePrivate(FT_Face pface,
-                    const fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> &lib):
+                    const fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> &lib,
+                    const fastuidraw::reference_counted_ptr<const fastuidraw::DataBufferBase> &data):
   m_face(pface),
-  m_lib(lib)
+  m_lib(lib),
+  m_data(data)
 {
   FASTUIDRAWassert(m_face);
   FASTUIDRAWassert(m_lib);
@@ -60,6 +87,20 @@ FreeTypeFacePrivate::
   m_lib->unlock();
 }
 
+/////////////////////////////
+// GeneratorFilePrivate methods
+const fastuidraw::reference_counted_ptr<const fastuidraw::DataBufferBase>&
+GeneratorFilePrivate::
+bytes(void)
+{
+  std::lock_guard<std::mutex> m(m_mutex);
+  if (!m_bytes)
+    {
+      m_bytes = FASTUIDRAWnew fastuidraw::MappedDataBuffer(m_filename.c_str());
+    }
+  return m_bytes;
+}
+
 //////////////////////////////////////////////////
 // fastuidraw::FreeTypeFace::GeneratorBase methods
 fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeFace>
@@ -80,11 +121,18 @@ create_face(reference_counted_ptr<FreeTypeLib> lib) const
 
   if (face != nullptr)
     {
-      return_value = FASTUIDRAWnew FreeTypeFace(face, lib);
+      return_value = FASTUIDRAWnew FreeTypeFace(face, lib, face_data());
     }
   return return_value;
 }
 
+fastuidraw::reference_counted_ptr<const fastuidraw::DataBufferBase>
+fastuidraw::FreeTypeFace::GeneratorBase::
+face_data(void) const
+{
+  return reference_counted_ptr<const DataBufferBase>();
+}
+
 enum fastuidraw::return_code
 fastuidraw::FreeTypeFace::GeneratorBase::
 check_creation(reference_counted_ptr<FreeTypeLib> lib) const
@@ -129,9 +177,18 @@ create_face_implement(FT_Library lib) const
   FT_Error error_code;
   FT_Face face(nullptr);
   GeneratorFilePrivate *d;
+  c_array<const uint8_t> src;
 
+  /* Rather than having FreeType read the file for each
+   * FT_Face, the file is mapped once and each FT_Face is
+   * created from the same bytes.
+   */
   d = static_cast<GeneratorFilePrivate*>(m_d);
-  error_code = FT_New_Face(lib, d->first.c_str(), d->second, &face);
+  src = d->bytes()->data_ro();
+  error_code = FT_New_Memory_Face(lib,
+                                  static_cast<const FT_Byte*>(src.c_ptr()),
+                                  src.size(), d->m_face_index,
+                                  &face);
   if (error_code != 0 && face != nullptr)
     {
       FT_Done_Face(face);
@@ -140,6 +197,15 @@ create_face_implement(FT_Library lib) const
   return face;
 }
 
+fastuidraw::reference_counted_ptr<const fastuidraw::DataBufferBase>
+fastuidraw::FreeTypeFace::GeneratorFile::
+face_data(void) const
+{
+  GeneratorFilePrivate *d;
+  d = static_cast<GeneratorFilePrivate*>(m_d);
+  return d->bytes();
+}
+
 /////////////////////////////////////////////////
 // fastuidraw::FreeTypeFace::GeneratorMemory methods
 fastuidraw::FreeTypeFace::GeneratorMemory::
@@ -153,7 +219,7 @@ fastuidraw::FreeTypeFace::GeneratorMemory::
 GeneratorMemory(c_string filename, int face_index)
 {
   DataBufferBase *p;
-  p = FASTUIDRAWnew DataBuffer(filename);
+  p = FASTUIDRAWnew MappedDataBuffer(filename);
   m_d = FASTUIDRAWnew GeneratorMemoryPrivate(p, face_index);
 }
 
@@ -188,13 +254,23 @@ create_face_implement(FT_Library lib) const
   return face;
 }
 
+fastuidraw::reference_counted_ptr<const fastuidraw::DataBufferBase>
+fastuidraw::FreeTypeFace::GeneratorMemory::
+face_data(void) const
+{
+  GeneratorMemoryPrivate *d;
+  d = static_cast<GeneratorMemoryPrivate*>(m_d);
+  return d->first;
+}
+
 /////////////////////////////
 // fastuidraw::FreeTypeFace methods
 fastuidraw::FreeTypeFace::
 FreeTypeFace(FT_Face pFace,
-             const reference_counted_ptr<FreeTypeLib> &pLib)
+             const reference_counted_ptr<FreeTypeLib> &pLib,
+             const reference_counted_ptr<const DataBufferBase> &pData)
 {
-  m_d = FASTUIDRAWnew FreeTypeFacePrivate(pFace, pLib);
+  m_d = FASTUIDRAWnew FreeTypeFacePrivate(pFace, pLib, pData);
 }
 
 fastuidraw::FreeTypeFace::
@@ -0,0 +1,548 @@
+/*!
+ * \file freetype_font_registry.cpp
+ * \brief file freetype_font_registry.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <map>
+#include <set>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <thread>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fastuidraw/text/freetype_font_registry.hpp>
+#include <fastuidraw/text/freetype_face.hpp>
+#include "../private/util_private.hpp"
+
+namespace
+{
+  /* The header line of a cache file; the number is the
+   * version of the format and is to be increased when
+   * the format changes.
+   */
+  const char *cache_file_header = "fastuidraw_font_cache 1";
+
+  class FaceEntry
+  {
+  public:
+    int m_face_index;
+    fastuidraw::FontProperties m_props;
+  };
+
+  /* the scalable faces of a file together with the
+   * size and modification time of the file when its
+   * faces were read.
+   */
+  class FileEntry
+  {
+  public:
+    FileEntry(void):
+      m_size(0),
+      m_mtime(0)
+    {}
+
+    bool
+    matches(const FileEntry &obj) const
+    {
+      return m_size == obj.m_size && m_mtime == obj.m_mtime;
+    }
+
+    uint64_t m_size;
+    int64_t m_mtime;
+    std::vector<FaceEntry> m_faces;
+  };
+
+  /* identifies a file or directory regardless of the
+   * path, symbolic links or hard links used to reach it.
+   */
+  typedef std::pair<dev_t, ino_t> FileId;
+
+  class PendingFile
+  {
+  public:
+    std::string m_filename;
+    FileEntry m_entry;
+    bool m_needs_scan;
+  };
+
+  class LazyFontGenerator:public fastuidraw::GlyphSelector::FontGeneratorBase
+  {
+  public:
+    LazyFontGenerator(const std::string &filename, const FaceEntry &face,
+                      const fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> &lib,
+                      const fastuidraw::FontFreeType::RenderParams &render_params):
+      m_filename(filename),
+      m_face_index(face.m_face_index),
+      m_props(face.m_props),
+      m_lib(lib),
+      m_render_params(render_params)
+    {}
+
+    virtual
+    fastuidraw::reference_counted_ptr<const fastuidraw::FontBase>
+    generate_font(void) const
+    {
+      /* a GlyphSelector may ask for the font from each of
+       * the font groups to which the generator belongs,
+       * so the font is made only once.
+       */
+      std::lock_guard<std::mutex> m(m_mutex);
+      if (!m_font)
+        {
+          fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeFace::GeneratorBase> gen;
+
+          gen = FASTUIDRAWnew fastuidraw::FreeTypeFace::GeneratorFile(m_filename.c_str(), m_face_index);
+          m_font = FASTUIDRAWnew fastuidraw::FontFreeType(gen, m_props, m_render_params, m_lib);
+        }
+      return m_font;
+    }
+
+    virtual
+    const fastuidraw::FontProperties&
+    font_properties(void) const
+    {
+      return m_props;
+    }
+
+  private:
+    std::string m_filename;
+    int m_face_index;
+    fastuidraw::FontProperties m_props;
+    fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> m_lib;
+    fastuidraw::FontFreeType::RenderParams m_render_params;
+
+    mutable std::mutex m_mutex;
+    mutable fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> m_font;
+  };
+
+  class FreeTypeFontRegistryPrivate
+  {
+  public:
+    FreeTypeFontRegistryPrivate(const fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> &lib,
+                                const fastuidraw::FontFreeType::RenderParams &render_params):
+      m_lib(lib),
+      m_render_params(render_params),
+      m_number_threads(1)
+    {}
+
+    void
+    find_files(const std::string &path, std::vector<PendingFile> &dst,
+               std::set<FileId> &visited_directories);
+
+    static
+    void
+    scan_files(std::vector<PendingFile> *files, unsigned int begin, unsigned int stride);
+
+    static
+    void
+    scan_file(FT_Library lib, PendingFile &file);
+
+    fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> m_lib;
+    fastuidraw::FontFreeType::RenderParams m_render_params;
+    unsigned int m_number_threads;
+
+    /* entries of the files loaded by load_cache() or
+     * added by add_path(), keyed by filename.
+     */
+    std::map<std::string, FileEntry> m_cache;
+
+    std::set<FileId> m_added_files;
+    std::vector<fastuidraw::reference_counted_ptr<const fastuidraw::GlyphSelector::FontGeneratorBase> > m_generators;
+  };
+
+  /* strings are written one per field separated by tabs,
+   * so tabs and line breaks within them are replaced.
+   */
+  std::string
+  sanitize(fastuidraw::c_string s)
+  {
+    std::string return_value(s ? s : "");
+    std::replace(return_value.begin(), return_value.end(), '\t', ' ');
+    std::replace(return_value.begin(), return_value.end(), '\n', ' ');
+    std::replace(return_value.begin(), return_value.end(), '\r', ' ');
+    return return_value;
+  }
+}
+
+//////////////////////////////////////////
+// FreeTypeFontRegistryPrivate methods
+void
+FreeTypeFontRegistryPrivate::
+find_files(const std::string &path, std::vector<PendingFile> &dst,
+           std::set<FileId> &visited_directories)
+{
+  struct stat st;
+  FileId id;
+
+  /* stat() follows symbolic links, so a directory is
+   * walked only the first time it is reached; this stops
+   * symbolic links that form a loop and a file reached by
+   * more than one path is added only once.
+   */
+  if (stat(path.c_str(), &st) != 0)
+    {
+      return;
+    }
+
+  id = FileId(st.st_dev, st.st_ino);
+  if (S_ISDIR(st.st_mode))
+    {
+      DIR *dir;
+      struct dirent *entry;
+
+      if (!visited_directories.insert(id).second)
+        {
+          return;
+        }
+
+      dir = opendir(path.c_str());
+      if (!dir)
+        {
+          return;
+        }
+
+      for(entry = readdir(dir); entry != nullptr; entry = readdir(dir))
+        {
+          std::string file(entry->d_name);
+          if (file != ".." && file != ".")
+            {
+              find_files(path + "/" + file, dst, visited_directories);
+            }
+        }
+      closedir(dir);
+    }
+  else if (S_ISREG(st.st_mode) && m_added_files.insert(id).second)
+    {
+      std::map<std::string, FileEntry>::const_iterator iter;
+      PendingFile P;
+
+      P.m_filename = path;
+      P.m_entry.m_size = st.st_size;
+      P.m_entry.m_mtime = st.st_mtime;
+
+      iter = m_cache.find(path);
+      if (iter != m_cache.end() && iter->second.matches(P.m_entry))
+        {
+          P.m_entry = iter->second;
+          P.m_needs_scan = false;
+        }
+      else
+        {
+          P.m_needs_scan = true;
+        }
+      dst.push_back(P);
+    }
+}
+
+void
+FreeTypeFontRegistryPrivate::
+scan_files(std::vector<PendingFile> *files, unsigned int begin, unsigned int stride)
+{
+  /* each thread uses its own FT_Library so that the
+   * threads do not serialize on the lock of a shared
+   * FreeTypeLib when opening faces.
+   */
+  fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeLib> lib;
+
+  lib = FASTUIDRAWnew fastuidraw::FreeTypeLib();
+  for (unsigned int i = begin; i < files->size(); i += stride)
+    {
+      if ((*files)[i].m_needs_scan)
+        {
+          scan_file(lib->lib(), (*files)[i]);
+        }
+    }
+}
+
+void
+FreeTypeFontRegistryPrivate::
+scan_file(FT_Library lib, PendingFile &file)
+{
+  FT_Face face(nullptr);
+  FT_Long num_faces;
+
+  if (FT_New_Face(lib, file.m_filename.c_str(), 0, &face) != 0 || face == nullptr)
+    {
+      return;
+    }
+
+  num_faces = face->num_faces;
+  for (FT_Long i = 0; i < num_faces; ++i)
+    {
+      if (i != 0)
+        {
+          FT_Done_Face(face);
+          face = nullptr;
+          if (FT_New_Face(lib, file.m_filename.c_str(), i, &face) != 0 || face == nullptr)
+            {
+              continue;
+            }
+        }
+
+      if ((face->face_flags & FT_FACE_FLAG_SCALABLE) != 0)
+        {
+          std::ostringstream source_label;
+          FaceEntry F;
+
+          F.m_face_index = i;
+          fastuidraw::FontFreeType::compute_font_properties_from_face(face, F.m_props);
+          source_label << file.m_filename << ":" << i;
+          F.m_props.source_label(source_label.str().c_str());
+          file.m_entry.m_faces.push_back(F);
+        }
+    }
+
+  if (face != nullptr)
+    {
+      FT_Done_Face(face);
+    }
+}
+
+//////////////////////////////////////////
+// fastuidraw::FreeTypeFontRegistry methods
+fastuidraw::FreeTypeFontRegistry::
+FreeTypeFontRegistry(const reference_counted_ptr<FreeTypeLib> &lib,
+                     const FontFreeType::RenderParams &render_params)
+{
+  m_d = FASTUIDRAWnew FreeTypeFontRegistryPrivate(lib, render_params);
+}
+
+fastuidraw::FreeTypeFontRegistry::
+~FreeTypeFontRegistry()
+{
+  FreeTypeFontRegistryPrivate *d;
+  d = static_cast<FreeTypeFontRegistryPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+unsigned int
+fastuidraw::FreeTypeFontRegistry::
+number_threads(void) const
+{
+  FreeTypeFontRegistryPrivate *d;
+  d = static_cast<FreeTypeFontRegistryPrivate*>(m_d);
+  return d->m_number_threads;
+}
+
+fastuidraw::FreeTypeFontRegistry&
+fastuidraw::FreeTypeFontRegistry::
+number_threads(unsigned int n)
+{
+  FreeTypeFontRegistryPrivate *d;
+  d = static_cast<FreeTypeFontRegistryPrivate*>(m_d);
+  d->m_number_threads = t_max(1u, n);
+  return *this;
+}
+
+enum fastuidraw::return_code
+fastuidraw::FreeTypeFontRegistry::
+load_cache(c_string filename)
+{
+  FreeTypeFontRegistryPrivate *d;
+  d = static_cast<FreeTypeFontRegistryPrivate*>(m_d);
+
+  std::ifstream file(filename);
+  std::string line;
+
+  if (!file || !std::getline(file, line) || line != cache_file_header)
+    {
+      return routine_fail;
+    }
+
+  /* The format of a cache file is the header line followed
+   * by for each file the line
+   *   file <size> <mtime> <number faces> <filename>
+   * followed by the line of each of its scalable faces
+   *   face <index> <bold> <italic>\t<family>\t<style>\t<foundry>
+   */
+  while (std::getline(file, line))
+    {
+      std::istringstream str(line);
+      std::string tag, name;
+      unsigned int num_faces(0);
+      FileEntry E;
+
+      if (!(str >> tag >> E.m_size >> E.m_mtime >> num_faces) || tag != "file")
+        {
+          return routine_fail;
+        }
+      str.get();
+      std::getline(str, name);
+
+      for (unsigned int i = 0; i < num_faces; ++i)
+        {
+          std::istringstream face_str;
+          std::string family, style, foundry;
+          bool bold(false), italic(false);
+          std::ostringstream source_label;
+          FaceEntry F;
+
+          if (!std::getline(file, line))
+            {
+              return routine_fail;
+            }
+
+          face_str.str(line);
+          if (!(face_str >> tag >> F.m_face_index >> bold >> italic) || tag != "face")
+            {
+              return routine_fail;
+            }
+          face_str.get();
+          std::getline(face_str, family, '\t');
+          std::getline(face_str, style, '\t');
+          std::getline(face_str, foundry);
+
+          source_label << name << ":" << F.m_face_index;
+          F.m_props
+            .bold(bold)
+            .italic(italic)
+            .family(family.c_str())
+            .style(style.c_str())
+            .foundry(foundry.c_str())
+            .source_label(source_label.str().c_str());
+          E.m_faces.push_back(F);
+        }
+      d->m_cache[name] = E;
+    }
+
+  return routine_success;
+}
+
+enum fastuidraw::return_code
+fastuidraw::FreeTypeFontRegistry::
+save_cache(c_string filename) const
+{
+  FreeTypeFontRegistryPrivate *d;
+  d = static_cast<FreeTypeFontRegistryPrivate*>(m_d);
+
+  std::ofstream file(filename);
+  if (!file)
+    {
+      return routine_fail;
+    }
+
+  file << cache_file_header << "\n";
+  for (const auto &e : d->m_cache)
+    {
+      if (e.first.find('\n') != std::string::npos)
+        {
+          continue;
+        }
+
+      file << "file " << e.second.m_size << " " << e.second.m_mtime
+           << " " << e.second.m_faces.size() << " " << e.first << "\n";
+      for (const FaceEntry &F : e.second.m_faces)
+        {
+          file << "face " << F.m_face_index << " " << F.m_props.bold()
+               << " " << F.m_props.italic() << "\t" << sanitize(F.m_props.family())
+               << "\t" << sanitize(F.m_props.style()) << "\t"
+               << sanitize(F.m_props.foundry()) << "\n";
+        }
+    }
+
+  return file ? routine_success : routine_fail;
+}
+
+unsigned int
+fastuidraw::FreeTypeFontRegistry::
+add_path(c_string path)
+{
+  FreeTypeFontRegistryPrivate *d;
+  d = static_cast<FreeTypeFontRegistryPrivate*>(m_d);
+
+  std::vector<PendingFile> files;
+  std::set<FileId> visited_directories;
+  std::vector<std::thread> threads;
+  unsigned int num_to_scan(0), num_threads, return_value(0);
+
+  d->find_files(path, files, visited_directories);
+  for (const PendingFile &P : files)
+    {
+      num_to_scan += (P.m_needs_scan) ? 1u : 0u;
+    }
+
+  num_threads = t_min(d->m_number_threads, num_to_scan);
+  for (unsigned int t = 1; t < num_threads; ++t)
+    {
+      threads.push_back(std::thread(FreeTypeFontRegistryPrivate::scan_files,
+                                    &files, t, num_threads));
+    }
+  if (num_threads > 0)
+    {
+      FreeTypeFontRegistryPrivate::scan_files(&files, 0, num_threads);
+    }
+  for (std::thread &th : threads)
+    {
+      th.join();
+    }
+
+  /* the fonts are added in the order the files were found
+   * regardless of which thread scanned them.
+   */
+  for (const PendingFile &P : files)
+    {
+      for (const FaceEntry &F : P.m_entry.m_faces)
+        {
+          reference_counted_ptr<const GlyphSelector::FontGeneratorBase> h;
+
+          h = FASTUIDRAWnew LazyFontGenerator(P.m_filename, F, d->m_lib, d->m_render_params);
+          d->m_generators.push_back(h);
+          ++return_value;
+        }
+      d->m_cache[P.m_filename] = P.m_entry;
+    }
+
+  return return_value;
+}
+
+unsigned int
+fastuidraw::FreeTypeFontRegistry::
+number_fonts(void) const
+{
+  FreeTypeFontRegistryPrivate *d;
+  d = static_cast<FreeTypeFontRegistryPrivate*>(m_d);
+  return d->m_generators.size();
+}
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::GlyphSelector::FontGeneratorBase>&
+fastuidraw::FreeTypeFontRegistry::
+font_generator(unsigned int I) const
+{
+  FreeTypeFontRegistryPrivate *d;
+  d = static_cast<FreeTypeFontRegistryPrivate*>(m_d);
+
+  FASTUIDRAWassert(I < d->m_generators.size());
+  return d->m_generators[I];
+}
+
+void
+fastuidraw::FreeTypeFontRegistry::
+register_fonts(GlyphSelector &selector) const
+{
+  FreeTypeFontRegistryPrivate *d;
+  d = static_cast<FreeTypeFontRegistryPrivate*>(m_d);
+
+  for (const auto &h : d->m_generators)
+    {
+      selector.add_font_generator(h);
+    }
+}
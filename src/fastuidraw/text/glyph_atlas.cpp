@@ -20,32 +20,57 @@
 #include <mutex>
 #include <fastuidraw/text/glyph_atlas.hpp>
 
-#include "../private/interval_allocator.hpp"
+#include "../private/segregated_interval_allocator.hpp"
 #include "../private/util_private.hpp"
 #include "private/rect_atlas.hpp"
+#include "private/shelf_atlas.hpp"
 
 namespace
 {
-  class rect_atlas_layer:
-    public fastuidraw::reference_counted<rect_atlas_layer>::non_concurrent,
-    public fastuidraw::detail::RectAtlas
+  class texel_layer:
+    public fastuidraw::reference_counted<texel_layer>::non_concurrent
   {
   public:
     explicit
-    rect_atlas_layer(const fastuidraw::ivec2 &dimensions, int player):
-      fastuidraw::detail::RectAtlas(dimensions),
+    texel_layer(int player):
       m_layer(player)
     {}
 
+    virtual
+    ~texel_layer()
+    {}
+
     int
     layer(void) const
     {
       return m_layer;
     }
 
+    virtual
+    fastuidraw::detail::RectAtlasBase&
+    atlas(void) = 0;
+
   private:
     int m_layer;
+  };
+
+  template<typename T>
+  class texel_layer_implement:
+    public texel_layer,
+    public T
+  {
+  public:
+    texel_layer_implement(const fastuidraw::ivec2 &dimensions, int player):
+      texel_layer(player),
+      T(dimensions)
+    {}
 
+    virtual
+    fastuidraw::detail::RectAtlasBase&
+    atlas(void)
+    {
+      return *this;
+    }
   };
 
   class GlyphAtlasTexelBackingStoreBasePrivate
@@ -85,7 +110,9 @@ namespace
   {
   public:
     GlyphAtlasPrivate(fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasTexelBackingStoreBase> ptexel_store,
-                      fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasGeometryBackingStoreBase> pgeometry_store):
+                      fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasGeometryBackingStoreBase> pgeometry_store,
+                      enum fastuidraw::GlyphAtlas::texel_allocator_t ptexel_allocator):
+      m_texel_allocator(ptexel_allocator),
       m_texel_store(ptexel_store),
       m_geometry_store(pgeometry_store),
       m_geometry_data_allocator(pgeometry_store->size())
@@ -105,15 +132,23 @@ namespace
       m_private_data.resize(new_size);
       for(int i = old_size; i < new_size; ++i)
         {
-          m_private_data[i] = FASTUIDRAWnew rect_atlas_layer(dims, i);
+          if (m_texel_allocator == fastuidraw::GlyphAtlas::shelf_texel_allocator)
+            {
+              m_private_data[i] = FASTUIDRAWnew texel_layer_implement<fastuidraw::detail::ShelfAtlas>(dims, i);
+            }
+          else
+            {
+              m_private_data[i] = FASTUIDRAWnew texel_layer_implement<fastuidraw::detail::RectAtlas>(dims, i);
+            }
         }
     }
 
     std::mutex m_mutex;
+    enum fastuidraw::GlyphAtlas::texel_allocator_t m_texel_allocator;
     fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasTexelBackingStoreBase> m_texel_store;
     fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasGeometryBackingStoreBase> m_geometry_store;
-    std::vector<fastuidraw::reference_counted_ptr<rect_atlas_layer> > m_private_data;
-    fastuidraw::interval_allocator m_geometry_data_allocator;
+    std::vector<fastuidraw::reference_counted_ptr<texel_layer> > m_private_data;
+    fastuidraw::segregated_interval_allocator m_geometry_data_allocator;
   };
 }
 
@@ -235,9 +270,9 @@ fastuidraw::ivec2
 fastuidraw::GlyphLocation::
 location(void) const
 {
-  const detail::RectAtlas::rectangle *p;
+  const detail::RectAtlasBase::rectangle *p;
 
-  p = static_cast<const detail::RectAtlas::rectangle*>(m_opaque);
+  p = static_cast<const detail::RectAtlasBase::rectangle*>(m_opaque);
   return (p != nullptr) ?
     p->unpadded_minX_minY() :
     ivec2(-1, -1);
@@ -247,17 +282,20 @@ int
 fastuidraw::GlyphLocation::
 layer(void) const
 {
-  const detail::RectAtlas::rectangle *p;
-  const rect_atlas_layer *a;
+  const detail::RectAtlasBase::rectangle *p;
+  const texel_layer *a;
 
-  p = static_cast<const detail::RectAtlas::rectangle*>(m_opaque);
+  p = static_cast<const detail::RectAtlasBase::rectangle*>(m_opaque);
   if (p == nullptr)
     {
       return -1;
     }
 
-  FASTUIDRAWassert(dynamic_cast<const rect_atlas_layer*>(p->atlas()));
-  a = static_cast<const rect_atlas_layer*>(p->atlas());
+  /* the atlas of p is a texel_layer_implement, which
+   * is a texel_layer by its other base class
+   */
+  a = dynamic_cast<const texel_layer*>(p->atlas());
+  FASTUIDRAWassert(a != nullptr);
 
   return a->layer();
 }
@@ -266,8 +304,8 @@ fastuidraw::ivec2
 fastuidraw::GlyphLocation::
 size(void) const
 {
-  const detail::RectAtlas::rectangle *p;
-  p = static_cast<const detail::RectAtlas::rectangle*>(m_opaque);
+  const detail::RectAtlasBase::rectangle *p;
+  p = static_cast<const detail::RectAtlasBase::rectangle*>(m_opaque);
   return (p != nullptr) ?
     p->unpadded_size() :
     ivec2(-1, -1);
@@ -277,9 +315,10 @@ size(void) const
 // fastuidraw::GlyphAtlas methods
 fastuidraw::GlyphAtlas::
 GlyphAtlas(reference_counted_ptr<GlyphAtlasTexelBackingStoreBase> ptexel_store,
-           reference_counted_ptr<GlyphAtlasGeometryBackingStoreBase> pgeometry_store)
+           reference_counted_ptr<GlyphAtlasGeometryBackingStoreBase> pgeometry_store,
+           enum texel_allocator_t ptexel_allocator)
 {
-  m_d = FASTUIDRAWnew GlyphAtlasPrivate(ptexel_store, pgeometry_store);
+  m_d = FASTUIDRAWnew GlyphAtlasPrivate(ptexel_store, pgeometry_store, ptexel_allocator);
 };
 
 fastuidraw::GlyphAtlas::
@@ -301,7 +340,7 @@ allocate(fastuidraw::ivec2 size, c_array<const uint8_t> pdata,
   d = static_cast<GlyphAtlasPrivate*>(m_d);
 
   GlyphLocation return_value;
-  const detail::RectAtlas::rectangle *r(nullptr);
+  const detail::RectAtlasBase::rectangle *r(nullptr);
   unsigned int layer;
 
   if (size.x() > d->m_texel_store->dimensions().x()
@@ -314,9 +353,9 @@ allocate(fastuidraw::ivec2 size, c_array<const uint8_t> pdata,
 
   for(unsigned int i = 0, endi = d->m_private_data.size(); i < endi && r == nullptr; ++i)
     {
-      r = d->m_private_data[i]->add_rectangle(size,
-                                              padding.m_left, padding.m_right,
-                                              padding.m_top, padding.m_bottom);
+      r = d->m_private_data[i]->atlas().add_rectangle(size,
+                                                      padding.m_left, padding.m_right,
+                                                      padding.m_top, padding.m_bottom);
       layer = i;
     }
 
@@ -333,9 +372,9 @@ allocate(fastuidraw::ivec2 size, c_array<const uint8_t> pdata,
       d->m_texel_store->resize(old_size + 1);
       d->allocate_atlas_bookkeeping(d->m_texel_store->dimensions().z());
 
-      r = d->m_private_data[old_size]->add_rectangle(size,
-                                                     padding.m_left, padding.m_right,
-                                                     padding.m_top, padding.m_bottom);
+      r = d->m_private_data[old_size]->atlas().add_rectangle(size,
+                                                             padding.m_left, padding.m_right,
+                                                             padding.m_top, padding.m_bottom);
       layer = old_size;
       FASTUIDRAWassert(r != nullptr);
     }
@@ -355,12 +394,12 @@ fastuidraw::GlyphAtlas::
 deallocate(fastuidraw::GlyphLocation G)
 {
   FASTUIDRAWassert(G.valid());
-  const detail::RectAtlas::rectangle *r;
+  const detail::RectAtlasBase::rectangle *r;
 
-  r = static_cast<const detail::RectAtlas::rectangle*>(G.m_opaque);
+  r = static_cast<const detail::RectAtlasBase::rectangle*>(G.m_opaque);
   if (r != nullptr)
     {
-      detail::RectAtlas::delete_rectangle(r);
+      detail::RectAtlasBase::delete_rectangle(r);
     }
 }
 
@@ -435,7 +474,7 @@ clear(void)
   d->m_geometry_data_allocator.reset(d->m_geometry_data_allocator.size());
   for(unsigned int i = 0, endi = d->m_private_data.size(); i < endi; ++i)
     {
-      d->m_private_data[i]->clear();
+      d->m_private_data[i]->atlas().clear();
     }
 }
 
@@ -451,6 +490,15 @@ flush(void) const
   d->m_geometry_store->flush();
 }
 
+enum fastuidraw::GlyphAtlas::texel_allocator_t
+fastuidraw::GlyphAtlas::
+texel_allocator(void) const
+{
+  GlyphAtlasPrivate *d;
+  d = static_cast<GlyphAtlasPrivate*>(m_d);
+  return d->m_texel_allocator;
+}
+
 fastuidraw::reference_counted_ptr<const fastuidraw::GlyphAtlasTexelBackingStoreBase>
 fastuidraw::GlyphAtlas::
 texel_store(void) const
@@ -17,8 +17,10 @@
  */
 
 
-#include <map>
+#include <unordered_map>
 #include <vector>
+#include <mutex>
+#include <atomic>
 #include <fastuidraw/text/glyph_cache.hpp>
 #include <fastuidraw/text/glyph_render_data.hpp>
 #include "../private/util_private.hpp"
@@ -40,6 +42,10 @@ namespace
     void
     clear(void);
 
+    void
+    generate(const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+             uint32_t glyph_code);
+
     enum fastuidraw::return_code
     upload_to_atlas(void);
 
@@ -60,7 +66,15 @@ namespace
      */
     fastuidraw::vecN<fastuidraw::GlyphLocation, 2> m_atlas_location;
     int m_geometry_offset, m_geometry_length;
-    bool m_uploaded_to_atlas;
+    std::atomic<bool> m_uploaded_to_atlas;
+
+    /* m_generated is set after m_layout, m_path and
+     * m_glyph_data are computed by generate(), which
+     * computes them under m_generate_mutex so that
+     * only one thread computes the data of a glyph.
+     */
+    std::mutex m_generate_mutex;
+    std::atomic<bool> m_generated;
 
     /* Path of the glyph
      */
@@ -86,11 +100,11 @@ namespace
     {}
 
     bool
-    operator<(const GlyphSource &rhs) const
+    operator==(const GlyphSource &rhs) const
     {
-      return (m_font != rhs.m_font) ? m_font < rhs.m_font :
-        (m_glyph_code != rhs.m_glyph_code) ? m_glyph_code < rhs.m_glyph_code :
-        m_render < rhs.m_render;
+      return m_font == rhs.m_font
+        && m_glyph_code == rhs.m_glyph_code
+        && m_render == rhs.m_render;
     }
 
     fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> m_font;
@@ -98,6 +112,36 @@ namespace
     fastuidraw::GlyphRender m_render;
   };
 
+  class GlyphSourceHasher
+  {
+  public:
+    size_t
+    operator()(const GlyphSource &v) const
+    {
+      /* must agree with GlyphRender::operator==() which
+       * ignores m_pixel_size for scalable glyph types;
+       * consecutive glyph codes land in different shards.
+       */
+      size_t return_value;
+
+      return_value = reinterpret_cast<uintptr_t>(v.m_font.get());
+      return_value = 31u * return_value + v.m_glyph_code;
+      return_value = 31u * return_value + v.m_render.m_type;
+      if (!fastuidraw::GlyphRender::scalable(v.m_render.m_type))
+        {
+          return_value = 31u * return_value + v.m_render.m_pixel_size;
+        }
+      return return_value;
+    }
+  };
+
+  class GlyphCacheShard
+  {
+  public:
+    std::mutex m_mutex;
+    std::unordered_map<GlyphSource, GlyphDataPrivate*, GlyphSourceHasher> m_glyph_map;
+  };
+
   class GlyphCachePrivate
   {
   public:
@@ -107,17 +151,44 @@ namespace
 
     ~GlyphCachePrivate();
 
+    enum
+      {
+        number_shards = 16
+      };
+
+    GlyphCacheShard&
+    shard(const GlyphSource &src)
+    {
+      return m_shards[GlyphSourceHasher()(src) % number_shards];
+    }
+
     /* When the atlas is full, we will clear the atlas, but save
      *  the values in m_glyphs but mark them as not having been
      *  uploaded, this way returned values are safe and we do
      *  not have to regenerate data either.
      */
 
+    /* Locking order is: shard mutexes in increasing index,
+     * then m_upload_mutex, then m_glyphs_mutex.
+     */
     GlyphDataPrivate*
-    fetch_or_allocate_glyph(GlyphSource src);
+    fetch_or_allocate_glyph(const GlyphSource &src);
 
     fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> m_atlas;
-    std::map<GlyphSource, GlyphDataPrivate*> m_glyph_map;
+
+    /* a glyph is found from its GlyphSource by locking
+     * only the shard of the GlyphSource, so that lookups
+     * from different threads rarely contend.
+     */
+    GlyphCacheShard m_shards[number_shards];
+
+    /* serializes uploading glyph data to m_atlas and
+     * clearing the atlas locations of the glyphs.
+     */
+    std::mutex m_upload_mutex;
+
+    /* guards m_glyphs and m_free_slots */
+    std::mutex m_glyphs_mutex;
     std::vector<GlyphDataPrivate*> m_glyphs;
     std::vector<unsigned int> m_free_slots;
     fastuidraw::GlyphCache *m_p;
@@ -133,6 +204,7 @@ GlyphDataPrivate(GlyphCachePrivate *c, unsigned int I):
   m_geometry_offset(-1),
   m_geometry_length(0),
   m_uploaded_to_atlas(false),
+  m_generated(false),
   m_glyph_data(nullptr)
 {}
 
@@ -143,6 +215,7 @@ GlyphDataPrivate(void):
   m_geometry_offset(-1),
   m_geometry_length(0),
   m_uploaded_to_atlas(false),
+  m_generated(false),
   m_glyph_data(nullptr)
 {}
 
@@ -176,6 +249,7 @@ clear(void)
     }
 
   m_uploaded_to_atlas = false;
+  m_generated = false;
   if (m_glyph_data)
     {
       FASTUIDRAWdelete(m_glyph_data);
@@ -184,19 +258,32 @@ clear(void)
   m_path.clear();
 }
 
+void
+GlyphDataPrivate::
+generate(const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+         uint32_t glyph_code)
+{
+  if (m_generated.load(std::memory_order_acquire))
+    {
+      return;
+    }
+
+  std::lock_guard<std::mutex> m(m_generate_mutex);
+  if (!m_generated.load(std::memory_order_relaxed))
+    {
+      FASTUIDRAWassert(!m_glyph_data);
+      m_glyph_data = font->compute_rendering_data(m_render, glyph_code, m_layout, m_path);
+      m_generated.store(true, std::memory_order_release);
+    }
+}
+
 enum fastuidraw::return_code
 GlyphDataPrivate::
 upload_to_atlas(void)
 {
-  /* TODO:
-   * 1. this method is not thread safe if different threads
-   *    attempt to access the same glyph (or if different
-   *    threads call this routine and clear_atlas()
-   *    at the same time).
-   */
   enum fastuidraw::return_code return_value;
 
-  if (m_uploaded_to_atlas)
+  if (m_uploaded_to_atlas.load(std::memory_order_acquire))
     {
       return fastuidraw::routine_success;
     }
@@ -206,6 +293,12 @@ upload_to_atlas(void)
       return fastuidraw::routine_fail;
     }
 
+  std::lock_guard<std::mutex> m(m_cache->m_upload_mutex);
+  if (m_uploaded_to_atlas.load(std::memory_order_relaxed))
+    {
+      return fastuidraw::routine_success;
+    }
+
   FASTUIDRAWassert(m_glyph_data);
   return_value = m_glyph_data->upload_to_atlas(m_cache->m_atlas,
                                                m_atlas_location[0],
@@ -214,7 +307,7 @@ upload_to_atlas(void)
                                                m_geometry_length);
   if (return_value == fastuidraw::routine_success)
     {
-      m_uploaded_to_atlas = true;
+      m_uploaded_to_atlas.store(true, std::memory_order_release);
     }
 
   return return_value;
@@ -244,17 +337,20 @@ GlyphCachePrivate::
 
 GlyphDataPrivate*
 GlyphCachePrivate::
-fetch_or_allocate_glyph(GlyphSource src)
+fetch_or_allocate_glyph(const GlyphSource &src)
 {
-  std::map<GlyphSource, GlyphDataPrivate*>::iterator iter;
+  GlyphCacheShard &S(shard(src));
+  std::lock_guard<std::mutex> m(S.m_mutex);
+  std::unordered_map<GlyphSource, GlyphDataPrivate*, GlyphSourceHasher>::iterator iter;
   GlyphDataPrivate *G;
 
-  iter = m_glyph_map.find(src);
-  if (iter != m_glyph_map.end())
+  iter = S.m_glyph_map.find(src);
+  if (iter != S.m_glyph_map.end())
     {
       return iter->second;
     }
 
+  std::lock_guard<std::mutex> g(m_glyphs_mutex);
 
   if (m_free_slots.empty())
     {
@@ -269,7 +365,12 @@ fetch_or_allocate_glyph(GlyphSource src)
       G = m_glyphs[v];
       FASTUIDRAWassert(!G->m_render.valid());
     }
-  m_glyph_map[src] = G;
+
+  /* the glyph data is generated outside of the shard
+   * lock by GlyphDataPrivate::generate().
+   */
+  G->m_render = src.m_render;
+  S.m_glyph_map[src] = G;
   return G;
 }
 
@@ -384,7 +485,7 @@ create_glyph(GlyphRender render,
   GlyphDataPrivate *d;
   d = FASTUIDRAWnew GlyphDataPrivate();
   d->m_render = render;
-  d->m_glyph_data = font->compute_rendering_data(d->m_render, glyph_code, d->m_layout, d->m_path);
+  d->generate(font, glyph_code);
   return Glyph(d);
 }
 
@@ -439,13 +540,7 @@ fetch_glyph(GlyphRender render,
   GlyphSource src(font, glyph_code, render);
 
   q = d->fetch_or_allocate_glyph(src);
-
-  if (!q->m_render.valid())
-    {
-      q->m_render = render;
-      FASTUIDRAWassert(!q->m_glyph_data);
-      q->m_glyph_data = font->compute_rendering_data(q->m_render, glyph_code, q->m_layout, q->m_path);
-    }
+  q->generate(font, glyph_code);
 
   return Glyph(q);
 }
@@ -468,14 +563,19 @@ add_glyph(Glyph glyph)
 
   GlyphCachePrivate *d;
   d = static_cast<GlyphCachePrivate*>(m_d);
-  if (d->m_glyph_map.find(src) != d->m_glyph_map.end())
+
+  GlyphCacheShard &S(d->shard(src));
+  std::lock_guard<std::mutex> m(S.m_mutex);
+  if (S.m_glyph_map.find(src) != S.m_glyph_map.end())
     {
       return routine_fail;
     }
 
+  std::lock_guard<std::mutex> gm(d->m_glyphs_mutex);
   g->m_cache = d;
   g->m_cache_location = d->m_glyphs.size();
   d->m_glyphs.push_back(g);
+  S.m_glyph_map[src] = g;
 
   return routine_success;
 }
@@ -494,7 +594,12 @@ delete_glyph(Glyph G)
   FASTUIDRAWassert(p->m_render.valid());
 
   GlyphSource src(p->m_layout.m_font, p->m_layout.m_glyph_code, p->m_render);
-  d->m_glyph_map.erase(src);
+  GlyphCacheShard &S(d->shard(src));
+  std::lock_guard<std::mutex> m(S.m_mutex);
+  std::lock_guard<std::mutex> um(d->m_upload_mutex);
+  std::lock_guard<std::mutex> gm(d->m_glyphs_mutex);
+
+  S.m_glyph_map.erase(src);
   p->clear();
   d->m_free_slots.push_back(p->m_cache_location);
 }
@@ -506,6 +611,9 @@ clear_atlas(void)
   GlyphCachePrivate *d;
   d = static_cast<GlyphCachePrivate*>(m_d);
 
+  std::lock_guard<std::mutex> um(d->m_upload_mutex);
+  std::lock_guard<std::mutex> gm(d->m_glyphs_mutex);
+
   d->m_atlas->clear();
   for(unsigned int i = 0, endi = d->m_glyphs.size(); i < endi; ++i)
     {
@@ -525,9 +633,18 @@ clear_cache(void)
   GlyphCachePrivate *d;
   d = static_cast<GlyphCachePrivate*>(m_d);
 
-  d->m_atlas->clear();
-  d->m_glyph_map.clear();
+  for(unsigned int i = 0; i < GlyphCachePrivate::number_shards; ++i)
+    {
+      d->m_shards[i].m_mutex.lock();
+      d->m_shards[i].m_glyph_map.clear();
+    }
+
+  d->m_upload_mutex.lock();
+  d->m_glyphs_mutex.lock();
 
+  /* clear the glyphs before the atlas, since clearing a
+   * glyph frees its regions of the atlas.
+   */
   for(unsigned int i = 0, endi = d->m_glyphs.size(); i < endi; ++i)
     {
       GlyphDataPrivate *p;
@@ -538,4 +655,12 @@ clear_cache(void)
           d->m_free_slots.push_back(p->m_cache_location);
         }
     }
+  d->m_atlas->clear();
+
+  d->m_glyphs_mutex.unlock();
+  d->m_upload_mutex.unlock();
+  for(unsigned int i = 0; i < GlyphCachePrivate::number_shards; ++i)
+    {
+      d->m_shards[i].m_mutex.unlock();
+    }
 }
@@ -44,6 +44,23 @@ namespace
     uint32_t m_glyph_code;
   };
 
+  /* Returns the glyph code of a character code of a font, using
+   * the FontBase::character_coverage() of the font to skip calling
+   * FontBase::glyph_code() when the font lacks the character.
+   */
+  uint32_t
+  fetch_glyph_code(const fastuidraw::FontBase *font, uint32_t character_code)
+  {
+    const fastuidraw::CharacterCoverage *coverage;
+
+    coverage = font->character_coverage();
+    if (coverage && !coverage->contains(character_code))
+      {
+        return 0;
+      }
+    return font->glyph_code(character_code);
+  }
+
   class font_group:public fastuidraw::reference_counted<font_group>::non_concurrent
   {
   public:
@@ -317,7 +334,7 @@ fetch_glyph(uint32_t character_code, enum fastuidraw::glyph_type tp,
     {
       if (font->can_create_rendering_data(tp))
         {
-          r = font->glyph_code(character_code);
+          r = fetch_glyph_code(font.get(), character_code);
           if (r)
             {
               return glyph_source(font, r);
@@ -332,7 +349,7 @@ fetch_glyph(uint32_t character_code, enum fastuidraw::glyph_type tp,
       f = use_unused_generator();
       if (f && f->can_create_rendering_data(tp))
         {
-          r = f->glyph_code(character_code);
+          r = fetch_glyph_code(f.get(), character_code);
           if (r)
             {
               return glyph_source(f, r);
@@ -396,7 +413,7 @@ fetch_glyph_helper(fastuidraw::reference_counted_ptr<const fastuidraw::FontBase>
 
   if (h->can_create_rendering_data(tp))
     {
-      r = h->glyph_code(character_code);
+      r = fetch_glyph_code(h.get(), character_code);
     }
 
   if (r)
@@ -431,7 +448,7 @@ fetch_glyph_no_merging_no_lock(fastuidraw::GlyphRender tp,
 
   if (h->can_create_rendering_data(tp.m_type))
     {
-      glyph_code = h->glyph_code(character_code);
+      glyph_code = fetch_glyph_code(h.get(), character_code);
     }
 
   if (glyph_code)
@@ -4,7 +4,7 @@ dirstack_$(sp)	:= $(d)
 d		:= $(dir)
 # End standard header
 
-FASTUIDRAW_PRIVATE_SOURCES += $(call filelist, rect_atlas.cpp)
+FASTUIDRAW_PRIVATE_SOURCES += $(call filelist, rect_atlas.cpp shelf_atlas.cpp)
 
 # Begin standard footer
 d		:= $(dirstack_$(sp))
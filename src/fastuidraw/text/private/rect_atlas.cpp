@@ -473,7 +473,7 @@ clear(void)
   m_mutex.unlock();
 }
 
-const fastuidraw::detail::RectAtlas::rectangle*
+const fastuidraw::detail::RectAtlasBase::rectangle*
 fastuidraw::detail::RectAtlas::
 add_rectangle(const ivec2 &dimensions,
               int left_padding, int right_padding,
@@ -526,11 +526,13 @@ add_rectangle(const ivec2 &dimensions,
 
 enum fastuidraw::return_code
 fastuidraw::detail::RectAtlas::
-remove_rectangle_implement(const rectangle *im)
+remove_rectangle_implement(const RectAtlasBase::rectangle *pim)
 {
   add_remove_return_value R;
+  const rectangle *im;
 
-  FASTUIDRAWassert(im->atlas() == this);
+  FASTUIDRAWassert(pim->atlas() == this);
+  im = static_cast<const rectangle*>(pim);
 
   if (im->size().x() <= 0 || im->size().y() <= 0)
     {
@@ -551,13 +553,3 @@ remove_rectangle_implement(const rectangle *im)
     }
 }
 
-
-
-enum fastuidraw::return_code
-fastuidraw::detail::RectAtlas::
-delete_rectangle(const RectAtlas::rectangle *im)
-{
-  FASTUIDRAWassert(im);
-  FASTUIDRAWassert(im->m_atlas != nullptr);
-  return im->m_atlas->remove_rectangle_implement(im);
-}
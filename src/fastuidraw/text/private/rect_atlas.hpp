@@ -30,61 +30,30 @@
 #include <fastuidraw/util/c_array.hpp>
 
 #include "../../private/util_private.hpp"
+#include "rect_atlas_base.hpp"
 
 
 namespace fastuidraw {
 namespace detail {
 
 /*!\class RectAtlas
- * Provides an interface to allocate and free rectangle
- * regions from a large rectangle.
+ * Implements \ref RectAtlasBase with a tree of nodes,
+ * where adding a rectangle to a node that is already
+ * occupied splits the node into 3 children.
  */
-class RectAtlas:public fastuidraw::noncopyable
+class RectAtlas:public RectAtlasBase
 {
 private:
   class tree_base;
 
 public:
   /*!\class rectangle
-   * An rectangle gives the location (i.e size and
-   * position) of a rectangle within a RectAtlas.
-   * The location of a rectangle does not change for the
-   * lifetime of the rectangle after returned by
-   * add_rectangle().
+   * A rectangle of a RectAtlas, records the leaf
+   * of the tree that holds it.
    */
-  class rectangle:public fastuidraw::noncopyable
+  class rectangle:public RectAtlasBase::rectangle
   {
   public:
-    /*!\fn const ivec2& minX_minY
-     * Returns the minX_minY of the rectangle.
-     */
-    const ivec2&
-    minX_minY(void) const
-    {
-      return m_minX_minY;
-    }
-
-    /*!\fn const ivec2& size
-     * Returns the size of the rectangle.
-     */
-    const ivec2&
-    size(void) const
-    {
-      return m_size;
-    }
-
-    const ivec2&
-    unpadded_minX_minY(void) const
-    {
-      return m_unpadded_minX_minY;
-    }
-
-    const ivec2&
-    unpadded_size(void) const
-    {
-      return m_unpadded_size;
-    }
-
     /*!\fn
      * Returns the owning RectAtlas of this
      * rectangle.
@@ -92,35 +61,18 @@ public:
     const RectAtlas*
     atlas(void) const
     {
-      return m_atlas;
+      return static_cast<const RectAtlas*>(m_atlas);
     }
 
-    virtual
-    ~rectangle()
-    {}
-
   private:
     friend class RectAtlas;
     friend class tree_base;
 
     rectangle(RectAtlas *p, const ivec2 &psize):
-      m_atlas(p),
-      m_minX_minY(0, 0),
-      m_size(psize),
+      RectAtlasBase::rectangle(p, psize),
       m_tree(nullptr)
     {}
 
-    void
-    finalize(int left, int right,
-             int top, int bottom)
-    {
-      m_unpadded_minX_minY = m_minX_minY - ivec2(left, top);
-      m_unpadded_size = m_size - ivec2(left + right, top + bottom);
-    }
-
-    RectAtlas *m_atlas;
-    ivec2 m_minX_minY, m_size;
-    ivec2 m_unpadded_minX_minY, m_unpadded_size;
     tree_base *m_tree;
 
     void
@@ -137,50 +89,24 @@ public:
   virtual
   ~RectAtlas();
 
-  /*!\fn const rectangle* add_rectangle
-   * Returns a pointer to the a newly created rectangle
-   * of the requested size. Returns nullptr on failure.
-   * The rectangle is owned by this RectAtlas.
-   * An implementation may not change the location
-   * (or size) of a rectangle once it has been
-   * returned by add_rectangle().
-   * \param dimension width and height of the rectangle
-   */
-  const rectangle*
+  virtual
+  const RectAtlasBase::rectangle*
   add_rectangle(const ivec2 &dimension,
                 int left_padding, int right_padding,
                 int top_padding, int bottom_padding);
 
-  /*!\fn void clear
-   * Clears the RectAtlas, in doing so deleting
-   * all recranges allocated by \ref add_rectangle().
-   * After clear(), all rectangle objects
-   * returned by add_rectangle() are deleted, and as
-   * such the pointers are then wild-invalid.
-   */
+  virtual
   void
   clear(void);
 
-  /*!\fn ivec2 size
-   * Returns the size of the \ref RectAtlas,
-   * i.e. the value passed as dimensions
-   * in RectAtlas().
-   */
+  virtual
   ivec2
   size(void) const;
 
-  /*!\fn enum return_code delete_rectangle
-   * Delete a rectangle, and in doing so remove it
-   * from the owning RectAtlas, and thus allowing
-   * subsequent rectangles added to use the room of the
-   * removed rectangle. Removing a rectangle deallocates
-   * it's backing data structure.
-   * \param im pointer to a rectangle,
-   *           as returned by add_rectangle, to remove
-   */
-  static
+protected:
+  virtual
   enum return_code
-  delete_rectangle(const rectangle *im);
+  remove_rectangle_implement(const RectAtlasBase::rectangle *im);
 
 private:
   /*
@@ -370,9 +296,6 @@ private:
     freesize_map m_sorted_by_y_size;
   };
 
-  enum return_code
-  remove_rectangle_implement(const rectangle *im);
-
   static
   void
   move_rectangle(rectangle *rect, const ivec2 &moveby)
@@ -0,0 +1,181 @@
+/*!
+ * \file rect_atlas_base.hpp
+ * \brief file rect_atlas_base.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/vecN.hpp>
+
+namespace fastuidraw {
+namespace detail {
+
+/*!\class RectAtlasBase
+ * Interface to allocate and free rectangle regions
+ * from a large rectangle; implemented by \ref RectAtlas
+ * and \ref ShelfAtlas.
+ */
+class RectAtlasBase:public fastuidraw::noncopyable
+{
+public:
+  /*!\class rectangle
+   * An rectangle gives the location (i.e size and
+   * position) of a rectangle within a RectAtlasBase.
+   * The location of a rectangle does not change for the
+   * lifetime of the rectangle after returned by
+   * add_rectangle().
+   */
+  class rectangle:public fastuidraw::noncopyable
+  {
+  public:
+    /*!\fn const ivec2& minX_minY
+     * Returns the minX_minY of the rectangle.
+     */
+    const ivec2&
+    minX_minY(void) const
+    {
+      return m_minX_minY;
+    }
+
+    /*!\fn const ivec2& size
+     * Returns the size of the rectangle.
+     */
+    const ivec2&
+    size(void) const
+    {
+      return m_size;
+    }
+
+    const ivec2&
+    unpadded_minX_minY(void) const
+    {
+      return m_unpadded_minX_minY;
+    }
+
+    const ivec2&
+    unpadded_size(void) const
+    {
+      return m_unpadded_size;
+    }
+
+    /*!\fn
+     * Returns the owning RectAtlasBase of this
+     * rectangle.
+     */
+    const RectAtlasBase*
+    atlas(void) const
+    {
+      return m_atlas;
+    }
+
+    virtual
+    ~rectangle()
+    {}
+
+  protected:
+    friend class RectAtlasBase;
+
+    rectangle(RectAtlasBase *p, const ivec2 &psize):
+      m_atlas(p),
+      m_minX_minY(0, 0),
+      m_size(psize)
+    {}
+
+    void
+    finalize(int left, int right,
+             int top, int bottom)
+    {
+      m_unpadded_minX_minY = m_minX_minY - ivec2(left, top);
+      m_unpadded_size = m_size - ivec2(left + right, top + bottom);
+    }
+
+    RectAtlasBase *m_atlas;
+    ivec2 m_minX_minY, m_size;
+    ivec2 m_unpadded_minX_minY, m_unpadded_size;
+  };
+
+  virtual
+  ~RectAtlasBase()
+  {}
+
+  /*!\fn const rectangle* add_rectangle
+   * Returns a pointer to the a newly created rectangle
+   * of the requested size. Returns nullptr on failure.
+   * The rectangle is owned by this RectAtlasBase.
+   * An implementation may not change the location
+   * (or size) of a rectangle once it has been
+   * returned by add_rectangle().
+   * \param dimension width and height of the rectangle
+   */
+  virtual
+  const rectangle*
+  add_rectangle(const ivec2 &dimension,
+                int left_padding, int right_padding,
+                int top_padding, int bottom_padding) = 0;
+
+  /*!\fn void clear
+   * Clears the RectAtlasBase, in doing so deleting
+   * all recranges allocated by \ref add_rectangle().
+   * After clear(), all rectangle objects
+   * returned by add_rectangle() are deleted, and as
+   * such the pointers are then wild-invalid.
+   */
+  virtual
+  void
+  clear(void) = 0;
+
+  /*!\fn ivec2 size
+   * Returns the size of the \ref RectAtlasBase,
+   * i.e. the dimensions of the rectangle from
+   * which rectangles are allocated.
+   */
+  virtual
+  ivec2
+  size(void) const = 0;
+
+  /*!\fn enum return_code delete_rectangle
+   * Delete a rectangle, and in doing so remove it
+   * from the owning RectAtlasBase, and thus allowing
+   * subsequent rectangles added to use the room of the
+   * removed rectangle. Removing a rectangle deallocates
+   * it's backing data structure.
+   * \param im pointer to a rectangle,
+   *           as returned by add_rectangle, to remove
+   */
+  static
+  enum return_code
+  delete_rectangle(const rectangle *im)
+  {
+    FASTUIDRAWassert(im);
+    FASTUIDRAWassert(im->m_atlas != nullptr);
+    return im->m_atlas->remove_rectangle_implement(im);
+  }
+
+protected:
+  /*!\fn enum return_code remove_rectangle_implement
+   * To be implemented by a derived class to remove
+   * and delete a rectangle it returned from
+   * add_rectangle().
+   */
+  virtual
+  enum return_code
+  remove_rectangle_implement(const rectangle *im) = 0;
+};
+
+} //namespace detail
+
+} //namespace fastuidraw
@@ -0,0 +1,304 @@
+/*!
+ * \file shelf_atlas.cpp
+ * \brief file shelf_atlas.cpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <algorithm>
+#include "shelf_atlas.hpp"
+
+namespace
+{
+  inline
+  int
+  highest_bit(uint32_t v)
+  {
+    int r(0);
+
+    FASTUIDRAWassert(v != 0u);
+    for (; v >>= 1u; ++r)
+      {}
+    return r;
+  }
+}
+
+////////////////////////////////////
+// fastuidraw::detail::ShelfAtlas methods
+fastuidraw::detail::ShelfAtlas::
+ShelfAtlas(const ivec2 &dimensions):
+  m_dimensions(dimensions),
+  m_y_allocator(dimensions.y()),
+  m_empty_rect(this, ivec2(0, 0))
+{
+}
+
+fastuidraw::detail::ShelfAtlas::
+~ShelfAtlas()
+{
+  clear_implement();
+}
+
+fastuidraw::ivec2
+fastuidraw::detail::ShelfAtlas::
+size(void) const
+{
+  return m_dimensions;
+}
+
+int
+fastuidraw::detail::ShelfAtlas::
+height_class(int height, int *rounded_height)
+{
+  const int number_sub_classes(1 << height_class_log2);
+  int l, step;
+
+  FASTUIDRAWassert(height > 0);
+  if (height < number_sub_classes)
+    {
+      *rounded_height = height;
+      return height;
+    }
+
+  /* round up to a multiple of a quarter of the
+   * power of two at or below height, then the class
+   * is given by the power of two and which quarter
+   * of the rounded height.
+   */
+  l = highest_bit(height);
+  step = 1 << (l - height_class_log2);
+  *rounded_height = step * ((height + step - 1) / step);
+
+  l = highest_bit(*rounded_height);
+  return (l - height_class_log2 + 1) * number_sub_classes
+    + (*rounded_height >> (l - height_class_log2)) - number_sub_classes;
+}
+
+fastuidraw::detail::ShelfAtlas::rectangle*
+fastuidraw::detail::ShelfAtlas::
+add_to_shelf(shelf *S, const ivec2 &dimensions)
+{
+  rectangle *return_value;
+  int x;
+
+  if (S->m_height < dimensions.y())
+    {
+      return nullptr;
+    }
+
+  x = S->m_x_allocator.allocate_interval(dimensions.x());
+  if (x == -1)
+    {
+      return nullptr;
+    }
+
+  return_value = FASTUIDRAWnew rectangle(this, dimensions);
+  return_value->m_minX_minY = ivec2(x, S->m_y);
+  return_value->m_shelf = S;
+  return_value->m_next = S->m_rectangles;
+  if (S->m_rectangles != nullptr)
+    {
+      S->m_rectangles->m_prev = return_value;
+    }
+  S->m_rectangles = return_value;
+
+  return return_value;
+}
+
+fastuidraw::detail::ShelfAtlas::shelf*
+fastuidraw::detail::ShelfAtlas::
+create_shelf(int height_class, int height)
+{
+  shelf *S;
+  int y;
+
+  y = m_y_allocator.allocate_interval(height);
+  if (y == -1)
+    {
+      return nullptr;
+    }
+
+  if (height_class >= static_cast<int>(m_shelves.size()))
+    {
+      m_shelves.resize(height_class + 1);
+    }
+
+  S = FASTUIDRAWnew shelf(y, height, m_dimensions.x(), height_class);
+  S->m_index = m_shelves[height_class].size();
+  m_shelves[height_class].push_back(S);
+
+  return S;
+}
+
+void
+fastuidraw::detail::ShelfAtlas::
+release_shelf(shelf *S)
+{
+  std::vector<shelf*> &shelves(m_shelves[S->m_height_class]);
+
+  FASTUIDRAWassert(S->m_rectangles == nullptr);
+  FASTUIDRAWassert(shelves[S->m_index] == S);
+
+  shelves[S->m_index] = shelves.back();
+  shelves[S->m_index]->m_index = S->m_index;
+  shelves.pop_back();
+
+  m_y_allocator.free_interval(S->m_y, S->m_height);
+  FASTUIDRAWdelete(S);
+}
+
+void
+fastuidraw::detail::ShelfAtlas::
+clear_implement(void)
+{
+  for (std::vector<shelf*> &shelves : m_shelves)
+    {
+      for (shelf *S : shelves)
+        {
+          for (rectangle *r = S->m_rectangles, *next; r != nullptr; r = next)
+            {
+              next = r->m_next;
+              FASTUIDRAWdelete(r);
+            }
+          FASTUIDRAWdelete(S);
+        }
+    }
+  m_shelves.clear();
+  m_y_allocator.reset(m_dimensions.y());
+}
+
+void
+fastuidraw::detail::ShelfAtlas::
+clear(void)
+{
+  std::lock_guard<std::mutex> m(m_mutex);
+  clear_implement();
+}
+
+const fastuidraw::detail::RectAtlasBase::rectangle*
+fastuidraw::detail::ShelfAtlas::
+add_rectangle(const ivec2 &dimensions,
+              int left_padding, int right_padding,
+              int top_padding, int bottom_padding)
+{
+  rectangle *return_value(nullptr);
+  int cls, height;
+
+  if (dimensions.x() <= 0 || dimensions.y() <= 0)
+    {
+      return &m_empty_rect;
+    }
+
+  if (dimensions.x() > m_dimensions.x() || dimensions.y() > m_dimensions.y())
+    {
+      return nullptr;
+    }
+
+  cls = height_class(dimensions.y(), &height);
+  height = std::min(height, m_dimensions.y());
+
+  m_mutex.lock();
+
+  /* first try the shelves of the height class, newest first
+   * since those are the ones most likely to have room.
+   */
+  if (cls < static_cast<int>(m_shelves.size()))
+    {
+      const std::vector<shelf*> &shelves(m_shelves[cls]);
+      for (unsigned int i = shelves.size(); i > 0 && return_value == nullptr; --i)
+        {
+          return_value = add_to_shelf(shelves[i - 1], dimensions);
+        }
+    }
+
+  /* then start a new shelf */
+  if (return_value == nullptr)
+    {
+      shelf *S;
+
+      S = create_shelf(cls, height);
+      if (S != nullptr)
+        {
+          return_value = add_to_shelf(S, dimensions);
+          FASTUIDRAWassert(return_value != nullptr);
+        }
+    }
+
+  /* and as a last resort place the rectangle on a taller shelf */
+  for (unsigned int c = cls + 1, endc = m_shelves.size(); c < endc && return_value == nullptr; ++c)
+    {
+      const std::vector<shelf*> &shelves(m_shelves[c]);
+      for (unsigned int i = shelves.size(); i > 0 && return_value == nullptr; --i)
+        {
+          return_value = add_to_shelf(shelves[i - 1], dimensions);
+        }
+    }
+
+  m_mutex.unlock();
+
+  if (return_value != nullptr)
+    {
+      return_value->finalize(left_padding, right_padding,
+                             top_padding, bottom_padding);
+    }
+
+  return return_value;
+}
+
+enum fastuidraw::return_code
+fastuidraw::detail::ShelfAtlas::
+remove_rectangle_implement(const RectAtlasBase::rectangle *pim)
+{
+  rectangle *im;
+  shelf *S;
+
+  FASTUIDRAWassert(pim->atlas() == this);
+  if (pim == &m_empty_rect)
+    {
+      return routine_success;
+    }
+
+  /* the rectangle is owned by this ShelfAtlas, so
+   * casting away const to unlink and delete it is
+   * legitimate.
+   */
+  im = static_cast<rectangle*>(const_cast<RectAtlasBase::rectangle*>(pim));
+  S = im->m_shelf;
+
+  std::lock_guard<std::mutex> m(m_mutex);
+
+  S->m_x_allocator.free_interval(im->minX_minY().x(), im->size().x());
+  if (im->m_prev != nullptr)
+    {
+      im->m_prev->m_next = im->m_next;
+    }
+  else
+    {
+      FASTUIDRAWassert(S->m_rectangles == im);
+      S->m_rectangles = im->m_next;
+    }
+
+  if (im->m_next != nullptr)
+    {
+      im->m_next->m_prev = im->m_prev;
+    }
+
+  if (S->m_rectangles == nullptr)
+    {
+      release_shelf(S);
+    }
+  FASTUIDRAWdelete(im);
+
+  return routine_success;
+}
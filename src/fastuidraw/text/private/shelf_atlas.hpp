@@ -0,0 +1,177 @@
+/*!
+ * \file shelf_atlas.hpp
+ * \brief file shelf_atlas.hpp
+ *
+ * Copyright 2018 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/fastuidraw_memory.hpp>
+
+#include "../../private/segregated_interval_allocator.hpp"
+#include "rect_atlas_base.hpp"
+
+namespace fastuidraw {
+namespace detail {
+
+/*!\class ShelfAtlas
+ * Implements \ref RectAtlasBase by packing rectangles
+ * into shelves: horizontal strips that span the width
+ * of the atlas. The height of a shelf is the height of
+ * the first rectangle placed on it rounded up to a height
+ * class (4 classes per power of two), and rectangles are
+ * placed on a shelf of their height class by allocating
+ * a range of x from the shelf. Shelves are allocated as a
+ * range of y from the atlas and a shelf is released once
+ * all of its rectangles are deleted, so that deallocation
+ * returns space to the atlas without a tree to maintain.
+ * This packs the many small, similarly sized rectangles
+ * of glyphs tightly and allocates no nodes beyond the
+ * rectangle itself.
+ */
+class ShelfAtlas:public RectAtlasBase
+{
+private:
+  class shelf;
+
+public:
+  /*!\class rectangle
+   * A rectangle of a ShelfAtlas, records the
+   * shelf on which it is located.
+   */
+  class rectangle:public RectAtlasBase::rectangle
+  {
+  public:
+    /*!\fn
+     * Returns the owning ShelfAtlas of this
+     * rectangle.
+     */
+    const ShelfAtlas*
+    atlas(void) const
+    {
+      return static_cast<const ShelfAtlas*>(m_atlas);
+    }
+
+  private:
+    friend class ShelfAtlas;
+
+    rectangle(ShelfAtlas *p, const ivec2 &psize):
+      RectAtlasBase::rectangle(p, psize),
+      m_shelf(nullptr),
+      m_prev(nullptr),
+      m_next(nullptr)
+    {}
+
+    shelf *m_shelf;
+
+    /* list of the rectangles of m_shelf */
+    rectangle *m_prev, *m_next;
+  };
+
+  /*!\fn
+   * Ctor
+   * \param dimensions dimension of the atlas, this is then the return value to size().
+   */
+  explicit
+  ShelfAtlas(const ivec2 &dimensions);
+
+  virtual
+  ~ShelfAtlas();
+
+  virtual
+  const RectAtlasBase::rectangle*
+  add_rectangle(const ivec2 &dimension,
+                int left_padding, int right_padding,
+                int top_padding, int bottom_padding);
+
+  virtual
+  void
+  clear(void);
+
+  virtual
+  ivec2
+  size(void) const;
+
+protected:
+  virtual
+  enum return_code
+  remove_rectangle_implement(const RectAtlasBase::rectangle *im);
+
+private:
+  enum
+    {
+      /* log2 of the number of height classes per power of two */
+      height_class_log2 = 2,
+    };
+
+  class shelf:fastuidraw::noncopyable
+  {
+  public:
+    shelf(int y, int height, int width, int height_class):
+      m_y(y),
+      m_height(height),
+      m_height_class(height_class),
+      m_index(-1),
+      m_x_allocator(width),
+      m_rectangles(nullptr)
+    {}
+
+    int m_y, m_height, m_height_class;
+
+    /* location of the shelf in m_shelves[m_height_class] */
+    int m_index;
+
+    segregated_interval_allocator m_x_allocator;
+    rectangle *m_rectangles;
+  };
+
+  /* Returns the height class of a height and sets
+   * rounded_height to the height of shelves of that class
+   */
+  static
+  int
+  height_class(int height, int *rounded_height);
+
+  rectangle*
+  add_to_shelf(shelf *S, const ivec2 &dimensions);
+
+  shelf*
+  create_shelf(int height_class, int height);
+
+  void
+  release_shelf(shelf *S);
+
+  void
+  clear_implement(void);
+
+  ivec2 m_dimensions;
+  std::mutex m_mutex;
+
+  /* allocation of y-ranges for shelves */
+  segregated_interval_allocator m_y_allocator;
+
+  /* shelves bucketed by their height class */
+  std::vector<std::vector<shelf*> > m_shelves;
+  rectangle m_empty_rect;
+};
+
+} //namespace detail
+
+} //namespace fastuidraw
@@ -18,12 +18,111 @@
 
 #include <vector>
 #include <fstream>
+#include <iterator>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <fastuidraw/util/data_buffer.hpp>
 #include "../private/util_private.hpp"
 
 namespace
 {
   typedef std::vector<uint8_t> DataBufferBackingStorePrivate;
+
+  class MappedDataBufferBackingStorePrivate
+  {
+  public:
+    explicit
+    MappedDataBufferBackingStorePrivate(fastuidraw::c_string filename);
+
+    ~MappedDataBufferBackingStorePrivate();
+
+    /* m_mapped is non-null exactly when the file is mapped,
+     * otherwise the file is copied into m_copy.
+     */
+    void *m_mapped;
+    size_t m_mapped_size;
+    std::vector<uint8_t> m_copy;
+  };
+
+  void
+  read_file(fastuidraw::c_string filename, std::vector<uint8_t> &dst)
+  {
+    std::ifstream file(filename, std::ios::binary);
+    if (file)
+      {
+        std::ifstream::pos_type sz;
+
+        file.seekg(0, std::ios::end);
+        sz = file.tellg();
+
+        /* files that cannot seek (pipes, /proc files) are read
+         * a byte at a time until their end.
+         */
+        if (sz == std::ifstream::pos_type(-1))
+          {
+            file.clear();
+            dst.assign(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+            return;
+          }
+
+        dst.resize(sz);
+
+        fastuidraw::c_array<char> p;
+        p = fastuidraw::make_c_array(dst).reinterpret_pointer<char>();
+
+        file.seekg(0, std::ios::beg);
+        file.read(p.c_ptr(), p.size());
+      }
+  }
+}
+
+////////////////////////////////////////////////
+// MappedDataBufferBackingStorePrivate methods
+MappedDataBufferBackingStorePrivate::
+MappedDataBufferBackingStorePrivate(fastuidraw::c_string filename):
+  m_mapped(nullptr),
+  m_mapped_size(0)
+{
+  int fd;
+
+  fd = open(filename, O_RDONLY);
+  if (fd != -1)
+    {
+      struct stat st;
+
+      /* mmap() fails for empty files, so those (and anything
+       * that is not a regular file) are read instead.
+       */
+      if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+        {
+          void *p;
+
+          p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+          if (p != MAP_FAILED)
+            {
+              m_mapped = p;
+              m_mapped_size = st.st_size;
+            }
+        }
+      close(fd);
+    }
+
+  if (!m_mapped)
+    {
+      read_file(filename, m_copy);
+    }
+}
+
+MappedDataBufferBackingStorePrivate::
+~MappedDataBufferBackingStorePrivate()
+{
+  if (m_mapped)
+    {
+      munmap(m_mapped, m_mapped_size);
+    }
 }
 
 fastuidraw::DataBufferBackingStore::
@@ -39,22 +138,7 @@ DataBufferBackingStore(c_string filename)
 
   d = FASTUIDRAWnew DataBufferBackingStorePrivate();
   m_d = d;
-
-  std::ifstream file(filename, std::ios::binary);
-  if (file)
-    {
-      std::ifstream::pos_type sz;
-
-      file.seekg(0, std::ios::end);
-      sz = file.tellg();
-      d->resize(sz);
-
-      c_array<char> dst;
-      dst = make_c_array(*d).reinterpret_pointer<char>();
-
-      file.seekg(0, std::ios::beg);
-      file.read(dst.c_ptr(), dst.size());
-    }
+  read_file(filename, *d);
 }
 
 fastuidraw::DataBufferBackingStore::
@@ -73,3 +157,43 @@ data(void)
   d = static_cast<DataBufferBackingStorePrivate*>(m_d);
   return make_c_array(*d);
 }
+
+/////////////////////////////////////////////////////
+// fastuidraw::MappedDataBufferBackingStore methods
+fastuidraw::MappedDataBufferBackingStore::
+MappedDataBufferBackingStore(c_string filename)
+{
+  m_d = FASTUIDRAWnew MappedDataBufferBackingStorePrivate(filename);
+}
+
+fastuidraw::MappedDataBufferBackingStore::
+~MappedDataBufferBackingStore()
+{
+  MappedDataBufferBackingStorePrivate *d;
+  d = static_cast<MappedDataBufferBackingStorePrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+}
+
+fastuidraw::c_array<const uint8_t>
+fastuidraw::MappedDataBufferBackingStore::
+data(void) const
+{
+  MappedDataBufferBackingStorePrivate *d;
+  d = static_cast<MappedDataBufferBackingStorePrivate*>(m_d);
+
+  if (d->m_mapped)
+    {
+      return c_array<const uint8_t>(static_cast<const uint8_t*>(d->m_mapped),
+                                    d->m_mapped_size);
+    }
+  return make_c_array(d->m_copy);
+}
+
+bool
+fastuidraw::MappedDataBufferBackingStore::
+mapped(void) const
+{
+  MappedDataBufferBackingStorePrivate *d;
+  d = static_cast<MappedDataBufferBackingStorePrivate*>(m_d);
+  return d->m_mapped != nullptr;
+}